@@ -31,8 +31,11 @@
 #define USE_GUI_MAIN 1
 /**
  * Ҫ֧ԤȽλͼ壬붨屾ꡣһֻRAMСʱñꡣ
+ *  WITH_STB_FONT ͬʱʱʹΪ"_ֺ"λͼ( tools/font_gen )
+ * λͼûеַֺ Truetype Ⱦ
  * #define WITH_BITMAP_FONT 1
  */
+#define WITH_BITMAP_FONT 1
 
 /**
  * ֧png/jpegͼƬ붨屾
@@ -98,6 +101,20 @@
  * #define HAS_STD_MALLOC 1
  */
 #define HAS_STD_MALLOC 1
+/**
+ * ֲṩ΢뾫ȵ get_time_us64 붨屾ꡣ
+ *
+ * #define HAS_GET_TIME_US64 1
+ */
+#define HAS_GET_TIME_US64 1
+/**
+ * ؼ¼ڴ(mem_slab)з䣬붨屾ꡣ
+ * ڴذرմںȫеĿ黹ѣԱⷴ/رմɵĶƬ
+ * ֻпؼ¼ڴط䣬emitter(߳ʹ)ȻӶѷ䡣
+ *
+ * #define WITH_WIDGET_POOL 1
+ */
+#define WITH_WIDGET_POOL 1
 /**
  * б׼fopen/fcloseȺ붨屾
  *
@@ -121,7 +138,9 @@
  *
  * #define WITH_WCSXXX 1
  */
+#ifndef AWTK_NATIVE /*(native)Իlibcṩwcsxxx*/
 #define WITH_WCSXXX 1
+#endif /*AWTK_NATIVE*/
 /**
  * STM32 G2DӲ٣붨屾
  *
@@ -163,8 +182,9 @@
  * ڵͶƽ̨ʹôڶ붨屾ꡣ
  *
  * #define WITHOUT_WINDOW_ANIMATORS 1
+ *
+ * ʹƬ֡ʱڶͼǰƬֱӻƴ(ԶWITHOUT_WINDOW_ANIMATOR_CACHE)
  */
-#define WITHOUT_WINDOW_ANIMATORS 1
 /**
  * ڵͶƽ̨ʹöԻԣ붨屾ꡣ
  *
@@ -184,6 +204,28 @@
  */
 #define FRAGMENT_FRAME_BUFFER_SIZE 32 * 1024
 
+/**
+ * Ƭʽ FrameBuffer ƽΪٸƬλ 1 ʱҪ LCD ṩ첽( DMA)ӿڣ
+ * ڴһƬεͬʱһƬΡ
+ *
+ * #define FRAGMENT_FRAME_BUFFER_NR 2
+ */
+
+/**
+ * û trace¼ÿһ֡ÿƬκÿؼĻƺʱԼÿƬεĻͼô
+ * glyph cache ûеĴˢºʱԵΪ Chrome trace ʽ JSON(ο base/render_trace.h)
+ *
+ * #define ENABLE_RENDER_TRACE 1
+ */
+
+/**
+ *  tickless ѭѭһʱڡ idle Ҫ߱жϻΪֹ
+ * ʱԵѯҪֲṩ TK_WAIT_EVENT/TK_WAKEUP(ο awtk-port/main_loop_esp32_raw.cpp)
+ *
+ * #define WITH_MAIN_LOOP_TICKLESS 1
+ */
+#define WITH_MAIN_LOOP_TICKLESS 1
+
 /**
  * 뷨빦ܣ붨屾ꡣ
  *
@@ -215,7 +257,6 @@
  *
  * #define WITH_CANVAS_OFFLINE_CUSTION 1
  */
-#define WITH_CANVAS_OFFLINE_CUSTION 1
 /**
  * ͸ɫˢ»ƣһʹڶͼ͸ʹ
  *
@@ -18,6 +18,17 @@ TFT_eSPI tft = TFT_eSPI();
 
 extern void write_data_func(uint16_t dat);
 extern void set_window_func(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end);
+extern void draw_bitmap_func(uint16_t x, uint16_t y, uint16_t w, uint16_t h, pixel_t *data);
+
+#define lcd_draw_bitmap_impl(x, y, w, h, p) draw_bitmap_func(x, y, w, h, p)
+
+#if FRAGMENT_FRAME_BUFFER_NR > 1
+extern void draw_bitmap_async_func(uint16_t x, uint16_t y, uint16_t w, uint16_t h, pixel_t *data);
+extern void draw_bitmap_wait_func(void);
+
+#define lcd_draw_bitmap_async_impl(x, y, w, h, p) draw_bitmap_async_func(x, y, w, h, p)
+#define lcd_draw_bitmap_wait_impl() draw_bitmap_wait_func()
+#endif /*FRAGMENT_FRAME_BUFFER_NR > 1*/
 
 void write_data_func(uint16_t dat)
 {
@@ -27,7 +38,33 @@ void set_window_func(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_
 {
   tft.esp32_set_window_func(x_start, y_start, x_end, y_end);
 }
+void draw_bitmap_func(uint16_t x, uint16_t y, uint16_t w, uint16_t h, pixel_t *data)
+{
+  tft.esp32_draw_bitmap_func(x, y, w, h, data);
+}
 
 #include "../awtk/src/base/pixel.h"
 #include "../awtk/src/blend/pixel_ops.inc"
 #include "../awtk/src/lcd/lcd_mem_fragment.inc"
+
+#if FRAGMENT_FRAME_BUFFER_NR > 1
+static bool_t s_dma_pending = FALSE;
+
+void draw_bitmap_wait_func(void)
+{
+  if (s_dma_pending)
+  {
+    tft.esp32_wait_bitmap_dma_func();
+    s_dma_pending = FALSE;
+    lcd_mem_fragment_flush_done((lcd_t *)&s_lcd_mem_fragment);
+  }
+}
+
+void draw_bitmap_async_func(uint16_t x, uint16_t y, uint16_t w, uint16_t h, pixel_t *data)
+{
+  /* TFT_eSPI keeps one DMA transfer in flight, so the previous strip is released here */
+  draw_bitmap_wait_func();
+  tft.esp32_draw_bitmap_dma_func(x, y, w, h, data);
+  s_dma_pending = TRUE;
+}
+#endif /*FRAGMENT_FRAME_BUFFER_NR > 1*/
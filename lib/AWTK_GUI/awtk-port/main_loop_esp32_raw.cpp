@@ -14,7 +14,20 @@
 #define KEY1_PIN (5)
 #define KEY2_PIN (21)
 
-ret_t platform_disaptch_input(main_loop_t *l) { return RET_OK; }
+#define KEY_DEBOUNCE_TIME 10 // ȥʱ()
+
+void dispatch_input_events(void);
+
+static bool s_key_inited = false;
+static uint32_t s_debounce_start = 0; // ȥʼʱ䣬0 ʾûȥ
+static TaskHandle_t s_main_loop_task = NULL;
+
+ret_t platform_disaptch_input(main_loop_t *l)
+{
+    dispatch_input_events();
+
+    return RET_OK;
+}
 
 // ʹõSPIӿڵСߴĻ,ֻʹƬʽframebufferĻ
 lcd_t *platform_create_lcd(wh_t w, wh_t h)
@@ -22,10 +35,57 @@ lcd_t *platform_create_lcd(wh_t w, wh_t h)
     return lcd_mem_fragment_create(w, h);
 }
 
+#ifdef WITH_MAIN_LOOP_TICKLESS
+// жֻѭ״̬ѭжȡ
+static void IRAM_ATTR key_isr(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (s_main_loop_task != NULL)
+    {
+        vTaskNotifyGiveFromISR(s_main_loop_task, &woken);
+        if (woken)
+        {
+            portYIELD_FROM_ISR();
+        }
+    }
+}
+
+static ret_t main_loop_esp32_wait_event(main_loop_simple_t *loop, uint32_t timeout_ms)
+{
+    if (s_debounce_start != 0)
+    {
+        timeout_ms = tk_min(timeout_ms, KEY_DEBOUNCE_TIME);
+    }
+
+    return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)) > 0 ? RET_OK : RET_TIMEOUT;
+}
+
+static ret_t main_loop_esp32_wakeup(main_loop_t *l)
+{
+    // ѭԼͶݵ¼ǰͻᱻҪ
+    if (s_main_loop_task != NULL && xTaskGetCurrentTaskHandle() != s_main_loop_task)
+    {
+        xTaskNotifyGive(s_main_loop_task);
+    }
+
+    return RET_OK;
+}
+
+#define TK_WAIT_EVENT main_loop_esp32_wait_event
+#define TK_WAKEUP main_loop_esp32_wakeup
+#endif /*WITH_MAIN_LOOP_TICKLESS*/
+
 void Key_Init(void)
 {
-    pinMode(KEY1_PIN, PULLUP);
-    pinMode(KEY2_PIN, PULLUP);
+    pinMode(KEY1_PIN, INPUT_PULLUP);
+    pinMode(KEY2_PIN, INPUT_PULLUP);
+
+    s_main_loop_task = xTaskGetCurrentTaskHandle();
+#ifdef WITH_MAIN_LOOP_TICKLESS
+    attachInterrupt(digitalPinToInterrupt(KEY1_PIN), key_isr, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(KEY2_PIN), key_isr, CHANGE);
+#endif /*WITH_MAIN_LOOP_TICKLESS*/
 }
 
 uint8_t Key_Scan(void)
@@ -33,7 +93,18 @@ uint8_t Key_Scan(void)
     static uint16_t key_up = 1; // ɿ־
     if (key_up == 1 && (digitalRead(KEY1_PIN) == LOW || digitalRead(KEY2_PIN) == LOW))
     {
-        delay(10); // ȥ
+        // ȥѭ³ KEY_DEBOUNCE_TIME ȷ
+        uint32_t now = millis();
+        if (s_debounce_start == 0)
+        {
+            s_debounce_start = now != 0 ? now : 1;
+            return 0;
+        }
+        if (now - s_debounce_start < KEY_DEBOUNCE_TIME)
+        {
+            return 0;
+        }
+        s_debounce_start = 0;
         key_up = 0;
         if (digitalRead(KEY1_PIN) == LOW)
             return TK_KEY_LEFT;
@@ -43,23 +114,34 @@ uint8_t Key_Scan(void)
     else if (digitalRead(KEY1_PIN) == HIGH && digitalRead(KEY2_PIN) == HIGH)
     {
         key_up = 1;
+        s_debounce_start = 0;
     }
     return 0; // ް
 }
 
 void dispatch_input_events(void)
 {
-    bool is_press = 0; /* ĬϰΪ̧״̬ */
+    static int last_key = 0;
+    int key = 0;
+
+    if (!s_key_inited)
+    {
+        Key_Init();
+        s_key_inited = true;
+    }
+
     /* ȡ豸Ϣʵʵ֣ */
-    int key = Key_Scan();
+    key = Key_Scan();
     /* ȡֵͰ״̬AWTK ļֵο awtk/src/base/keys.h */
     if (key)
     {
+        last_key = key;
         main_loop_post_key_event(main_loop(), TRUE, key);
     }
-    else
+    else if (last_key != 0 && digitalRead(KEY1_PIN) == HIGH && digitalRead(KEY2_PIN) == HIGH)
     {
-        main_loop_post_key_event(main_loop(), FALSE, key);
+        main_loop_post_key_event(main_loop(), FALSE, last_key);
+        last_key = 0;
     }
 }
 
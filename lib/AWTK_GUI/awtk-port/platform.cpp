@@ -21,6 +21,17 @@ uint64_t get_time_ms64(void)
   return (uint64_t)(esp_timer_get_time() / 1000ULL);
 }
 
+/**
+ * @method get_time_us64
+ * ȡǰʱ(΢)
+ *
+ * @return {uint64_t} ɹصǰʱ䡣
+ */
+uint64_t get_time_us64(void)
+{
+  return (uint64_t)esp_timer_get_time();
+}
+
 /**
  * @method sleep_ms
  *
@@ -46,6 +46,8 @@ struct AGGENVGcontext
 {
   AGGENVGcontext()
   {
+    this->x = 0;
+    this->y = 0;
     this->w = 0;
     this->h = 0;
     this->data = NULL;
@@ -77,7 +79,9 @@ struct AGGENVGcontext
   uint8_t b;
   uint8_t a;
 
-  /*frame buffer*/
+  /*frame buffer, (x, y) is the canvas position of its first pixel*/
+  int32_t x;
+  int32_t y;
   uint32_t w;
   uint32_t h;
   uint32_t stride;
@@ -304,7 +308,7 @@ static void aggenvg__renderFlush(void *uptr)
   NVG_NOTUSED(uptr);
 }
 
-static void prepareRasterizer(AGGENVGcontext *agge, NVGscissor *scissor, NVGpaint *paint)
+static bool prepareRasterizer(AGGENVGcontext *agge, NVGscissor *scissor, NVGpaint *paint)
 {
   agge::rasterizer<agge::clipper<int>> &ras = agge->ras;
 
@@ -322,17 +326,32 @@ static void prepareRasterizer(AGGENVGcontext *agge, NVGscissor *scissor, NVGpain
     clip_y -= offset;
   }
   agge::rect<agge::real_t> clip_r = mkrect(clip_x, clip_y, clip_x + clip_w, clip_y + clip_h);
+  if (clip_w < 0 || clip_h < 0)
+  {
+    /*no scissor(extent is -1 after nvgResetScissor): clip to the frame buffer only*/
+    clip_r = mkrect<agge::real_t>(agge->x, agge->y, agge->x + (int32_t)agge->w,
+                                  agge->y + (int32_t)agge->h);
+  }
+
+  /*clip to the frame buffer too, so only the rows it holds are scanline-converted*/
+  clip_r.x1 = agge::agge_max<agge::real_t>(clip_r.x1, agge->x);
+  clip_r.y1 = agge::agge_max<agge::real_t>(clip_r.y1, agge->y);
+  clip_r.x2 = agge::agge_min<agge::real_t>(clip_r.x2, agge->x + (int32_t)agge->w);
+  clip_r.y2 = agge::agge_min<agge::real_t>(clip_r.y2, agge->y + (int32_t)agge->h);
 
   ras.reset();
-  if (clip_w > 0 && clip_h > 0)
+  if (clip_r.x1 >= clip_r.x2 || clip_r.y1 >= clip_r.y2)
   {
-    ras.set_clipping(clip_r);
+    return false;
   }
+  ras.set_clipping(clip_r);
 
   agge->r = paint->innerColor.r * 0xff;
   agge->g = paint->innerColor.g * 0xff;
   agge->b = paint->innerColor.b * 0xff;
   agge->a = paint->innerColor.a * 0xff;
+
+  return true;
 }
 
 static agge::pixel32_rgba to_pixel32_rgba(NVGcolor rgba)
@@ -342,6 +361,12 @@ static agge::pixel32_rgba to_pixel32_rgba(NVGcolor rgba)
 
 static int clip_rect_is_zero(NVGscissor *scissor)
 {
+  /*negative extent means no scissor, not an empty one*/
+  if (scissor->extent[0] < 0 || scissor->extent[1] < 0)
+  {
+    return 1;
+  }
+
   int w = (int)(scissor->extent[0] + 0.5f);
   int h = (int)(scissor->extent[1] + 0.5f);
   if (w <= 0 || h <= 0)
@@ -357,6 +382,7 @@ void renderPaint(AGGENVGcontext *agge, NVGpaint *paint)
   agge::renderer &ren = agge->ren;
   agge::rasterizer<agge::clipper<int>> &ras = agge->ras;
   agge::bitmap<PixelT, agge::raw_bitmap> surface(agge->w, agge->h, agge->stride, agge->data);
+  agge::rect_i window = mkrect<int>(agge->x, agge->y, agge->x + agge->w, agge->y + agge->h);
 
   if (paint->image > 0)
   {
@@ -373,7 +399,7 @@ void renderPaint(AGGENVGcontext *agge, NVGpaint *paint)
       typedef agge::bitmap<agge::pixel32_rgba, agge::raw_bitmap> rgba_bitmap_t;
       rgba_bitmap_t src(tex->width, tex->height, tex->stride, tex->flags, tex->orientation, (uint8_t *)(tex->data));
       agge::nanovg_image_blender<PixelT, rgba_bitmap_t> color(&src, (float *)invxform, paint->innerColor.a);
-      ren(surface, 0, ras, color, agge::winding<>());
+      ren(surface, &window, ras, color, agge::winding<>());
       break;
     }
     case NVG_TEXTURE_BGRA:
@@ -381,7 +407,7 @@ void renderPaint(AGGENVGcontext *agge, NVGpaint *paint)
       typedef agge::bitmap<agge::pixel32_bgra, agge::raw_bitmap> bgra_bitmap_t;
       bgra_bitmap_t src(tex->width, tex->height, tex->stride, tex->flags, tex->orientation, (uint8_t *)(tex->data));
       agge::nanovg_image_blender<PixelT, bgra_bitmap_t> color(&src, (float *)invxform, paint->innerColor.a);
-      ren(surface, 0, ras, color, agge::winding<>());
+      ren(surface, &window, ras, color, agge::winding<>());
       break;
     }
     case NVG_TEXTURE_BGR565:
@@ -389,7 +415,7 @@ void renderPaint(AGGENVGcontext *agge, NVGpaint *paint)
       typedef agge::bitmap<agge::pixel16_bgr565, agge::raw_bitmap> bgr565_bitmap_t;
       bgr565_bitmap_t src(tex->width, tex->height, tex->stride, tex->flags, tex->orientation, (uint8_t *)(tex->data));
       agge::nanovg_image_blender<PixelT, bgr565_bitmap_t> color(&src, (float *)invxform, paint->innerColor.a);
-      ren(surface, 0, ras, color, agge::winding<>());
+      ren(surface, &window, ras, color, agge::winding<>());
       break;
     }
     case NVG_TEXTURE_RGB:
@@ -397,7 +423,7 @@ void renderPaint(AGGENVGcontext *agge, NVGpaint *paint)
       typedef agge::bitmap<agge::pixel24_rgb, agge::raw_bitmap> rgb_bitmap_t;
       rgb_bitmap_t src(tex->width, tex->height, tex->stride, tex->flags, tex->orientation, (uint8_t *)(tex->data));
       agge::nanovg_image_blender<PixelT, rgb_bitmap_t> color(&src, (float *)invxform, paint->innerColor.a);
-      ren(surface, 0, ras, color, agge::winding<>());
+      ren(surface, &window, ras, color, agge::winding<>());
       break;
     }
     default:
@@ -412,7 +438,7 @@ void renderPaint(AGGENVGcontext *agge, NVGpaint *paint)
     if (memcmp(&(paint->innerColor), &(paint->outerColor), sizeof(paint->outerColor)) == 0)
     {
       agge::blender_solid_color_rgb<PixelT> color(agge->r, agge->g, agge->b, agge->a);
-      ren(surface, 0, ras, color, agge::winding<>());
+      ren(surface, &window, ras, color, agge::winding<>());
     }
     else if (paint->radius == 0)
     {
@@ -428,7 +454,7 @@ void renderPaint(AGGENVGcontext *agge, NVGpaint *paint)
       agge::pixel32_rgba oc = to_pixel32_rgba(paint->outerColor);
       agge::blender_linear_gradient<PixelT> color(sx, sy, ex, ey, ic, oc);
 
-      ren(surface, 0, ras, color, agge::winding<>());
+      ren(surface, &window, ras, color, agge::winding<>());
     }
     else
     {
@@ -441,7 +467,7 @@ void renderPaint(AGGENVGcontext *agge, NVGpaint *paint)
       agge::pixel32_rgba oc = to_pixel32_rgba(paint->outerColor);
       agge::blender_radial_gradient<PixelT> color(cx, cy, inr, outr, ic, oc);
 
-      ren(surface, 0, ras, color, agge::winding<>());
+      ren(surface, &window, ras, color, agge::winding<>());
     }
   }
 }
@@ -456,7 +482,11 @@ void renderFill(void *uptr, NVGpaint *paint, NVGcompositeOperationState composit
   AGGENVGcontext *agge = (AGGENVGcontext *)uptr;
   agge::rasterizer<agge::clipper<int>> &ras = agge->ras;
 
-  prepareRasterizer(agge, scissor, paint);
+  /*bounds: minx, miny, maxx, maxy*/
+  if (bounds[3] < agge->y || bounds[1] >= agge->y + (int32_t)agge->h)
+    return;
+  if (!prepareRasterizer(agge, scissor, paint))
+    return;
 
   for (int i = 0; i < npaths; i++)
   {
@@ -492,7 +522,8 @@ void renderStroke(void *uptr, NVGpaint *paint, NVGcompositeOperationState compos
   agge::rasterizer<agge::clipper<int>> &ras = agge->ras;
 
   line_style.width(strokeWidth);
-  prepareRasterizer(agge, scissor, paint);
+  if (!prepareRasterizer(agge, scissor, paint))
+    return;
 
   for (int i = 0; i < npaths; i++)
   {
@@ -545,6 +576,8 @@ static void aggenvg__globalSreenOrientation(void *uptr, enum NVGorientation orie
 static void nvgInitAGGE(AGGENVGcontext *agge, NVGparams *params, uint32_t w, uint32_t h, uint32_t stride,
                         enum NVGtexture format, uint8_t *data)
 {
+  agge->x = 0;
+  agge->y = 0;
   agge->w = w;
   agge->h = h;
   agge->data = data;
@@ -607,6 +640,17 @@ void nvgReinitAgge(NVGcontext *ctx, uint32_t w, uint32_t h, uint32_t stride, enu
   nvgInitAGGE(agge, params, w, h, stride, format, data);
 }
 
+void nvgReinitAggeFragment(NVGcontext *ctx, int32_t x, int32_t y, uint32_t w, uint32_t h,
+                           uint32_t stride, enum NVGtexture format, uint8_t *data)
+{
+  NVGparams *params = nvgGetParams(ctx);
+  AGGENVGcontext *agge = (AGGENVGcontext *)(params->userPtr);
+
+  nvgInitAGGE(agge, params, w, h, stride, format, data);
+  agge->x = x;
+  agge->y = y;
+}
+
 NVGcontext *nvgCreateAGGE(uint32_t w, uint32_t h, uint32_t stride, enum NVGtexture format, uint8_t *data)
 {
   NVGparams params;
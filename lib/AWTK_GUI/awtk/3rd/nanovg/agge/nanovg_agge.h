@@ -19,6 +19,9 @@ extern "C"
     NVGcontext *nvgCreateAGGE(uint32_t w, uint32_t h, uint32_t stride, enum NVGtexture format, uint8_t *data);
     void nvgReinitAgge(NVGcontext *ctx, uint32_t w, uint32_t h, uint32_t stride, enum NVGtexture format,
                        uint8_t *data);
+    /*data holds the w x h pixels at (x, y) of the canvas, e.g. one fragment frame buffer strip*/
+    void nvgReinitAggeFragment(NVGcontext *ctx, int32_t x, int32_t y, uint32_t w, uint32_t h,
+                               uint32_t stride, enum NVGtexture format, uint8_t *data);
     void nvgDeleteAGGE(NVGcontext *ctx);
 
 #ifdef __cplusplus
@@ -48,6 +48,8 @@
 #define NVG_INIT_PATHS_SIZE 16
 #define NVG_INIT_VERTS_SIZE 256
 #define NVG_MAX_STATES 32
+#define NVG_REUSE_KEY_SIZE 8
+#define NVG_REUSE_ALIGN(n) (((n) + 7) & ~7)
 
 #define NVG_KAPPA90 0.5522847493f	// Length proportional to radius of a cubic bezier handle for 90deg arcs.
 
@@ -114,6 +116,27 @@ struct NVGpathCache {
 };
 typedef struct NVGpathCache NVGpathCache;
 
+// A path kept for nvgSetPathReuse(): followed by its commands, its paths and their vertices.
+struct NVGreusedPath {
+	unsigned int hash;
+	int size;
+	int ncommands;
+	int npaths;
+	float key[NVG_REUSE_KEY_SIZE];
+	float bounds[4];
+};
+typedef struct NVGreusedPath NVGreusedPath;
+
+struct NVGpathReuse {
+	unsigned char* data;
+	int ndata;
+	int cdata;
+	int maxBytes;
+	NVGpath* paths;
+	int cpaths;
+};
+typedef struct NVGpathReuse NVGpathReuse;
+
 struct NVGcontext {
 	NVGparams params;
 	float* commands;
@@ -123,6 +146,7 @@ struct NVGcontext {
 	NVGstate states[NVG_MAX_STATES];
 	int nstates;
 	NVGpathCache* cache;
+	NVGpathReuse reuse;
 	float tessTol;
 	float distTol;
 	float fringeWidth;
@@ -363,6 +387,7 @@ void nvgDeleteInternal(NVGcontext* ctx)
 	if (ctx == NULL) return;
 	if (ctx->commands != NULL) free(ctx->commands);
 	if (ctx->cache != NULL) nvg__deletePathCache(ctx->cache);
+	nvgSetPathReuse(ctx, 0);
 
 #ifdef WITH_NANOVG_GPU
 	if (ctx->fs)
@@ -446,6 +471,27 @@ void nvgBeginFrame(NVGcontext* ctx, float windowWidth, float windowHeight, float
 	nvgBeginFrameEx(ctx, windowWidth, windowHeight, devicePixelRatio, 1, orientation);
 }
 
+void nvgSetPathReuse(NVGcontext* ctx, int maxBytes)
+{
+	NVGpathReuse* reuse = &ctx->reuse;
+
+	if (maxBytes <= 0) {
+		if (reuse->data != NULL) free(reuse->data);
+		if (reuse->paths != NULL) free(reuse->paths);
+		memset(reuse, 0, sizeof(NVGpathReuse));
+		return;
+	}
+
+	if (reuse->ndata > maxBytes)
+		reuse->ndata = 0;
+	reuse->maxBytes = maxBytes;
+}
+
+void nvgResetPathReuse(NVGcontext* ctx)
+{
+	ctx->reuse.ndata = 0;
+}
+
 void nvgCancelFrame(NVGcontext* ctx)
 {
 	ctx->params.renderCancel(ctx->params.userPtr);
@@ -2604,18 +2650,169 @@ void nvgDebugDumpPathCache(NVGcontext* ctx)
 }
 #endif/*WITH_NANOVG_GPU*/
 
+static float* nvg__reusedCommands(NVGreusedPath* reused)
+{
+	return (float*)((unsigned char*)reused + NVG_REUSE_ALIGN(sizeof(NVGreusedPath)));
+}
+
+static NVGpath* nvg__reusedPaths(NVGreusedPath* reused)
+{
+	unsigned char* commands = (unsigned char*)nvg__reusedCommands(reused);
+	return (NVGpath*)(commands + NVG_REUSE_ALIGN(sizeof(float)*reused->ncommands));
+}
+
+static NVGvertex* nvg__reusedVerts(NVGreusedPath* reused)
+{
+	return (NVGvertex*)(nvg__reusedPaths(reused) + reused->npaths);
+}
+
+static unsigned int nvg__hashCommands(NVGcontext* ctx)
+{
+	const unsigned int* p = (const unsigned int*)ctx->commands;
+	unsigned int hash = 2166136261u;
+	int i;
+
+	for (i = 0; i < ctx->ncommands; i++) {
+		hash ^= p[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+// Finds the path kept for the current commands and the same flatten/expand state (key).
+static NVGreusedPath* nvg__findReusedPath(NVGcontext* ctx, unsigned int hash, const float* key)
+{
+	NVGpathReuse* reuse = &ctx->reuse;
+	int offset = 0;
+
+	while (offset < reuse->ndata) {
+		NVGreusedPath* reused = (NVGreusedPath*)(reuse->data + offset);
+		if (reused->hash == hash && reused->ncommands == ctx->ncommands &&
+			memcmp(reused->key, key, sizeof(reused->key)) == 0 &&
+			memcmp(nvg__reusedCommands(reused), ctx->commands, sizeof(float)*ctx->ncommands) == 0)
+			return reused;
+		offset += reused->size;
+	}
+
+	return NULL;
+}
+
+// Returns the kept paths with their fill/stroke pointing to the kept vertices.
+static const NVGpath* nvg__reusePaths(NVGcontext* ctx, NVGreusedPath* reused)
+{
+	NVGpathReuse* reuse = &ctx->reuse;
+	const NVGpath* src = nvg__reusedPaths(reused);
+	NVGvertex* verts = nvg__reusedVerts(reused);
+	int i;
+
+	if (reused->npaths > reuse->cpaths) {
+		NVGpath* paths = (NVGpath*)realloc(reuse->paths, sizeof(NVGpath)*reused->npaths);
+		if (paths == NULL) return NULL;
+		reuse->paths = paths;
+		reuse->cpaths = reused->npaths;
+	}
+
+	for (i = 0; i < reused->npaths; i++) {
+		NVGpath* path = &reuse->paths[i];
+		*path = src[i];
+		path->fill = src[i].fill != NULL ? verts : NULL;
+		verts += src[i].nfill;
+		path->stroke = src[i].stroke != NULL ? verts : NULL;
+		verts += src[i].nstroke;
+	}
+
+	return reuse->paths;
+}
+
+// Keeps the paths just flattened and expanded in ctx->cache, if they fit in maxBytes.
+static void nvg__keepReusedPath(NVGcontext* ctx, unsigned int hash, const float* key)
+{
+	NVGpathReuse* reuse = &ctx->reuse;
+	NVGpathCache* cache = ctx->cache;
+	NVGreusedPath* reused;
+	NVGpath* paths;
+	NVGvertex* verts;
+	int i, size, nverts = 0;
+
+	for (i = 0; i < cache->npaths; i++)
+		nverts += cache->paths[i].nfill + cache->paths[i].nstroke;
+
+	size = NVG_REUSE_ALIGN(sizeof(NVGreusedPath)) + NVG_REUSE_ALIGN(sizeof(float)*ctx->ncommands) +
+		sizeof(NVGpath)*cache->npaths + sizeof(NVGvertex)*nverts;
+	size = NVG_REUSE_ALIGN(size);
+	if (reuse->ndata + size > reuse->maxBytes)
+		return;
+
+	if (reuse->ndata + size > reuse->cdata) {
+		int cdata = nvg__mini(nvg__maxi(reuse->ndata + size, reuse->cdata * 2), reuse->maxBytes);
+		unsigned char* data = (unsigned char*)realloc(reuse->data, cdata);
+		if (data == NULL) return;
+		reuse->data = data;
+		reuse->cdata = cdata;
+	}
+
+	reused = (NVGreusedPath*)(reuse->data + reuse->ndata);
+	reused->hash = hash;
+	reused->size = size;
+	reused->ncommands = ctx->ncommands;
+	reused->npaths = cache->npaths;
+	memcpy(reused->key, key, sizeof(reused->key));
+	memcpy(reused->bounds, cache->bounds, sizeof(reused->bounds));
+	memcpy(nvg__reusedCommands(reused), ctx->commands, sizeof(float)*ctx->ncommands);
+
+	paths = nvg__reusedPaths(reused);
+	verts = nvg__reusedVerts(reused);
+	for (i = 0; i < cache->npaths; i++) {
+		const NVGpath* path = &cache->paths[i];
+		paths[i] = *path;
+		if (path->nfill > 0)
+			memcpy(verts, path->fill, sizeof(NVGvertex)*path->nfill);
+		verts += path->nfill;
+		if (path->nstroke > 0)
+			memcpy(verts, path->stroke, sizeof(NVGvertex)*path->nstroke);
+		verts += path->nstroke;
+	}
+
+	reuse->ndata += size;
+}
+
 void nvgFill(NVGcontext* ctx)
 {
 	NVGstate* state = nvg__getState(ctx);
 	const NVGpath* path;
+	const NVGpath* paths = NULL;
+	const float* bounds;
 	NVGpaint fillPaint = state->fill;
-	int i;
-
-	nvg__flattenPaths(ctx);
-	if (ctx->params.edgeAntiAlias && state->shapeAntiAlias)
-		nvg__expandFill(ctx, ctx->fringeWidth, NVG_MITER, 2.4f);
-	else
-		nvg__expandFill(ctx, 0.0f, NVG_MITER, 2.4f);
+	NVGreusedPath* reused = NULL;
+	float fringe = (ctx->params.edgeAntiAlias && state->shapeAntiAlias) ? ctx->fringeWidth : 0.0f;
+	float key[NVG_REUSE_KEY_SIZE] = {0};
+	unsigned int hash = 0;
+	int i, npaths;
+
+	if (ctx->reuse.maxBytes > 0) {
+		key[1] = ctx->tessTol;
+		key[2] = ctx->distTol;
+		key[3] = fringe;
+		key[4] = ctx->fringeWidth;
+		hash = nvg__hashCommands(ctx);
+		reused = nvg__findReusedPath(ctx, hash, key);
+		if (reused != NULL)
+			paths = nvg__reusePaths(ctx, reused);
+	}
+
+	if (paths != NULL) {
+		npaths = reused->npaths;
+		bounds = reused->bounds;
+	} else {
+		nvg__flattenPaths(ctx);
+		nvg__expandFill(ctx, fringe, NVG_MITER, 2.4f);
+		if (ctx->reuse.maxBytes > 0)
+			nvg__keepReusedPath(ctx, hash, key);
+		paths = ctx->cache->paths;
+		npaths = ctx->cache->npaths;
+		bounds = ctx->cache->bounds;
+	}
 
 	// Apply global alpha
 	fillPaint.innerColor.a *= state->alpha;
@@ -2627,11 +2824,11 @@ void nvgFill(NVGcontext* ctx)
 	}
 
 	ctx->params.renderFill(ctx->params.userPtr, &fillPaint, state->compositeOperation, &state->scissor, ctx->fringeWidth,
-						   ctx->cache->bounds, ctx->cache->paths, ctx->cache->npaths);
+						   bounds, paths, npaths);
 
 	// Count triangles
-	for (i = 0; i < ctx->cache->npaths; i++) {
-		path = &ctx->cache->paths[i];
+	for (i = 0; i < npaths; i++) {
+		path = &paths[i];
 		ctx->fillTriCount += path->nfill-2;
 		ctx->fillTriCount += path->nstroke-2;
 		ctx->drawCallCount += 2;
@@ -2645,7 +2842,12 @@ void nvgStroke(NVGcontext* ctx)
 	float strokeWidth = nvg__clampf(state->strokeWidth * scale, 0.0f, 200.0f);
 	NVGpaint strokePaint = state->stroke;
 	const NVGpath* path;
-	int i;
+	const NVGpath* paths = NULL;
+	NVGreusedPath* reused = NULL;
+	float fringe = (ctx->params.edgeAntiAlias && state->shapeAntiAlias) ? ctx->fringeWidth : 0.0f;
+	float key[NVG_REUSE_KEY_SIZE];
+	unsigned int hash = 0;
+	int i, npaths;
 
 
 	if (strokeWidth < ctx->fringeWidth) {
@@ -2661,12 +2863,31 @@ void nvgStroke(NVGcontext* ctx)
 	strokePaint.innerColor.a *= state->alpha;
 	strokePaint.outerColor.a *= state->alpha;
 
-	nvg__flattenPaths(ctx);
-
-	if (ctx->params.edgeAntiAlias && state->shapeAntiAlias)
-		nvg__expandStroke(ctx, strokeWidth*0.5f, ctx->fringeWidth, state->lineCap, state->lineJoin, state->miterLimit);
-	else
-		nvg__expandStroke(ctx, strokeWidth*0.5f, 0.0f, state->lineCap, state->lineJoin, state->miterLimit);
+	if (ctx->reuse.maxBytes > 0) {
+		key[0] = 1.0f;
+		key[1] = ctx->tessTol;
+		key[2] = ctx->distTol;
+		key[3] = strokeWidth*0.5f;
+		key[4] = fringe;
+		key[5] = (float)state->lineCap;
+		key[6] = (float)state->lineJoin;
+		key[7] = state->miterLimit;
+		hash = nvg__hashCommands(ctx);
+		reused = nvg__findReusedPath(ctx, hash, key);
+		if (reused != NULL)
+			paths = nvg__reusePaths(ctx, reused);
+	}
+
+	if (paths != NULL) {
+		npaths = reused->npaths;
+	} else {
+		nvg__flattenPaths(ctx);
+		nvg__expandStroke(ctx, strokeWidth*0.5f, fringe, state->lineCap, state->lineJoin, state->miterLimit);
+		if (ctx->reuse.maxBytes > 0)
+			nvg__keepReusedPath(ctx, hash, key);
+		paths = ctx->cache->paths;
+		npaths = ctx->cache->npaths;
+	}
 
 	/* 把 nanovg 的坐标系传入到适量画布算法中 */
 	if(ctx->params.setStateXfrom != NULL) {
@@ -2674,11 +2895,11 @@ void nvgStroke(NVGcontext* ctx)
 	}
 
 	ctx->params.renderStroke(ctx->params.userPtr, &strokePaint, state->compositeOperation, &state->scissor, ctx->fringeWidth,
-							 strokeWidth, ctx->cache->paths, ctx->cache->npaths);
+							 strokeWidth, paths, npaths);
 
 	// Count triangles
-	for (i = 0; i < ctx->cache->npaths; i++) {
-		path = &ctx->cache->paths[i];
+	for (i = 0; i < npaths; i++) {
+		path = &paths[i];
 		ctx->strokeTriCount += path->nstroke-2;
 		ctx->drawCallCount++;
 	}
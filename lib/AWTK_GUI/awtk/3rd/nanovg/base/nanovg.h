@@ -168,6 +168,14 @@ void nvgCancelFrame(NVGcontext* ctx);
 // Ends drawing flushing remaining render state.
 void nvgEndFrame(NVGcontext* ctx);
 
+// Keeps the paths flattened by nvgFill() and nvgStroke() until nvgResetPathReuse(), and reuses them
+// when the same path is filled or stroked again with the same state, e.g. when a frame is drawn one
+// fragment (strip) at a time. maxBytes limits the memory kept, 0 turns it off and frees the memory.
+void nvgSetPathReuse(NVGcontext* ctx, int maxBytes);
+
+// Forgets the kept paths, call it when a new frame begins.
+void nvgResetPathReuse(NVGcontext* ctx);
+
 //
 // Composite operation
 //
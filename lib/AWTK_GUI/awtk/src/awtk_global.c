@@ -125,30 +125,42 @@ static ret_t tk_add_font(const asset_info_t *res)
   return RET_OK;
 }
 
+static ret_t tk_init_asset(const asset_info_t *iter)
+{
+  switch (iter->type)
+  {
+  case ASSET_TYPE_FONT:
+    tk_add_font(iter);
+    break;
+  case ASSET_TYPE_STYLE:
+  {
+    theme_t *t = theme();
+    if ((t == NULL || t->data == NULL) && tk_str_eq(iter->name, TK_DEFAULT_STYLE))
+    {
+      theme_set(theme_load_from_data(iter->name, iter->data, iter->size));
+    }
+    break;
+  }
+  }
+
+  return RET_OK;
+}
+
 ret_t tk_init_assets(void)
 {
   uint32_t i = 0;
-  uint32_t nr = assets_manager()->assets.size;
-  const asset_info_t **all = (const asset_info_t **)(assets_manager()->assets.elms);
+  assets_manager_t *am = assets_manager();
+  uint32_t nr = am->assets.size;
+  const asset_info_t **all = (const asset_info_t **)(am->assets.elms);
+
+  for (i = 0; i < am->rom_assets_nr; i++)
+  {
+    tk_init_asset(am->rom_assets[i]);
+  }
 
   for (i = 0; i < nr; i++)
   {
-    const asset_info_t *iter = all[i];
-    switch (iter->type)
-    {
-    case ASSET_TYPE_FONT:
-      tk_add_font(iter);
-      break;
-    case ASSET_TYPE_STYLE:
-    {
-      theme_t *t = theme();
-      if ((t == NULL || t->data == NULL) && tk_str_eq(iter->name, TK_DEFAULT_STYLE))
-      {
-        theme_set(theme_load_from_data(iter->name, iter->data, iter->size));
-      }
-      break;
-    }
-    }
+    tk_init_asset(all[i]);
   }
 
   return RET_OK;
@@ -160,6 +172,7 @@ static ret_t tk_clear_cache_when_oom(uint32_t tried_times)
   {
     image_manager_unload_unused(image_manager(), 10);
     font_manager_shrink_cache(font_manager(), 10);
+    widget_pool_trim();
   }
   else if (tried_times == 2)
   {
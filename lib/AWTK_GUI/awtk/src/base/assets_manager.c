@@ -65,6 +65,119 @@ static int asset_cache_cmp_type_and_name(const void *a, const void *b)
   }
 }
 
+#define ASSETS_INDEX_MIN_CAPACITY 16
+
+static uint32_t asset_index_hash(uint16_t type, const char *name)
+{
+  uint32_t hash = 2166136261u ^ type;
+
+  while (*name)
+  {
+    hash = (hash ^ (uint8_t)(*name++)) * 16777619u;
+  }
+
+  return hash;
+}
+
+static bool_t asset_info_match(const asset_info_t *info, asset_type_t type, uint16_t subtype,
+                               const char *name)
+{
+  return type == info->type && strcmp(name, info->name) == 0 &&
+         (subtype == 0 || subtype == info->subtype);
+}
+
+static void asset_index_put(asset_index_slot_t *slots, uint32_t capacity, uint32_t hash,
+                            const asset_info_t *info)
+{
+  uint32_t i = hash & (capacity - 1);
+
+  while (slots[i].info != NULL)
+  {
+    i = (i + 1) & (capacity - 1);
+  }
+
+  slots[i].hash = hash;
+  slots[i].info = info;
+}
+
+static ret_t assets_manager_index_rebuild(assets_manager_t *am)
+{
+  uint32_t i = 0;
+  uint32_t nr = am->assets.size;
+  uint32_t capacity = ASSETS_INDEX_MIN_CAPACITY;
+  const asset_info_t **all = (const asset_info_t **)(am->assets.elms);
+
+  while (capacity < nr * 2)
+  {
+    capacity <<= 1;
+  }
+
+  if (capacity != am->index_capacity)
+  {
+    TKMEM_FREE(am->index);
+    am->index_capacity = 0;
+    am->index = TKMEM_ZALLOCN(asset_index_slot_t, capacity);
+    return_value_if_fail(am->index != NULL, RET_OOM);
+    am->index_capacity = capacity;
+  }
+  else
+  {
+    memset(am->index, 0x00, sizeof(asset_index_slot_t) * capacity);
+  }
+
+  /*插入顺序与assets一致，同名资源先加入的先被找到*/
+  for (i = 0; i < nr; i++)
+  {
+    const asset_info_t *iter = all[i];
+    asset_index_put(am->index, capacity, asset_index_hash(iter->type, iter->name), iter);
+  }
+  am->index_size = nr;
+  am->index_dirty = FALSE;
+
+  return RET_OK;
+}
+
+static int asset_rom_cmp(const asset_info_t *info, uint16_t type, const char *name)
+{
+  if (info->type != type)
+  {
+    return (int)(info->type) - (int)type;
+  }
+
+  return strcmp(info->name, name);
+}
+
+static const asset_info_t *assets_manager_find_in_rom(assets_manager_t *am, asset_type_t type,
+                                                      uint16_t subtype, const char *name)
+{
+  uint32_t lo = 0;
+  uint32_t hi = am->rom_assets_nr;
+  const asset_info_t *const *all = am->rom_assets;
+
+  while (lo < hi)
+  {
+    uint32_t mid = lo + ((hi - lo) >> 1);
+    if (asset_rom_cmp(all[mid], type, name) < 0)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  for (; lo < am->rom_assets_nr && asset_rom_cmp(all[lo], type, name) == 0; lo++)
+  {
+    if (subtype == 0 || subtype == all[lo]->subtype)
+    {
+      return all[lo];
+    }
+  }
+
+  return NULL;
+}
+
 static assets_manager_t *s_assets_manager = NULL;
 
 static ret_t assets_manager_dispatch_event(assets_manager_t *am, int32_t etype,
@@ -713,6 +826,7 @@ assets_manager_t *assets_manager_init(assets_manager_t *am, uint32_t init_nr)
 
   darray_init(&(am->assets), init_nr, (tk_destroy_t)asset_info_unref,
               (tk_compare_t)asset_cache_cmp_type);
+  am->index_dirty = TRUE;
   assets_manager_set_theme(am, THEME_DEFAULT);
 
 #ifdef WITH_ASSET_LOADER
@@ -741,6 +855,10 @@ ret_t assets_manager_clear_all(assets_manager_t *am)
   assets_manager_clear_cache(am, ASSET_TYPE_STYLE);
   assets_manager_clear_cache(am, ASSET_TYPE_FONT);
 
+  am->rom_assets = NULL;
+  am->rom_assets_nr = 0;
+  am->index_dirty = TRUE;
+
   return darray_clear(&(am->assets));
 }
 
@@ -798,7 +916,44 @@ ret_t assets_manager_add(assets_manager_t *am, const void *info)
   }
 #endif
   asset_info_ref((asset_info_t *)r);
-  return darray_push(&(am->assets), (void *)r);
+  if (darray_push(&(am->assets), (void *)r) != RET_OK)
+  {
+    asset_info_unref((asset_info_t *)r);
+    return RET_OOM;
+  }
+
+  if (!am->index_dirty)
+  {
+    if ((am->index_size + 1) * 2 > am->index_capacity)
+    {
+      am->index_dirty = TRUE;
+    }
+    else
+    {
+      asset_index_put(am->index, am->index_capacity, asset_index_hash(r->type, r->name), r);
+      am->index_size++;
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t assets_manager_set_rom_assets(assets_manager_t *am, const asset_info_t *const *assets,
+                                    uint32_t nr)
+{
+  uint32_t i = 0;
+  return_value_if_fail(am != NULL && (assets != NULL || nr == 0), RET_BAD_PARAMS);
+
+  for (i = 1; i < nr; i++)
+  {
+    return_value_if_fail(asset_rom_cmp(assets[i - 1], assets[i]->type, assets[i]->name) <= 0,
+                         RET_BAD_PARAMS);
+  }
+
+  am->rom_assets = assets;
+  am->rom_assets_nr = nr;
+
+  return RET_OK;
 }
 
 ret_t assets_manager_add_data(assets_manager_t *am, const char *name, uint16_t type,
@@ -817,6 +972,8 @@ const asset_info_t *assets_manager_find_in_cache(assets_manager_t *am, asset_typ
                                                  uint16_t subtype, const char *name)
 {
   uint32_t i = 0;
+  uint32_t hash = 0;
+  uint32_t mask = 0;
   const char *assets_name = NULL;
   const asset_info_t *iter = NULL;
   const asset_info_t **all = NULL;
@@ -824,13 +981,43 @@ const asset_info_t *assets_manager_find_in_cache(assets_manager_t *am, asset_typ
 
   assets_name = asset_info_get_formatted_name(name);
 
-  all = (const asset_info_t **)(am->assets.elms);
+  if (am->rom_assets_nr > 0)
+  {
+    iter = assets_manager_find_in_rom(am, type, subtype, assets_name);
+    if (iter != NULL)
+    {
+      return iter;
+    }
+  }
 
+  if (am->assets.size == 0)
+  {
+    return NULL;
+  }
+
+  if (!am->index_dirty || assets_manager_index_rebuild(am) == RET_OK)
+  {
+    hash = asset_index_hash(type, assets_name);
+    mask = am->index_capacity - 1;
+
+    for (i = hash & mask; am->index[i].info != NULL; i = (i + 1) & mask)
+    {
+      iter = am->index[i].info;
+      if (am->index[i].hash == hash && asset_info_match(iter, type, subtype, assets_name))
+      {
+        return iter;
+      }
+    }
+
+    return NULL;
+  }
+
+  /*内存不足时退化为线性查找*/
+  all = (const asset_info_t **)(am->assets.elms);
   for (i = 0; i < am->assets.size; i++)
   {
     iter = all[i];
-    if (type == iter->type && strcmp(assets_name, iter->name) == 0 &&
-        (subtype == 0 || (subtype != 0 && subtype == iter->subtype)))
+    if (asset_info_match(iter, type, subtype, assets_name))
     {
       return iter;
     }
@@ -958,6 +1145,7 @@ ret_t assets_manager_clear_cache_ex(assets_manager_t *am, asset_type_t type, con
 
   if (am->assets.size < size)
   {
+    am->index_dirty = TRUE;
     assets_manager_dispatch_event(am, EVT_ASSET_MANAGER_UNLOAD_ASSET, &info);
   }
 
@@ -979,6 +1167,7 @@ ret_t assets_manager_clear_cache(assets_manager_t *am, asset_type_t type)
 
   if (am->assets.size < size)
   {
+    am->index_dirty = TRUE;
     assets_manager_dispatch_event(am, EVT_ASSET_MANAGER_CLEAR_CACHE, &info);
   }
 
@@ -1000,6 +1189,10 @@ ret_t assets_manager_deinit(assets_manager_t *am)
 
   asset_loader_destroy(am->loader);
   darray_deinit(&(am->assets));
+  TKMEM_FREE(am->index);
+  am->index_capacity = 0;
+  am->index_size = 0;
+  am->index_dirty = TRUE;
   TKMEM_FREE(am->name);
 
   return RET_OK;
@@ -37,6 +37,12 @@ typedef ret_t (*assets_manager_build_asset_dir_t)(void *ctx, char *path, uint32_
 typedef asset_info_t *(*assets_manager_load_asset_t)(assets_manager_t *am, asset_type_t type,
                                                      uint16_t subtype, const char *name);
 
+typedef struct _asset_index_slot_t
+{
+  uint32_t hash;
+  const asset_info_t *info;
+} asset_index_slot_t;
+
 /**
  * @class assets_manager_t
  * @parent emitter_t
@@ -82,6 +88,14 @@ struct _assets_manager_t
   char *theme;
   char *res_root;
   darray_t assets;
+  /*按(type, name)索引assets的开放寻址哈希表，删除资源后在下次查找时重建*/
+  asset_index_slot_t *index;
+  uint32_t index_capacity;
+  uint32_t index_size;
+  bool_t index_dirty;
+  /*编译到程序中的资源，按(type, name)排序*/
+  const asset_info_t *const *rom_assets;
+  uint32_t rom_assets_nr;
   locale_info_t *locale_info;
   system_info_t *system_info;
 
@@ -198,6 +212,20 @@ ret_t assets_manager_set_locale_info(assets_manager_t *am, locale_info_t *locale
  */
 ret_t assets_manager_add(assets_manager_t *am, const void *info);
 
+/**
+ * @method assets_manager_set_rom_assets
+ * 设置编译到程序中的资源表。
+ * 资源表由资源生成工具生成，按类型和名称排序，查找时使用二分查找，不需要逐个调用assets_manager_add。
+ * 资源表中的资源优先于缓存中的资源。
+ * @param {assets_manager_t*} am asset manager对象。
+ * @param {const asset_info_t**} assets 资源表(NULL表示清除)。
+ * @param {uint32_t} nr 资源个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t assets_manager_set_rom_assets(assets_manager_t *am, const asset_info_t *const *assets,
+                                    uint32_t nr);
+
 /**
  * @method assets_manager_add_data
  * 向资源管理器中增加一个资源data。
@@ -31,6 +31,8 @@
 
 /**
  * 如果需要支持预先解码的位图字体，请定义本宏。一般只在RAM极小时，才启用本宏。
+ * 与 WITH_STB_FONT 同时定义时，优先使用名为"字体名_字号"的位图字体(可用 tools/font_gen 生成)，
+ * 位图字体里没有的字符和其它字号仍由 Truetype 字体渲染。
  * #define WITH_BITMAP_FONT 1
  */
 
@@ -106,6 +108,14 @@
  * #define HAS_STD_MALLOC 1
  */
 
+/**
+ * 如果控件和事件处理项从内存池(mem_slab)中分配，请定义本宏。
+ * 内存池按块增长，关闭窗口后把全部空闲的块归还给堆，可以避免反复打开/关闭窗口造成的堆碎片。
+ * 只有控件的事件处理项从内存池分配，其它emitter(可能在其它线程中使用)仍然从堆分配。
+ *
+ * #define WITH_WIDGET_POOL 1
+ */
+
 /**
  * 如果有标准的fopen/fclose等函数，请定义本宏
  *
@@ -191,6 +201,20 @@
  * #define FRAGMENT_FRAME_BUFFER_SIZE 32 * 1024
  */
 
+/**
+ * 片段式 FrameBuffer 平分为多少个片段缓冲区。大于 1 时，需要 LCD 提供异步传输(如 DMA)接口，
+ * 在传输上一个片段的同时绘制下一个片段。
+ *
+ * #define FRAGMENT_FRAME_BUFFER_NR 2
+ */
+
+/**
+ * 启用 tickless 主循环：主循环阻塞到下一个定时器到期、有 idle 需要处理或者被输入中断唤醒为止，
+ * 空闲时不再周期性地轮询。需要移植层提供 TK_WAIT_EVENT/TK_WAKEUP(参考 awtk-port/main_loop_esp32_raw.cpp)。
+ *
+ * #define WITH_MAIN_LOOP_TICKLESS 1
+ */
+
 /**
  * 启用输入法，但不想启用联想功能，请定义本宏。
  *
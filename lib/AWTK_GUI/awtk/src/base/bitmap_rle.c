@@ -0,0 +1,310 @@
+﻿/**
+ * File:   bitmap_rle.c
+ * Author: AWTK Develop Team
+ * Brief:  run length encoded raw bitmap
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#include "../tkc/mem.h"
+#include "../tkc/utils.h"
+#include "bitmap_rle.h"
+
+typedef struct _graphic_buffer_rle_t
+{
+  graphic_buffer_t graphic_buffer;
+
+  const uint32_t *offsets;
+  const uint8_t *rows;
+  uint32_t w;
+  uint32_t h;
+  uint32_t bpp;
+
+  /*整张图片解压后的数据，只在lock期间存在*/
+  uint8_t *data;
+  uint32_t locks;
+} graphic_buffer_rle_t;
+
+static graphic_buffer_rle_t *graphic_buffer_rle_cast(graphic_buffer_t *buffer);
+
+#define GRAPHIC_BUFFER_RLE(buffer) graphic_buffer_rle_cast(buffer)
+
+static void bitmap_rle_fill(uint8_t *d, const uint8_t *pixel, uint32_t bpp, uint32_t n)
+{
+  uint32_t i = 0;
+
+  if (bpp == 2)
+  {
+    uint16_t v = 0;
+    uint16_t *p = (uint16_t *)d;
+
+    memcpy(&v, pixel, sizeof(v));
+    for (i = 0; i < n; i++)
+    {
+      p[i] = v;
+    }
+  }
+  else if (bpp == 4)
+  {
+    uint32_t v = 0;
+    uint32_t *p = (uint32_t *)d;
+
+    memcpy(&v, pixel, sizeof(v));
+    for (i = 0; i < n; i++)
+    {
+      p[i] = v;
+    }
+  }
+  else
+  {
+    for (i = 0; i < n; i++, d += bpp)
+    {
+      memcpy(d, pixel, bpp);
+    }
+  }
+}
+
+static void bitmap_rle_decode_row(graphic_buffer_rle_t *b, uint32_t y, uint32_t x, uint32_t w,
+                                  uint8_t *d)
+{
+  uint32_t n = 0;
+  uint32_t bpp = b->bpp;
+  uint32_t skip = x;
+  const uint8_t *p = b->rows + b->offsets[y];
+  const uint8_t *end = b->rows + b->offsets[y + 1];
+
+  while (w > 0 && p < end)
+  {
+    uint8_t c = *p++;
+    const uint8_t *s = p;
+
+    n = (c & 0x7f) + 1;
+    p += (c & 0x80) ? bpp : n * bpp;
+    if (p > end)
+    {
+      break;
+    }
+
+    if (skip >= n)
+    {
+      skip -= n;
+      continue;
+    }
+
+    n = tk_min(n - skip, w);
+    if (c & 0x80)
+    {
+      bitmap_rle_fill(d, s, bpp, n);
+    }
+    else
+    {
+      memcpy(d, s + skip * bpp, n * bpp);
+    }
+
+    skip = 0;
+    w -= n;
+    d += n * bpp;
+  }
+
+  if (w > 0)
+  {
+    /*数据不完整*/
+    memset(d, 0x00, w * bpp);
+  }
+}
+
+static bool_t graphic_buffer_rle_is_valid_for(graphic_buffer_t *buffer, bitmap_t *bitmap)
+{
+  graphic_buffer_rle_t *b = GRAPHIC_BUFFER_RLE(buffer);
+  return_value_if_fail(b != NULL && bitmap != NULL, FALSE);
+
+  return b->w == (uint32_t)(bitmap->w) && b->h == (uint32_t)(bitmap->h);
+}
+
+static uint8_t *graphic_buffer_rle_lock_for_read(graphic_buffer_t *buffer)
+{
+  uint32_t y = 0;
+  graphic_buffer_rle_t *b = GRAPHIC_BUFFER_RLE(buffer);
+  return_value_if_fail(b != NULL, NULL);
+
+  if (b->data == NULL)
+  {
+    b->data = TKMEM_ALLOC(b->w * b->h * b->bpp);
+    return_value_if_fail(b->data != NULL, NULL);
+
+    for (y = 0; y < b->h; y++)
+    {
+      bitmap_rle_decode_row(b, y, 0, b->w, b->data + y * b->w * b->bpp);
+    }
+  }
+  b->locks++;
+
+  return b->data;
+}
+
+static uint8_t *graphic_buffer_rle_lock_for_write(graphic_buffer_t *buffer)
+{
+  (void)buffer;
+  return NULL;
+}
+
+static ret_t graphic_buffer_rle_unlock(graphic_buffer_t *buffer)
+{
+  graphic_buffer_rle_t *b = GRAPHIC_BUFFER_RLE(buffer);
+  return_value_if_fail(b != NULL, RET_BAD_PARAMS);
+
+  if (b->locks > 0)
+  {
+    b->locks--;
+    if (b->locks == 0)
+    {
+      TKMEM_FREE(b->data);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t graphic_buffer_rle_attach(graphic_buffer_t *buffer, void *data, uint32_t w,
+                                       uint32_t h)
+{
+  (void)buffer;
+  (void)data;
+  (void)w;
+  (void)h;
+  return RET_NOT_IMPL;
+}
+
+static ret_t graphic_buffer_rle_destroy(graphic_buffer_t *buffer)
+{
+  graphic_buffer_rle_t *b = GRAPHIC_BUFFER_RLE(buffer);
+  return_value_if_fail(b != NULL, RET_BAD_PARAMS);
+
+  TKMEM_FREE(b->data);
+  memset(b, 0x00, sizeof(*b));
+  TKMEM_FREE(b);
+
+  return RET_OK;
+}
+
+static uint32_t graphic_buffer_rle_get_physical_width(graphic_buffer_t *buffer)
+{
+  graphic_buffer_rle_t *b = GRAPHIC_BUFFER_RLE(buffer);
+  return_value_if_fail(b != NULL, 0);
+
+  return b->w;
+}
+
+static uint32_t graphic_buffer_rle_get_physical_height(graphic_buffer_t *buffer)
+{
+  graphic_buffer_rle_t *b = GRAPHIC_BUFFER_RLE(buffer);
+  return_value_if_fail(b != NULL, 0);
+
+  return b->h;
+}
+
+static uint32_t graphic_buffer_rle_get_physical_line_length(graphic_buffer_t *buffer)
+{
+  graphic_buffer_rle_t *b = GRAPHIC_BUFFER_RLE(buffer);
+  return_value_if_fail(b != NULL, 0);
+
+  return b->w * b->bpp;
+}
+
+static const graphic_buffer_vtable_t s_graphic_buffer_rle_vtable = {
+    .lock_for_read = graphic_buffer_rle_lock_for_read,
+    .lock_for_write = graphic_buffer_rle_lock_for_write,
+    .unlock = graphic_buffer_rle_unlock,
+    .attach = graphic_buffer_rle_attach,
+    .is_valid_for = graphic_buffer_rle_is_valid_for,
+    .get_width = graphic_buffer_rle_get_physical_width,
+    .get_height = graphic_buffer_rle_get_physical_height,
+    .get_line_length = graphic_buffer_rle_get_physical_line_length,
+    .destroy = graphic_buffer_rle_destroy};
+
+graphic_buffer_t *graphic_buffer_rle_create(const uint8_t *data, uint32_t size, uint32_t w,
+                                            uint32_t h, bitmap_format_t format)
+{
+  uint32_t y = 0;
+  uint32_t bpp = bitmap_get_bpp_of_format(format);
+  const uint32_t *offsets = (const uint32_t *)data;
+  graphic_buffer_rle_t *buffer = NULL;
+  return_value_if_fail(data != NULL && w > 0 && h > 0 && bpp > 0, NULL);
+  return_value_if_fail(((uintptr_t)data & 0x03) == 0, NULL);
+  return_value_if_fail(size >= (h + 1) * sizeof(uint32_t), NULL);
+
+  size -= (h + 1) * sizeof(uint32_t);
+  for (y = 0; y < h; y++)
+  {
+    return_value_if_fail(offsets[y] <= offsets[y + 1], NULL);
+  }
+  return_value_if_fail(offsets[h] <= size, NULL);
+
+  buffer = TKMEM_ZALLOC(graphic_buffer_rle_t);
+  return_value_if_fail(buffer != NULL, NULL);
+
+  buffer->w = w;
+  buffer->h = h;
+  buffer->bpp = bpp;
+  buffer->offsets = offsets;
+  buffer->rows = (const uint8_t *)(offsets + h + 1);
+  buffer->graphic_buffer.vt = &s_graphic_buffer_rle_vtable;
+
+  return GRAPHIC_BUFFER(buffer);
+}
+
+bool_t bitmap_is_rle(bitmap_t *bitmap)
+{
+  return bitmap != NULL && bitmap->buffer != NULL &&
+         bitmap->buffer->vt == &s_graphic_buffer_rle_vtable;
+}
+
+uint32_t bitmap_rle_get_mem_size(bitmap_t *bitmap)
+{
+  graphic_buffer_rle_t *b = NULL;
+  return_value_if_fail(bitmap_is_rle(bitmap), 0);
+
+  b = GRAPHIC_BUFFER_RLE(bitmap->buffer);
+
+  return (b->h + 1) * sizeof(uint32_t) + b->offsets[b->h];
+}
+
+ret_t bitmap_rle_decode(bitmap_t *bitmap, const rect_t *r, uint8_t *dst, uint32_t line_length)
+{
+  int32_t y = 0;
+  graphic_buffer_rle_t *b = NULL;
+  return_value_if_fail(bitmap_is_rle(bitmap) && r != NULL && dst != NULL, RET_BAD_PARAMS);
+
+  b = GRAPHIC_BUFFER_RLE(bitmap->buffer);
+  return_value_if_fail(r->x >= 0 && r->y >= 0 && r->w >= 0 && r->h >= 0, RET_BAD_PARAMS);
+  return_value_if_fail((uint32_t)(r->x + r->w) <= b->w && (uint32_t)(r->y + r->h) <= b->h,
+                       RET_BAD_PARAMS);
+
+  for (y = 0; y < r->h; y++)
+  {
+    bitmap_rle_decode_row(b, r->y + y, r->x, r->w, dst);
+    dst += line_length;
+  }
+
+  return RET_OK;
+}
+
+static graphic_buffer_rle_t *graphic_buffer_rle_cast(graphic_buffer_t *buffer)
+{
+  return_value_if_fail(buffer != NULL && buffer->vt == &s_graphic_buffer_rle_vtable, NULL);
+
+  return (graphic_buffer_rle_t *)(buffer);
+}
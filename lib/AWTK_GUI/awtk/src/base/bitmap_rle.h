@@ -0,0 +1,101 @@
+﻿/**
+ * File:   bitmap_rle.h
+ * Author: AWTK Develop Team
+ * Brief:  run length encoded raw bitmap
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_BITMAP_RLE_H
+#define TK_BITMAP_RLE_H
+
+#include "../tkc/rect.h"
+#include "bitmap.h"
+#include "graphic_buffer.h"
+
+BEGIN_C_DECLS
+
+#ifndef TK_BITMAP_RLE_BAND_ROWS
+/*image_copy/image_blend每次解码到临时缓冲区的行数*/
+#define TK_BITMAP_RLE_BAND_ROWS 16
+#endif /*TK_BITMAP_RLE_BAND_ROWS*/
+
+/**
+ * @class bitmap_rle_t
+ * @annotation ["fake"]
+ * 按行做RLE压缩的raw图片(ASSET\_TYPE\_IMAGE\_RLE)。
+ *
+ * 数据格式(小端)：bitmap\_header\_t之后依次为：
+ *
+ * * uint32\_t offsets[h + 1]：每一行的压缩数据相对于行数据起始位置的偏移，offsets[h]为总长度。
+ * * 行数据：每行独立编码，由若干个包组成。包的第一个字节为c，c & 0x80为真时后面跟一个像素，
+ *   表示该像素重复(c & 0x7f) + 1次，否则后面跟c + 1个原样保存的像素。
+ *
+ * 有了行索引，image\_copy/image\_blend只需解码当前strip可见的那几行，
+ * 不需要把整张图片解压到内存中。其它直接访问像素的代码(如vgcanvas)通过
+ * bitmap\_lock\_buffer\_for\_read访问时，会临时解压整张图片，在unlock时释放。
+ *
+ * 可以用tools/image_gen生成。
+ */
+
+/**
+ * @method graphic_buffer_rle_create
+ * 为RLE压缩的raw图片创建(只读的)缓冲区。
+ * @annotation ["constructor"]
+ * @param {const uint8_t*} data 压缩数据(bitmap\_header\_t之后的数据，需要4字节对齐)。
+ * @param {uint32_t} size 压缩数据的长度。
+ * @param {uint32_t} w 宽度。
+ * @param {uint32_t} h 高度。
+ * @param {bitmap_format_t} format 格式。
+ *
+ * @return {graphic_buffer_t*} 返回缓存区，数据无效时返回NULL。
+ */
+graphic_buffer_t *graphic_buffer_rle_create(const uint8_t *data, uint32_t size, uint32_t w,
+                                            uint32_t h, bitmap_format_t format);
+
+/**
+ * @method bitmap_is_rle
+ * 判断图片的数据是否为RLE压缩的。
+ * @param {bitmap_t*} bitmap 图片对象。
+ *
+ * @return {bool_t} 返回TRUE表示是，否则表示不是。
+ */
+bool_t bitmap_is_rle(bitmap_t *bitmap);
+
+/**
+ * @method bitmap_rle_get_mem_size
+ * 获取RLE压缩的图片数据(行索引和行数据)的字节数。图片缓存按它计算RLE图片占用的内存。
+ * @param {bitmap_t*} bitmap 图片对象。
+ *
+ * @return {uint32_t} 返回字节数，不是RLE图片时返回0。
+ */
+uint32_t bitmap_rle_get_mem_size(bitmap_t *bitmap);
+
+/**
+ * @method bitmap_rle_decode
+ * 解码RLE压缩的图片中指定的区域。
+ * @param {bitmap_t*} bitmap 图片对象。
+ * @param {const rect_t*} r 要解码的区域。
+ * @param {uint8_t*} dst 目标数据。
+ * @param {uint32_t} line_length 目标数据的行长度(字节数)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t bitmap_rle_decode(bitmap_t *bitmap, const rect_t *r, uint8_t *dst, uint32_t line_length);
+
+END_C_DECLS
+
+#endif /*TK_BITMAP_RLE_H*/
@@ -139,7 +139,8 @@ ret_t canvas_set_assets_manager(canvas_t *c, assets_manager_t *assets_manager)
   vgcanvas_t *vgcanvas = NULL;
   return_value_if_fail(c != NULL && assets_manager != NULL, RET_BAD_PARAMS);
 
-  vgcanvas = lcd_get_vgcanvas(c->lcd);
+  /*还没有创建的 vgcanvas 在 canvas_get_vgcanvas 中设置*/
+  vgcanvas = lcd_peek_vgcanvas(c->lcd);
   c->assets_manager = assets_manager;
   if (vgcanvas != NULL)
   {
@@ -2253,6 +2254,10 @@ vgcanvas_t *canvas_get_vgcanvas(canvas_t *c)
   if (vg != NULL)
   {
     rect_t r;
+    if (c->assets_manager != NULL && vg->assets_manager != c->assets_manager)
+    {
+      vgcanvas_set_assets_manager(vg, c->assets_manager);
+    }
     canvas_get_clip_rect(c, &r);
     vgcanvas_clip_rect(vg, r.x, r.y, r.w, r.h);
     vgcanvas_begin_path(vg);
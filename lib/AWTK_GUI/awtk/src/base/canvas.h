@@ -164,6 +164,10 @@ struct _canvas_t
   /*确保begin_frame/end_frame配对使用*/
   bool_t began_frame;
 
+  /*绘制时遍历到的控件数和实际绘制的控件数，片段式 FrameBuffer 在每个片段开始时清零*/
+  uint32_t visited_widgets_nr;
+  uint32_t painted_widgets_nr;
+
   float last_text_length;
   uint32_t last_text_nr;
   wchar_t *last_text_str;
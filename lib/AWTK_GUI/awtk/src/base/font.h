@@ -120,9 +120,29 @@ typedef struct _glyph_t
    * 数据。
    */
   const uint8_t *data;
+  /**
+   * @property {const uint8_t*} spans
+   * @annotation ["readable"]
+   * 每行的透明/不透明/半透明区间(见GLYPH_SPAN_TYPE)，加入glyph_cache时生成，可以为NULL。
+   */
+  const uint8_t *spans;
 } glyph_t;
 #pragma pack(pop)
 
+/*
+ * GLYPH_FMT_ALPHA字模的span数据：逐行保存，每个字节表示一段连续的像素，
+ * 高2位为类型，低6位为长度减1，每行各段的长度之和等于字模的宽度。
+ * SKIP段的alpha小到不会画出任何颜色，FILL段的alpha都是0xff，其余为BLEND段。
+ * 短于GLYPH_SPAN_MIN_LEN的SKIP/FILL段并入相邻的BLEND段。
+ */
+#define GLYPH_SPAN_SKIP 0x00
+#define GLYPH_SPAN_FILL 0x40
+#define GLYPH_SPAN_BLEND 0x80
+#define GLYPH_SPAN_MAX_LEN 64
+#define GLYPH_SPAN_MIN_LEN 4
+#define GLYPH_SPAN_TYPE(s) ((s) & 0xc0)
+#define GLYPH_SPAN_LEN(s) (((s) & 0x3f) + 1)
+
 /**
  * @method glyph_create
  * @annotation ["constructor"]
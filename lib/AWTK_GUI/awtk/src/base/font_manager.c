@@ -24,6 +24,9 @@
 #include "events.h"
 #include "system_info.h"
 #include "font_manager.h"
+#if WITH_BITMAP_FONT
+#include "../font_loader/font_loader_bitmap.h"
+#endif /*WITH_BITMAP_FONT*/
 
 static font_manager_t *s_font_manager = NULL;
 
@@ -116,10 +119,52 @@ ret_t font_manager_set_assets_manager(font_manager_t *fm, assets_manager_t *am)
   return RET_OK;
 }
 
+#if WITH_BITMAP_FONT
+/*"字体名_字号"的位图字体里没有的字符，用同名的 Truetype 字体渲染*/
+static font_t *font_manager_get_bitmap_fallback(void *ctx, const char *name, font_size_t size)
+{
+  font_t *font = NULL;
+  char base_name[TK_NAME_LEN + 1];
+  font_cmp_info_t info = {base_name, size};
+  font_manager_t *fm = (font_manager_t *)ctx;
+  const char *suffix = strrchr(name, '_');
+
+  if (suffix == NULL || tk_atoi(suffix + 1) != size)
+  {
+    return NULL;
+  }
+  tk_strncpy(base_name, name, tk_min(suffix - name, TK_NAME_LEN));
+
+  font = darray_find(&(fm->fonts), &info);
+  if (font == NULL && fm->loader != NULL && fm->loader->type != ASSET_TYPE_FONT_BMP)
+  {
+    const asset_info_t *asset = assets_manager_ref(fm->assets_manager, ASSET_TYPE_FONT, base_name);
+    if (asset != NULL)
+    {
+      if (asset->subtype == fm->loader->type)
+      {
+        font = font_loader_load(fm->loader, base_name, asset->data, asset->size);
+        if (font != NULL)
+        {
+          darray_push(&(fm->fonts), font);
+        }
+      }
+      assets_manager_unref(fm->assets_manager, asset);
+    }
+  }
+
+  return font;
+}
+#endif /*WITH_BITMAP_FONT*/
+
 ret_t font_manager_add_font(font_manager_t *fm, font_t *font)
 {
   return_value_if_fail(fm != NULL && font != NULL, RET_BAD_PARAMS);
 
+#if WITH_BITMAP_FONT
+  font_bitmap_set_fallback(font, font_manager_get_bitmap_fallback, fm);
+#endif /*WITH_BITMAP_FONT*/
+
   return darray_push(&(fm->fonts), font);
 }
 
@@ -185,6 +230,13 @@ font_t *font_manager_load(font_manager_t *fm, const char *name, uint32_t size)
       {
         font = font_loader_load(fm->loader, name, info->data, info->size);
       }
+#if WITH_BITMAP_FONT
+      else if (info->subtype == ASSET_TYPE_FONT_BMP)
+      {
+        /*预先光栅化的字模可与 TTF 字体共存，直接从 flash 中读取*/
+        font = font_bitmap_create(name, info->data, info->size);
+      }
+#endif
       assets_manager_unref(fm->assets_manager, info);
     }
     else
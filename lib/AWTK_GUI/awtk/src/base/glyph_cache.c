@@ -19,151 +19,463 @@
  *
  */
 
-#define GLYPH_CACHE_FREE_ITEM(cache, item)            \
-  {                                                   \
-    if (cache->destroy_glyph && item->g != NULL)      \
-    {                                                 \
-      cache->destroy_glyph(item->g);                  \
-      memset(item, 0x00, sizeof(glyph_cache_item_t)); \
-    }                                                 \
-  }
-
 #include "../tkc/mem.h"
-#include "../tkc/time_now.h"
 #include "glyph_cache.h"
+#include "render_trace.h"
+
+#define GLYPH_CACHE_NIL 0xffffffff
+
+/*段的平均长度(像素)小于此值时不生成spans*/
+#ifndef GLYPH_CACHE_SPAN_MIN_AVG_LEN
+#define GLYPH_CACHE_SPAN_MIN_AVG_LEN 6
+#endif /*GLYPH_CACHE_SPAN_MIN_AVG_LEN*/
+
+/*字形的高度(像素)小于此值时不生成spans*/
+#ifndef GLYPH_CACHE_SPAN_MIN_H
+#define GLYPH_CACHE_SPAN_MIN_H 20
+#endif /*GLYPH_CACHE_SPAN_MIN_H*/
+
+static uint32_t glyph_cache_hash(glyph_cache_t *cache, wchar_t code, font_size_t size)
+{
+  uint32_t h = (((uint32_t)code) << 8) ^ (uint32_t)size;
+
+  return (h * 2654435761u) >> (32 - cache->buckets_bits);
+}
+
+static uint32_t glyph_cache_get_glyph_bytes(glyph_t *g)
+{
+  uint32_t pitch = g->pitch;
+
+  if (pitch == 0)
+  {
+    switch (g->format)
+    {
+    case GLYPH_FMT_MONO:
+      pitch = (g->w + 7) >> 3;
+      break;
+    case GLYPH_FMT_ALPHA2:
+      pitch = (g->w + 3) >> 2;
+      break;
+    case GLYPH_FMT_ALPHA4:
+      pitch = (g->w + 1) >> 1;
+      break;
+    case GLYPH_FMT_RGBA:
+      pitch = g->w * 4;
+      break;
+    default:
+      pitch = g->w;
+      break;
+    }
+  }
+
+  return sizeof(glyph_t) + pitch * g->h;
+}
+
+static uint8_t glyph_cache_span_type(uint8_t a)
+{
+  /*与文字颜色的alpha相乘后仍小于TK_TRANSPARENT_ALPHA，绘制时会被跳过*/
+  if (((a * 0xff) >> 8) < TK_TRANSPARENT_ALPHA)
+  {
+    return GLYPH_SPAN_SKIP;
+  }
+  else if (a == 0xff)
+  {
+    return GLYPH_SPAN_FILL;
+  }
+  else
+  {
+    return GLYPH_SPAN_BLEND;
+  }
+}
+
+static uint32_t glyph_cache_run_length(const uint8_t *p, uint32_t w, uint8_t type)
+{
+  uint32_t len = 1;
+
+  while (len < w && glyph_cache_span_type(p[len]) == type)
+  {
+    len++;
+  }
+
+  return len;
+}
+
+/*spans为NULL时只计算字节数*/
+static uint32_t glyph_cache_encode_spans(glyph_t *g, uint8_t *spans)
+{
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t n = 0;
+
+  for (j = 0; j < g->h; j++)
+  {
+    const uint8_t *p = g->data + j * g->w;
+
+    for (i = 0; i < g->w;)
+    {
+      uint8_t type = glyph_cache_span_type(p[i]);
+      uint32_t len = glyph_cache_run_length(p + i, g->w - i, type);
+
+      /*很短的SKIP/FILL段并入BLEND段，逐像素处理比多解码一个段更快*/
+      if (type == GLYPH_SPAN_BLEND || len < GLYPH_SPAN_MIN_LEN)
+      {
+        uint32_t k = i + len;
+
+        type = GLYPH_SPAN_BLEND;
+        while (k < g->w)
+        {
+          uint8_t t = glyph_cache_span_type(p[k]);
+          uint32_t l = glyph_cache_run_length(p + k, g->w - k, t);
+
+          if (t != GLYPH_SPAN_BLEND && l >= GLYPH_SPAN_MIN_LEN)
+          {
+            break;
+          }
+          k += l;
+        }
+        len = k - i;
+      }
+
+      for (i += len; len > 0; n++)
+      {
+        uint32_t l = tk_min(len, GLYPH_SPAN_MAX_LEN);
+
+        if (spans != NULL)
+        {
+          spans[n] = type | (l - 1);
+        }
+        len -= l;
+      }
+    }
+  }
+
+  return n;
+}
+
+static uint32_t glyph_cache_build_spans(glyph_t *g)
+{
+  uint32_t size = 0;
+  uint8_t *spans = NULL;
+
+  g->spans = NULL;
+  /*lcd_mem_fragment_draw_glyph8按w逐行访问点阵*/
+  if (g->format != GLYPH_FMT_ALPHA || g->data == NULL || (g->pitch != 0 && g->pitch != g->w))
+  {
+    return 0;
+  }
+
+  /*16/24px的字每行只有几个段，解码段的开销抵消了省下的逐像素判断，只有大字才有收益*/
+  if (g->h < GLYPH_CACHE_SPAN_MIN_H)
+  {
+    return 0;
+  }
+
+  size = glyph_cache_encode_spans(g, NULL);
+  /*段太碎(小字号)时逐像素绘制更快，也不值得占用内存*/
+  if (size == 0 || size * GLYPH_CACHE_SPAN_MIN_AVG_LEN > (uint32_t)(g->w * g->h))
+  {
+    return 0;
+  }
+
+  spans = (uint8_t *)TKMEM_ALLOC(size);
+  return_value_if_fail(spans != NULL, 0);
+
+  glyph_cache_encode_spans(g, spans);
+  g->spans = spans;
+
+  return size;
+}
+
+static void glyph_cache_destroy_glyph(glyph_cache_t *cache, glyph_t *g)
+{
+  if (g->spans != NULL)
+  {
+    TKMEM_FREE(g->spans);
+  }
+
+  if (cache->destroy_glyph != NULL)
+  {
+    cache->destroy_glyph(g);
+  }
+}
+
+static void glyph_cache_lru_remove(glyph_cache_t *cache, uint32_t index)
+{
+  glyph_cache_item_t *item = cache->items + index;
+
+  if (item->prev != GLYPH_CACHE_NIL)
+  {
+    cache->items[item->prev].next = item->next;
+  }
+  else
+  {
+    cache->lru_head = item->next;
+  }
+
+  if (item->next != GLYPH_CACHE_NIL)
+  {
+    cache->items[item->next].prev = item->prev;
+  }
+  else
+  {
+    cache->lru_tail = item->prev;
+  }
+
+  item->prev = GLYPH_CACHE_NIL;
+  item->next = GLYPH_CACHE_NIL;
+}
+
+static void glyph_cache_lru_push_front(glyph_cache_t *cache, uint32_t index)
+{
+  glyph_cache_item_t *item = cache->items + index;
+
+  item->prev = GLYPH_CACHE_NIL;
+  item->next = cache->lru_head;
+  if (cache->lru_head != GLYPH_CACHE_NIL)
+  {
+    cache->items[cache->lru_head].prev = index;
+  }
+  cache->lru_head = index;
+
+  if (cache->lru_tail == GLYPH_CACHE_NIL)
+  {
+    cache->lru_tail = index;
+  }
+}
+
+static uint32_t glyph_cache_find_slot(glyph_cache_t *cache, wchar_t code, font_size_t size)
+{
+  uint32_t mask = cache->buckets_mask;
+  uint32_t i = glyph_cache_hash(cache, code, size);
+
+  while (cache->buckets[i] != 0)
+  {
+    glyph_cache_item_t *item = cache->items + cache->buckets[i] - 1;
+    if (item->code == code && item->size == size)
+    {
+      break;
+    }
+    i = (i + 1) & mask;
+  }
+
+  return i;
+}
+
+static void glyph_cache_unindex(glyph_cache_t *cache, glyph_cache_item_t *item)
+{
+  uint32_t j = 0;
+  uint32_t mask = cache->buckets_mask;
+  uint32_t i = glyph_cache_find_slot(cache, item->code, item->size);
+
+  return_if_fail(cache->buckets[i] != 0);
+  cache->buckets[i] = 0;
+
+  /* linear probing: move the following entries back so that no probe chain is broken */
+  for (j = (i + 1) & mask; cache->buckets[j] != 0; j = (j + 1) & mask)
+  {
+    glyph_cache_item_t *iter = cache->items + cache->buckets[j] - 1;
+    uint32_t home = glyph_cache_hash(cache, iter->code, iter->size);
+
+    if (((j - home) & mask) >= ((j - i) & mask))
+    {
+      cache->buckets[i] = cache->buckets[j];
+      cache->buckets[j] = 0;
+      i = j;
+    }
+  }
+}
+
+static void glyph_cache_remove(glyph_cache_t *cache, uint32_t index)
+{
+  glyph_cache_item_t *item = cache->items + index;
+
+  glyph_cache_unindex(cache, item);
+  glyph_cache_lru_remove(cache, index);
+
+  if (item->g != NULL)
+  {
+    glyph_cache_destroy_glyph(cache, item->g);
+  }
+
+  cache->bytes -= item->bytes;
+  cache->size--;
+
+  memset(item, 0x00, sizeof(glyph_cache_item_t));
+  item->prev = GLYPH_CACHE_NIL;
+  item->next = cache->free_list;
+  cache->free_list = index;
+}
 
 glyph_cache_t *glyph_cache_init(glyph_cache_t *cache, uint32_t capacity,
                                 tk_destroy_t destroy_glyph)
 {
+  uint32_t buckets_nr = 4;
   return_value_if_fail(cache != NULL && capacity > 0, NULL);
 
+  memset(cache, 0x00, sizeof(glyph_cache_t));
+  cache->buckets_bits = 2;
+  /* keep the load factor under 1/2 */
+  while (buckets_nr < capacity * 2)
+  {
+    buckets_nr <<= 1;
+    cache->buckets_bits++;
+  }
+
   cache->items = TKMEM_ZALLOCN(glyph_cache_item_t, capacity);
   return_value_if_fail(cache->items != NULL, NULL);
 
+  cache->buckets = TKMEM_ZALLOCN(uint32_t, buckets_nr);
+  if (cache->buckets == NULL)
+  {
+    TKMEM_FREE(cache->items);
+    return NULL;
+  }
+
   cache->size = 0;
   cache->capacity = capacity;
+  cache->buckets_mask = buckets_nr - 1;
   cache->destroy_glyph = destroy_glyph;
+  cache->lru_head = GLYPH_CACHE_NIL;
+  cache->lru_tail = GLYPH_CACHE_NIL;
+  cache->free_list = GLYPH_CACHE_NIL;
 
   return cache;
 }
 
-static glyph_cache_item_t *glyph_cache_get_empty(glyph_cache_t *cache)
+ret_t glyph_cache_set_max_bytes(glyph_cache_t *cache, uint32_t max_bytes)
 {
-  uint32_t i = 0;
-  uint32_t nr = 0;
-  uint32_t oldest = 0;
-  glyph_cache_item_t *item = NULL;
-  uint32_t oldest_time = 0xffffffff;
-
-  return_value_if_fail(cache != NULL && cache->items != NULL, NULL);
+  return_value_if_fail(cache != NULL && cache->items != NULL, RET_BAD_PARAMS);
 
-  if (cache->size < cache->capacity)
+  cache->max_bytes = max_bytes;
+  while (cache->max_bytes > 0 && cache->bytes > cache->max_bytes &&
+         cache->lru_tail != GLYPH_CACHE_NIL)
   {
-    oldest = cache->size++;
-    return cache->items + oldest;
+    glyph_cache_remove(cache, cache->lru_tail);
   }
 
-  for (i = 0, nr = cache->size; i < nr; i++)
+  return RET_OK;
+}
+
+static uint32_t glyph_cache_get_empty(glyph_cache_t *cache, uint32_t bytes)
+{
+  uint32_t index = GLYPH_CACHE_NIL;
+
+  while (cache->lru_tail != GLYPH_CACHE_NIL &&
+         (cache->size >= cache->capacity ||
+          (cache->max_bytes > 0 && cache->bytes + bytes > cache->max_bytes)))
   {
-    glyph_cache_item_t *item = cache->items + i;
-    if (item->last_access_time < oldest_time)
-    {
-      oldest_time = item->last_access_time;
-      oldest = i;
-      if (oldest_time == 0)
-      {
-        break;
-      }
-    }
+    glyph_cache_remove(cache, cache->lru_tail);
   }
 
-  item = cache->items + oldest;
-  GLYPH_CACHE_FREE_ITEM(cache, item);
+  if (cache->free_list != GLYPH_CACHE_NIL)
+  {
+    index = cache->free_list;
+    cache->free_list = cache->items[index].next;
+  }
+  else if (cache->used < cache->capacity)
+  {
+    index = cache->used++;
+  }
 
-  return item;
+  return index;
 }
 
 ret_t glyph_cache_add(glyph_cache_t *cache, wchar_t code, font_size_t size, glyph_t *g)
 {
-  glyph_cache_item_t *item = glyph_cache_get_empty(cache);
-  return_value_if_fail(cache != NULL && g != NULL && item != NULL, RET_BAD_PARAMS);
+  uint32_t slot = 0;
+  uint32_t index = 0;
+  uint32_t bytes = 0;
+  glyph_cache_item_t *item = NULL;
+  return_value_if_fail(cache != NULL && cache->items != NULL && g != NULL, RET_BAD_PARAMS);
+
+  slot = glyph_cache_find_slot(cache, code, size);
+  if (cache->buckets[slot] != 0)
+  {
+    glyph_cache_remove(cache, cache->buckets[slot] - 1);
+  }
 
+  bytes = glyph_cache_get_glyph_bytes(g) + glyph_cache_build_spans(g);
+  index = glyph_cache_get_empty(cache, bytes);
+  if (index == GLYPH_CACHE_NIL)
+  {
+    if (g->spans != NULL)
+    {
+      TKMEM_FREE(g->spans);
+    }
+    return RET_OOM;
+  }
+
+  item = cache->items + index;
   item->g = g;
   item->size = size;
   item->code = code;
-  item->last_access_time = time_now_ms();
+  item->bytes = bytes;
+
+  cache->size++;
+  cache->bytes += bytes;
+  cache->buckets[glyph_cache_find_slot(cache, code, size)] = index + 1;
+  glyph_cache_lru_push_front(cache, index);
 
   return RET_OK;
 }
 
 ret_t glyph_cache_lookup(glyph_cache_t *cache, wchar_t code, font_size_t size, glyph_t *g)
 {
-  uint32_t i = 0;
-  uint32_t nr = 0;
+  uint32_t slot = 0;
+  uint32_t index = 0;
+
+  return_value_if_fail(cache != NULL && cache->items != NULL && g != NULL, RET_BAD_PARAMS);
 
-  return_value_if_fail(cache != NULL && g != NULL, RET_BAD_PARAMS);
-  for (i = 0, nr = cache->size; i < nr; i++)
+  slot = glyph_cache_find_slot(cache, code, size);
+  if (cache->buckets[slot] == 0)
   {
-    glyph_cache_item_t *item = cache->items + i;
-    if (item->code == code && item->size == size)
-    {
-      *g = *(item->g);
-      item->last_access_time = time_now_ms();
+    RENDER_TRACE_ON_GLYPH_CACHE_MISS();
+    return RET_NOT_FOUND;
+  }
 
-      return RET_OK;
-    }
+  index = cache->buckets[slot] - 1;
+  if (cache->lru_head != index)
+  {
+    glyph_cache_lru_remove(cache, index);
+    glyph_cache_lru_push_front(cache, index);
   }
+  *g = *(cache->items[index].g);
 
-  return RET_NOT_FOUND;
+  return RET_OK;
 }
 
 ret_t glyph_cache_deinit(glyph_cache_t *cache)
 {
-  uint32_t i = 0;
-  uint32_t nr = 0;
-
   return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
 
-  if (cache->destroy_glyph != NULL)
+  if (cache->items != NULL)
   {
-    for (i = 0, nr = cache->size; i < nr; i++)
+    uint32_t i = cache->lru_head;
+    while (i != GLYPH_CACHE_NIL)
     {
       glyph_cache_item_t *item = cache->items + i;
-
-      GLYPH_CACHE_FREE_ITEM(cache, item);
+      if (item->g != NULL)
+      {
+        glyph_cache_destroy_glyph(cache, item->g);
+      }
+      i = item->next;
     }
   }
 
   TKMEM_FREE(cache->items);
+  TKMEM_FREE(cache->buckets);
   memset(cache, 0x00, sizeof(glyph_cache_t));
 
   return RET_OK;
 }
 
-static int glyph_cache_item_compare_by_time(const void *a, const void *b)
-{
-  glyph_cache_item_t *aa = (glyph_cache_item_t *)a;
-  glyph_cache_item_t *bb = (glyph_cache_item_t *)b;
-
-  return bb->last_access_time - aa->last_access_time;
-}
-
 ret_t glyph_cache_shrink(glyph_cache_t *cache, uint32_t cache_size)
 {
   return_value_if_fail(cache != NULL && cache->items != NULL, RET_BAD_PARAMS);
 
-  if (cache->size > cache_size)
+  while (cache->size > cache_size && cache->lru_tail != GLYPH_CACHE_NIL)
   {
-    uint32_t i = 0;
-    qsort(cache->items, cache->size, sizeof(glyph_cache_item_t), glyph_cache_item_compare_by_time);
-
-    for (i = cache_size; i < cache->size; i++)
-    {
-      glyph_cache_item_t *item = cache->items + i;
-      GLYPH_CACHE_FREE_ITEM(cache, item);
-    }
-
-    cache->size = cache_size;
+    glyph_cache_remove(cache, cache->lru_tail);
   }
 
   return RET_OK;
@@ -28,15 +28,21 @@ BEGIN_C_DECLS
 
 typedef struct _glyph_cache_item_t
 {
-  uint64_t last_access_time;
   font_size_t size;
   wchar_t code;
   glyph_t *g;
+  uint32_t bytes;
+  /*LRU链表(空闲时为空闲链表)*/
+  uint32_t prev;
+  uint32_t next;
 } glyph_cache_item_t;
 
 /**
  * @class glyph_cache_t
  * glyph cache
+ *
+ * 以(code, size)为键的开放寻址哈希表，查找为O(1)。
+ * 按LRU顺序淘汰，容量可以按个数和字节数限制。
  */
 typedef struct _glyph_cache_t
 {
@@ -44,6 +50,17 @@ typedef struct _glyph_cache_t
   uint32_t capacity;
   glyph_cache_item_t *items;
   tk_destroy_t destroy_glyph;
+
+  /*private*/
+  uint32_t *buckets;
+  uint32_t buckets_mask;
+  uint32_t buckets_bits;
+  uint32_t used;
+  uint32_t free_list;
+  uint32_t lru_head;
+  uint32_t lru_tail;
+  uint32_t bytes;
+  uint32_t max_bytes;
 } glyph_cache_t;
 
 /**
@@ -61,6 +78,8 @@ glyph_cache_t *glyph_cache_init(glyph_cache_t *cache, uint32_t capacity,
 /**
  * @method glyph_cache_add
  * 增加一个glyph对象到cache。
+ * GLYPH_FMT_ALPHA格式、高度不小于GLYPH_CACHE_SPAN_MIN_H的字模会同时生成spans(见GLYPH_SPAN_TYPE)，
+ * 由cache负责释放。
  *
  * @param {glyph_cache_t*} cache cache对象。
  * @param {wchar_t} code 字符。
@@ -71,6 +90,15 @@ glyph_cache_t *glyph_cache_init(glyph_cache_t *cache, uint32_t capacity,
  */
 ret_t glyph_cache_add(glyph_cache_t *cache, wchar_t code, font_size_t size, glyph_t *g);
 
+/**
+ * @method glyph_cache_set_max_bytes
+ * 设置cache占用内存的上限(glyph_t及其点阵数据)，超出时淘汰最久没有使用的glyph。
+ * @param {glyph_cache_t*} cache cache对象。
+ * @param {uint32_t} max_bytes 最大字节数(0表示不限制)。
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t glyph_cache_set_max_bytes(glyph_cache_t *cache, uint32_t max_bytes);
+
 /**
  * @method glyph_cache_lookup
  * 查找glyph对象。
@@ -86,7 +114,7 @@ ret_t glyph_cache_lookup(glyph_cache_t *cache, wchar_t code, font_size_t size, g
 
 /**
  * @method glyph_cache_shrink
- * 释放部分glyph。
+ * 释放部分glyph(最久没有使用的先释放)。
  *
  * @param {glyph_cache_t*} cache cache对象。
  * @param {uint32_t} cache_size 保留cache个数。
@@ -23,35 +23,47 @@
 #include "../tkc/utils.h"
 #include "../tkc/time_now.h"
 #include "locale_info.h"
+#include "bitmap_rle.h"
 #include "image_manager.h"
 
 typedef struct _bitmap_cache_t
 {
   bitmap_t image;
   char *name;
+  uint32_t name_hash;
   uint32_t access_count;
   uint64_t created_time;
   uint64_t last_access_time;
+
+  struct _bitmap_cache_t *next_by_name;
+  struct _bitmap_cache_t *next_by_buffer;
+  struct _bitmap_cache_t *lru_prev;
+  struct _bitmap_cache_t *lru_next;
 } bitmap_cache_t;
 
-static int bitmap_cache_cmp_time(bitmap_cache_t *a, bitmap_cache_t *b)
+static uint32_t bitmap_cache_hash_name(const char *name)
 {
-  return (a->last_access_time <= b->last_access_time) ? 0 : -1;
-}
+  uint32_t hash = 2166136261u;
 
-static int bitmap_cache_cmp_name(bitmap_cache_t *a, bitmap_cache_t *b)
-{
-  return strcmp(a->name, b->name);
+  while (*name)
+  {
+    hash = (hash ^ (uint8_t)(*name++)) * 16777619u;
+  }
+
+  return hash;
 }
 
-static int bitmap_cache_cmp_data(bitmap_cache_t *a, bitmap_cache_t *b)
+static uint32_t bitmap_cache_hash_buffer(const void *buffer)
 {
-  return (char *)(a->image.buffer) - (char *)(b->image.buffer);
+  uint32_t hash = (uint32_t)((uintptr_t)buffer >> 3);
+
+  return hash ^ (hash >> 7);
 }
 
-static int bitmap_cache_cmp_access_time_dec(bitmap_cache_t *a, bitmap_cache_t *b)
+/*RLE图片只保留压缩数据，按压缩数据的大小计入缓存，而不是解压后的大小*/
+static uint32_t bitmap_cache_get_mem_size(bitmap_t *image)
 {
-  return (b->last_access_time) - (a->last_access_time);
+  return bitmap_is_rle(image) ? bitmap_rle_get_mem_size(image) : bitmap_get_mem_size(image);
 }
 
 static ret_t bitmap_cache_destroy(bitmap_cache_t *cache)
@@ -62,7 +74,7 @@ static ret_t bitmap_cache_destroy(bitmap_cache_t *cache)
 
   if (imm != NULL && image->should_free_data)
   {
-    imm->mem_size_of_cached_images -= bitmap_get_mem_size(image);
+    imm->mem_size_of_cached_images -= bitmap_cache_get_mem_size(image);
   }
   log_debug("unload image %s\n", cache->name);
   bitmap_destroy(&(cache->image));
@@ -72,6 +84,131 @@ static ret_t bitmap_cache_destroy(bitmap_cache_t *cache)
   return RET_OK;
 }
 
+static void image_manager_lru_unlink(image_manager_t *imm, bitmap_cache_t *cache)
+{
+  if (cache->lru_prev != NULL)
+  {
+    cache->lru_prev->lru_next = cache->lru_next;
+  }
+  else
+  {
+    imm->lru_first = cache->lru_next;
+  }
+
+  if (cache->lru_next != NULL)
+  {
+    cache->lru_next->lru_prev = cache->lru_prev;
+  }
+  else
+  {
+    imm->lru_last = cache->lru_prev;
+  }
+
+  cache->lru_prev = NULL;
+  cache->lru_next = NULL;
+}
+
+static void image_manager_lru_push_front(image_manager_t *imm, bitmap_cache_t *cache)
+{
+  cache->lru_prev = NULL;
+  cache->lru_next = imm->lru_first;
+
+  if (imm->lru_first != NULL)
+  {
+    imm->lru_first->lru_prev = cache;
+  }
+  else
+  {
+    imm->lru_last = cache;
+  }
+  imm->lru_first = cache;
+}
+
+static void image_manager_link(image_manager_t *imm, bitmap_cache_t *cache)
+{
+  bitmap_cache_t **by_name = imm->by_name + (cache->name_hash % TK_IMAGE_MANAGER_BUCKETS);
+  bitmap_cache_t **by_buffer =
+      imm->by_buffer + (bitmap_cache_hash_buffer(cache->image.buffer) % TK_IMAGE_MANAGER_BUCKETS);
+
+  cache->next_by_name = *by_name;
+  *by_name = cache;
+  cache->next_by_buffer = *by_buffer;
+  *by_buffer = cache;
+
+  image_manager_lru_push_front(imm, cache);
+  imm->nr++;
+}
+
+static void image_manager_unlink(image_manager_t *imm, bitmap_cache_t *cache)
+{
+  uint32_t hash = cache->name_hash;
+  bitmap_cache_t **iter = imm->by_name + (hash % TK_IMAGE_MANAGER_BUCKETS);
+
+  while (*iter != NULL && *iter != cache)
+  {
+    iter = &((*iter)->next_by_name);
+  }
+  if (*iter != NULL)
+  {
+    *iter = cache->next_by_name;
+  }
+
+  hash = bitmap_cache_hash_buffer(cache->image.buffer);
+  iter = imm->by_buffer + (hash % TK_IMAGE_MANAGER_BUCKETS);
+  while (*iter != NULL && *iter != cache)
+  {
+    iter = &((*iter)->next_by_buffer);
+  }
+  if (*iter != NULL)
+  {
+    *iter = cache->next_by_buffer;
+  }
+
+  image_manager_lru_unlink(imm, cache);
+  imm->nr--;
+}
+
+static ret_t image_manager_remove(image_manager_t *imm, bitmap_cache_t *cache)
+{
+  image_manager_unlink(imm, cache);
+
+  return bitmap_cache_destroy(cache);
+}
+
+static bitmap_cache_t *image_manager_find_by_name(image_manager_t *imm, const char *name)
+{
+  uint32_t hash = bitmap_cache_hash_name(name);
+  bitmap_cache_t *iter = imm->by_name[hash % TK_IMAGE_MANAGER_BUCKETS];
+
+  while (iter != NULL)
+  {
+    if (iter->name_hash == hash && strcmp(iter->name, name) == 0)
+    {
+      return iter;
+    }
+    iter = iter->next_by_name;
+  }
+
+  return NULL;
+}
+
+static bitmap_cache_t *image_manager_find_by_buffer(image_manager_t *imm, const void *buffer)
+{
+  uint32_t hash = bitmap_cache_hash_buffer(buffer);
+  bitmap_cache_t *iter = imm->by_buffer[hash % TK_IMAGE_MANAGER_BUCKETS];
+
+  while (iter != NULL)
+  {
+    if ((const void *)(iter->image.buffer) == buffer)
+    {
+      return iter;
+    }
+    iter = iter->next_by_buffer;
+  }
+
+  return NULL;
+}
+
 static image_manager_t *s_image_manager = NULL;
 image_manager_t *image_manager()
 {
@@ -110,10 +247,14 @@ image_manager_t *image_manager_init(image_manager_t *imm)
 {
   return_value_if_fail(imm != NULL, NULL);
 
-  darray_init(&(imm->images), 0, (tk_destroy_t)bitmap_cache_destroy, NULL);
   imm->assets_manager = assets_manager();
   imm->refcount = 1;
   imm->name = NULL;
+  imm->nr = 0;
+  imm->lru_first = NULL;
+  imm->lru_last = NULL;
+  memset(imm->by_name, 0x00, sizeof(imm->by_name));
+  memset(imm->by_buffer, 0x00, sizeof(imm->by_buffer));
 
   return imm;
 }
@@ -121,22 +262,27 @@ image_manager_t *image_manager_init(image_manager_t *imm)
 static ret_t image_manager_clear_cache(image_manager_t *imm)
 {
   bitmap_cache_t *iter = NULL;
+  bitmap_cache_t *prev = NULL;
   return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
-  if (imm->images.size == 0 || imm->max_mem_size_of_cached_images == 0 ||
-      imm->mem_size_of_cached_images < imm->max_mem_size_of_cached_images)
+  if (imm->max_mem_size_of_cached_images == 0)
   {
     return RET_OK;
   }
 
-  darray_sort(&(imm->images), (tk_compare_t)bitmap_cache_cmp_access_time_dec);
-  do
+  /*raw images are not counted in mem_size_of_cached_images, evicting them frees nothing.*/
+  iter = imm->lru_last;
+  while (iter != NULL && imm->mem_size_of_cached_images > imm->max_mem_size_of_cached_images)
   {
-    iter = (bitmap_cache_t *)darray_pop(&(imm->images));
-    bitmap_cache_destroy(iter);
-    log_debug("clear cache: mem_size_of_cached_images=%u nr=%u", imm->mem_size_of_cached_images,
-              imm->images.size);
-  } while (imm->images.size > 0 &&
-           imm->mem_size_of_cached_images > imm->max_mem_size_of_cached_images);
+    prev = iter->lru_prev;
+    if (iter->image.should_free_data)
+    {
+      image_manager_remove(imm, iter);
+      imm->evictions++;
+      log_debug("clear cache: mem_size_of_cached_images=%u nr=%u", imm->mem_size_of_cached_images,
+                imm->nr);
+    }
+    iter = prev;
+  }
 
   return RET_OK;
 }
@@ -154,30 +300,24 @@ ret_t image_manager_add(image_manager_t *imm, const char *name, const bitmap_t *
   cache->created_time = time_now_s();
   cache->image.should_free_handle = FALSE;
   cache->name = tk_strdup(name);
+  cache->name_hash = bitmap_cache_hash_name(name);
   cache->image.name = cache->name;
   cache->last_access_time = cache->created_time;
 
   cache->image.image_manager = imm;
   if (image->should_free_data)
   {
-    imm->mem_size_of_cached_images += bitmap_get_mem_size((bitmap_t *)image);
+    imm->mem_size_of_cached_images += bitmap_cache_get_mem_size((bitmap_t *)image);
     image_manager_clear_cache(imm);
   }
+  image_manager_link(imm, cache);
 
-  return darray_push(&(imm->images), cache);
+  return RET_OK;
 }
 
-ret_t image_manager_lookup(image_manager_t *imm, const char *name, bitmap_t *image)
+static ret_t image_manager_lookup_impl(image_manager_t *imm, const char *name, bitmap_t *image)
 {
-  bitmap_cache_t info;
-  bitmap_cache_t *iter = NULL;
-  return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
-
-  memset(&info, 0x00, sizeof(info));
-
-  info.name = (char *)name;
-  imm->images.compare = (tk_compare_t)bitmap_cache_cmp_name;
-  iter = darray_find(&(imm->images), &info);
+  bitmap_cache_t *iter = image_manager_find_by_name(imm, name);
 
   if (iter != NULL)
   {
@@ -189,6 +329,11 @@ ret_t image_manager_lookup(image_manager_t *imm, const char *name, bitmap_t *ima
 
     iter->access_count++;
     iter->last_access_time = time_now_s();
+    if (imm->lru_first != iter)
+    {
+      image_manager_lru_unlink(imm, iter);
+      image_manager_lru_push_front(imm, iter);
+    }
 
     return RET_OK;
   }
@@ -196,9 +341,24 @@ ret_t image_manager_lookup(image_manager_t *imm, const char *name, bitmap_t *ima
   return RET_NOT_FOUND;
 }
 
+ret_t image_manager_lookup(image_manager_t *imm, const char *name, bitmap_t *image)
+{
+  return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
+
+  if (image_manager_lookup_impl(imm, name, image) == RET_OK)
+  {
+    imm->hits++;
+    return RET_OK;
+  }
+  else
+  {
+    imm->misses++;
+    return RET_NOT_FOUND;
+  }
+}
+
 ret_t image_manager_update_specific(image_manager_t *imm, bitmap_t *image)
 {
-  bitmap_cache_t info;
   bitmap_cache_t *iter = NULL;
   return_value_if_fail(image != NULL, RET_BAD_PARAMS);
 
@@ -212,9 +372,7 @@ ret_t image_manager_update_specific(image_manager_t *imm, bitmap_t *image)
     imm = image->image_manager;
   }
 
-  info.image.buffer = image->buffer;
-  imm->images.compare = (tk_compare_t)bitmap_cache_cmp_data;
-  iter = darray_find(&(imm->images), &info);
+  iter = image_manager_find_by_buffer(imm, image->buffer);
 
   if (iter != NULL)
   {
@@ -286,6 +444,31 @@ static ret_t image_manager_get_bitmap_impl(image_manager_t *imm, const char *nam
 
     return RET_OK;
   }
+  else if (res->subtype == ASSET_TYPE_IMAGE_RLE)
+  {
+    const bitmap_header_t *header = (const bitmap_header_t *)res->data;
+    uint32_t header_size = sizeof(bitmap_header_t) - sizeof(header->data);
+    return_value_if_fail(res->size > header_size, RET_BAD_PARAMS);
+    /*RLE图片只按行解码，不支持预先旋转*/
+    return_value_if_fail(!(header->flags & BITMAP_FLAG_LCD_ORIENTATION), RET_NOT_IMPL);
+
+    image->w = header->w;
+    image->h = header->h;
+    image->flags = header->flags;
+    image->format = header->format;
+    image->name = res->name;
+    image->image_manager = imm;
+    image->orientation = LCD_ORIENTATION_0;
+    bitmap_set_line_length(image, 0);
+    image->buffer = graphic_buffer_rle_create(header->data, res->size - header_size, header->w,
+                                              header->h, (bitmap_format_t)(header->format));
+    return_value_if_fail(image->buffer != NULL, RET_BAD_PARAMS);
+    image->should_free_data = TRUE;
+    image_manager_add(imm, name, image);
+    image->should_free_data = FALSE;
+
+    return RET_OK;
+  }
   else if (res->subtype != ASSET_TYPE_IMAGE_BSVG)
   {
     ret_t ret = image_loader_load_image(res, image);
@@ -295,7 +478,7 @@ static ret_t image_manager_get_bitmap_impl(image_manager_t *imm, const char *nam
       assets_manager_unref(imm->assets_manager, res);
     }
 
-    return image_manager_lookup(imm, name, image);
+    return image_manager_lookup_impl(imm, name, image);
   }
   else
   {
@@ -389,47 +572,80 @@ ret_t image_manager_set_assets_manager(image_manager_t *imm, assets_manager_t *a
 
 bool_t image_manager_has_bitmap(image_manager_t *imm, bitmap_t *image)
 {
-  bitmap_cache_t b;
   return_value_if_fail(imm != NULL && image != NULL, RET_BAD_PARAMS);
 
-  b.image.buffer = image->buffer;
-
-  if (darray_find_ex(&(imm->images), (tk_compare_t)bitmap_cache_cmp_data, &b) == NULL)
-  {
-    return FALSE;
-  }
-  else
-  {
-    return TRUE;
-  }
+  return image_manager_find_by_buffer(imm, image->buffer) != NULL;
 }
 
 ret_t image_manager_unload_unused(image_manager_t *imm, uint32_t time_delta_s)
 {
-  bitmap_cache_t b;
-  b.last_access_time = time_now_s() - time_delta_s;
+  uint64_t last_access_time = 0;
+  bitmap_cache_t *iter = NULL;
+  bitmap_cache_t *prev = NULL;
   return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
 
-  imm->images.compare = (tk_compare_t)bitmap_cache_cmp_time;
-  return darray_remove_all(&(imm->images), NULL, &b);
+  /*the lru list is ordered by access time, stop at the first recently used one.*/
+  last_access_time = time_now_s() - time_delta_s;
+  iter = imm->lru_last;
+  while (iter != NULL && iter->last_access_time <= last_access_time)
+  {
+    prev = iter->lru_prev;
+    image_manager_remove(imm, iter);
+    iter = prev;
+  }
+
+  return RET_OK;
 }
 
 ret_t image_manager_unload_all(image_manager_t *imm)
 {
   return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
 
-  return darray_clear(&(imm->images));
+  while (imm->lru_first != NULL)
+  {
+    image_manager_remove(imm, imm->lru_first);
+  }
+
+  return RET_OK;
 }
 
 ret_t image_manager_unload_bitmap(image_manager_t *imm, bitmap_t *image)
 {
-  bitmap_cache_t b;
+  bitmap_cache_t *iter = NULL;
   return_value_if_fail(imm != NULL && image != NULL, RET_BAD_PARAMS);
 
-  b.image.buffer = image->buffer;
-  imm->images.compare = (tk_compare_t)bitmap_cache_cmp_data;
+  iter = image_manager_find_by_buffer(imm, image->buffer);
+  if (iter != NULL)
+  {
+    image_manager_remove(imm, iter);
+  }
+
+  return RET_OK;
+}
+
+ret_t image_manager_get_stats(image_manager_t *imm, image_manager_stats_t *stats)
+{
+  return_value_if_fail(imm != NULL && stats != NULL, RET_BAD_PARAMS);
+
+  stats->nr = imm->nr;
+  stats->mem_size = imm->mem_size_of_cached_images;
+  stats->max_mem_size = imm->max_mem_size_of_cached_images;
+  stats->hits = imm->hits;
+  stats->misses = imm->misses;
+  stats->evictions = imm->evictions;
 
-  return darray_remove_all(&(imm->images), NULL, &b);
+  return RET_OK;
+}
+
+ret_t image_manager_reset_stats(image_manager_t *imm)
+{
+  return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
+
+  imm->hits = 0;
+  imm->misses = 0;
+  imm->evictions = 0;
+
+  return RET_OK;
 }
 
 ret_t image_manager_deinit(image_manager_t *imm)
@@ -437,7 +653,7 @@ ret_t image_manager_deinit(image_manager_t *imm)
   return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
 
   TKMEM_FREE(imm->name);
-  darray_deinit(&(imm->images));
+  image_manager_unload_all(imm);
 
   return RET_OK;
 }
@@ -44,19 +44,72 @@ typedef struct _bitmap_header_t
 typedef ret_t (*image_manager_get_bitmap_t)(image_manager_t *imm, const char *name,
                                             bitmap_t *image);
 
+#ifndef TK_IMAGE_MANAGER_BUCKETS
+#define TK_IMAGE_MANAGER_BUCKETS 32
+#endif /*TK_IMAGE_MANAGER_BUCKETS*/
+
+struct _bitmap_cache_t;
+
+/**
+ * @class image_manager_stats_t
+ * 图片缓存的统计信息。
+ */
+typedef struct _image_manager_stats_t
+{
+  /**
+   * @property {uint32_t} nr
+   * @annotation ["readable"]
+   * 缓存的图片数。
+   */
+  uint32_t nr;
+  /**
+   * @property {uint32_t} mem_size
+   * @annotation ["readable"]
+   * 缓存的图片占用的内存(字节数)。
+   */
+  uint32_t mem_size;
+  /**
+   * @property {uint32_t} max_mem_size
+   * @annotation ["readable"]
+   * 缓存的最大内存(字节数)，0表示不限制。
+   */
+  uint32_t max_mem_size;
+  /**
+   * @property {uint32_t} hits
+   * @annotation ["readable"]
+   * 在缓存中找到图片的次数。
+   */
+  uint32_t hits;
+  /**
+   * @property {uint32_t} misses
+   * @annotation ["readable"]
+   * 没有在缓存中找到图片(需要加载)的次数。
+   */
+  uint32_t misses;
+  /**
+   * @property {uint32_t} evictions
+   * @annotation ["readable"]
+   * 因超出最大内存而被淘汰的图片数。
+   */
+  uint32_t evictions;
+} image_manager_stats_t;
+
 /**
  * @class image_manager_t
  * @annotation ["scriptable"]
  * 图片管理器。负责加载，解码和缓存图片。
+ *
+ * 缓存的图片按名称和buffer分别建立哈希索引，并按最近访问顺序排列。
+ * 缓存占用的内存超过max_mem_size_of_cached_images时，淘汰最久没有访问的图片。
  */
 struct _image_manager_t
 {
   /**
-   * @property {darray_t} images
+   * @property {uint32_t} nr
    * @annotation ["private"]
-   * 缓存的图片。
+   * 缓存的图片数。
    */
-  darray_t images;
+  uint32_t nr;
 
   /**
    * @property {assets_manager_t*} assets_manager
@@ -73,6 +126,15 @@ struct _image_manager_t
 
   image_manager_get_bitmap_t fallback_get_bitmap;
   void *fallback_get_bitmap_ctx;
+
+  struct _bitmap_cache_t *by_name[TK_IMAGE_MANAGER_BUCKETS];
+  struct _bitmap_cache_t *by_buffer[TK_IMAGE_MANAGER_BUCKETS];
+  struct _bitmap_cache_t *lru_first;
+  struct _bitmap_cache_t *lru_last;
+
+  uint32_t hits;
+  uint32_t misses;
+  uint32_t evictions;
 };
 
 /**
@@ -122,6 +184,25 @@ image_manager_t *image_manager_init(image_manager_t *imm);
  */
 ret_t image_manager_set_max_mem_size_of_cached_images(image_manager_t *imm, uint32_t max_mem_size);
 
+/**
+ * @method image_manager_get_stats
+ * 获取图片缓存的统计信息。
+ * @param {image_manager_t*} imm 图片管理器对象。
+ * @param {image_manager_stats_t*} stats 用于返回统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_manager_get_stats(image_manager_t *imm, image_manager_stats_t *stats);
+
+/**
+ * @method image_manager_reset_stats
+ * 清除命中、未命中和淘汰计数。
+ * @param {image_manager_t*} imm 图片管理器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_manager_reset_stats(image_manager_t *imm);
+
 /**
  * @method image_manager_get_bitmap
  * 获取指定的图片。
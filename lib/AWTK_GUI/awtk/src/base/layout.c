@@ -173,6 +173,19 @@ ret_t widget_set_self_layout(widget_t *widget, const char *params)
   return widget_set_need_relayout(widget);
 }
 
+ret_t widget_set_self_layouter(widget_t *widget, self_layouter_t *layouter)
+{
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  if (widget->self_layout != NULL)
+  {
+    self_layouter_destroy(widget->self_layout);
+  }
+  widget->self_layout = layouter;
+
+  return widget_set_need_relayout(widget);
+}
+
 ret_t widget_set_children_layout(widget_t *widget, const char *params)
 {
   return_value_if_fail(widget != NULL && params != NULL, RET_BAD_PARAMS);
@@ -385,6 +385,18 @@ vgcanvas_t *lcd_get_vgcanvas(lcd_t *lcd)
   return NULL;
 }
 
+vgcanvas_t *lcd_peek_vgcanvas(lcd_t *lcd)
+{
+  return_value_if_fail(lcd != NULL, NULL);
+
+  if (lcd->peek_vgcanvas != NULL)
+  {
+    return lcd->peek_vgcanvas(lcd);
+  }
+
+  return lcd_get_vgcanvas(lcd);
+}
+
 bitmap_format_t lcd_get_desired_bitmap_format(lcd_t *lcd)
 {
   return_value_if_fail(lcd != NULL && lcd->get_desired_bitmap_format != NULL, BITMAP_FMT_BGR565);
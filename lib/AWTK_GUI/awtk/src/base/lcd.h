@@ -218,6 +218,7 @@ struct _lcd_t
   lcd_sync_t sync;
   lcd_end_frame_t end_frame;
   lcd_get_vgcanvas_t get_vgcanvas;
+  lcd_get_vgcanvas_t peek_vgcanvas;
   lcd_get_desired_bitmap_format_t get_desired_bitmap_format;
   lcd_set_vgcanvas_t set_vgcanvas;
   lcd_set_line_length_t set_line_length;
@@ -575,6 +576,15 @@ ret_t lcd_draw_image_matrix(lcd_t *lcd, draw_image_info_t *info);
  */
 vgcanvas_t *lcd_get_vgcanvas(lcd_t *lcd);
 
+/**
+ * @method lcd_peek_vgcanvas
+ * 获取已经创建的矢量图canvas。按需创建矢量图canvas的lcd还没有创建时返回NULL，不会为此创建。
+ * @param {lcd_t*} lcd lcd对象。
+ *
+ * @return {vgcanvas_t*} 返回矢量图canvas。
+ */
+vgcanvas_t *lcd_peek_vgcanvas(lcd_t *lcd);
+
 /**
  * @method lcd_get_desired_bitmap_format
  * 获取期望的位图格式。绘制期望的位图格式可以提高绘制性能。
@@ -293,6 +293,13 @@ static vgcanvas_t *lcd_profile_get_vgcanvas(lcd_t *lcd)
   return lcd_get_vgcanvas(profile->impl);
 }
 
+static vgcanvas_t *lcd_profile_peek_vgcanvas(lcd_t *lcd)
+{
+  lcd_profile_t *profile = LCD_PROFILE(lcd);
+
+  return lcd_peek_vgcanvas(profile->impl);
+}
+
 static bitmap_format_t lcd_profile_get_desired_bitmap_format(lcd_t *lcd)
 {
   lcd_profile_t *profile = LCD_PROFILE(lcd);
@@ -479,6 +486,7 @@ lcd_t *lcd_profile_create(lcd_t *impl)
   if (impl->get_vgcanvas != NULL)
   {
     lcd->get_vgcanvas = lcd_profile_get_vgcanvas;
+    lcd->peek_vgcanvas = lcd_profile_peek_vgcanvas;
   }
 
   if (impl->get_desired_bitmap_format != NULL)
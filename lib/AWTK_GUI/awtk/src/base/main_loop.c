@@ -81,9 +81,16 @@ ret_t main_loop_set(main_loop_t *loop)
 
 ret_t main_loop_queue_event(main_loop_t *l, const event_queue_req_t *e)
 {
+  ret_t ret = RET_FAIL;
   return_value_if_fail(l != NULL && l->queue_event != NULL && e != NULL, RET_BAD_PARAMS);
 
-  return l->queue_event(l, e);
+  ret = l->queue_event(l, e);
+  if (ret == RET_OK)
+  {
+    main_loop_wakeup(l);
+  }
+
+  return ret;
 }
 
 ret_t main_loop_recv_event(main_loop_t *l, event_queue_req_t *r)
@@ -132,6 +132,7 @@ ret_t main_loop_remove_event_source(main_loop_t *l, event_source_t *source);
 ret_t main_loop_remove_event_source_by_tag(main_loop_t *l, void *tag);
 
 /* private */
+ret_t main_loop_sleep_default(main_loop_t *l);
 ret_t main_loop_set_curr_expected_sleep_time(main_loop_t *l, uint32_t sleep_time);
 
 END_C_DECLS
@@ -0,0 +1,580 @@
+﻿/**
+ * File:   render_trace.c
+ * Author: AWTK Develop Team
+ * Brief:  per frame/strip render trace
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#include "../tkc/fs.h"
+#include "../tkc/mem.h"
+#include "../tkc/utils.h"
+#include "../tkc/time_now.h"
+#include "render_trace.h"
+
+#ifdef ENABLE_RENDER_TRACE
+typedef struct _render_trace_ctx_t
+{
+  render_trace_event_t *events;
+  uint32_t capacity;
+  /*已经记录的事件总数，事件保存在events[seq % capacity]。*/
+  uint32_t seq;
+  uint32_t min_widget_cost;
+
+  uint32_t frame;
+  uint64_t frame_start;
+  bool_t in_frame;
+
+  /*当前片段的统计信息，片段结束时才写入环形缓冲区，避免被控件事件覆盖。*/
+  render_trace_strip_t strip;
+  uint64_t strip_start;
+  uint64_t flush_start;
+  bool_t in_strip;
+} render_trace_ctx_t;
+
+static render_trace_ctx_t s_render_trace;
+
+static render_trace_event_t *render_trace_push(uint8_t type, uint64_t start)
+{
+  render_trace_ctx_t *t = &s_render_trace;
+  render_trace_event_t *e = t->events + (t->seq % t->capacity);
+
+  t->seq++;
+  e->type = type;
+  e->frame = t->frame;
+  e->start = start;
+  e->duration = 0;
+
+  return e;
+}
+
+ret_t render_trace_start(uint32_t capacity, uint32_t min_widget_cost)
+{
+  render_trace_ctx_t *t = &s_render_trace;
+  return_value_if_fail(capacity > 0, RET_BAD_PARAMS);
+
+  render_trace_stop();
+  t->events = TKMEM_ZALLOCN(render_trace_event_t, capacity);
+  return_value_if_fail(t->events != NULL, RET_OOM);
+
+  t->capacity = capacity;
+  t->min_widget_cost = min_widget_cost;
+
+  return RET_OK;
+}
+
+ret_t render_trace_stop(void)
+{
+  render_trace_ctx_t *t = &s_render_trace;
+
+  TKMEM_FREE(t->events);
+  memset(t, 0x00, sizeof(*t));
+
+  return RET_OK;
+}
+
+bool_t render_trace_is_started(void)
+{
+  return s_render_trace.events != NULL;
+}
+
+ret_t render_trace_clear(void)
+{
+  return_value_if_fail(render_trace_is_started(), RET_BAD_PARAMS);
+  s_render_trace.seq = 0;
+
+  return RET_OK;
+}
+
+ret_t render_trace_frame_begin(void)
+{
+  render_trace_ctx_t *t = &s_render_trace;
+
+  if (!render_trace_is_started())
+  {
+    return RET_OK;
+  }
+
+  t->frame++;
+  t->in_frame = TRUE;
+  t->frame_start = time_now_us();
+
+  return RET_OK;
+}
+
+ret_t render_trace_frame_end(void)
+{
+  render_trace_event_t *e = NULL;
+  render_trace_ctx_t *t = &s_render_trace;
+
+  if (!render_trace_is_started())
+  {
+    return RET_OK;
+  }
+  return_value_if_fail(t->in_frame, RET_BAD_PARAMS);
+
+  e = render_trace_push(RENDER_TRACE_EVENT_FRAME, t->frame_start);
+  e->duration = (uint32_t)(time_now_us() - t->frame_start);
+  t->in_frame = FALSE;
+
+  return RET_OK;
+}
+
+ret_t render_trace_strip_begin(const rect_t *r)
+{
+  render_trace_ctx_t *t = &s_render_trace;
+  return_value_if_fail(r != NULL, RET_BAD_PARAMS);
+
+  if (!render_trace_is_started())
+  {
+    return RET_OK;
+  }
+
+  memset(&(t->strip), 0x00, sizeof(t->strip));
+  t->strip.rect = *r;
+  t->in_strip = TRUE;
+  t->flush_start = 0;
+  t->strip_start = time_now_us();
+
+  return RET_OK;
+}
+
+ret_t render_trace_strip_flush_begin(void)
+{
+  render_trace_ctx_t *t = &s_render_trace;
+
+  if (!render_trace_is_started())
+  {
+    return RET_OK;
+  }
+  return_value_if_fail(t->in_strip, RET_BAD_PARAMS);
+
+  t->flush_start = time_now_us();
+
+  return RET_OK;
+}
+
+ret_t render_trace_strip_end(uint32_t visited_widgets, uint32_t painted_widgets)
+{
+  uint64_t now = 0;
+  render_trace_event_t *e = NULL;
+  render_trace_ctx_t *t = &s_render_trace;
+
+  if (!render_trace_is_started())
+  {
+    return RET_OK;
+  }
+  return_value_if_fail(t->in_strip, RET_BAD_PARAMS);
+
+  now = time_now_us();
+  t->strip.visited_widgets = visited_widgets;
+  t->strip.painted_widgets = painted_widgets;
+  if (t->flush_start > 0)
+  {
+    t->strip.flush_start = (uint32_t)(t->flush_start - t->strip_start);
+    t->strip.flush_cost = (uint32_t)(now - t->flush_start);
+  }
+
+  e = render_trace_push(RENDER_TRACE_EVENT_STRIP, t->strip_start);
+  e->duration = (uint32_t)(now - t->strip_start);
+  e->info.strip = t->strip;
+  t->in_strip = FALSE;
+
+  return RET_OK;
+}
+
+uint32_t render_trace_widget_begin(const char *type, const char *name)
+{
+  render_trace_event_t *e = NULL;
+  render_trace_ctx_t *t = &s_render_trace;
+
+  if (!render_trace_is_started() || !t->in_frame)
+  {
+    return t->seq;
+  }
+
+  e = render_trace_push(RENDER_TRACE_EVENT_WIDGET, time_now_us());
+  e->info.widget.type = type;
+  tk_strncpy(e->info.widget.name, name != NULL ? name : "", TK_NAME_LEN);
+
+  return t->seq - 1;
+}
+
+ret_t render_trace_widget_end(uint32_t seq)
+{
+  render_trace_event_t *e = NULL;
+  render_trace_ctx_t *t = &s_render_trace;
+
+  /*没有记录，或者已经被覆盖。*/
+  if (!render_trace_is_started() || seq >= t->seq || t->seq - seq > t->capacity)
+  {
+    return RET_OK;
+  }
+
+  e = t->events + (seq % t->capacity);
+  e->duration = (uint32_t)(time_now_us() - e->start);
+  /*子控件的耗时不会超过父控件，父控件耗时太短时子控件都已经被丢弃，所以它就是最后一条记录。*/
+  if (e->duration < t->min_widget_cost && seq + 1 == t->seq)
+  {
+    t->seq--;
+  }
+
+  return RET_OK;
+}
+
+ret_t render_trace_on_draw(render_trace_draw_t draw, render_trace_pixels_t kind, uint32_t pixels)
+{
+  render_trace_ctx_t *t = &s_render_trace;
+
+  if (t->in_strip && draw < RENDER_TRACE_DRAW_NR && kind < RENDER_TRACE_PIXELS_NR)
+  {
+    t->strip.draw_calls[draw]++;
+    t->strip.pixels[kind] += pixels;
+  }
+
+  return RET_OK;
+}
+
+ret_t render_trace_on_glyph_cache_miss(void)
+{
+  render_trace_ctx_t *t = &s_render_trace;
+
+  if (t->in_strip)
+  {
+    t->strip.glyph_cache_misses++;
+  }
+
+  return RET_OK;
+}
+
+ret_t render_trace_foreach(tk_visit_t visit, void *ctx)
+{
+  uint32_t i = 0;
+  uint32_t first = 0;
+  render_trace_ctx_t *t = &s_render_trace;
+  return_value_if_fail(visit != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(render_trace_is_started(), RET_BAD_PARAMS);
+
+  first = t->seq > t->capacity ? t->seq - t->capacity : 0;
+  for (i = first; i < t->seq; i++)
+  {
+    if (visit(ctx, t->events + (i % t->capacity)) == RET_STOP)
+    {
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+typedef struct _render_trace_dump_ctx_t
+{
+  str_t *str;
+  uint64_t base;
+  uint32_t nr;
+  ret_t ret;
+} render_trace_dump_ctx_t;
+
+static ret_t render_trace_find_base(void *ctx, const void *data)
+{
+  uint64_t *base = (uint64_t *)ctx;
+  const render_trace_event_t *e = (const render_trace_event_t *)data;
+
+  if (*base == 0 || e->start < *base)
+  {
+    *base = e->start;
+  }
+
+  return RET_OK;
+}
+
+static ret_t render_trace_dump_begin(render_trace_dump_ctx_t *info, const char *name,
+                                     const char *cat, uint64_t start, uint32_t duration)
+{
+  str_t *str = info->str;
+
+  if (info->nr++ > 0)
+  {
+    return_value_if_fail(str_append(str, ",\n") == RET_OK, RET_OOM);
+  }
+  return_value_if_fail(str_append(str, "{") == RET_OK, RET_OOM);
+  return_value_if_fail(str_append_json_str_pair(str, "name", name) == RET_OK, RET_OOM);
+  return_value_if_fail(str_append(str, ",") == RET_OK, RET_OOM);
+  return_value_if_fail(str_append_json_str_pair(str, "cat", cat) == RET_OK, RET_OOM);
+  return_value_if_fail(str_append(str, ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":") == RET_OK,
+                       RET_OOM);
+  return_value_if_fail(str_append_uint64(str, start - info->base) == RET_OK, RET_OOM);
+  return_value_if_fail(str_append(str, ",\"dur\":") == RET_OK, RET_OOM);
+  return_value_if_fail(str_append_uint64(str, duration) == RET_OK, RET_OOM);
+
+  return str_append(str, ",\"args\":{");
+}
+
+static ret_t render_trace_dump_int(str_t *str, const char *key, uint32_t value, bool_t last)
+{
+  return_value_if_fail(str_append_json_str(str, key) == RET_OK, RET_OOM);
+  return_value_if_fail(str_append_char(str, ':') == RET_OK, RET_OOM);
+  return_value_if_fail(str_append_uint64(str, value) == RET_OK, RET_OOM);
+
+  return str_append(str, last ? "}}" : ",");
+}
+
+static ret_t render_trace_dump_strip(render_trace_dump_ctx_t *info, const render_trace_event_t *e)
+{
+  str_t *str = info->str;
+  const render_trace_strip_t *s = &(e->info.strip);
+
+  return_value_if_fail(render_trace_dump_begin(info, "strip", "strip", e->start, e->duration) ==
+                           RET_OK,
+                       RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "frame", e->frame, FALSE) == RET_OK, RET_OOM);
+  return_value_if_fail(str_append_json_int_pair(str, "x", s->rect.x) == RET_OK, RET_OOM);
+  return_value_if_fail(str_append(str, ",") == RET_OK, RET_OOM);
+  return_value_if_fail(str_append_json_int_pair(str, "y", s->rect.y) == RET_OK, RET_OOM);
+  return_value_if_fail(str_append(str, ",") == RET_OK, RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "w", s->rect.w, FALSE) == RET_OK, RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "h", s->rect.h, FALSE) == RET_OK, RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "visited_widgets", s->visited_widgets, FALSE) ==
+                           RET_OK,
+                       RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "painted_widgets", s->painted_widgets, FALSE) ==
+                           RET_OK,
+                       RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "fill_calls",
+                                             s->draw_calls[RENDER_TRACE_DRAW_FILL], FALSE) ==
+                           RET_OK,
+                       RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "stroke_calls",
+                                             s->draw_calls[RENDER_TRACE_DRAW_STROKE], FALSE) ==
+                           RET_OK,
+                       RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "image_calls",
+                                             s->draw_calls[RENDER_TRACE_DRAW_IMAGE], FALSE) ==
+                           RET_OK,
+                       RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "glyph_calls",
+                                             s->draw_calls[RENDER_TRACE_DRAW_GLYPH], FALSE) ==
+                           RET_OK,
+                       RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "filled_pixels",
+                                             s->pixels[RENDER_TRACE_PIXELS_FILLED], FALSE) ==
+                           RET_OK,
+                       RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "blended_pixels",
+                                             s->pixels[RENDER_TRACE_PIXELS_BLENDED], FALSE) ==
+                           RET_OK,
+                       RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "copied_pixels",
+                                             s->pixels[RENDER_TRACE_PIXELS_COPIED], FALSE) ==
+                           RET_OK,
+                       RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "glyph_cache_misses", s->glyph_cache_misses,
+                                             FALSE) == RET_OK,
+                       RET_OOM);
+  return_value_if_fail(render_trace_dump_int(str, "flush_cost", s->flush_cost, TRUE) == RET_OK,
+                       RET_OOM);
+
+  if (s->flush_cost > 0)
+  {
+    return_value_if_fail(render_trace_dump_begin(info, "flush", "flush", e->start + s->flush_start,
+                                                 s->flush_cost) == RET_OK,
+                         RET_OOM);
+    return_value_if_fail(render_trace_dump_int(str, "frame", e->frame, TRUE) == RET_OK, RET_OOM);
+  }
+
+  return RET_OK;
+}
+
+static ret_t render_trace_dump_event(void *ctx, const void *data)
+{
+  render_trace_dump_ctx_t *info = (render_trace_dump_ctx_t *)ctx;
+  const render_trace_event_t *e = (const render_trace_event_t *)data;
+  str_t *str = info->str;
+
+  switch (e->type)
+  {
+  case RENDER_TRACE_EVENT_FRAME:
+  {
+    info->ret = render_trace_dump_begin(info, "frame", "frame", e->start, e->duration);
+    if (info->ret == RET_OK)
+    {
+      info->ret = render_trace_dump_int(str, "frame", e->frame, TRUE);
+    }
+    break;
+  }
+  case RENDER_TRACE_EVENT_STRIP:
+  {
+    info->ret = render_trace_dump_strip(info, e);
+    break;
+  }
+  case RENDER_TRACE_EVENT_WIDGET:
+  {
+    const char *type = e->info.widget.type != NULL ? e->info.widget.type : "widget";
+
+    info->ret = render_trace_dump_begin(info, type, "widget", e->start, e->duration);
+    if (info->ret == RET_OK)
+    {
+      info->ret = render_trace_dump_int(str, "frame", e->frame, FALSE);
+    }
+    if (info->ret == RET_OK)
+    {
+      info->ret = str_append_json_str_pair(str, "name", e->info.widget.name);
+    }
+    if (info->ret == RET_OK)
+    {
+      info->ret = str_append(str, "}}");
+    }
+    break;
+  }
+  default:
+    break;
+  }
+
+  return info->ret == RET_OK ? RET_OK : RET_STOP;
+}
+
+ret_t render_trace_dump(str_t *str)
+{
+  render_trace_dump_ctx_t info;
+  return_value_if_fail(str != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(render_trace_is_started(), RET_BAD_PARAMS);
+
+  memset(&info, 0x00, sizeof(info));
+  info.str = str;
+  info.ret = RET_OK;
+  render_trace_foreach(render_trace_find_base, &(info.base));
+
+  str_set(str, "{\"traceEvents\":[\n");
+  render_trace_foreach(render_trace_dump_event, &info);
+  return_value_if_fail(info.ret == RET_OK, info.ret);
+
+  return str_append(str, "\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+ret_t render_trace_save(const char *filename)
+{
+  str_t str;
+  ret_t ret = RET_OK;
+  return_value_if_fail(filename != NULL, RET_BAD_PARAMS);
+
+  str_init(&str, 4096);
+  ret = render_trace_dump(&str);
+  if (ret == RET_OK)
+  {
+    ret = file_write(filename, str.str, str.size);
+  }
+  str_reset(&str);
+
+  return ret;
+}
+#else
+ret_t render_trace_start(uint32_t capacity, uint32_t min_widget_cost)
+{
+  (void)capacity;
+  (void)min_widget_cost;
+  log_warn("render trace is disabled, please define ENABLE_RENDER_TRACE\n");
+
+  return RET_NOT_IMPL;
+}
+
+ret_t render_trace_stop(void)
+{
+  return RET_OK;
+}
+
+bool_t render_trace_is_started(void)
+{
+  return FALSE;
+}
+
+ret_t render_trace_clear(void)
+{
+  return RET_NOT_IMPL;
+}
+
+ret_t render_trace_frame_begin(void)
+{
+  return RET_NOT_IMPL;
+}
+
+ret_t render_trace_frame_end(void)
+{
+  return RET_NOT_IMPL;
+}
+
+ret_t render_trace_strip_begin(const rect_t *r)
+{
+  (void)r;
+  return RET_NOT_IMPL;
+}
+
+ret_t render_trace_strip_flush_begin(void)
+{
+  return RET_NOT_IMPL;
+}
+
+ret_t render_trace_strip_end(uint32_t visited_widgets, uint32_t painted_widgets)
+{
+  (void)visited_widgets;
+  (void)painted_widgets;
+  return RET_NOT_IMPL;
+}
+
+uint32_t render_trace_widget_begin(const char *type, const char *name)
+{
+  (void)type;
+  (void)name;
+  return 0;
+}
+
+ret_t render_trace_widget_end(uint32_t seq)
+{
+  (void)seq;
+  return RET_NOT_IMPL;
+}
+
+ret_t render_trace_on_draw(render_trace_draw_t draw, render_trace_pixels_t kind, uint32_t pixels)
+{
+  (void)draw;
+  (void)kind;
+  (void)pixels;
+  return RET_NOT_IMPL;
+}
+
+ret_t render_trace_on_glyph_cache_miss(void)
+{
+  return RET_NOT_IMPL;
+}
+
+ret_t render_trace_foreach(tk_visit_t visit, void *ctx)
+{
+  (void)visit;
+  (void)ctx;
+  return RET_NOT_IMPL;
+}
+
+ret_t render_trace_dump(str_t *str)
+{
+  (void)str;
+  return RET_NOT_IMPL;
+}
+
+ret_t render_trace_save(const char *filename)
+{
+  (void)filename;
+  return RET_NOT_IMPL;
+}
+#endif /*ENABLE_RENDER_TRACE*/
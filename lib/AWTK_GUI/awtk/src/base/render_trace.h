@@ -0,0 +1,384 @@
+﻿/**
+ * File:   render_trace.h
+ * Author: AWTK Develop Team
+ * Brief:  per frame/strip render trace
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_RENDER_TRACE_H
+#define TK_RENDER_TRACE_H
+
+#include "../tkc/str.h"
+#include "../tkc/rect.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @enum render_trace_draw_t
+ * @prefix RENDER_TRACE_DRAW_
+ * 绘图调用的类型。
+ */
+typedef enum _render_trace_draw_t
+{
+  /**
+   * @const RENDER_TRACE_DRAW_FILL
+   * fill_rect/clear_rect。
+   */
+  RENDER_TRACE_DRAW_FILL = 0,
+  /**
+   * @const RENDER_TRACE_DRAW_STROKE
+   * draw_hline/draw_vline/draw_points。
+   */
+  RENDER_TRACE_DRAW_STROKE,
+  /**
+   * @const RENDER_TRACE_DRAW_IMAGE
+   * draw_image。
+   */
+  RENDER_TRACE_DRAW_IMAGE,
+  /**
+   * @const RENDER_TRACE_DRAW_GLYPH
+   * draw_glyph。
+   */
+  RENDER_TRACE_DRAW_GLYPH,
+  RENDER_TRACE_DRAW_NR
+} render_trace_draw_t;
+
+/**
+ * @enum render_trace_pixels_t
+ * @prefix RENDER_TRACE_PIXELS_
+ * 像素的处理方式。
+ */
+typedef enum _render_trace_pixels_t
+{
+  /**
+   * @const RENDER_TRACE_PIXELS_FILLED
+   * 直接写入颜色。
+   */
+  RENDER_TRACE_PIXELS_FILLED = 0,
+  /**
+   * @const RENDER_TRACE_PIXELS_BLENDED
+   * 与背景混合。
+   */
+  RENDER_TRACE_PIXELS_BLENDED,
+  /**
+   * @const RENDER_TRACE_PIXELS_COPIED
+   * 从图片直接拷贝。
+   */
+  RENDER_TRACE_PIXELS_COPIED,
+  RENDER_TRACE_PIXELS_NR
+} render_trace_pixels_t;
+
+/**
+ * @enum render_trace_event_type_t
+ * @prefix RENDER_TRACE_EVENT_
+ * 事件类型。
+ */
+typedef enum _render_trace_event_type_t
+{
+  /**
+   * @const RENDER_TRACE_EVENT_FRAME
+   * 一帧。
+   */
+  RENDER_TRACE_EVENT_FRAME = 0,
+  /**
+   * @const RENDER_TRACE_EVENT_STRIP
+   * 一个片段(没有启用片段式FrameBuffer时为整个脏矩形)。
+   */
+  RENDER_TRACE_EVENT_STRIP,
+  /**
+   * @const RENDER_TRACE_EVENT_WIDGET
+   * 一个控件(包括子控件)的绘制。
+   */
+  RENDER_TRACE_EVENT_WIDGET
+} render_trace_event_type_t;
+
+/**
+ * @class render_trace_strip_t
+ * 一个片段的统计信息。
+ */
+typedef struct _render_trace_strip_t
+{
+  /**
+   * @property {rect_t} rect
+   * 片段(脏矩形)的位置和大小。
+   */
+  rect_t rect;
+  /**
+   * @property {uint32_t} visited_widgets
+   * 访问过的控件数。
+   */
+  uint32_t visited_widgets;
+  /**
+   * @property {uint32_t} painted_widgets
+   * 实际绘制的控件数。
+   */
+  uint32_t painted_widgets;
+  /**
+   * @property {uint32_t*} draw_calls
+   * 各类绘图调用的次数(见render_trace_draw_t)。
+   */
+  uint32_t draw_calls[RENDER_TRACE_DRAW_NR];
+  /**
+   * @property {uint32_t*} pixels
+   * 按处理方式统计的像素数(见render_trace_pixels_t)。
+   */
+  uint32_t pixels[RENDER_TRACE_PIXELS_NR];
+  /**
+   * @property {uint32_t} glyph_cache_misses
+   * glyph cache没有命中的次数。
+   */
+  uint32_t glyph_cache_misses;
+  /**
+   * @property {uint32_t} flush_start
+   * 开始刷新到LCD的时间(相对片段开始的时间，微秒)。
+   */
+  uint32_t flush_start;
+  /**
+   * @property {uint32_t} flush_cost
+   * 刷新到LCD的耗时(微秒)。异步传输时只包括提交的时间，等待传输完成的时间计入下一个片段。
+   */
+  uint32_t flush_cost;
+} render_trace_strip_t;
+
+/**
+ * @class render_trace_event_t
+ * 一条trace记录。
+ */
+typedef struct _render_trace_event_t
+{
+  /**
+   * @property {uint8_t} type
+   * 类型(见render_trace_event_type_t)。
+   */
+  uint8_t type;
+  /**
+   * @property {uint32_t} frame
+   * 帧序号。
+   */
+  uint32_t frame;
+  /**
+   * @property {uint64_t} start
+   * 开始时间(微秒)。
+   */
+  uint64_t start;
+  /**
+   * @property {uint32_t} duration
+   * 耗时(微秒)。
+   */
+  uint32_t duration;
+
+  union {
+    render_trace_strip_t strip;
+    struct
+    {
+      const char *type;
+      char name[TK_NAME_LEN + 1];
+    } widget;
+  } info;
+} render_trace_event_t;
+
+/**
+ * @class render_trace_t
+ * @annotation ["fake"]
+ * 绘制过程的trace。
+ *
+ * 记录每一帧、每个片段(FRAGMENT_FRAME_BUFFER_SIZE)和每个控件的绘制耗时，
+ * 以及每个片段的脏矩形、绘图调用次数、填充/混合/拷贝的像素数、glyph cache没有命中的次数和刷新耗时。
+ * 记录保存在环形缓冲区中，满了以后覆盖最早的记录，可以导出为Chrome trace格式的JSON，
+ * 用chrome://tracing或者https://ui.perfetto.dev查看。
+ *
+ * 需要定义宏ENABLE_RENDER_TRACE，并调用render_trace_start开始记录。
+ * 绘图调用和像素的统计由lcd_mem_fragment完成。
+ *
+ * ```c
+ * render_trace_start(1024, 50);
+ * ...
+ * render_trace_save("trace.json");
+ * render_trace_stop();
+ * ```
+ */
+
+/**
+ * @method render_trace_start
+ * 开始记录。
+ * @annotation ["static"]
+ * @param {uint32_t} capacity 环形缓冲区可以保存的记录数。
+ * @param {uint32_t} min_widget_cost 耗时(微秒)小于该值的控件(及其子控件)不记录，为0时全部记录。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_start(uint32_t capacity, uint32_t min_widget_cost);
+
+/**
+ * @method render_trace_stop
+ * 停止记录并释放环形缓冲区。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_stop(void);
+
+/**
+ * @method render_trace_is_started
+ * 检查是否正在记录。
+ * @annotation ["static"]
+ *
+ * @return {bool_t} 返回TRUE表示正在记录。
+ */
+bool_t render_trace_is_started(void);
+
+/**
+ * @method render_trace_clear
+ * 清除已经记录的事件。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_clear(void);
+
+/**
+ * @method render_trace_frame_begin
+ * 一帧开始(由窗口管理器调用)。没有开始记录时直接返回RET_OK。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_frame_begin(void);
+
+/**
+ * @method render_trace_frame_end
+ * 一帧结束(由窗口管理器调用)。没有开始记录时直接返回RET_OK。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_frame_end(void);
+
+/**
+ * @method render_trace_strip_begin
+ * 一个片段开始(由窗口管理器调用)。没有开始记录时直接返回RET_OK。
+ * @annotation ["static"]
+ * @param {const rect_t*} r 片段的位置和大小。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_strip_begin(const rect_t *r);
+
+/**
+ * @method render_trace_strip_flush_begin
+ * 片段开始刷新到LCD(由窗口管理器调用)。没有开始记录时直接返回RET_OK。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_strip_flush_begin(void);
+
+/**
+ * @method render_trace_strip_end
+ * 一个片段结束(由窗口管理器调用)。没有开始记录时直接返回RET_OK。
+ * @annotation ["static"]
+ * @param {uint32_t} visited_widgets 访问过的控件数。
+ * @param {uint32_t} painted_widgets 实际绘制的控件数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_strip_end(uint32_t visited_widgets, uint32_t painted_widgets);
+
+/**
+ * @method render_trace_widget_begin
+ * 开始绘制控件(由widget_paint调用)。
+ * @annotation ["static"]
+ * @param {const char*} type 控件类型(必须是常量字符串)。
+ * @param {const char*} name 控件名称。
+ *
+ * @return {uint32_t} 返回记录的序号，传给render_trace_widget_end。
+ */
+uint32_t render_trace_widget_begin(const char *type, const char *name);
+
+/**
+ * @method render_trace_widget_end
+ * 控件绘制完成(由widget_paint调用)。
+ * @annotation ["static"]
+ * @param {uint32_t} seq render_trace_widget_begin的返回值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_widget_end(uint32_t seq);
+
+/**
+ * @method render_trace_on_draw
+ * 统计一次绘图调用(由LCD调用)。
+ * @annotation ["static"]
+ * @param {render_trace_draw_t} draw 绘图调用的类型。
+ * @param {render_trace_pixels_t} kind 像素的处理方式。
+ * @param {uint32_t} pixels 像素数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_on_draw(render_trace_draw_t draw, render_trace_pixels_t kind, uint32_t pixels);
+
+/**
+ * @method render_trace_on_glyph_cache_miss
+ * 统计一次glyph cache没有命中(由glyph_cache调用)。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_on_glyph_cache_miss(void);
+
+/**
+ * @method render_trace_foreach
+ * 按时间顺序遍历环形缓冲区中的记录。
+ * @annotation ["static"]
+ * @param {tk_visit_t} visit 遍历函数，data参数为render_trace_event_t*，返回RET_STOP时停止遍历。
+ * @param {void*} ctx 遍历函数的上下文。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_foreach(tk_visit_t visit, void *ctx);
+
+/**
+ * @method render_trace_dump
+ * 把环形缓冲区中的记录导出为Chrome trace格式的JSON。
+ * @annotation ["static"]
+ * @param {str_t*} str 用于返回JSON。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_dump(str_t *str);
+
+/**
+ * @method render_trace_save
+ * 把环形缓冲区中的记录导出为Chrome trace格式的JSON文件(一般在PC模拟器上使用)。
+ * @annotation ["static"]
+ * @param {const char*} filename 文件名。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t render_trace_save(const char *filename);
+
+#ifdef ENABLE_RENDER_TRACE
+#define RENDER_TRACE_ON_DRAW(draw, kind, pixels) render_trace_on_draw(draw, kind, pixels)
+#define RENDER_TRACE_ON_GLYPH_CACHE_MISS() render_trace_on_glyph_cache_miss()
+#else
+#define RENDER_TRACE_ON_DRAW(draw, kind, pixels)
+#define RENDER_TRACE_ON_GLYPH_CACHE_MISS()
+#endif /*ENABLE_RENDER_TRACE*/
+
+END_C_DECLS
+
+#endif /*TK_RENDER_TRACE_H*/
@@ -95,7 +95,7 @@ ret_t timer_modify(uint32_t timer_id, uint32_t duration)
   info->duration = duration;
   info->start = timer_manager()->get_time();
 
-  return RET_OK;
+  return timer_manager_update(timer_manager(), info);
 }
 
 uint32_t timer_count(void)
@@ -381,6 +381,10 @@ typedef struct _system_info_t system_info_t;
 #error " TK_GLYPH_CACHE_NR must > 0 "
 #endif
 
+#ifndef TK_GLYPH_CACHE_MAX_BYTES
+#define TK_GLYPH_CACHE_MAX_BYTES 0
+#endif /*TK_GLYPH_CACHE_MAX_BYTES*/
+
 #if defined(WITH_STB_FONT) || defined(WITH_FT_FONT)
 #define WITH_TRUETYPE_FONT 1
 #endif /*WITH_STB_FONT or WITH_FT_FONT*/
@@ -405,6 +409,11 @@ typedef struct _system_info_t system_info_t;
 #undef WITH_UNICODE_BREAK
 #endif /*AWTK_LITE*/
 
+#if defined(FRAGMENT_FRAME_BUFFER_SIZE) && !defined(WITHOUT_WINDOW_ANIMATOR_CACHE)
+/*片段帧缓存放不下整屏的截图，窗口动画按片段直接绘制窗口。*/
+#define WITHOUT_WINDOW_ANIMATOR_CACHE 1
+#endif /*FRAGMENT_FRAME_BUFFER_SIZE*/
+
 #ifdef WITHOUT_WINDOW_ANIMATOR_CACHE
 #define WITHOUT_DIALOG_HIGHLIGHTER 1
 #endif /*WITHOUT_WINDOW_ANIMATOR_CACHE*/
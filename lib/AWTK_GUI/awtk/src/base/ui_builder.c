@@ -36,6 +36,35 @@ ret_t ui_builder_on_widget_prop(ui_builder_t *b, const char *name, const char *v
   return b->on_widget_prop(b, name, value);
 }
 
+ret_t ui_builder_on_widget_prop_value(ui_builder_t *b, const char *name, const value_t *value)
+{
+  char str[64];
+  return_value_if_fail(b != NULL && name != NULL && value != NULL, RET_BAD_PARAMS);
+
+  if (b->on_widget_prop_value != NULL)
+  {
+    return b->on_widget_prop_value(b, name, value);
+  }
+
+  return ui_builder_on_widget_prop(b, name, value_str_ex(value, str, sizeof(str)));
+}
+
+ret_t ui_builder_on_widget_self_layout(ui_builder_t *b, self_layouter_t *layouter)
+{
+  ret_t ret = RET_OK;
+  return_value_if_fail(b != NULL && layouter != NULL, RET_BAD_PARAMS);
+
+  if (b->on_widget_self_layout != NULL)
+  {
+    return b->on_widget_self_layout(b, layouter);
+  }
+
+  ret = ui_builder_on_widget_prop(b, WIDGET_PROP_SELF_LAYOUT, self_layouter_to_string(layouter));
+  self_layouter_destroy(layouter);
+
+  return ret;
+}
+
 ret_t ui_builder_on_widget_prop_end(ui_builder_t *b)
 {
   return_value_if_fail(b != NULL && b->on_widget_prop_end != NULL, RET_BAD_PARAMS);
@@ -39,6 +39,9 @@ typedef struct _widget_desc_t
 typedef ret_t (*ui_builder_on_start_t)(ui_builder_t *b);
 typedef ret_t (*ui_builder_on_widget_start_t)(ui_builder_t *b, const widget_desc_t *desc);
 typedef ret_t (*ui_builder_on_widget_prop_t)(ui_builder_t *b, const char *name, const char *value);
+typedef ret_t (*ui_builder_on_widget_prop_value_t)(ui_builder_t *b, const char *name,
+                                                   const value_t *value);
+typedef ret_t (*ui_builder_on_widget_self_layout_t)(ui_builder_t *b, self_layouter_t *layouter);
 typedef ret_t (*ui_builder_on_widget_prop_end_t)(ui_builder_t *b);
 typedef ret_t (*ui_builder_on_widget_end_t)(ui_builder_t *b);
 typedef ret_t (*ui_builder_on_end_t)(ui_builder_t *b);
@@ -70,6 +73,8 @@ struct _ui_builder_t
   ui_builder_on_start_t on_start;
   ui_builder_on_widget_start_t on_widget_start;
   ui_builder_on_widget_prop_t on_widget_prop;
+  ui_builder_on_widget_prop_value_t on_widget_prop_value;
+  ui_builder_on_widget_self_layout_t on_widget_self_layout;
   ui_builder_on_widget_prop_end_t on_widget_prop_end;
   ui_builder_on_widget_end_t on_widget_end;
   ui_builder_on_end_t on_end;
@@ -104,6 +109,37 @@ ret_t ui_builder_on_widget_start(ui_builder_t *builder, const widget_desc_t *des
  */
 ret_t ui_builder_on_widget_prop(ui_builder_t *builder, const char *name, const char *value);
 
+/**
+ * @method ui_builder_on_widget_prop_value
+ * ui\_loader在解析到已经带类型的widget属性时，调用本函数进一步处理。
+ *
+ * > builder没有实现on\_widget\_prop\_value时，把属性值转换成字符串后调用on\_widget\_prop。
+ *
+ * @param {ui_builder_t*} builder builder对象。
+ * @param {const char*} name 属性名。
+ * @param {const value_t*} value 属性值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ *
+ */
+ret_t ui_builder_on_widget_prop_value(ui_builder_t *builder, const char *name,
+                                      const value_t *value);
+
+/**
+ * @method ui_builder_on_widget_self_layout
+ * ui\_loader在解析到已经预先解析好的self\_layout属性时，调用本函数进一步处理。
+ *
+ * > builder接管layouter的所有权。builder没有实现on\_widget\_self\_layout时，
+ * > 把layouter转换成字符串后调用on\_widget\_prop，然后销毁layouter。
+ *
+ * @param {ui_builder_t*} builder builder对象。
+ * @param {self_layouter_t*} layouter 布局器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ *
+ */
+ret_t ui_builder_on_widget_self_layout(ui_builder_t *builder, self_layouter_t *layouter);
+
 /**
  * @method ui_builder_on_widget_prop_end
  * ui\_loader在解析到widget全部属性结束时，调用本函数进一步处理。
@@ -161,6 +197,9 @@ ret_t ui_builder_destroy(ui_builder_t *builder);
 
 #define UI_DATA_MAGIC 0x11221212
 
+/*类型名/属性名驻留为字符串表的下标、属性值预先转换为对应类型的UI数据(见ui_binary_writer)*/
+#define UI_DATA_MAGIC_V2 0x11221213
+
 END_C_DECLS
 
 #endif /*TK_UI_BUILDER_H*/
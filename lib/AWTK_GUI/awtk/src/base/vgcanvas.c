@@ -593,6 +593,19 @@ ret_t vgcanvas_reinit(vgcanvas_t *vg, uint32_t w, uint32_t h, uint32_t stride,
   return RET_NOT_IMPL;
 }
 
+ret_t vgcanvas_bind_fragment(vgcanvas_t *vg, const rect_t *r, uint32_t stride,
+                             bitmap_format_t format, void *data)
+{
+  return_value_if_fail(vg != NULL && r != NULL && data != NULL, RET_BAD_PARAMS);
+
+  if (vg->vt->bind_fragment != NULL)
+  {
+    return vg->vt->bind_fragment(vg, r, stride, format, data);
+  }
+
+  return RET_NOT_IMPL;
+}
+
 vgcanvas_t *vgcanvas_cast(vgcanvas_t *vg)
 {
   return vg;
@@ -50,6 +50,8 @@ typedef struct _vgcanvas_t vgcanvas_t;
 
 typedef ret_t (*vgcanvas_reinit_t)(vgcanvas_t *vg, uint32_t w, uint32_t h, uint32_t stride,
                                    bitmap_format_t format, void *data);
+typedef ret_t (*vgcanvas_bind_fragment_t)(vgcanvas_t *vg, const rect_t *r, uint32_t stride,
+                                          bitmap_format_t format, void *data);
 typedef ret_t (*vgcanvas_begin_frame_t)(vgcanvas_t *vg, const dirty_rects_t *dirty_rects);
 typedef ret_t (*vgcanvas_end_frame_t)(vgcanvas_t *vg);
 
@@ -161,6 +163,7 @@ typedef ret_t (*vgcanvas_destroy_t)(vgcanvas_t *vg);
 typedef struct _vgcanvas_vtable_t
 {
   vgcanvas_reinit_t reinit;
+  vgcanvas_bind_fragment_t bind_fragment;
 
   vgcanvas_begin_frame_t begin_frame;
   vgcanvas_set_assets_manager_t set_assets_manager;
@@ -455,6 +458,23 @@ vgcanvas_t *vgcanvas_cast(vgcanvas_t *vg);
 ret_t vgcanvas_reinit(vgcanvas_t *vg, uint32_t w, uint32_t h, uint32_t stride,
                       bitmap_format_t format, void *data);
 
+/**
+ * @method vgcanvas_bind_fragment
+ * 绑定到片段帧缓存的当前片段，系统内部调用。
+ *
+ * > 画布的大小和坐标不变，data只保存画布上r区域的像素，r以外的扫描线不会被光栅化。
+ *
+ * @param {vgcanvas_t*} vg vgcanvas对象。
+ * @param {const rect_t*} r 片段在画布上的区域。
+ * @param {uint32_t} stride 片段一行占用的字节数。
+ * @param {bitmap_format_t} format data的格式。
+ * @param {void*} data 片段的framebuffer。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t vgcanvas_bind_fragment(vgcanvas_t *vg, const rect_t *r, uint32_t stride,
+                             bitmap_format_t format, void *data);
+
 /**
  * @method vgcanvas_reset
  * 重置所有状态。
@@ -24,6 +24,7 @@
 #include "../tkc/utils.h"
 #include "../tkc/fscript.h"
 #include "../tkc/tokenizer.h"
+#include "../tkc/str_intern.h"
 #include "../tkc/color_parser.h"
 #include "../tkc/object_default.h"
 
@@ -40,12 +41,14 @@
 #include "system_info.h"
 #include "window_manager.h"
 #include "widget_vtable.h"
+#include "widget_prop_ids.h"
 #include "style_mutable.h"
 #include "style_factory.h"
 #include "widget_animator_manager.h"
 #include "widget_animator_factory.h"
 #include "window_base.h"
 #include "assets_manager.h"
+#include "render_trace.h"
 #include "../blend/image_g2d.h"
 
 ret_t widget_focus_up(widget_t *widget);
@@ -168,8 +171,112 @@ ret_t widget_update_style(widget_t *widget)
   return RET_OK;
 }
 
+/*name/state/style/animation/pointer_cursor 都是驻留字符串(见str_intern.h)*/
+static ret_t widget_str_reset(char **str)
+{
+  if (*str != NULL)
+  {
+    tk_str_intern_unref(*str);
+    *str = NULL;
+  }
+
+  return RET_OK;
+}
+
+#ifdef WITH_WIDGET_POOL
+#include "../tkc/mem_slab.h"
+
+#ifndef TK_WIDGET_POOL_MAX_SIZE
+#define TK_WIDGET_POOL_MAX_SIZE 512
+#endif /*TK_WIDGET_POOL_MAX_SIZE*/
+
+#ifndef TK_WIDGET_POOL_BLOCK_NR
+#define TK_WIDGET_POOL_BLOCK_NR 8
+#endif /*TK_WIDGET_POOL_BLOCK_NR*/
+
+#define WIDGET_POOL_STEP 32
+#define WIDGET_POOL_SLAB_NR (TK_WIDGET_POOL_MAX_SIZE / WIDGET_POOL_STEP)
+
+/*按vt->size以32字节为步长分档，每档一个slab，超过TK_WIDGET_POOL_MAX_SIZE的控件直接从堆分配*/
+static mem_slab_t s_widget_slabs[WIDGET_POOL_SLAB_NR];
+
+static mem_slab_t *widget_pool_get_slab(uint32_t size)
+{
+  mem_slab_t *slab = NULL;
+  uint32_t index = (size + WIDGET_POOL_STEP - 1) / WIDGET_POOL_STEP;
+
+  if (index == 0 || index > WIDGET_POOL_SLAB_NR)
+  {
+    return NULL;
+  }
+
+  slab = s_widget_slabs + index - 1;
+  if (slab->block_size == 0)
+  {
+    mem_slab_init(slab, index * WIDGET_POOL_STEP, TK_WIDGET_POOL_BLOCK_NR);
+  }
+
+  return slab;
+}
+
+static widget_t *widget_pool_alloc(uint32_t size)
+{
+  mem_slab_t *slab = widget_pool_get_slab(size);
+
+  return slab != NULL ? (widget_t *)mem_slab_alloc(slab) : (widget_t *)TKMEM_ALLOC(size);
+}
+
+static ret_t widget_pool_free(widget_t *widget, uint32_t size)
+{
+  mem_slab_t *slab = widget_pool_get_slab(size);
+
+  /*window_manager等不是由widget_create分配的控件，不在slab中*/
+  if (slab == NULL || mem_slab_free(slab, widget) != RET_OK)
+  {
+    TKMEM_FREE(widget);
+  }
+
+  return RET_OK;
+}
+
+ret_t widget_pool_trim(void)
+{
+  uint32_t i = 0;
+
+  for (i = 0; i < WIDGET_POOL_SLAB_NR; i++)
+  {
+    if (s_widget_slabs[i].block_size > 0)
+    {
+      mem_slab_trim(s_widget_slabs + i);
+    }
+  }
+
+  return emitter_pool_trim();
+}
+#else
+static widget_t *widget_pool_alloc(uint32_t size)
+{
+  return (widget_t *)TKMEM_ALLOC(size);
+}
+
+static ret_t widget_pool_free(widget_t *widget, uint32_t size)
+{
+  (void)size;
+  TKMEM_FREE(widget);
+
+  return RET_OK;
+}
+
+ret_t widget_pool_trim(void)
+{
+  return RET_OK;
+}
+#endif /*WITH_WIDGET_POOL*/
+
 static ret_t widget_real_destroy(widget_t *widget)
 {
+  uint32_t size = widget->vt->size;
+  bool_t is_window = widget->vt->is_window;
   ENSURE(widget->ref_count == 1);
 
   if (widget->vt->on_destroy)
@@ -177,25 +284,31 @@ static ret_t widget_real_destroy(widget_t *widget)
     widget->vt->on_destroy(widget);
   }
 
-  TKMEM_FREE(widget->name);
-  TKMEM_FREE(widget->state);
-  TKMEM_FREE(widget->style);
+  widget_str_reset(&(widget->name));
+  widget_str_reset(&(widget->state));
+  widget_str_reset(&(widget->style));
   TKMEM_FREE(widget->tr_text);
-  TKMEM_FREE(widget->animation);
-  TKMEM_FREE(widget->pointer_cursor);
+  widget_str_reset(&(widget->animation));
+  widget_str_reset(&(widget->pointer_cursor));
   TK_OBJECT_UNREF(widget->custom_props);
   wstr_reset(&(widget->text));
   style_destroy(widget->astyle);
 
   memset(widget, 0x00, sizeof(widget_t));
-  TKMEM_FREE(widget);
+  widget_pool_free(widget, size);
+
+  /*窗口和它的子控件都已经释放，把空出来的chunk还给堆*/
+  if (is_window)
+  {
+    widget_pool_trim();
+  }
 
   return RET_OK;
 }
 
 static widget_t *widget_real_create(const widget_vtable_t *vt)
 {
-  widget_t *widget = TKMEM_ALLOC(vt->size);
+  widget_t *widget = widget_pool_alloc(vt->size);
   return_value_if_fail(widget != NULL, NULL);
 
   memset(widget, 0x00, vt->size);
@@ -493,7 +606,7 @@ ret_t widget_use_style(widget_t *widget, const char *value)
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
   widget_set_need_update_style(widget);
-  widget->style = tk_str_copy(widget->style, value);
+  widget->style = tk_str_intern_copy(widget->style, value);
 
   if (widget_is_window_opened(widget))
   {
@@ -776,11 +889,11 @@ ret_t widget_set_name(widget_t *widget, const char *name)
 
   if (name != NULL)
   {
-    widget->name = tk_str_copy(widget->name, name);
+    widget->name = tk_str_intern_copy(widget->name, name);
   }
   else
   {
-    TKMEM_FREE(widget->name);
+    widget_str_reset(&(widget->name));
   }
 
   return RET_OK;
@@ -839,7 +952,7 @@ ret_t widget_set_pointer_cursor(widget_t *widget, const char *cursor)
 
   if (!tk_str_eq(widget->pointer_cursor, cursor))
   {
-    widget->pointer_cursor = tk_str_copy(widget->pointer_cursor, cursor);
+    widget->pointer_cursor = tk_str_intern_copy(widget->pointer_cursor, cursor);
     widget_update_pointer_cursor(widget);
   }
 
@@ -851,7 +964,7 @@ ret_t widget_set_animation(widget_t *widget, const char *animation)
 {
   return_value_if_fail(widget != NULL && animation != NULL, RET_BAD_PARAMS);
 
-  widget->animation = tk_str_copy(widget->animation, animation);
+  widget->animation = tk_str_intern_copy(widget->animation, animation);
 
   return widget_create_animator(widget, animation);
 }
@@ -1051,7 +1164,7 @@ ret_t widget_set_state(widget_t *widget, const char *state)
   if (!tk_str_eq(widget->state, state))
   {
     widget_invalidate_force(widget, NULL);
-    widget->state = tk_str_copy(widget->state, state);
+    widget->state = tk_str_intern_copy(widget->state, state);
     widget_set_need_update_style(widget);
     widget_invalidate_force(widget, NULL);
   }
@@ -1705,6 +1818,9 @@ uint32_t widget_on_with_tag(widget_t *widget, uint32_t type, event_func_t on_eve
   if (widget->emitter == NULL)
   {
     widget->emitter = emitter_create();
+    return_value_if_fail(widget->emitter != NULL, TK_INVALID_ID);
+    /*控件只在GUI线程中注册/注销事件，回调项可以从内存池中分配*/
+    widget->emitter->pooled = TRUE;
   }
 
   return emitter_on_with_tag(widget->emitter, type, on_event, ctx, tag);
@@ -2227,9 +2343,19 @@ ret_t widget_paint(widget_t *widget, canvas_t *c)
     widget_update_style(widget);
   }
 
+#ifdef ENABLE_RENDER_TRACE
+  {
+    uint32_t seq = render_trace_widget_begin(widget->vt->type, widget->name);
+    canvas_save(c);
+    widget_paint_impl(widget, c);
+    canvas_restore(c);
+    render_trace_widget_end(seq);
+  }
+#else
   canvas_save(c);
   widget_paint_impl(widget, c);
   canvas_restore(c);
+#endif /*ENABLE_RENDER_TRACE*/
 
   widget->dirty = FALSE;
 
@@ -2533,10 +2659,13 @@ ret_t widget_set_prop(widget_t *widget, const char *name, const value_t *v)
 {
   ret_t ret = RET_OK;
   prop_change_event_t e;
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
   return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
   return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_EXEC))
+  id = widget_prop_id(name);
+
+  if (id == WIDGET_PROP_ID_EXEC)
   {
     ret = widget_exec(widget, value_str(v));
     if (ret != RET_NOT_FOUND)
@@ -2550,88 +2679,88 @@ ret_t widget_set_prop(widget_t *widget, const char *name, const value_t *v)
   e.e = event_init(EVT_PROP_WILL_CHANGE, widget);
   widget_dispatch(widget, (event_t *)&e);
 
-  if (tk_str_eq(name, WIDGET_PROP_X))
+  if (id == WIDGET_PROP_ID_X)
   {
     widget_set_x(widget, (xy_t)value_int(v), TRUE);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_Y))
+  else if (id == WIDGET_PROP_ID_Y)
   {
     widget_set_y(widget, (xy_t)value_int(v), TRUE);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_W))
+  else if (id == WIDGET_PROP_ID_W)
   {
     widget_set_w(widget, (wh_t)value_int(v), TRUE);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_H))
+  else if (id == WIDGET_PROP_ID_H)
   {
     widget_set_h(widget, (wh_t)value_int(v), TRUE);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_OPACITY))
+  else if (id == WIDGET_PROP_ID_OPACITY)
   {
     widget->opacity = (uint8_t)value_int(v);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_VISIBLE))
+  else if (id == WIDGET_PROP_ID_VISIBLE)
   {
     widget_set_visible(widget, value_bool(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_SENSITIVE))
+  else if (id == WIDGET_PROP_ID_SENSITIVE)
   {
     widget->sensitive = value_bool(v);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_FLOATING))
+  else if (id == WIDGET_PROP_ID_FLOATING)
   {
     widget->floating = value_bool(v);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_FOCUSABLE))
+  else if (id == WIDGET_PROP_ID_FOCUSABLE)
   {
     widget->focusable = value_bool(v);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_WITH_FOCUS_STATE))
+  else if (id == WIDGET_PROP_ID_WITH_FOCUS_STATE)
   {
     widget->with_focus_state = value_bool(v);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_DIRTY_RECT_TOLERANCE))
+  else if (id == WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE)
   {
     widget->dirty_rect_tolerance = value_int(v);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_STYLE))
+  else if (id == WIDGET_PROP_ID_STYLE)
   {
     const char *name = value_str(v);
     return widget_use_style(widget, name);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_ENABLE))
+  else if (id == WIDGET_PROP_ID_ENABLE)
   {
     widget_set_enable(widget, value_bool(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_FEEDBACK))
+  else if (id == WIDGET_PROP_ID_FEEDBACK)
   {
     widget->feedback = value_bool(v);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_AUTO_ADJUST_SIZE))
+  else if (id == WIDGET_PROP_ID_AUTO_ADJUST_SIZE)
   {
     widget_set_auto_adjust_size(widget, value_bool(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_NAME))
+  else if (id == WIDGET_PROP_ID_NAME)
   {
     widget_set_name(widget, value_str(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_TR_TEXT))
+  else if (id == WIDGET_PROP_ID_TR_TEXT)
   {
     widget_set_tr_text(widget, value_str(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_ANIMATION))
+  else if (id == WIDGET_PROP_ID_ANIMATION)
   {
     widget_set_animation(widget, value_str(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_SELF_LAYOUT))
+  else if (id == WIDGET_PROP_ID_SELF_LAYOUT)
   {
     widget_set_self_layout(widget, value_str(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_LAYOUT) || tk_str_eq(name, WIDGET_PROP_CHILDREN_LAYOUT))
+  else if (id == WIDGET_PROP_ID_LAYOUT || id == WIDGET_PROP_ID_CHILDREN_LAYOUT)
   {
     widget_set_children_layout(widget, value_str(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_POINTER_CURSOR))
+  else if (id == WIDGET_PROP_ID_POINTER_CURSOR)
   {
     widget_set_pointer_cursor(widget, value_str(v));
   }
@@ -2662,17 +2791,17 @@ ret_t widget_set_prop(widget_t *widget, const char *name, const value_t *v)
 
   if (ret == RET_NOT_FOUND)
   {
-    if (tk_str_eq(name, WIDGET_PROP_FOCUSED) || tk_str_eq(name, WIDGET_PROP_FOCUS))
+    if (id == WIDGET_PROP_ID_FOCUSED || id == WIDGET_PROP_ID_FOCUS)
     {
       widget_set_focused(widget, value_bool(v));
       ret = RET_OK;
     }
-    else if (tk_str_eq(name, WIDGET_PROP_TEXT))
+    else if (id == WIDGET_PROP_ID_TEXT)
     {
       wstr_from_value(&(widget->text), v);
       ret = RET_OK;
     }
-    else if (tk_str_eq(name, WIDGET_PROP_EXEC))
+    else if (id == WIDGET_PROP_ID_EXEC)
     {
       ret = RET_NOT_FOUND;
     }
@@ -2687,7 +2816,7 @@ ret_t widget_set_prop(widget_t *widget, const char *name, const value_t *v)
         widget->custom_props = object_default_create();
       }
 
-      if (tk_str_eq(name, WIDGET_PROP_GRAB_KEYS))
+      if (id == WIDGET_PROP_ID_GRAB_KEYS)
       {
         window_manager_t *wm = WINDOW_MANAGER(widget_get_window_manager(widget));
 
@@ -2764,90 +2893,93 @@ ret_t widget_set_prop(widget_t *widget, const char *name, const value_t *v)
 ret_t widget_get_prop(widget_t *widget, const char *name, value_t *v)
 {
   ret_t ret = RET_OK;
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
   return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
   return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_X))
+  id = widget_prop_id(name);
+
+  if (id == WIDGET_PROP_ID_X)
   {
     value_set_int32(v, widget->x);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_Y))
+  else if (id == WIDGET_PROP_ID_Y)
   {
     value_set_int32(v, widget->y);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_W))
+  else if (id == WIDGET_PROP_ID_W)
   {
     value_set_int32(v, widget->w);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_H))
+  else if (id == WIDGET_PROP_ID_H)
   {
     value_set_int32(v, widget->h);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_OPACITY))
+  else if (id == WIDGET_PROP_ID_OPACITY)
   {
     value_set_int32(v, widget->opacity);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_VISIBLE))
+  else if (id == WIDGET_PROP_ID_VISIBLE)
   {
     value_set_bool(v, widget->visible);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_SENSITIVE))
+  else if (id == WIDGET_PROP_ID_SENSITIVE)
   {
     value_set_bool(v, widget->sensitive);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_FLOATING))
+  else if (id == WIDGET_PROP_ID_FLOATING)
   {
     value_set_bool(v, widget->floating);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_FOCUSABLE))
+  else if (id == WIDGET_PROP_ID_FOCUSABLE)
   {
     value_set_bool(v, widget_is_focusable(widget));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_FOCUSED))
+  else if (id == WIDGET_PROP_ID_FOCUSED)
   {
     value_set_bool(v, widget->focused);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_WITH_FOCUS_STATE))
+  else if (id == WIDGET_PROP_ID_WITH_FOCUS_STATE)
   {
     value_set_bool(v, widget->with_focus_state);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_DIRTY_RECT_TOLERANCE))
+  else if (id == WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE)
   {
     value_set_int(v, widget->dirty_rect_tolerance);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_STYLE))
+  else if (id == WIDGET_PROP_ID_STYLE)
   {
     value_set_str(v, widget->style);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_ENABLE))
+  else if (id == WIDGET_PROP_ID_ENABLE)
   {
     value_set_bool(v, widget->enable);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_FEEDBACK))
+  else if (id == WIDGET_PROP_ID_FEEDBACK)
   {
     value_set_bool(v, widget->feedback);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_AUTO_ADJUST_SIZE))
+  else if (id == WIDGET_PROP_ID_AUTO_ADJUST_SIZE)
   {
     value_set_bool(v, widget->auto_adjust_size);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_NAME))
+  else if (id == WIDGET_PROP_ID_NAME)
   {
     value_set_str(v, widget->name);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_ANIMATION))
+  else if (id == WIDGET_PROP_ID_ANIMATION)
   {
     value_set_str(v, widget->animation);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_POINTER_CURSOR))
+  else if (id == WIDGET_PROP_ID_POINTER_CURSOR)
   {
     value_set_str(v, widget->pointer_cursor);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_LOADING))
+  else if (id == WIDGET_PROP_ID_LOADING)
   {
     value_set_bool(v, widget->loading);
   }
-  else if (tk_str_eq(name, WIDGET_PROP_SELF_LAYOUT))
+  else if (id == WIDGET_PROP_ID_SELF_LAYOUT)
   {
     if (widget->self_layout != NULL)
     {
@@ -2858,7 +2990,7 @@ ret_t widget_get_prop(widget_t *widget, const char *name, value_t *v)
       ret = RET_NOT_FOUND;
     }
   }
-  else if (tk_str_eq(name, WIDGET_PROP_CHILDREN_LAYOUT))
+  else if (id == WIDGET_PROP_ID_CHILDREN_LAYOUT)
   {
     if (widget->children_layout != NULL)
     {
@@ -2884,22 +3016,22 @@ ret_t widget_get_prop(widget_t *widget, const char *name, value_t *v)
   /*default*/
   if (ret == RET_NOT_FOUND)
   {
-    if (tk_str_eq(name, WIDGET_PROP_LAYOUT_W))
+    if (id == WIDGET_PROP_ID_LAYOUT_W)
     {
       value_set_int32(v, widget->w);
       ret = RET_OK;
     }
-    else if (tk_str_eq(name, WIDGET_PROP_LAYOUT_H))
+    else if (id == WIDGET_PROP_ID_LAYOUT_H)
     {
       value_set_int32(v, widget->h);
       ret = RET_OK;
     }
-    else if (tk_str_eq(name, WIDGET_PROP_TR_TEXT))
+    else if (id == WIDGET_PROP_ID_TR_TEXT)
     {
       value_set_str(v, widget->tr_text);
       ret = RET_OK;
     }
-    else if (tk_str_eq(name, WIDGET_PROP_TEXT))
+    else if (id == WIDGET_PROP_ID_TEXT)
     {
       wchar_t *text = widget->text.str;
       if (text != NULL)
@@ -2909,7 +3041,7 @@ ret_t widget_get_prop(widget_t *widget, const char *name, value_t *v)
       value_set_wstr(v, text);
       ret = RET_OK;
     }
-    else if (tk_str_eq(name, WIDGET_PROP_STATE_FOR_STYLE))
+    else if (id == WIDGET_PROP_ID_STATE_FOR_STYLE)
     {
       value_set_str(v, widget_get_state_for_style(widget, FALSE, FALSE));
       ret = RET_OK;
@@ -2926,7 +3058,7 @@ ret_t widget_get_prop(widget_t *widget, const char *name, value_t *v)
 
   if (ret == RET_NOT_FOUND)
   {
-    if (tk_str_eq(name, WIDGET_PROP_TYPE))
+    if (id == WIDGET_PROP_ID_TYPE)
     {
       value_set_str(v, widget->vt->type);
       ret = RET_OK;
@@ -4427,7 +4559,7 @@ widget_t *widget_init(widget_t *widget, widget_t *parent, const widget_vtable_t
   widget->emitter = NULL;
   widget->children = NULL;
   widget->initializing = TRUE;
-  widget->state = tk_strdup(WIDGET_STATE_NORMAL);
+  widget->state = tk_str_intern_ref(WIDGET_STATE_NORMAL);
   widget->target = NULL;
   widget->key_target = NULL;
   widget->grab_widget = NULL;
@@ -4767,9 +4899,9 @@ const char *const *widget_get_persistent_props(void)
 
 static ret_t widget_copy_base_props(widget_t *widget, widget_t *other)
 {
-  widget->state = tk_str_copy(widget->state, other->state);
-  widget->name = tk_str_copy(widget->name, other->name);
-  widget->style = tk_str_copy(widget->style, other->style);
+  widget->state = tk_str_intern_copy(widget->state, other->state);
+  widget->name = tk_str_intern_copy(widget->name, other->name);
+  widget->style = tk_str_intern_copy(widget->style, other->style);
 
   if (other->text.str != NULL)
   {
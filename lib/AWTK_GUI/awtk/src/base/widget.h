@@ -2478,6 +2478,16 @@ ret_t widget_destroy(widget_t *widget);
  */
 ret_t widget_destroy_async(widget_t *widget);
 
+/**
+ * @method widget_pool_trim
+ * 把控件和事件处理项内存池中全部空闲的chunk归还给堆(没有定义WITH_WIDGET_POOL时什么也不做)。
+ *
+ * > 关闭窗口(窗口销毁)后和内存不足时自动调用，一般无需直接调用。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_pool_trim(void);
+
 /**
  * @method widget_ref
  * 增加控件的引用计数。
@@ -2836,6 +2846,17 @@ ret_t widget_layout_children(widget_t *widget);
  */
 ret_t widget_set_self_layout(widget_t *widget, const char *params);
 
+/**
+ * @method widget_set_self_layouter
+ * 直接设置控件自己的布局器(用于加载预先解析好布局参数的UI数据)。
+ * > 控件接管 layouter 的所有权。
+ * @param {widget_t*} widget 控件对象。
+ * @param {self_layouter_t*} layouter 布局器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_set_self_layouter(widget_t *widget, self_layouter_t *layouter);
+
 /**
  * @method widget_set_children_layout
  * 设置子控件的布局参数。
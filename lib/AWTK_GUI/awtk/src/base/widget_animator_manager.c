@@ -99,17 +99,36 @@ static ret_t widget_animator_manager_on_timer(const timer_info_t *info)
 
   widget_animator_manager_time_elapse(am, elapsed_time);
 
+  if (am->first == NULL)
+  {
+    /*没有动画时停止定时器，避免空闲时主循环被周期性地唤醒*/
+    am->timer_id = TK_INVALID_ID;
+    am->last_dispatch_time = 0;
+
+    return RET_REMOVE;
+  }
+
   am->last_dispatch_time = info->now;
 
   return RET_REPEAT;
 }
 
+static ret_t widget_animator_manager_start_timer(widget_animator_manager_t *am)
+{
+  if (am->timer_id == TK_INVALID_ID)
+  {
+    am->timer_id = timer_add(widget_animator_manager_on_timer, am, TK_MAX_SLEEP_TIME);
+  }
+
+  return RET_OK;
+}
+
 widget_animator_manager_t *widget_animator_manager_init(widget_animator_manager_t *am)
 {
   return_value_if_fail(am != NULL, NULL);
 
   am->time_scale = 1;
-  am->timer_id = timer_add(widget_animator_manager_on_timer, am, TK_MAX_SLEEP_TIME);
+  am->timer_id = TK_INVALID_ID;
 
   return am;
 }
@@ -136,7 +155,11 @@ ret_t widget_animator_manager_deinit(widget_animator_manager_t *am)
 {
   return_value_if_fail(am != NULL, RET_BAD_PARAMS);
 
-  timer_remove(am->timer_id);
+  if (am->timer_id != TK_INVALID_ID)
+  {
+    timer_remove(am->timer_id);
+    am->timer_id = TK_INVALID_ID;
+  }
 
   return RET_OK;
 }
@@ -172,7 +195,7 @@ ret_t widget_animator_manager_add(widget_animator_manager_t *am, widget_animator
   }
   animator->widget_animator_manager = am;
 
-  return RET_OK;
+  return widget_animator_manager_start_timer(am);
 }
 
 ret_t widget_animator_manager_remove(widget_animator_manager_t *am, widget_animator_t *animator)
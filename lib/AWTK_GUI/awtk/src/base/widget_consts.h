@@ -1067,6 +1067,278 @@ BEGIN_C_DECLS
  */
 #define WIDGET_PROP_ANIMATE_ANIMATING_TIME "animate:animating_time"
 
+/**
+ * @enum widget_prop_id_t
+ * @prefix WIDGET_PROP_ID_
+ * 常用属性名对应的整数ID。
+ *
+ * > widget_prop_id 把属性名转换为ID(一次哈希和一次字符串比较)，
+ * > widget 和常用控件的 get_prop/set_prop 按ID分发，不再逐个比较属性名。
+ */
+typedef enum _widget_prop_id_t
+{
+  /**
+   * @const WIDGET_PROP_ID_NONE
+   * 不是常用属性。
+   */
+  WIDGET_PROP_ID_NONE = 0,
+  /**
+   * @const WIDGET_PROP_ID_X
+   * WIDGET_PROP_X的ID。
+   */
+  WIDGET_PROP_ID_X,
+  /**
+   * @const WIDGET_PROP_ID_Y
+   * WIDGET_PROP_Y的ID。
+   */
+  WIDGET_PROP_ID_Y,
+  /**
+   * @const WIDGET_PROP_ID_W
+   * WIDGET_PROP_W的ID。
+   */
+  WIDGET_PROP_ID_W,
+  /**
+   * @const WIDGET_PROP_ID_H
+   * WIDGET_PROP_H的ID。
+   */
+  WIDGET_PROP_ID_H,
+  /**
+   * @const WIDGET_PROP_ID_OPACITY
+   * WIDGET_PROP_OPACITY的ID。
+   */
+  WIDGET_PROP_ID_OPACITY,
+  /**
+   * @const WIDGET_PROP_ID_VISIBLE
+   * WIDGET_PROP_VISIBLE的ID。
+   */
+  WIDGET_PROP_ID_VISIBLE,
+  /**
+   * @const WIDGET_PROP_ID_SENSITIVE
+   * WIDGET_PROP_SENSITIVE的ID。
+   */
+  WIDGET_PROP_ID_SENSITIVE,
+  /**
+   * @const WIDGET_PROP_ID_FLOATING
+   * WIDGET_PROP_FLOATING的ID。
+   */
+  WIDGET_PROP_ID_FLOATING,
+  /**
+   * @const WIDGET_PROP_ID_FOCUSABLE
+   * WIDGET_PROP_FOCUSABLE的ID。
+   */
+  WIDGET_PROP_ID_FOCUSABLE,
+  /**
+   * @const WIDGET_PROP_ID_FOCUSED
+   * WIDGET_PROP_FOCUSED的ID。
+   */
+  WIDGET_PROP_ID_FOCUSED,
+  /**
+   * @const WIDGET_PROP_ID_FOCUS
+   * WIDGET_PROP_FOCUS的ID。
+   */
+  WIDGET_PROP_ID_FOCUS,
+  /**
+   * @const WIDGET_PROP_ID_WITH_FOCUS_STATE
+   * WIDGET_PROP_WITH_FOCUS_STATE的ID。
+   */
+  WIDGET_PROP_ID_WITH_FOCUS_STATE,
+  /**
+   * @const WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE
+   * WIDGET_PROP_DIRTY_RECT_TOLERANCE的ID。
+   */
+  WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE,
+  /**
+   * @const WIDGET_PROP_ID_STYLE
+   * WIDGET_PROP_STYLE的ID。
+   */
+  WIDGET_PROP_ID_STYLE,
+  /**
+   * @const WIDGET_PROP_ID_ENABLE
+   * WIDGET_PROP_ENABLE的ID。
+   */
+  WIDGET_PROP_ID_ENABLE,
+  /**
+   * @const WIDGET_PROP_ID_FEEDBACK
+   * WIDGET_PROP_FEEDBACK的ID。
+   */
+  WIDGET_PROP_ID_FEEDBACK,
+  /**
+   * @const WIDGET_PROP_ID_AUTO_ADJUST_SIZE
+   * WIDGET_PROP_AUTO_ADJUST_SIZE的ID。
+   */
+  WIDGET_PROP_ID_AUTO_ADJUST_SIZE,
+  /**
+   * @const WIDGET_PROP_ID_NAME
+   * WIDGET_PROP_NAME的ID。
+   */
+  WIDGET_PROP_ID_NAME,
+  /**
+   * @const WIDGET_PROP_ID_TYPE
+   * WIDGET_PROP_TYPE的ID。
+   */
+  WIDGET_PROP_ID_TYPE,
+  /**
+   * @const WIDGET_PROP_ID_TEXT
+   * WIDGET_PROP_TEXT的ID。
+   */
+  WIDGET_PROP_ID_TEXT,
+  /**
+   * @const WIDGET_PROP_ID_TR_TEXT
+   * WIDGET_PROP_TR_TEXT的ID。
+   */
+  WIDGET_PROP_ID_TR_TEXT,
+  /**
+   * @const WIDGET_PROP_ID_ANIMATION
+   * WIDGET_PROP_ANIMATION的ID。
+   */
+  WIDGET_PROP_ID_ANIMATION,
+  /**
+   * @const WIDGET_PROP_ID_POINTER_CURSOR
+   * WIDGET_PROP_POINTER_CURSOR的ID。
+   */
+  WIDGET_PROP_ID_POINTER_CURSOR,
+  /**
+   * @const WIDGET_PROP_ID_LOADING
+   * WIDGET_PROP_LOADING的ID。
+   */
+  WIDGET_PROP_ID_LOADING,
+  /**
+   * @const WIDGET_PROP_ID_LAYOUT
+   * WIDGET_PROP_LAYOUT的ID。
+   */
+  WIDGET_PROP_ID_LAYOUT,
+  /**
+   * @const WIDGET_PROP_ID_SELF_LAYOUT
+   * WIDGET_PROP_SELF_LAYOUT的ID。
+   */
+  WIDGET_PROP_ID_SELF_LAYOUT,
+  /**
+   * @const WIDGET_PROP_ID_CHILDREN_LAYOUT
+   * WIDGET_PROP_CHILDREN_LAYOUT的ID。
+   */
+  WIDGET_PROP_ID_CHILDREN_LAYOUT,
+  /**
+   * @const WIDGET_PROP_ID_LAYOUT_W
+   * WIDGET_PROP_LAYOUT_W的ID。
+   */
+  WIDGET_PROP_ID_LAYOUT_W,
+  /**
+   * @const WIDGET_PROP_ID_LAYOUT_H
+   * WIDGET_PROP_LAYOUT_H的ID。
+   */
+  WIDGET_PROP_ID_LAYOUT_H,
+  /**
+   * @const WIDGET_PROP_ID_STATE_FOR_STYLE
+   * WIDGET_PROP_STATE_FOR_STYLE的ID。
+   */
+  WIDGET_PROP_ID_STATE_FOR_STYLE,
+  /**
+   * @const WIDGET_PROP_ID_EXEC
+   * WIDGET_PROP_EXEC的ID。
+   */
+  WIDGET_PROP_ID_EXEC,
+  /**
+   * @const WIDGET_PROP_ID_GRAB_KEYS
+   * WIDGET_PROP_GRAB_KEYS的ID。
+   */
+  WIDGET_PROP_ID_GRAB_KEYS,
+  /**
+   * @const WIDGET_PROP_ID_VALUE
+   * WIDGET_PROP_VALUE的ID。
+   */
+  WIDGET_PROP_ID_VALUE,
+  /**
+   * @const WIDGET_PROP_ID_MIN
+   * WIDGET_PROP_MIN的ID。
+   */
+  WIDGET_PROP_ID_MIN,
+  /**
+   * @const WIDGET_PROP_ID_MAX
+   * WIDGET_PROP_MAX的ID。
+   */
+  WIDGET_PROP_ID_MAX,
+  /**
+   * @const WIDGET_PROP_ID_STEP
+   * WIDGET_PROP_STEP的ID。
+   */
+  WIDGET_PROP_ID_STEP,
+  /**
+   * @const WIDGET_PROP_ID_VERTICAL
+   * WIDGET_PROP_VERTICAL的ID。
+   */
+  WIDGET_PROP_ID_VERTICAL,
+  /**
+   * @const WIDGET_PROP_ID_REVERSE
+   * WIDGET_PROP_REVERSE的ID。
+   */
+  WIDGET_PROP_ID_REVERSE,
+  /**
+   * @const WIDGET_PROP_ID_FORMAT
+   * WIDGET_PROP_FORMAT的ID。
+   */
+  WIDGET_PROP_ID_FORMAT,
+  /**
+   * @const WIDGET_PROP_ID_SHOW_TEXT
+   * WIDGET_PROP_SHOW_TEXT的ID。
+   */
+  WIDGET_PROP_ID_SHOW_TEXT,
+  /**
+   * @const WIDGET_PROP_ID_BAR_SIZE
+   * WIDGET_PROP_BAR_SIZE的ID。
+   */
+  WIDGET_PROP_ID_BAR_SIZE,
+  /**
+   * @const WIDGET_PROP_ID_INPUTING
+   * WIDGET_PROP_INPUTING的ID。
+   */
+  WIDGET_PROP_ID_INPUTING,
+  /**
+   * @const WIDGET_PROP_ID_LENGTH
+   * WIDGET_PROP_LENGTH的ID。
+   */
+  WIDGET_PROP_ID_LENGTH,
+  /**
+   * @const WIDGET_PROP_ID_MAX_W
+   * WIDGET_PROP_MAX_W的ID。
+   */
+  WIDGET_PROP_ID_MAX_W,
+  /**
+   * @const WIDGET_PROP_ID_LINE_WRAP
+   * WIDGET_PROP_LINE_WRAP的ID。
+   */
+  WIDGET_PROP_ID_LINE_WRAP,
+  /**
+   * @const WIDGET_PROP_ID_WORD_WRAP
+   * WIDGET_PROP_WORD_WRAP的ID。
+   */
+  WIDGET_PROP_ID_WORD_WRAP,
+  /**
+   * @const WIDGET_PROP_ID_REPEAT
+   * WIDGET_PROP_REPEAT的ID。
+   */
+  WIDGET_PROP_ID_REPEAT,
+  /**
+   * @const WIDGET_PROP_ID_LONG_PRESS_TIME
+   * WIDGET_PROP_LONG_PRESS_TIME的ID。
+   */
+  WIDGET_PROP_ID_LONG_PRESS_TIME,
+  /**
+   * @const WIDGET_PROP_ID_ENABLE_LONG_PRESS
+   * WIDGET_PROP_ENABLE_LONG_PRESS的ID。
+   */
+  WIDGET_PROP_ID_ENABLE_LONG_PRESS,
+  /**
+   * @const WIDGET_PROP_ID_ENABLE_PREVIEW
+   * WIDGET_PROP_ENABLE_PREVIEW的ID。
+   */
+  WIDGET_PROP_ID_ENABLE_PREVIEW,
+  /**
+   * @const WIDGET_PROP_ID_NR
+   * ID的个数。
+   */
+  WIDGET_PROP_ID_NR
+} widget_prop_id_t;
+
 /**
  * @enum widget_type_t
  * @annotation ["scriptable", "string"]
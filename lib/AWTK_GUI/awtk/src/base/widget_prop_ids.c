@@ -0,0 +1,158 @@
+﻿/**
+ * File:   widget_prop_ids.c
+ * Author: AWTK Develop Team
+ * Brief:  interned ids of builtin widget property names
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#include "../tkc/utils.h"
+#include "widget_prop_ids.h"
+
+#define WIDGET_PROP_ID_SLOTS 128
+#define WIDGET_PROP_ID_SLOTS_MASK (WIDGET_PROP_ID_SLOTS - 1)
+
+typedef struct _widget_prop_name_t
+{
+  widget_prop_id_t id;
+  const char *name;
+} widget_prop_name_t;
+
+static const widget_prop_name_t s_widget_prop_names[] = {
+    {WIDGET_PROP_ID_X, WIDGET_PROP_X},
+    {WIDGET_PROP_ID_Y, WIDGET_PROP_Y},
+    {WIDGET_PROP_ID_W, WIDGET_PROP_W},
+    {WIDGET_PROP_ID_H, WIDGET_PROP_H},
+    {WIDGET_PROP_ID_OPACITY, WIDGET_PROP_OPACITY},
+    {WIDGET_PROP_ID_VISIBLE, WIDGET_PROP_VISIBLE},
+    {WIDGET_PROP_ID_SENSITIVE, WIDGET_PROP_SENSITIVE},
+    {WIDGET_PROP_ID_FLOATING, WIDGET_PROP_FLOATING},
+    {WIDGET_PROP_ID_FOCUSABLE, WIDGET_PROP_FOCUSABLE},
+    {WIDGET_PROP_ID_FOCUSED, WIDGET_PROP_FOCUSED},
+    {WIDGET_PROP_ID_FOCUS, WIDGET_PROP_FOCUS},
+    {WIDGET_PROP_ID_WITH_FOCUS_STATE, WIDGET_PROP_WITH_FOCUS_STATE},
+    {WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE, WIDGET_PROP_DIRTY_RECT_TOLERANCE},
+    {WIDGET_PROP_ID_STYLE, WIDGET_PROP_STYLE},
+    {WIDGET_PROP_ID_ENABLE, WIDGET_PROP_ENABLE},
+    {WIDGET_PROP_ID_FEEDBACK, WIDGET_PROP_FEEDBACK},
+    {WIDGET_PROP_ID_AUTO_ADJUST_SIZE, WIDGET_PROP_AUTO_ADJUST_SIZE},
+    {WIDGET_PROP_ID_NAME, WIDGET_PROP_NAME},
+    {WIDGET_PROP_ID_TYPE, WIDGET_PROP_TYPE},
+    {WIDGET_PROP_ID_TEXT, WIDGET_PROP_TEXT},
+    {WIDGET_PROP_ID_TR_TEXT, WIDGET_PROP_TR_TEXT},
+    {WIDGET_PROP_ID_ANIMATION, WIDGET_PROP_ANIMATION},
+    {WIDGET_PROP_ID_POINTER_CURSOR, WIDGET_PROP_POINTER_CURSOR},
+    {WIDGET_PROP_ID_LOADING, WIDGET_PROP_LOADING},
+    {WIDGET_PROP_ID_LAYOUT, WIDGET_PROP_LAYOUT},
+    {WIDGET_PROP_ID_SELF_LAYOUT, WIDGET_PROP_SELF_LAYOUT},
+    {WIDGET_PROP_ID_CHILDREN_LAYOUT, WIDGET_PROP_CHILDREN_LAYOUT},
+    {WIDGET_PROP_ID_LAYOUT_W, WIDGET_PROP_LAYOUT_W},
+    {WIDGET_PROP_ID_LAYOUT_H, WIDGET_PROP_LAYOUT_H},
+    {WIDGET_PROP_ID_STATE_FOR_STYLE, WIDGET_PROP_STATE_FOR_STYLE},
+    {WIDGET_PROP_ID_EXEC, WIDGET_PROP_EXEC},
+    {WIDGET_PROP_ID_GRAB_KEYS, WIDGET_PROP_GRAB_KEYS},
+    {WIDGET_PROP_ID_VALUE, WIDGET_PROP_VALUE},
+    {WIDGET_PROP_ID_MIN, WIDGET_PROP_MIN},
+    {WIDGET_PROP_ID_MAX, WIDGET_PROP_MAX},
+    {WIDGET_PROP_ID_STEP, WIDGET_PROP_STEP},
+    {WIDGET_PROP_ID_VERTICAL, WIDGET_PROP_VERTICAL},
+    {WIDGET_PROP_ID_REVERSE, WIDGET_PROP_REVERSE},
+    {WIDGET_PROP_ID_FORMAT, WIDGET_PROP_FORMAT},
+    {WIDGET_PROP_ID_SHOW_TEXT, WIDGET_PROP_SHOW_TEXT},
+    {WIDGET_PROP_ID_BAR_SIZE, WIDGET_PROP_BAR_SIZE},
+    {WIDGET_PROP_ID_INPUTING, WIDGET_PROP_INPUTING},
+    {WIDGET_PROP_ID_LENGTH, WIDGET_PROP_LENGTH},
+    {WIDGET_PROP_ID_MAX_W, WIDGET_PROP_MAX_W},
+    {WIDGET_PROP_ID_LINE_WRAP, WIDGET_PROP_LINE_WRAP},
+    {WIDGET_PROP_ID_WORD_WRAP, WIDGET_PROP_WORD_WRAP},
+    {WIDGET_PROP_ID_REPEAT, WIDGET_PROP_REPEAT},
+    {WIDGET_PROP_ID_LONG_PRESS_TIME, WIDGET_PROP_LONG_PRESS_TIME},
+    {WIDGET_PROP_ID_ENABLE_LONG_PRESS, WIDGET_PROP_ENABLE_LONG_PRESS},
+    {WIDGET_PROP_ID_ENABLE_PREVIEW, WIDGET_PROP_ENABLE_PREVIEW},
+};
+
+/*哈希槽中保存 s_widget_prop_names 的下标加一，0 表示空槽*/
+static uint8_t s_widget_prop_slots[WIDGET_PROP_ID_SLOTS];
+static bool_t s_widget_prop_slots_inited = FALSE;
+
+/*
+ * 上一次查到的属性：widget_get_prop/widget_set_prop 和控件的 get_prop/set_prop
+ * 会用同一个 name 先后查两次，第二次只需比较指针和字符串。
+ */
+static const char *s_widget_prop_last_name = NULL;
+static const widget_prop_name_t *s_widget_prop_last = NULL;
+
+static uint32_t widget_prop_hash(const char *name)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*name)
+  {
+    hash = (hash ^ (uint8_t)(*name++)) * 16777619u;
+  }
+
+  return hash;
+}
+
+static ret_t widget_prop_ids_init(void)
+{
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(s_widget_prop_names); i++)
+  {
+    uint32_t slot = widget_prop_hash(s_widget_prop_names[i].name) & WIDGET_PROP_ID_SLOTS_MASK;
+
+    while (s_widget_prop_slots[slot] != 0)
+    {
+      slot = (slot + 1) & WIDGET_PROP_ID_SLOTS_MASK;
+    }
+    s_widget_prop_slots[slot] = i + 1;
+  }
+  s_widget_prop_slots_inited = TRUE;
+
+  return RET_OK;
+}
+
+widget_prop_id_t widget_prop_id(const char *name)
+{
+  uint32_t slot = 0;
+  return_value_if_fail(name != NULL, WIDGET_PROP_ID_NONE);
+
+  if (!s_widget_prop_slots_inited)
+  {
+    widget_prop_ids_init();
+  }
+
+  if (name == s_widget_prop_last_name && tk_str_eq(s_widget_prop_last->name, name))
+  {
+    return s_widget_prop_last->id;
+  }
+
+  slot = widget_prop_hash(name) & WIDGET_PROP_ID_SLOTS_MASK;
+  while (s_widget_prop_slots[slot] != 0)
+  {
+    const widget_prop_name_t *iter = s_widget_prop_names + s_widget_prop_slots[slot] - 1;
+    if (tk_str_eq(iter->name, name))
+    {
+      s_widget_prop_last_name = name;
+      s_widget_prop_last = iter;
+      return iter->id;
+    }
+    slot = (slot + 1) & WIDGET_PROP_ID_SLOTS_MASK;
+  }
+
+  return WIDGET_PROP_ID_NONE;
+}
@@ -0,0 +1,41 @@
+﻿/**
+ * File:   widget_prop_ids.h
+ * Author: AWTK Develop Team
+ * Brief:  interned ids of builtin widget property names
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_WIDGET_PROP_IDS_H
+#define TK_WIDGET_PROP_IDS_H
+
+#include "widget_consts.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @method widget_prop_id
+ * 获取内置属性名对应的ID。
+ * @annotation ["static"]
+ * @param {const char*} name 属性名。
+ *
+ * @return {widget_prop_id_t} 返回属性ID，不是内置属性时返回WIDGET_PROP_ID_NONE。
+ */
+widget_prop_id_t widget_prop_id(const char *name);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_PROP_IDS_H*/
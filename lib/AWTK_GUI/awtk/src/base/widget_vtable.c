@@ -164,6 +164,7 @@ ret_t widget_on_paint_children_default(widget_t *widget, canvas_t *c)
     continue;
   }
 
+  c->visited_widgets_nr++;
   if (!(iter->vt->allow_draw_outside))
   {
     int32_t tolerance = iter->dirty_rect_tolerance;
@@ -179,6 +180,7 @@ ret_t widget_on_paint_children_default(widget_t *widget, canvas_t *c)
     }
   }
 
+  c->painted_widgets_nr++;
   widget_paint(iter, c);
   WIDGET_FOR_EACH_CHILD_END();
 
@@ -319,8 +321,14 @@ ret_t widget_paint_with_clip(widget_t *widget, rect_t *clip, canvas_t *c,
   rect_t r = {0};
   rect_t r_save = {0};
   rect_t r_vg_save = {0};
-  vgcanvas_t *vg = canvas_get_vgcanvas(c);
-  return_value_if_fail(widget != NULL && on_paint != NULL, RET_BAD_PARAMS);
+  vgcanvas_t *vg = NULL;
+  return_value_if_fail(widget != NULL && c != NULL && on_paint != NULL, RET_BAD_PARAMS);
+
+  /* 不为保存裁剪区而创建 vgcanvas，子控件用到时 canvas_get_vgcanvas 会设置它的裁剪区 */
+  if (lcd_peek_vgcanvas(c->lcd) != NULL)
+  {
+    vg = canvas_get_vgcanvas(c);
+  }
 
   /* 裁剪子控件的话，需要注意保存和还原 canvas 和 vg 这两个画布，*/
   /* 因为子控件可能会修改任意一个画布的裁剪区或者其他的配置，有概率会导致其他的控件的绘图不正常 */
@@ -161,6 +161,27 @@ struct _window_animator_t
  */
 ret_t window_animator_update(window_animator_t *wa, uint64_t time_ms);
 
+/**
+ * @method window_animator_step
+ * 根据当前时间计算动画的进度，但不绘制。
+ *
+ * > 与window\_animator\_draw配合使用：一帧只计算一次进度，然后分片段多次绘制。
+ * @param {window_animator_t*} wa 窗口动画对象。
+ * @param {uint64_t} time_ms 当前时间(毫秒)。
+ *
+ * @return {ret_t} 返回RET_DONE表示动画已经完成，RET_OK表示动画还在进行中。
+ */
+ret_t window_animator_step(window_animator_t *wa, uint64_t time_ms);
+
+/**
+ * @method window_animator_draw
+ * 按当前的进度绘制前后两个窗口。
+ * @param {window_animator_t*} wa 窗口动画对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t window_animator_draw(window_animator_t *wa);
+
 /**
  * @method window_animator_begin_frame
  * begin frame
@@ -170,6 +191,18 @@ ret_t window_animator_update(window_animator_t *wa, uint64_t time_ms);
  */
 ret_t window_animator_begin_frame(window_animator_t *wa);
 
+/**
+ * @method window_animator_begin_frame_ex
+ * begin frame，只绘制指定的脏矩形。
+ *
+ * > 用于片段帧缓存(FRAGMENT\_FRAME\_BUFFER\_SIZE)，每个片段调用一次。
+ * @param {window_animator_t*} wa 窗口动画对象。
+ * @param {const dirty_rects_t*} dirty_rects 脏矩形(为NULL时绘制整个屏幕)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t window_animator_begin_frame_ex(window_animator_t *wa, const dirty_rects_t *dirty_rects);
+
 /**
  * @method window_animator_end_frame
  * end frame
@@ -548,6 +548,19 @@ bool_t window_manager_is_animating(widget_t *widget)
   return FALSE;
 }
 
+bool_t window_manager_has_dirty_rect(widget_t *widget)
+{
+  window_manager_t *wm = WINDOW_MANAGER(widget);
+  return_value_if_fail(wm != NULL && wm->vt != NULL, FALSE);
+
+  if (wm->vt->has_dirty_rect == NULL)
+  {
+    return FALSE;
+  }
+
+  return wm->vt->has_dirty_rect(widget);
+}
+
 static ret_t wm_on_locale_changed(void *ctx, event_t *e)
 {
   widget_t *widget = WIDGET(ctx);
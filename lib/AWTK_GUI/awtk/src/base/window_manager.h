@@ -49,6 +49,7 @@ typedef ret_t (*window_manager_switch_to_t)(widget_t *widget, widget_t *curr_win
                                             widget_t *target_win, bool_t close);
 typedef ret_t (*window_manager_get_pointer_t)(widget_t *widget, xy_t *x, xy_t *y, bool_t *pressed);
 typedef ret_t (*window_manager_is_animating_t)(widget_t *widget, bool_t *playing);
+typedef bool_t (*window_manager_has_dirty_rect_t)(widget_t *widget);
 
 typedef ret_t (*window_manager_dispatch_native_window_event_t)(widget_t *widget, event_t *e,
                                                                void *handle);
@@ -81,6 +82,7 @@ typedef struct _window_manager_vtable_t
   window_manager_set_screen_saver_time_t set_screen_saver_time;
   window_manager_get_pointer_t get_pointer;
   window_manager_is_animating_t is_animating;
+  window_manager_has_dirty_rect_t has_dirty_rect;
   window_manager_snap_curr_window_t snap_curr_window;
   window_manager_snap_prev_window_t snap_prev_window;
   window_manager_get_dialog_highlighter_t get_dialog_highlighter;
@@ -233,6 +235,16 @@ bool_t window_manager_get_pointer_pressed(widget_t *widget);
  */
 bool_t window_manager_is_animating(widget_t *widget);
 
+/**
+ * @method window_manager_has_dirty_rect
+ * 是否有等待绘制的脏矩形。
+ * @annotation ["private"]
+ * @param {widget_t*} widget 窗口管理器对象。
+ *
+ * @return {bool_t} 返回TRUE表示下一帧需要绘制。
+ */
+bool_t window_manager_has_dirty_rect(widget_t *widget);
+
 /**
  * @method window_manager_post_init
  * post init。
@@ -48,14 +48,7 @@ static inline void blend_a_bgr565_bgra8888(uint8_t *dst, uint8_t *src, uint8_t a
   }
   else if (a > 8)
   {
-    uint8_t minus_a = 0xff - a;
-    uint16_t sc = *(uint16_t *)src;
-    uint16_t dc = *(uint16_t *)dst;
-
-    uint8_t r = (((sc >> 11) << 3) * a + ((dc >> 11) << 3) * minus_a) >> 11;
-    uint8_t g = ((((sc >> 5) << 2) & 0xff) * a + ((((dc >> 5) << 2) & 0xff) * minus_a)) >> 10;
-    uint8_t b = ((((sc & 0x1f) << 3)) * a + ((((dc & 0x1f) << 3) & 0xff) * minus_a)) >> 11;
-    *(uint16_t *)dst = (r << 11) | (g << 5) | b;
+    *(uint16_t *)dst = pixel_565_blend(*(uint16_t *)dst, *(uint16_t *)src, pixel_565_alpha(a));
   }
 }
 
@@ -69,7 +69,8 @@ static inline void blend_a_bgr565_rgba8888(uint8_t *dst, uint8_t *src, uint8_t a
     }
     else
     {
-      pixel_bgr565_blend_rgba(dst, rgba);
+      uint16_t s = ((sr >> 3) << 11) | ((sg >> 2) << 5) | (sb >> 3);
+      *(uint16_t *)dst = pixel_565_blend(*(uint16_t *)dst, s, pixel_565_alpha(a));
     }
   }
 }
@@ -20,6 +20,7 @@
  */
 
 #include "../base/g2d.h"
+#include "../base/bitmap_rle.h"
 #include "soft_g2d.h"
 #include "image_g2d.h"
 
@@ -91,6 +92,103 @@ ret_t TK_WEAK g2d_blend_image_rotate(bitmap_t *dst, bitmap_t *src, const rectf_t
 
 #endif
 
+static ret_t image_rle_band_init(bitmap_t *band, bitmap_t *src, uint32_t w, uint32_t h)
+{
+  memset(band, 0x00, sizeof(bitmap_t));
+  return_value_if_fail(bitmap_init(band, w, h, (bitmap_format_t)(src->format), NULL) == RET_OK,
+                       RET_OOM);
+  band->flags = src->flags & (BITMAP_FLAG_OPAQUE | BITMAP_FLAG_PREMULTI_ALPHA);
+
+  return RET_OK;
+}
+
+/*
+ * RLE压缩的图片：按行解码到临时的band中，再当作普通图片拷贝/混合。
+ * 只解码src_r覆盖的行和列，也就是当前strip可见的部分。
+ */
+static ret_t image_copy_rle(bitmap_t *dst, bitmap_t *src, const rect_t *src_r, xy_t dx, xy_t dy)
+{
+  rect_t r;
+  rect_t band_r;
+  bitmap_t band;
+  int32_t y = 0;
+  ret_t ret = RET_OK;
+  uint8_t *data = NULL;
+  uint32_t line_length = 0;
+  int32_t rows = tk_min(TK_BITMAP_RLE_BAND_ROWS, src_r->h);
+  return_value_if_fail(src_r->w > 0 && src_r->h > 0, RET_OK);
+  return_value_if_fail(image_rle_band_init(&band, src, src_r->w, rows) == RET_OK, RET_OOM);
+
+  data = bitmap_lock_buffer_for_write(&band);
+  line_length = bitmap_get_line_length(&band);
+  for (y = 0; y < src_r->h && ret == RET_OK; y += rows)
+  {
+    r = rect_init(src_r->x, src_r->y + y, src_r->w, tk_min(rows, src_r->h - y));
+    band_r = rect_init(0, 0, r.w, r.h);
+    ret = bitmap_rle_decode(src, &r, data, line_length);
+    if (ret == RET_OK)
+    {
+      ret = image_copy(dst, &band, &band_r, dx, dy + y);
+    }
+  }
+  bitmap_unlock_buffer(&band);
+  bitmap_destroy(&band);
+
+  return ret;
+}
+
+static ret_t image_blend_rle(bitmap_t *dst, bitmap_t *src, const rectf_t *dst_r,
+                             const rectf_t *src_r, uint8_t global_alpha)
+{
+  rect_t r;
+  rectf_t band_r;
+  rectf_t band_dst_r;
+  bitmap_t band;
+  int32_t y = 0;
+  ret_t ret = RET_OK;
+  uint8_t *data = NULL;
+  uint32_t line_length = 0;
+  int32_t rows = 0;
+  int32_t x0 = tk_max(0, (int32_t)floorf(src_r->x));
+  int32_t y0 = tk_max(0, (int32_t)floorf(src_r->y));
+  int32_t x1 = tk_min((int32_t)(src->w), (int32_t)ceilf(src_r->x + src_r->w));
+  int32_t y1 = tk_min((int32_t)(src->h), (int32_t)ceilf(src_r->y + src_r->h));
+  /*没有垂直缩放时，源和目标的行一一对应，可以分段解码，否则一次解码全部的行*/
+  bool_t by_band = src_r->h == dst_r->h && src_r->y == y0;
+  return_value_if_fail(x1 > x0 && y1 > y0, RET_OK);
+
+  rows = by_band ? tk_min(TK_BITMAP_RLE_BAND_ROWS, y1 - y0) : y1 - y0;
+  return_value_if_fail(image_rle_band_init(&band, src, x1 - x0, rows) == RET_OK, RET_OOM);
+
+  data = bitmap_lock_buffer_for_write(&band);
+  line_length = bitmap_get_line_length(&band);
+  for (y = y0; y < y1 && ret == RET_OK; y += rows)
+  {
+    r = rect_init(x0, y, x1 - x0, tk_min(rows, y1 - y));
+    if (by_band)
+    {
+      float h = tk_min((float)(r.h), src_r->y + src_r->h - y);
+      band_r = rectf_init(src_r->x - x0, 0, src_r->w, h);
+      band_dst_r = rectf_init(dst_r->x, dst_r->y + (y - y0), dst_r->w, h);
+    }
+    else
+    {
+      band_r = rectf_init(src_r->x - x0, src_r->y - y0, src_r->w, src_r->h);
+      band_dst_r = *dst_r;
+    }
+
+    ret = bitmap_rle_decode(src, &r, data, line_length);
+    if (ret == RET_OK)
+    {
+      ret = image_blend(dst, &band, &band_dst_r, &band_r, global_alpha);
+    }
+  }
+  bitmap_unlock_buffer(&band);
+  bitmap_destroy(&band);
+
+  return ret;
+}
+
 ret_t image_fill(bitmap_t *dst, const rect_t *dst_r, color_t c)
 {
   return_value_if_fail(dst != NULL && dst_r != NULL, RET_OK);
@@ -125,6 +223,11 @@ ret_t image_copy(bitmap_t *dst, bitmap_t *src, const rect_t *src_r, xy_t dx, xy_
   assert(dx >= 0 && (dx + src_r->w) <= bitmap_get_physical_width(dst));
   assert(dy >= 0 && (dy + src_r->h) <= bitmap_get_physical_height(dst));
 
+  if (bitmap_is_rle(src))
+  {
+    return image_copy_rle(dst, src, src_r, dx, dy);
+  }
+
 #ifdef WITH_G2D
   if (g2d_copy_image(dst, src, src_r, dx, dy) == RET_OK)
   {
@@ -169,6 +272,11 @@ ret_t image_blend(bitmap_t *dst, bitmap_t *src, const rectf_t *dst_r, const rect
   assert(dst_r->x >= 0 && (dst_r->x + dst_r->w) <= bitmap_get_physical_width(dst));
   assert(dst_r->y >= 0 && (dst_r->y + dst_r->h) <= bitmap_get_physical_height(dst));
 
+  if (bitmap_is_rle(src))
+  {
+    return image_blend_rle(dst, src, dst_r, src_r, global_alpha);
+  }
+
 #ifdef WITH_G2D
   if (src_r->w == dst_r->w && src_r->h == dst_r->h)
   {
@@ -22,9 +22,68 @@
 #include "../../tkc/mem.h"
 #include "../../tkc/utils.h"
 #include "../../base/timer.h"
+#include "../../base/assets_manager.h"
 #include "../../base/widget_vtable.h"
 #include "gif_image.h"
 
+static ret_t gif_image_update_index(gif_image_t *image, uint32_t frames_nr)
+{
+  if (frames_nr > 0)
+  {
+    image->index %= frames_nr;
+    if (image->loop > 0)
+    {
+      image->loop--;
+    }
+  }
+  else
+  {
+    image->index = 0;
+  }
+
+  if (image->loop == 0)
+  {
+    if (frames_nr > 0)
+    {
+      image->index = frames_nr - 1;
+    }
+    else
+    {
+      image->index = 0;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t gif_image_draw_frame(widget_t *widget, canvas_t *c, bitmap_t *bitmap, wh_t y, wh_t h)
+{
+  rect_t src;
+  rect_t dst;
+  vgcanvas_t *vg = canvas_get_vgcanvas(c);
+
+  if (vg != NULL)
+  {
+    if (image_need_transform(widget))
+    {
+      vgcanvas_save(vg);
+      image_transform(widget, c);
+      vgcanvas_draw_icon(vg, bitmap, 0, y, bitmap->w, h, 0, 0, widget->w, widget->h);
+      vgcanvas_restore(vg);
+
+      return RET_OK;
+    }
+  }
+
+  src = rect_init(0, y, bitmap->w, h);
+  dst = rect_init(0, 0, widget->w, widget->h);
+  canvas_draw_image_scale_down(c, bitmap, &src, &dst);
+
+  widget_paint_helper(widget, c, NULL, NULL);
+
+  return RET_OK;
+}
+
 #ifdef AWTK_WEB
 static ret_t gif_image_on_timer(const timer_info_t *info)
 {
@@ -40,6 +99,88 @@ static ret_t gif_image_on_timer(const timer_info_t *info)
   return RET_REPEAT;
 }
 #else
+static ret_t gif_image_reset_decoder(gif_image_t *image)
+{
+  if (image->decoder != NULL)
+  {
+    gif_decoder_destroy(image->decoder);
+    image->decoder = NULL;
+  }
+
+  if (image->asset != NULL)
+  {
+    assets_manager_unref(widget_get_assets_manager(WIDGET(image)), image->asset);
+    image->asset = NULL;
+  }
+  TKMEM_FREE(image->decoder_image);
+
+  return RET_OK;
+}
+
+/*
+ * GIF资源直接引用压缩数据按帧解码，不再通过image_manager一次解码全部帧。
+ * 不是GIF资源(或者不支持按帧解码)时返回NULL，仍然使用widget_load_image。
+ */
+static gif_decoder_t *gif_image_get_decoder(gif_image_t *image, const char *name)
+{
+  assets_manager_t *am = widget_get_assets_manager(WIDGET(image));
+
+  if (image->decoder_image != NULL && tk_str_eq(image->decoder_image, name))
+  {
+    return image->decoder;
+  }
+
+  gif_image_reset_decoder(image);
+  image->decoder_image = tk_strdup(name);
+  image->asset = assets_manager_ref(am, ASSET_TYPE_IMAGE, name);
+  if (image->asset != NULL && image->asset->subtype == ASSET_TYPE_IMAGE_GIF)
+  {
+    image->decoder = gif_decoder_create(image->asset->data, image->asset->size);
+  }
+
+  if (image->decoder == NULL && image->asset != NULL)
+  {
+    assets_manager_unref(am, image->asset);
+    image->asset = NULL;
+  }
+  image->index = 0;
+
+  return image->decoder;
+}
+
+/*把图像坐标中的区域转换成控件坐标，缩放规则与canvas_draw_image_scale_down一致。*/
+static rect_t gif_image_map_rect(widget_t *widget, gif_decoder_t *gif, const rect_t *r)
+{
+  xy_t left = 0;
+  xy_t top = 0;
+  xy_t right = 0;
+  xy_t bottom = 0;
+  float scale = 0;
+  int32_t gw = gif->w;
+  int32_t gh = gif->h;
+  int32_t w = gw;
+  int32_t h = gh;
+
+  if (image_need_transform(widget))
+  {
+    return rect_init(0, 0, widget->w, widget->h);
+  }
+
+  scale = tk_min((float)(widget->w) / gw, (float)(widget->h) / gh);
+  if (scale < 1)
+  {
+    w = gw * scale;
+    h = gh * scale;
+  }
+
+  left = ((widget->w - w) >> 1) + r->x * w / gw;
+  top = ((widget->h - h) >> 1) + r->y * h / gh;
+  right = ((widget->w - w) >> 1) + ((r->x + r->w) * w + gw - 1) / gw;
+  bottom = ((widget->h - h) >> 1) + ((r->y + r->h) * h + gh - 1) / gh;
+
+  return rect_init(left, top, right - left, bottom - top);
+}
+
 static ret_t gif_image_on_timer(const timer_info_t *info)
 {
   gif_image_t *image = GIF_IMAGE(info->ctx);
@@ -50,23 +191,73 @@ static ret_t gif_image_on_timer(const timer_info_t *info)
     image->index++;
   }
 
+  if (image->decoder != NULL)
+  {
+    /*在定时器中解码下一帧，只重绘发生变化的区域。不可见时只更新序号，绘制时再解码。*/
+    rect_t dirty = rect_init(0, 0, 0, 0);
+    widget_t *widget = WIDGET(image);
+    gif_decoder_t *gif = image->decoder;
+
+    gif_image_update_index(image, gif->frames_nr);
+    if (widget->visible)
+    {
+      if (gif_decoder_seek(gif, image->index, &dirty) != RET_OK)
+      {
+        widget_invalidate_force(widget, NULL);
+      }
+      else if (dirty.w > 0 && dirty.h > 0)
+      {
+        dirty = gif_image_map_rect(widget, gif, &dirty);
+        widget_invalidate_force(widget, &dirty);
+      }
+    }
+
+    return RET_REPEAT;
+  }
+
   if (WIDGET(image)->visible)
   {
     widget_invalidate_force(WIDGET(image), NULL);
   }
   return RET_REPEAT;
 }
+
+static ret_t gif_image_update_timer(gif_image_t *image, uint32_t frames_nr, uint32_t delay)
+{
+  if (frames_nr > 1)
+  {
+    if (image->timer_id == TK_INVALID_ID)
+    {
+      image->index = 0;
+      image->delay = delay;
+      image->timer_id = timer_add(gif_image_on_timer, image, image->delay);
+    }
+    else if (image->delay != delay)
+    {
+      image->delay = delay;
+      timer_info_t *timer = (timer_info_t *)timer_find(image->timer_id);
+      if (timer)
+      {
+        timer->duration = image->delay;
+        timer_manager_update(timer_manager(), timer);
+      }
+    }
+  }
+  else if (image->timer_id != TK_INVALID_ID)
+  {
+    image->index = 0;
+    timer_remove(image->timer_id);
+    image->timer_id = TK_INVALID_ID;
+  }
+
+  return RET_OK;
+}
 #endif /*AWTK_WEB*/
 
 static ret_t gif_image_on_paint_self(widget_t *widget, canvas_t *c)
 {
-  wh_t y = 0;
-  wh_t h = 0;
-  rect_t src;
-  rect_t dst;
   uint32_t frames_nr;
   bitmap_t bitmap;
-  vgcanvas_t *vg = NULL;
   gif_image_t *image = GIF_IMAGE(widget);
   image_base_t *image_base = IMAGE_BASE(widget);
   return_value_if_fail(image_base != NULL && image != NULL && widget != NULL && c != NULL,
@@ -78,7 +269,19 @@ static ret_t gif_image_on_paint_self(widget_t *widget, canvas_t *c)
     return RET_OK;
   }
 
-  vg = canvas_get_vgcanvas(c);
+#ifndef AWTK_WEB
+  if (gif_image_get_decoder(image, image_base->image) != NULL)
+  {
+    gif_decoder_t *gif = image->decoder;
+
+    image->index %= gif->frames_nr;
+    gif_decoder_seek(gif, image->index, NULL);
+    gif_image_update_timer(image, gif->frames_nr, gif->delay);
+
+    return gif_image_draw_frame(widget, c, gif->bitmap, 0, gif->h);
+  }
+#endif /*AWTK_WEB*/
+
   return_value_if_fail(widget_load_image(widget, image_base->image, &bitmap) == RET_OK,
                        RET_BAD_PARAMS);
 #ifdef AWTK_WEB
@@ -98,84 +301,19 @@ static ret_t gif_image_on_paint_self(widget_t *widget, canvas_t *c)
   frames_nr = bitmap.gif_frames_nr;
 #endif /*AWTK_WEB*/
 
-  if (frames_nr > 0)
-  {
-    image->index %= frames_nr;
-    if (image->loop > 0)
-    {
-      image->loop--;
-    }
-  }
-  else
-  {
-    image->index = 0;
-  }
-
-  if (image->loop == 0)
-  {
-    if (frames_nr > 0)
-    {
-      image->index = frames_nr - 1;
-    }
-    else
-    {
-      image->index = 0;
-    }
-  }
+  gif_image_update_index(image, frames_nr);
 #ifdef AWTK_WEB
   if (image->timer_id == TK_INVALID_ID)
   {
     image->timer_id = timer_add(gif_image_on_timer, image, 16);
   }
 #else
-  if (frames_nr > 1)
-  {
-    uint32_t delay = bitmap.gif_delays[image->index];
-    if (image->timer_id == TK_INVALID_ID)
-    {
-      image->index = 0;
-      image->delay = delay;
-      image->timer_id = timer_add(gif_image_on_timer, image, image->delay);
-    }
-    else if (image->delay != delay)
-    {
-      image->delay = delay;
-      timer_info_t *timer = (timer_info_t *)timer_find(image->timer_id);
-      if (timer)
-        timer->duration = image->delay;
-    }
-  }
-  else if (image->timer_id != TK_INVALID_ID)
-  {
-    image->index = 0;
-    timer_remove(image->timer_id);
-    image->timer_id = TK_INVALID_ID;
-  }
+  gif_image_update_timer(image, frames_nr,
+                         frames_nr > 1 ? (uint32_t)(bitmap.gif_delays[image->index]) : 0);
 #endif /*AWTK_WEB*/
 
-  h = bitmap.gif_frame_h;
-  y = bitmap.gif_frame_h * image->index;
-
-  if (vg != NULL)
-  {
-    if (image_need_transform(widget))
-    {
-      vgcanvas_save(vg);
-      image_transform(widget, c);
-      vgcanvas_draw_icon(vg, &bitmap, 0, y, bitmap.w, h, 0, 0, widget->w, widget->h);
-      vgcanvas_restore(vg);
-
-      return RET_OK;
-    }
-  }
-
-  src = rect_init(0, y, bitmap.w, h);
-  dst = rect_init(0, 0, widget->w, widget->h);
-  canvas_draw_image_scale_down(c, &bitmap, &src, &dst);
-
-  widget_paint_helper(widget, c, NULL, NULL);
-
-  return RET_OK;
+  return gif_image_draw_frame(widget, c, &bitmap, bitmap.gif_frame_h * image->index,
+                              bitmap.gif_frame_h);
 }
 
 static const char *s_gif_image_properties[] = {WIDGET_PROP_IMAGE, WIDGET_PROP_SCALE_X,
@@ -194,6 +332,9 @@ static ret_t gif_image_on_destroy(widget_t *widget)
     timer_remove(image->timer_id);
     image->timer_id = TK_INVALID_ID;
   }
+#ifndef AWTK_WEB
+  gif_image_reset_decoder(image);
+#endif /*AWTK_WEB*/
 
   return image_base_on_destroy(widget);
 }
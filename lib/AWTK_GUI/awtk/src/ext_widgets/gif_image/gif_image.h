@@ -24,6 +24,7 @@
 
 #include "../../base/widget.h"
 #include "../../base/image_base.h"
+#include "../../image_loader/gif_decoder.h"
 
 BEGIN_C_DECLS
 
@@ -36,6 +37,9 @@ BEGIN_C_DECLS
  * > 注意：GIF图片的尺寸大于控件大小时会自动缩小图片，但一般的嵌入式系统的硬件加速都不支持图片缩放，
  * 所以缩放图片会导致性能明显下降。如果性能不满意时，请确认一下GIF图片的尺寸是否小余控件大小。
  *
+ * > GIF资源按帧解码(参考[gif\_decoder\_t](gif_decoder_t.md))：内存中只保留压缩数据和合成后的当前帧，
+ * 定时器到期时才解码下一帧，并且只重绘GIF图像描述符指定的变化区域。
+ *
  * gif\_image\_t是[image\_base\_t](image_base_t.md)的子类控件，image\_base\_t的函数均适用于gif\_image\_t控件。
  *
  * 在xml中使用"gif"标签创建GIF图片控件。如：
@@ -100,6 +104,10 @@ typedef struct _gif_image_t
   uint32_t index;
   uint32_t delay;
   uint32_t timer_id;
+  /*GIF资源按帧解码*/
+  char *decoder_image;
+  gif_decoder_t *decoder;
+  const asset_info_t *asset;
 } gif_image_t;
 
 /**
@@ -39,8 +39,8 @@ static ret_t image_animation_play_to_done(image_animation_t *image_animation)
   return RET_OK;
 }
 
-ret_t image_animation_get_image_name(image_animation_t *image_animation,
-                                     char name[TK_NAME_LEN + 1])
+static ret_t image_animation_get_image_name_at(image_animation_t *image_animation, int32_t at,
+                                               char name[TK_NAME_LEN + 1])
 {
   uint32_t index = 0;
   memset(name, 0x00, TK_NAME_LEN + 1);
@@ -48,15 +48,14 @@ ret_t image_animation_get_image_name(image_animation_t *image_animation,
   {
     uint32_t len = strlen(image_animation->sequence);
     tk_strncpy(name, image_animation->image, TK_NAME_LEN);
-    image_animation->index = image_animation->index >= len ? 0 : image_animation->index;
-    index = image_animation->reverse ? len - image_animation->index - 1 : image_animation->index;
+    index = image_animation->reverse ? len - at - 1 : at;
     name[strlen(name)] = image_animation->sequence[index];
   }
   else
   {
     index = image_animation->reverse
-                ? image_animation->end_index + image_animation->start_index - image_animation->index
-                : image_animation->index;
+                ? image_animation->end_index + image_animation->start_index - at
+                : at;
     const char *format = image_animation->format ? image_animation->format : "%s%d";
     tk_snprintf(name, TK_NAME_LEN, format, image_animation->image, index);
   }
@@ -64,6 +63,183 @@ ret_t image_animation_get_image_name(image_animation_t *image_animation,
   return RET_OK;
 }
 
+ret_t image_animation_get_image_name(image_animation_t *image_animation,
+                                     char name[TK_NAME_LEN + 1])
+{
+  if (image_animation->sequence != NULL)
+  {
+    uint32_t len = strlen(image_animation->sequence);
+    image_animation->index = image_animation->index >= len ? 0 : image_animation->index;
+  }
+
+  return image_animation_get_image_name_at(image_animation, image_animation->index, name);
+}
+
+/*和image_animation_next/image_animation_restart一致，返回-1表示已经播放完成。*/
+static int32_t image_animation_index_after(image_animation_t *image_animation, int32_t index)
+{
+  if (image_animation->sequence != NULL)
+  {
+    if (index + 1 < (int32_t)strlen(image_animation->sequence))
+    {
+      return index + 1;
+    }
+
+    return image_animation->loop ? 0 : -1;
+  }
+  else
+  {
+    if (index < (int32_t)(image_animation->end_index))
+    {
+      return index + 1;
+    }
+
+    return image_animation->loop ? (int32_t)(image_animation->start_index) : -1;
+  }
+}
+
+static ret_t image_animation_unload_frame(image_animation_t *image_animation, int32_t index)
+{
+  bitmap_t bitmap;
+  char name[TK_NAME_LEN + 1];
+  widget_t *widget = WIDGET(image_animation);
+  image_manager_t *imm = widget_get_image_manager(widget);
+
+  image_animation_get_image_name_at(image_animation, index, name);
+  if (image_manager_lookup(imm, name, &bitmap) == RET_OK)
+  {
+    return widget_unload_image(widget, &bitmap);
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t image_animation_clear_prefetched(image_animation_t *image_animation)
+{
+  while (image_animation->prefetched_nr > 0)
+  {
+    image_animation_frame_t *iter = image_animation->prefetched + image_animation->prefetched_first;
+
+    if (image_animation->unload_after_paint)
+    {
+      image_animation_unload_frame(image_animation, iter->index);
+    }
+
+    image_animation->prefetched_first =
+        (image_animation->prefetched_first + 1) % IMAGE_ANIMATION_PREFETCH_MAX_NR;
+    image_animation->prefetched_nr--;
+  }
+  image_animation->prefetched_mem_size = 0;
+
+  return RET_OK;
+}
+
+/*预取的帧按播放顺序排列，要绘制的帧不在队头时说明播放顺序变了，丢弃全部预取的帧。*/
+static bool_t image_animation_take_prefetched(image_animation_t *image_animation, int32_t index)
+{
+  if (image_animation->prefetched_nr > 0)
+  {
+    image_animation_frame_t *iter = image_animation->prefetched + image_animation->prefetched_first;
+
+    if (iter->index == index)
+    {
+      image_animation->prefetched_mem_size -= iter->mem_size;
+      image_animation->prefetched_first =
+          (image_animation->prefetched_first + 1) % IMAGE_ANIMATION_PREFETCH_MAX_NR;
+      image_animation->prefetched_nr--;
+
+      return TRUE;
+    }
+
+    image_animation_clear_prefetched(image_animation);
+  }
+
+  return FALSE;
+}
+
+static bool_t image_animation_need_prefetch(image_animation_t *image_animation)
+{
+  if (image_animation->prefetch_mem_size == 0 || image_animation->timer_id == TK_INVALID_ID ||
+      image_animation->index < 0 || image_animation->image == NULL)
+  {
+    return FALSE;
+  }
+
+  /*空闲回调在绘制之前执行，当前帧还没有绘制时不要解码后面的帧，绘制完成后再重新开始预取。*/
+  if (image_animation->painted_index != image_animation->index ||
+      image_animation->prefetched_nr >= IMAGE_ANIMATION_PREFETCH_MAX_NR)
+  {
+    return FALSE;
+  }
+
+  /*下一帧的大小未知，按上一帧估算。*/
+  return image_animation->prefetched_mem_size + image_animation->frame_mem_size <=
+         image_animation->prefetch_mem_size;
+}
+
+static ret_t image_animation_on_idle_prefetch(const idle_info_t *info)
+{
+  bitmap_t bitmap;
+  int32_t index = 0;
+  char name[TK_NAME_LEN + 1];
+  widget_t *widget = NULL;
+  image_animation_frame_t *frame = NULL;
+  image_animation_t *image_animation = NULL;
+  return_value_if_fail(info != NULL, RET_REMOVE);
+
+  widget = WIDGET(info->ctx);
+  image_animation = IMAGE_ANIMATION(info->ctx);
+  return_value_if_fail(widget != NULL && image_animation != NULL, RET_REMOVE);
+
+  if (image_animation_need_prefetch(image_animation))
+  {
+    index = image_animation->index;
+    if (image_animation->prefetched_nr > 0)
+    {
+      uint32_t last = (image_animation->prefetched_first + image_animation->prefetched_nr - 1) %
+                      IMAGE_ANIMATION_PREFETCH_MAX_NR;
+      index = image_animation->prefetched[last].index;
+    }
+
+    /*每次只解码一帧，避免长时间占用主循环。*/
+    index = image_animation_index_after(image_animation, index);
+    if (index >= 0 && index != image_animation->index)
+    {
+      image_animation_get_image_name_at(image_animation, index, name);
+      if (widget_load_image(widget, name, &bitmap) == RET_OK)
+      {
+        frame = image_animation->prefetched +
+                (image_animation->prefetched_first + image_animation->prefetched_nr) %
+                    IMAGE_ANIMATION_PREFETCH_MAX_NR;
+        frame->index = index;
+        frame->mem_size = bitmap.line_length * bitmap.h;
+
+        image_animation->frame_mem_size = frame->mem_size;
+        image_animation->prefetched_mem_size += frame->mem_size;
+        image_animation->prefetched_nr++;
+
+        return RET_REPEAT;
+      }
+    }
+  }
+
+  image_animation->prefetch_idle_id = TK_INVALID_ID;
+
+  return RET_REMOVE;
+}
+
+static ret_t image_animation_prefetch(image_animation_t *image_animation)
+{
+  if (image_animation->prefetch_idle_id == TK_INVALID_ID &&
+      image_animation_need_prefetch(image_animation))
+  {
+    image_animation->prefetch_idle_id =
+        widget_add_idle(WIDGET(image_animation), image_animation_on_idle_prefetch);
+  }
+
+  return RET_OK;
+}
+
 #define MAX_CACHE_NR 60
 
 static ret_t on_idle_unload_image(const idle_info_t *info)
@@ -89,12 +265,33 @@ static ret_t on_idle_unload_image(const idle_info_t *info)
 
 static ret_t image_animation_load_image(image_animation_t *image_animation, bitmap_t *bitmap)
 {
+  ret_t ret = RET_OK;
   char name[TK_NAME_LEN + 1];
   widget_t *widget = WIDGET(image_animation);
   return_value_if_fail(widget != NULL && image_animation != NULL && bitmap != NULL, RET_BAD_PARAMS);
 
   image_animation_get_image_name(image_animation, name);
-  return widget_load_image(widget, name, bitmap);
+  if (image_animation->index != image_animation->painted_index)
+  {
+    image_animation->stats.frames++;
+    if (image_animation_take_prefetched(image_animation, image_animation->index))
+    {
+      image_animation->stats.prefetched++;
+    }
+    else
+    {
+      image_animation->stats.misses++;
+    }
+    image_animation->painted_index = image_animation->index;
+  }
+
+  ret = widget_load_image(widget, name, bitmap);
+  if (ret == RET_OK)
+  {
+    image_animation->frame_mem_size = bitmap->line_length * bitmap->h;
+  }
+
+  return ret;
 }
 
 static ret_t image_animation_on_paint_self(widget_t *widget, canvas_t *c)
@@ -121,6 +318,8 @@ static ret_t image_animation_on_paint_self(widget_t *widget, canvas_t *c)
         widget_add_idle(widget, on_idle_unload_image);
       }
     }
+
+    image_animation_prefetch(image_animation);
   }
 
   return RET_OK;
@@ -189,6 +388,11 @@ static ret_t image_animation_get_prop(widget_t *widget, const char *name, value_
     value_set_bool(v, image_animation->show_when_done);
     return RET_OK;
   }
+  else if (tk_str_eq(name, IMAGE_ANIMATION_PROP_PREFETCH_MEM_SIZE))
+  {
+    value_set_uint32(v, image_animation->prefetch_mem_size);
+    return RET_OK;
+  }
 
   return RET_NOT_FOUND;
 }
@@ -273,6 +477,10 @@ static ret_t image_animation_set_prop(widget_t *widget, const char *name, const
   {
     return image_animation_set_show_when_done(widget, value_bool(v));
   }
+  else if (tk_str_eq(name, IMAGE_ANIMATION_PROP_PREFETCH_MEM_SIZE))
+  {
+    return image_animation_set_prefetch_mem_size(widget, value_uint32(v));
+  }
 
   return RET_NOT_FOUND;
 }
@@ -287,6 +495,7 @@ static ret_t image_animation_on_destroy(widget_t *widget)
     timer_remove(image_animation->timer_id);
     image_animation->timer_id = TK_INVALID_ID;
   }
+  image_animation_clear_prefetched(image_animation);
   image_animation->image_buffer = NULL;
   TKMEM_FREE(image_animation->image);
   TKMEM_FREE(image_animation->sequence);
@@ -368,6 +577,9 @@ widget_t *image_animation_create(widget_t *parent, xy_t x, xy_t y, wh_t w, wh_t
   image_animation->interval = 16;
   image_animation->loop = TRUE;
   image_animation->auto_play = FALSE;
+  image_animation->painted_index = -1;
+  image_animation->prefetch_idle_id = TK_INVALID_ID;
+  image_animation->prefetch_mem_size = IMAGE_ANIMATION_PREFETCH_MEM_SIZE;
 
   return widget;
 }
@@ -387,6 +599,7 @@ ret_t image_animation_set_image(widget_t *widget, const char *image)
   image_animation_t *image_animation = IMAGE_ANIMATION(widget);
   return_value_if_fail(image_animation != NULL && image != NULL, RET_BAD_PARAMS);
 
+  image_animation_clear_prefetched(image_animation);
   image_animation->image = tk_str_copy(image_animation->image, image);
 
   return RET_OK;
@@ -444,6 +657,7 @@ ret_t image_animation_set_sequence(widget_t *widget, const char *sequence)
   image_animation_t *image_animation = IMAGE_ANIMATION(widget);
   return_value_if_fail(image_animation != NULL && sequence != NULL, RET_BAD_PARAMS);
 
+  image_animation_clear_prefetched(image_animation);
   if (sequence != NULL && sequence[0] != '\0')
   {
     image_animation->index = 0;
@@ -466,6 +680,7 @@ ret_t image_animation_set_range_sequence(widget_t *widget, uint32_t start_index,
   image_animation_t *image_animation = IMAGE_ANIMATION(widget);
   return_value_if_fail(image_animation != NULL, RET_BAD_PARAMS);
 
+  image_animation_clear_prefetched(image_animation);
   image_animation->index = start_index;
   image_animation->end_index = end_index;
   image_animation->start_index = start_index;
@@ -555,6 +770,17 @@ static ret_t image_animation_on_update(const timer_info_t *info)
   image_animation_t *image_animation = IMAGE_ANIMATION(widget);
   return_value_if_fail(info != NULL && image_animation != NULL, RET_BAD_PARAMS);
 
+  /*定时器从触发的时刻重新计时，累计晚了一个interval，说明有一帧没能按时显示。*/
+  if (image_animation->last_update_time > 0 && image_animation->interval > 0 &&
+      info->now > image_animation->last_update_time + image_animation->interval)
+  {
+    image_animation->late_time +=
+        info->now - image_animation->last_update_time - image_animation->interval;
+    image_animation->stats.dropped += image_animation->late_time / image_animation->interval;
+    image_animation->late_time %= image_animation->interval;
+  }
+  image_animation->last_update_time = info->now;
+
   image_animation->playing = TRUE;
   ret = image_animation_update(widget);
 
@@ -568,6 +794,8 @@ ret_t image_animation_play(widget_t *widget)
 
   if (image_animation->timer_id == TK_INVALID_ID)
   {
+    image_animation->late_time = 0;
+    image_animation->last_update_time = 0;
     image_animation->timer_id =
         timer_add(image_animation_on_update, widget, image_animation->interval);
   }
@@ -590,6 +818,7 @@ ret_t image_animation_stop(widget_t *widget)
 
   image_animation_pause(widget);
   image_animation_play_to_done(image_animation);
+  image_animation_clear_prefetched(image_animation);
 
   return RET_OK;
 }
@@ -614,6 +843,7 @@ ret_t image_animation_set_format(widget_t *widget, const char *format)
   image_animation_t *image_animation = IMAGE_ANIMATION(widget);
   return_value_if_fail(image_animation != NULL && format != NULL, RET_BAD_PARAMS);
 
+  image_animation_clear_prefetched(image_animation);
   if (format != NULL && format[0] != '\0')
   {
     image_animation->format = tk_str_copy(image_animation->format, format);
@@ -627,11 +857,36 @@ ret_t image_animation_set_format(widget_t *widget, const char *format)
   return widget_invalidate(widget, NULL);
 }
 
+ret_t image_animation_set_prefetch_mem_size(widget_t *widget, uint32_t prefetch_mem_size)
+{
+  image_animation_t *image_animation = IMAGE_ANIMATION(widget);
+  return_value_if_fail(image_animation != NULL, RET_BAD_PARAMS);
+
+  image_animation->prefetch_mem_size = prefetch_mem_size;
+  if (prefetch_mem_size == 0)
+  {
+    image_animation_clear_prefetched(image_animation);
+  }
+
+  return RET_OK;
+}
+
+ret_t image_animation_get_stats(widget_t *widget, image_animation_stats_t *stats)
+{
+  image_animation_t *image_animation = IMAGE_ANIMATION(widget);
+  return_value_if_fail(image_animation != NULL && stats != NULL, RET_BAD_PARAMS);
+
+  *stats = image_animation->stats;
+
+  return RET_OK;
+}
+
 ret_t image_animation_set_reverse(widget_t *widget, bool_t reverse)
 {
   image_animation_t *image_animation = IMAGE_ANIMATION(widget);
   return_value_if_fail(image_animation != NULL, RET_BAD_PARAMS);
 
+  image_animation_clear_prefetched(image_animation);
   image_animation->reverse = reverse;
   return RET_OK;
 }
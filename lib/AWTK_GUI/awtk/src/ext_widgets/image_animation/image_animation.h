@@ -26,6 +26,53 @@
 
 BEGIN_C_DECLS
 
+#ifndef IMAGE_ANIMATION_PREFETCH_MEM_SIZE
+#define IMAGE_ANIMATION_PREFETCH_MEM_SIZE 0
+#endif /*IMAGE_ANIMATION_PREFETCH_MEM_SIZE*/
+
+#ifndef IMAGE_ANIMATION_PREFETCH_MAX_NR
+#define IMAGE_ANIMATION_PREFETCH_MAX_NR 8
+#endif /*IMAGE_ANIMATION_PREFETCH_MAX_NR*/
+
+/**
+ * @class image_animation_stats_t
+ * 图片动画的播放统计信息。
+ */
+typedef struct _image_animation_stats_t
+{
+  /**
+   * @property {uint32_t} frames
+   * @annotation ["readable"]
+   * 绘制的帧数(同一帧重复绘制只计一次)。
+   */
+  uint32_t frames;
+  /**
+   * @property {uint32_t} prefetched
+   * @annotation ["readable"]
+   * 绘制时已经预先解码好的帧数。
+   */
+  uint32_t prefetched;
+  /**
+   * @property {uint32_t} misses
+   * @annotation ["readable"]
+   * 绘制时没有预先解码，需要在绘制时解码的帧数。
+   */
+  uint32_t misses;
+  /**
+   * @property {uint32_t} dropped
+   * @annotation ["readable"]
+   * 解码或者绘制太慢，定时器累计晚了多少个interval。
+   */
+  uint32_t dropped;
+} image_animation_stats_t;
+
+/*private*/
+typedef struct _image_animation_frame_t
+{
+  int32_t index;
+  uint32_t mem_size;
+} image_animation_frame_t;
+
 /**
  * @class image_animation_t
  * @parent widget_t
@@ -62,6 +109,9 @@ BEGIN_C_DECLS
  *
  * 可用通过style来设置控件的显示风格，如背景颜色和边框等等，不过一般情况并不需要。
  *
+ * 设置prefetch\_mem\_size后，播放时会在空闲时预先解码后面的几帧(占用的内存不超过prefetch\_mem\_size)，
+ * 绘制时直接使用缓存中的图片，避免在绘制时解码图片。
+ *
  */
 typedef struct _image_animation_t
 {
@@ -140,6 +190,13 @@ typedef struct _image_animation_t
    * 结束后是否继续显示最后一帧。
    */
   bool_t show_when_done;
+  /**
+   * @property {uint32_t} prefetch_mem_size
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 预先解码的帧最多占用的内存(字节数)，0表示不预先解码。
+   * 缺省值由宏IMAGE\_ANIMATION\_PREFETCH\_MEM\_SIZE指定。
+   */
+  uint32_t prefetch_mem_size;
 
   /*private*/
   bool_t inited;
@@ -147,6 +204,17 @@ typedef struct _image_animation_t
   int32_t index;
   uint32_t timer_id;
   void *image_buffer;
+
+  int32_t painted_index;
+  uint32_t prefetch_idle_id;
+  uint32_t frame_mem_size;
+  uint64_t last_update_time;
+  uint32_t late_time;
+  image_animation_frame_t prefetched[IMAGE_ANIMATION_PREFETCH_MAX_NR];
+  uint32_t prefetched_first;
+  uint32_t prefetched_nr;
+  uint32_t prefetched_mem_size;
+  image_animation_stats_t stats;
 } image_animation_t;
 
 /**
@@ -327,6 +395,27 @@ ret_t image_animation_set_format(widget_t *widget, const char *format);
  */
 ret_t image_animation_set_unload_after_paint(widget_t *widget, bool_t unload_after_paint);
 
+/**
+ * @method image_animation_set_prefetch_mem_size
+ * 设置预先解码的帧最多占用的内存。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget image_animation对象。
+ * @param {uint32_t} prefetch_mem_size 最多占用的内存(字节数)，0表示不预先解码。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_animation_set_prefetch_mem_size(widget_t *widget, uint32_t prefetch_mem_size);
+
+/**
+ * @method image_animation_get_stats
+ * 获取播放的统计信息。
+ * @param {widget_t*} widget image_animation对象。
+ * @param {image_animation_stats_t*} stats 用于返回统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_animation_get_stats(widget_t *widget, image_animation_stats_t *stats);
+
 /**
  * @method image_animation_set_reverse
  * 设置是否倒序播放。
@@ -378,6 +467,7 @@ bool_t image_animation_is_playing(widget_t *widget);
 #define IMAGE_ANIMATION_PROP_AUTO_PLAY "auto_play"
 #define IMAGE_ANIMATION_PROP_SHOW_WHEN_DENO "show_when_done"
 #define IMAGE_ANIMATION_PROP_UNLOAD_AFTER_PAINT "unload_after_paint"
+#define IMAGE_ANIMATION_PROP_PREFETCH_MEM_SIZE "prefetch_mem_size"
 
 #define WIDGET_TYPE_IMAGE_ANIMATION "image_animation"
 #define IMAGE_ANIMATION(widget) ((image_animation_t *)(image_animation_cast(WIDGET(widget))))
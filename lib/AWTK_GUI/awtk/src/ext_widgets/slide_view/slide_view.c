@@ -23,6 +23,8 @@
 #include "../../tkc/utils.h"
 #include "../../base/timer.h"
 #include "../../tkc/easing.h"
+#include "../../base/widget_vtable.h"
+#include "../../base/canvas_offline.h"
 #include "slide_view.h"
 #include "../../widgets/default_focused_child.inc"
 #include "../../widget_animators/widget_animator_scroll.h"
@@ -86,6 +88,133 @@ static ret_t canvas_set_clip_rect_with_offset(canvas_t *c, rect_t *r, rect_t *sa
   return canvas_set_clip_rect(c, &rr);
 }
 
+static ret_t slide_view_release_layers(slide_view_t *slide_view)
+{
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(slide_view->layers); i++)
+  {
+    slide_view_layer_t *layer = slide_view->layers + i;
+
+    if (layer->canvas != NULL)
+    {
+      canvas_offline_destroy(layer->canvas);
+    }
+    memset(layer, 0x00, sizeof(*layer));
+  }
+  slide_view->layers_failed = FALSE;
+
+  return RET_OK;
+}
+
+static bitmap_format_t slide_view_get_layer_format(widget_t *page, canvas_t *c)
+{
+  bitmap_format_t format = lcd_get_desired_bitmap_format(c->lcd);
+  color_t bg = style_get_color(page->astyle, STYLE_ID_BG_COLOR, color_init(0, 0, 0, 0));
+
+  /*页面背景不透明时，贴图时会覆盖下面的内容，可以直接使用LCD的格式。*/
+  if (bg.rgba.a == 0xff && page->opacity >= TK_OPACITY_ALPHA &&
+      style_get_int(page->astyle, STYLE_ID_ROUND_RADIUS, 0) == 0)
+  {
+    if (format == BITMAP_FMT_BGR565 || format == BITMAP_FMT_RGB565 ||
+        format == BITMAP_FMT_BGRA8888 || format == BITMAP_FMT_RGBA8888)
+    {
+      return format;
+    }
+  }
+
+  return BITMAP_FMT_BGRA8888;
+}
+
+static ret_t slide_view_render_layer(slide_view_layer_t *layer)
+{
+  widget_t *page = layer->page;
+  canvas_t *c = layer->canvas;
+  bitmap_t *bitmap = canvas_offline_get_bitmap(c);
+
+  canvas_offline_begin_draw(c);
+  if (bitmap->format == BITMAP_FMT_BGRA8888 || bitmap->format == BITMAP_FMT_RGBA8888)
+  {
+    canvas_offline_clear_canvas(c);
+  }
+  canvas_translate(c, -page->x, -page->y);
+  widget_paint(page, c);
+  canvas_untranslate(c, -page->x, -page->y);
+  canvas_offline_end_draw(c);
+
+  bitmap->flags |= BITMAP_FLAG_CHANGED;
+  layer->dirty = FALSE;
+
+  return RET_OK;
+}
+
+static bitmap_t *slide_view_get_page_layer(slide_view_t *slide_view, canvas_t *c, widget_t *page)
+{
+  slide_view_layer_t *layer = NULL;
+  widget_t *widget = WIDGET(slide_view);
+
+  if (!slide_view->cache_pages || slide_view->layers_failed || !page->visible || page->w <= 0 ||
+      page->h <= 0)
+  {
+    return NULL;
+  }
+
+  /*第一个缓存当前页，第二个缓存正在滑入或者滑出的相邻页。*/
+  layer = slide_view->layers + (page == widget_get_child(widget, slide_view->active) ? 0 : 1);
+  if (layer->page != page)
+  {
+    if (page->need_update_style)
+    {
+      widget_update_style(page);
+    }
+
+    if (layer->canvas != NULL)
+    {
+      bitmap_t *bitmap = canvas_offline_get_bitmap(layer->canvas);
+
+      if (bitmap->w != page->w || bitmap->h != page->h ||
+          bitmap->format != slide_view_get_layer_format(page, c))
+      {
+        canvas_offline_destroy(layer->canvas);
+        layer->canvas = NULL;
+      }
+    }
+
+    layer->page = page;
+    layer->dirty = TRUE;
+  }
+
+  if (layer->canvas == NULL)
+  {
+    layer->canvas = canvas_offline_create(page->w, page->h, slide_view_get_layer_format(page, c));
+    if (layer->canvas == NULL)
+    {
+      slide_view_release_layers(slide_view);
+      slide_view->layers_failed = TRUE;
+      return NULL;
+    }
+  }
+
+  if (layer->dirty)
+  {
+    slide_view_render_layer(layer);
+  }
+
+  return canvas_offline_get_bitmap(layer->canvas);
+}
+
+static ret_t slide_view_paint_page(slide_view_t *slide_view, canvas_t *c, widget_t *page)
+{
+  bitmap_t *bitmap = slide_view_get_page_layer(slide_view, c, page);
+
+  if (bitmap != NULL)
+  {
+    return canvas_draw_image_at(c, bitmap, page->x, page->y);
+  }
+
+  return widget_paint(page, c);
+}
+
 widget_t *slide_view_get_prev(slide_view_t *slide_view)
 {
   widget_t *widget = WIDGET(slide_view);
@@ -222,6 +351,7 @@ static ret_t slide_view_on_scroll_done(void *ctx, event_t *e)
   slide_view->remove_when_anim_done = FALSE;
   slide_view->prev = NULL;
   slide_view->next = NULL;
+  slide_view_release_layers(slide_view);
 
   widget->dirty = FALSE;
   widget_invalidate(widget, NULL);
@@ -545,6 +675,11 @@ static ret_t slide_view_get_prop(widget_t *widget, const char *name, value_t *v)
     value_set_uint32(v, slide_view->animating_time);
     return RET_OK;
   }
+  else if (tk_str_eq(name, SLIDE_VIEW_PROP_CACHE_PAGES))
+  {
+    value_set_bool(v, slide_view->cache_pages);
+    return RET_OK;
+  }
 
   return RET_NOT_FOUND;
 }
@@ -597,6 +732,10 @@ static ret_t slide_view_set_prop(widget_t *widget, const char *name, const value
     slide_view_set_animating_time(widget, value_uint32(v));
     return RET_OK;
   }
+  else if (tk_str_eq(name, SLIDE_VIEW_PROP_CACHE_PAGES))
+  {
+    return slide_view_set_cache_pages(widget, value_bool(v));
+  }
 
   return RET_NOT_FOUND;
 }
@@ -628,7 +767,7 @@ static ret_t slide_view_paint_prev_next_v_translate(slide_view_t *slide_view, ca
       canvas_save(c);
       canvas_translate(c, 0, -r_yoffset);
       canvas_set_clip_rect_with_offset(c, &r, save_r, ox, oy);
-      widget_paint(prev, c);
+      slide_view_paint_page(slide_view, c, prev);
       canvas_untranslate(c, 0, -r_yoffset);
       canvas_restore(c);
     }
@@ -650,7 +789,7 @@ static ret_t slide_view_paint_prev_next_v_translate(slide_view_t *slide_view, ca
       canvas_save(c);
       canvas_translate(c, 0, yoffset);
       canvas_set_clip_rect_with_offset(c, &r, save_r, ox, oy);
-      widget_paint(next, c);
+      slide_view_paint_page(slide_view, c, next);
       canvas_untranslate(c, 0, yoffset);
       canvas_restore(c);
     }
@@ -687,12 +826,12 @@ static ret_t slide_view_paint_prev_next_v_overlap(slide_view_t *slide_view, canv
     canvas_save(c);
     if (r_yoffset > h)
     {
-      widget_paint(next, c);
+      slide_view_paint_page(slide_view, c, next);
     }
     else
     {
       slide_view_set_global_alpha(slide_view, c, yoffset, h);
-      widget_paint(next, c);
+      slide_view_paint_page(slide_view, c, next);
       canvas_set_global_alpha(c, 0xff);
     }
     canvas_restore(c);
@@ -713,7 +852,7 @@ static ret_t slide_view_paint_prev_next_v_overlap(slide_view_t *slide_view, canv
       canvas_save(c);
       canvas_translate(c, 0, -r_yoffset);
       canvas_set_clip_rect_with_offset(c, &r, save_r, ox, oy);
-      widget_paint(prev, c);
+      slide_view_paint_page(slide_view, c, prev);
       canvas_untranslate(c, 0, -r_yoffset);
       canvas_restore(c);
     }
@@ -781,7 +920,7 @@ static ret_t slide_view_paint_prev_next_h_translate(slide_view_t *slide_view, ca
       canvas_save(c);
       canvas_translate(c, -r_xoffset, 0);
       canvas_set_clip_rect_with_offset(c, &r, save_r, ox, oy);
-      widget_paint(prev, c);
+      slide_view_paint_page(slide_view, c, prev);
       canvas_untranslate(c, -r_xoffset, 0);
       canvas_restore(c);
     }
@@ -803,7 +942,7 @@ static ret_t slide_view_paint_prev_next_h_translate(slide_view_t *slide_view, ca
       canvas_save(c);
       canvas_translate(c, xoffset, 0);
       canvas_set_clip_rect_with_offset(c, &r, save_r, ox, oy);
-      widget_paint(next, c);
+      slide_view_paint_page(slide_view, c, next);
       canvas_untranslate(c, xoffset, 0);
       canvas_restore(c);
     }
@@ -828,12 +967,12 @@ static ret_t slide_view_paint_prev_next_h_overlap(slide_view_t *slide_view, canv
     canvas_save(c);
     if (xoffset > w)
     {
-      widget_paint(prev, c);
+      slide_view_paint_page(slide_view, c, prev);
     }
     else
     {
       slide_view_set_global_alpha(slide_view, c, r_xoffset, w);
-      widget_paint(prev, c);
+      slide_view_paint_page(slide_view, c, prev);
       canvas_set_global_alpha(c, 0xff);
     }
     canvas_restore(c);
@@ -854,7 +993,7 @@ static ret_t slide_view_paint_prev_next_h_overlap(slide_view_t *slide_view, canv
       canvas_save(c);
       canvas_translate(c, xoffset, 0);
       canvas_set_clip_rect_with_offset(c, &r, save_r, ox, oy);
-      widget_paint(next, c);
+      slide_view_paint_page(slide_view, c, next);
       canvas_untranslate(c, xoffset, 0);
       canvas_restore(c);
     }
@@ -927,6 +1066,7 @@ static ret_t slide_view_on_paint_children(widget_t *widget, canvas_t *c)
     }
     else
     {
+      slide_view_release_layers(slide_view);
       widget_paint(active, c);
     }
   }
@@ -942,6 +1082,7 @@ static ret_t slide_view_on_paint_children(widget_t *widget, canvas_t *c)
     }
     else
     {
+      slide_view_release_layers(slide_view);
       widget_paint(active, c);
     }
   }
@@ -975,11 +1116,43 @@ static ret_t slide_view_on_destroy(widget_t *widget)
     timer_remove(slide_view->timer_id);
     slide_view->timer_id = 0;
   }
+  slide_view_release_layers(slide_view);
   TKMEM_FREE(slide_view->anim_hint);
   str_reset(&(slide_view->str_target));
   return RET_OK;
 }
 
+static ret_t slide_view_invalidate(widget_t *widget, const rect_t *r)
+{
+  slide_view_t *slide_view = SLIDE_VIEW(widget);
+  return_value_if_fail(slide_view != NULL && r != NULL, RET_BAD_PARAMS);
+
+  /*
+   * widget_invalidate会把发起刷新的控件标记为dirty，并清除所有父控件的dirty标志。
+   * 所以slide_view不是dirty时，说明是页面中的控件需要刷新，缓存的页面已经过期。
+   */
+  if (!widget->dirty)
+  {
+    slide_view->layers[0].dirty = TRUE;
+    slide_view->layers[1].dirty = TRUE;
+  }
+
+  return widget_invalidate_default(widget, r);
+}
+
+static ret_t slide_view_on_remove_child(widget_t *widget, widget_t *child)
+{
+  slide_view_t *slide_view = SLIDE_VIEW(widget);
+  return_value_if_fail(slide_view != NULL, RET_BAD_PARAMS);
+
+  if (slide_view->layers[0].page == child || slide_view->layers[1].page == child)
+  {
+    slide_view_release_layers(slide_view);
+  }
+
+  return RET_FAIL;
+}
+
 static ret_t slide_view_get_only_active_children(widget_t *widget, darray_t *all_focusable)
 {
   widget_t *child = widget_find_target(widget, 1, 1);
@@ -1006,6 +1179,8 @@ TK_DECL_VTABLE(slide_view) = {.size = sizeof(slide_view_t),
                               .find_target = slide_view_find_target,
                               .on_paint_children = slide_view_on_paint_children,
                               .on_paint_self = slide_view_on_paint_self,
+                              .invalidate = slide_view_invalidate,
+                              .on_remove_child = slide_view_on_remove_child,
                               .on_destroy = slide_view_on_destroy};
 
 static ret_t slide_view_on_idle_init_save_target(const idle_info_t *idle)
@@ -1260,6 +1435,20 @@ ret_t slide_view_set_animating_time(widget_t *widget, uint32_t animating_time)
   return RET_OK;
 }
 
+ret_t slide_view_set_cache_pages(widget_t *widget, bool_t cache_pages)
+{
+  slide_view_t *slide_view = SLIDE_VIEW(widget);
+  return_value_if_fail(slide_view != NULL, RET_BAD_PARAMS);
+
+  slide_view->cache_pages = cache_pages;
+  if (!cache_pages)
+  {
+    slide_view_release_layers(slide_view);
+  }
+
+  return RET_OK;
+}
+
 widget_t *slide_view_create(widget_t *parent, xy_t x, xy_t y, wh_t w, wh_t h)
 {
   widget_t *widget = widget_create(parent, TK_REF_VTABLE(slide_view), x, y, w, h);
@@ -27,6 +27,14 @@
 
 BEGIN_C_DECLS
 
+/*private*/
+typedef struct _slide_view_layer_t
+{
+  widget_t *page;
+  canvas_t *canvas;
+  bool_t dirty;
+} slide_view_layer_t;
+
 /**
  * @class slide_view_t
  * @parent widget_t
@@ -73,6 +81,10 @@ BEGIN_C_DECLS
  *
  * > 如果希望背景图片跟随滚动，请将背景图片设置到页面上，否则设置到slide\_view上。
  *
+ * 设置cache\_pages为TRUE后，滑动时把当前页和相邻页各绘制一次到离线画布，之后每一帧只贴图。
+ * 页面中的控件需要刷新时重新绘制离线画布，滑动结束后释放离线画布。
+ * > 页面背景不透明时离线画布使用LCD的格式，否则使用BGRA8888。内存不足时自动退回直接绘制页面。
+ *
  * > 更多用法请参考：[theme default](
  * https://github.com/zlgopen/awtk/blob/master/design/default/styles/default.xml#L458)
  *
@@ -128,6 +140,14 @@ typedef struct _slide_view_t
    */
   uint32_t animating_time;
 
+  /**
+   * @property {bool_t} cache_pages
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 滑动时是否把页面缓存到离线画布(缺省不缓存)。
+   *
+   */
+  bool_t cache_pages;
+
   /* private */
   velocity_t velocity;
   point_t down;
@@ -152,6 +172,10 @@ typedef struct _slide_view_t
   /* for move */
   uint32_t move_idle_id;
 
+  /* for page layer cache */
+  slide_view_layer_t layers[2];
+  bool_t layers_failed;
+
 } slide_view_t;
 
 /**
@@ -299,6 +323,17 @@ ret_t slide_view_set_drag_threshold(widget_t *widget, uint32_t drag_threshold);
  */
 ret_t slide_view_set_animating_time(widget_t *widget, uint32_t animating_time);
 
+/**
+ * @method slide_view_set_cache_pages
+ * 设置滑动时是否把页面缓存到离线画布。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget slide_view对象。
+ * @param {bool_t} cache_pages 是否缓存页面。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slide_view_set_cache_pages(widget_t *widget, bool_t cache_pages);
+
 /**
  * @method slide_view_remove_index
  * 删除指定序号页面。
@@ -316,6 +351,8 @@ widget_t *slide_view_get_next(slide_view_t *slide_view);
 ret_t slide_view_activate_prev(slide_view_t *slide_view);
 ret_t slide_view_activate_next(slide_view_t *slide_view);
 
+#define SLIDE_VIEW_PROP_CACHE_PAGES "cache_pages"
+
 #define SLIDE_VIEW(widget) ((slide_view_t *)(slide_view_cast(WIDGET(widget))))
 
 /*public for subclass and runtime type check*/
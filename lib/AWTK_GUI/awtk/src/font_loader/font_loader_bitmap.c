@@ -23,11 +23,16 @@
 #include "../tkc/utils.h"
 #include "font_loader_bitmap.h"
 
+/*资源中的字模头与glyph_t中data和spans之前的部分相同，点阵紧随其后*/
+#define FONT_BITMAP_GLYPH_HEADER_SIZE (sizeof(glyph_t) - 2 * sizeof(const uint8_t *))
+
 typedef struct _font_bitmap_t
 {
   font_t base;
   const uint8_t *buff;
   uint32_t buff_size;
+  font_bitmap_get_fallback_t get_fallback;
+  void *fallback_ctx;
 } font_bitmap_t;
 
 static font_bitmap_index_t *find_glyph(font_bitmap_index_t *elms, uint32_t nr, wchar_t c)
@@ -65,18 +70,30 @@ static ret_t font_bitmap_get_glyph(font_t *f, wchar_t c, font_size_t font_size,
   font_bitmap_t *font = (font_bitmap_t *)f;
   font_bitmap_header_t *header = (font_bitmap_header_t *)(font->buff);
   font_bitmap_index_t *index = find_glyph(header->index, header->char_nr, c);
+
+  if ((index == NULL || header->font_size != font_size) && font->get_fallback != NULL)
+  {
+    /*位图字体里没有的字符，由回退字体(一般是同名的 Truetype 字体)渲染*/
+    font_t *fallback = font->get_fallback(font->fallback_ctx, f->name, font_size);
+    if (fallback != NULL && fallback != f)
+    {
+      return font_get_glyph(fallback, c, font_size, g);
+    }
+    return RET_NOT_FOUND;
+  }
   return_value_if_fail(index != NULL, RET_NOT_FOUND);
   return_value_if_fail(header->font_size == font_size, RET_NOT_FOUND);
 
   p = (font->buff + index->offset);
-  memcpy(g, p, sizeof(glyph_t));
+  memcpy(g, p, FONT_BITMAP_GLYPH_HEADER_SIZE);
+  g->spans = NULL;
   if (c == ' ')
   {
     g->data = NULL;
   }
   else
   {
-    g->data = font->buff + index->offset + sizeof(glyph_t) - sizeof(g->data);
+    g->data = p + FONT_BITMAP_GLYPH_HEADER_SIZE;
   }
 
   return RET_OK;
@@ -140,6 +157,21 @@ font_t *font_bitmap_create(const char *name, const uint8_t *buff, uint32_t buff_
   return font_bitmap_init(font, name, buff, buff_size);
 }
 
+ret_t font_bitmap_set_fallback(font_t *f, font_bitmap_get_fallback_t get_fallback, void *ctx)
+{
+  font_bitmap_t *font = (font_bitmap_t *)f;
+  return_value_if_fail(f != NULL, RET_BAD_PARAMS);
+
+  if (f->get_glyph != font_bitmap_get_glyph)
+  {
+    return RET_NOT_IMPL;
+  }
+  font->get_fallback = get_fallback;
+  font->fallback_ctx = ctx;
+
+  return RET_OK;
+}
+
 static font_t *font_bitmap_load(font_loader_t *loader, const char *name, const uint8_t *buff,
                                 uint32_t buff_size)
 {
@@ -48,6 +48,19 @@ typedef struct _font_bitmap_header_t
 
 font_t *font_bitmap_create(const char *name, const uint8_t *buff, uint32_t buff_size);
 
+/**
+ * 获取回退字体的函数。name 为位图字体的名称，size 为字号。
+ */
+typedef font_t *(*font_bitmap_get_fallback_t)(void *ctx, const char *name, font_size_t size);
+
+/**
+ * 设置回退字体。位图字体里没有的字符(或字号不同)时，用 get_fallback 返回的字体获取字模。
+ * 回退字体每次都重新获取，位图字体不持有它。
+ *
+ * @return 不是位图字体时返回 RET_NOT_IMPL。
+ */
+ret_t font_bitmap_set_fallback(font_t *font, font_bitmap_get_fallback_t get_fallback, void *ctx);
+
 /**
  * @class font_loader_bitmap_t
  * @parent font_loader_t
@@ -81,6 +81,7 @@ static ret_t font_ft_get_glyph(font_t *f, wchar_t c, font_size_t font_size, glyp
       FT_LOAD_DEFAULT | FT_LOAD_RENDER | FT_LOAD_NO_AUTOHINT | FT_OUTLINE_HIGH_PRECISION;
 
   g->data = NULL;
+  g->spans = NULL;
   if (glyph_cache_lookup(&(font->cache), c, font_size, g) == RET_OK)
   {
     return RET_OK;
@@ -123,6 +124,10 @@ static ret_t font_ft_get_glyph(font_t *f, wchar_t c, font_size_t font_size, glyp
           TKMEM_FREE(g_ft);
           g_ft = NULL;
         }
+        else
+        {
+          g->spans = g_ft->glyph.spans;
+        }
       }
       if (g_ft == NULL)
       {
@@ -223,6 +228,7 @@ static font_t *font_ft_create_ex(const char *name, const uint8_t *buff, uint32_t
   tk_strncpy(f->base.name, name, TK_NAME_LEN);
 
   glyph_cache_init(&(f->cache), TK_GLYPH_CACHE_NR, destroy_glyph);
+  glyph_cache_set_max_bytes(&(f->cache), TK_GLYPH_CACHE_MAX_BYTES);
 
   return &(f->base);
 }
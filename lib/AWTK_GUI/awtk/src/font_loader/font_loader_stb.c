@@ -143,6 +143,7 @@ static ret_t font_stb_get_glyph(font_t *f, wchar_t c, font_size_t font_size, gly
   g->format = GLYPH_FMT_ALPHA;
   g->advance = advance * scale;
   g->data = NULL;
+  g->spans = NULL;
 
   if (bitmap != NULL)
   {
@@ -172,6 +173,10 @@ static ret_t font_stb_get_glyph(font_t *f, wchar_t c, font_size_t font_size, gly
         TKMEM_FREE(gg);
         gg = NULL;
       }
+      else
+      {
+        g->spans = gg->spans;
+      }
     }
     if (gg == NULL)
     {
@@ -233,6 +238,7 @@ static font_t *font_stb_create_ex(const char *name, const uint8_t *buff, uint32_
   tk_strncpy(f->base.name, name, TK_NAME_LEN);
 
   glyph_cache_init(&(f->cache), TK_GLYPH_CACHE_NR, destroy_glyph);
+  glyph_cache_set_max_bytes(&(f->cache), TK_GLYPH_CACHE_MAX_BYTES);
   stbtt_InitFont(&(f->stb_font), buff, stbtt_GetFontOffsetForIndex(buff, 0));
   stbtt_GetFontVMetrics(&(f->stb_font), &(f->ascent), &(f->descent), &(f->line_gap));
 
@@ -0,0 +1,753 @@
+﻿/**
+ * File:   gif_decoder.c
+ * Author: AWTK Develop Team
+ * Brief:  frame by frame gif decoder
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#include "../tkc/mem.h"
+#include "../tkc/utils.h"
+#include "../base/system_info.h"
+#include "../base/pixel_pack_unpack.h"
+#include "gif_decoder.h"
+
+#define GIF_HEADER_SIZE 13
+#define GIF_DESCRIPTOR_SIZE 9
+#define GIF_LZW_MAX_CODES 4096
+
+#define GIF_TAG_EXTENSION 0x21
+#define GIF_TAG_DESCRIPTOR 0x2C
+#define GIF_EXT_GRAPHIC_CONTROL 0xF9
+
+#define GIF_DISPOSE_BACKGROUND 2
+#define GIF_DISPOSE_PREVIOUS 3
+
+/*按照浏览器的惯例，不大于10毫秒的延时按100毫秒处理。*/
+#define GIF_MIN_DELAY 10
+#define GIF_DEFAULT_DELAY 100
+
+/*解码一帧时使用的临时数据(约17K)。每个解码器创建时分配一次，避免每帧都分配和释放。*/
+typedef struct _gif_frame_ctx_t
+{
+  uint16_t prefix[GIF_LZW_MAX_CODES];
+  uint8_t suffix[GIF_LZW_MAX_CODES];
+  uint8_t stack[GIF_LZW_MAX_CODES + 1];
+  uint32_t palette[256];
+  int32_t transparent;
+
+  /*压缩数据*/
+  const uint8_t *p;
+  const uint8_t *end;
+  uint32_t block_left;
+
+  /*输出位置*/
+  uint8_t *fb;
+  uint32_t bpp;
+  uint32_t line_length;
+  rect_t rect;
+  uint8_t *dst;
+  uint32_t col;
+  uint32_t row;
+  uint32_t pass;
+  bool_t interlaced;
+} gif_frame_ctx_t;
+
+static const uint8_t s_interlace_start[] = {0, 4, 2, 1};
+static const uint8_t s_interlace_step[] = {8, 8, 4, 2};
+
+static uint16_t gif_get16(const uint8_t *p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+static uint32_t gif_palette_size(uint8_t flags)
+{
+  return (flags & 0x80) ? 3 * (2 << (flags & 0x07)) : 0;
+}
+
+/*跳过数据子块，返回块结束符之后的位置，数据不完整时返回NULL。*/
+static const uint8_t *gif_skip_sub_blocks(const uint8_t *p, const uint8_t *end)
+{
+  while (p < end)
+  {
+    uint8_t len = *p++;
+    if (len == 0)
+    {
+      return p;
+    }
+    p += len;
+  }
+
+  return NULL;
+}
+
+static bitmap_format_t gif_decoder_get_format(bool_t opaque)
+{
+  bitmap_format_t opaque_format = BITMAP_FMT_RGBA8888;
+  bitmap_format_t transparent_format = BITMAP_FMT_RGBA8888;
+
+#ifdef WITH_BITMAP_BGR565
+  opaque_format = BITMAP_FMT_BGR565;
+#elif defined(WITH_BITMAP_RGB565)
+  opaque_format = BITMAP_FMT_RGB565;
+#elif defined(WITH_BITMAP_BGR888)
+  opaque_format = BITMAP_FMT_BGR888;
+#elif defined(WITH_BITMAP_RGB888)
+  opaque_format = BITMAP_FMT_RGB888;
+#endif /*WITH_BITMAP_RGB565*/
+
+#ifdef WITH_BITMAP_BGRA
+  transparent_format = BITMAP_FMT_BGRA8888;
+#endif /*WITH_BITMAP_BGRA*/
+
+#ifdef WITH_LCD_MONO
+  return BITMAP_FMT_NONE;
+#endif /*WITH_LCD_MONO*/
+
+  return opaque ? opaque_format : transparent_format;
+}
+
+static uint32_t gif_color_to_pixel(bitmap_format_t format, const uint8_t *rgb)
+{
+  uint32_t pixel = 0;
+  uint16_t pixel16 = 0;
+  uint8_t *d = (uint8_t *)&pixel;
+  uint8_t r = rgb[0];
+  uint8_t g = rgb[1];
+  uint8_t b = rgb[2];
+
+  switch (format)
+  {
+  case BITMAP_FMT_BGR565:
+    pixel16 = rgb_to_bgr565(r, g, b);
+    memcpy(d, &pixel16, sizeof(pixel16));
+    break;
+  case BITMAP_FMT_RGB565:
+    pixel16 = rgb_to_rgb565(r, g, b);
+    memcpy(d, &pixel16, sizeof(pixel16));
+    break;
+  case BITMAP_FMT_BGR888:
+    d[0] = b;
+    d[1] = g;
+    d[2] = r;
+    break;
+  case BITMAP_FMT_RGB888:
+    d[0] = r;
+    d[1] = g;
+    d[2] = b;
+    break;
+  case BITMAP_FMT_BGRA8888:
+    d[0] = b;
+    d[1] = g;
+    d[2] = r;
+    d[3] = 0xff;
+    break;
+  default:
+    d[0] = r;
+    d[1] = g;
+    d[2] = b;
+    d[3] = 0xff;
+    break;
+  }
+
+  return pixel;
+}
+
+/*
+ * 扫描全部数据块：统计帧数，检查图像描述符是否越界，并判断合成后的图像是否始终不透明
+ * (没有透明色、没有恢复成背景的帧，且第一帧覆盖整个画布)。
+ */
+static ret_t gif_decoder_scan(gif_decoder_t *gif, bool_t *opaque)
+{
+  const uint8_t *p = gif->data + gif->first_offset;
+  const uint8_t *end = gif->data + gif->size;
+
+  *opaque = TRUE;
+  gif->frames_nr = 0;
+  while (p != NULL && p < end)
+  {
+    uint8_t tag = *p++;
+
+    if (tag == GIF_TAG_EXTENSION)
+    {
+      break_if_fail(p + 1 < end);
+      if (p[0] == GIF_EXT_GRAPHIC_CONTROL && p[1] == 4 && p + 6 < end)
+      {
+        uint8_t packed = p[2];
+        if ((packed & 0x01) || ((packed >> 2) & 0x07) == GIF_DISPOSE_BACKGROUND)
+        {
+          *opaque = FALSE;
+        }
+      }
+      p = gif_skip_sub_blocks(p + 1, end);
+    }
+    else if (tag == GIF_TAG_DESCRIPTOR)
+    {
+      uint32_t x = 0;
+      uint32_t y = 0;
+      uint32_t w = 0;
+      uint32_t h = 0;
+      break_if_fail(p + GIF_DESCRIPTOR_SIZE < end);
+
+      x = gif_get16(p);
+      y = gif_get16(p + 2);
+      w = gif_get16(p + 4);
+      h = gif_get16(p + 6);
+      return_value_if_fail(x + w <= gif->w && y + h <= gif->h, RET_BAD_PARAMS);
+      if (gif->frames_nr == 0 && (x != 0 || y != 0 || w != gif->w || h != gif->h))
+      {
+        *opaque = FALSE;
+      }
+
+      p += GIF_DESCRIPTOR_SIZE + gif_palette_size(p[8]) + 1;
+      p = p < end ? gif_skip_sub_blocks(p, end) : NULL;
+      if (p != NULL)
+      {
+        gif->frames_nr++;
+      }
+    }
+    else
+    {
+      /*结束符，或者不认识的数据(与stb一样，忽略后面的数据)。*/
+      break;
+    }
+  }
+
+  return gif->frames_nr > 0 ? RET_OK : RET_BAD_PARAMS;
+}
+
+static int32_t gif_frame_read_byte(gif_frame_ctx_t *ctx)
+{
+  if (ctx->block_left == 0)
+  {
+    if (ctx->p >= ctx->end || *ctx->p == 0)
+    {
+      return -1;
+    }
+    ctx->block_left = *ctx->p++;
+  }
+
+  if (ctx->p >= ctx->end)
+  {
+    return -1;
+  }
+  ctx->block_left--;
+
+  return *ctx->p++;
+}
+
+static bool_t gif_frame_next_row(gif_frame_ctx_t *ctx)
+{
+  ctx->col = 0;
+  if (ctx->interlaced)
+  {
+    ctx->row += s_interlace_step[ctx->pass];
+    while (ctx->row >= (uint32_t)(ctx->rect.h) && ctx->pass < 3)
+    {
+      ctx->pass++;
+      ctx->row = s_interlace_start[ctx->pass];
+    }
+  }
+  else
+  {
+    ctx->row++;
+  }
+
+  if (ctx->row >= (uint32_t)(ctx->rect.h))
+  {
+    return FALSE;
+  }
+  ctx->dst = ctx->fb + (ctx->rect.y + ctx->row) * ctx->line_length + ctx->rect.x * ctx->bpp;
+
+  return TRUE;
+}
+
+/*把stack中的颜色索引(逆序)写入当前帧，所有行都写完时返回FALSE。*/
+static bool_t gif_frame_output(gif_frame_ctx_t *ctx, const uint8_t *sp)
+{
+  uint32_t bpp = ctx->bpp;
+  int32_t transparent = ctx->transparent;
+
+  while (sp > ctx->stack)
+  {
+    uint8_t index = *--sp;
+
+    if (index != transparent)
+    {
+      uint32_t pixel = ctx->palette[index];
+      if (bpp == 2)
+      {
+        memcpy(ctx->dst, &pixel, 2);
+      }
+      else if (bpp == 4)
+      {
+        memcpy(ctx->dst, &pixel, 4);
+      }
+      else
+      {
+        memcpy(ctx->dst, &pixel, 3);
+      }
+    }
+    ctx->dst += bpp;
+
+    if (++ctx->col >= (uint32_t)(ctx->rect.w))
+    {
+      if (!gif_frame_next_row(ctx))
+      {
+        return FALSE;
+      }
+    }
+  }
+
+  return TRUE;
+}
+
+static ret_t gif_frame_decode(gif_frame_ctx_t *ctx, uint32_t min_code_size)
+{
+  uint32_t i = 0;
+  uint32_t bits = 0;
+  uint32_t nbits = 0;
+  int32_t old = -1;
+  uint8_t first = 0;
+  uint32_t clear = 0;
+  uint32_t avail = 0;
+  uint32_t code_size = 0;
+  uint32_t mask = 0;
+  return_value_if_fail(min_code_size >= 1 && min_code_size <= 11, RET_BAD_PARAMS);
+
+  clear = 1 << min_code_size;
+  avail = clear + 2;
+  code_size = min_code_size + 1;
+  mask = (1 << code_size) - 1;
+  for (i = 0; i < clear; i++)
+  {
+    ctx->prefix[i] = 0;
+    ctx->suffix[i] = (uint8_t)i;
+  }
+
+  for (;;)
+  {
+    uint32_t in = 0;
+    uint32_t code = 0;
+    uint8_t *sp = ctx->stack;
+
+    while (nbits < code_size)
+    {
+      int32_t b = gif_frame_read_byte(ctx);
+      if (b < 0)
+      {
+        /*数据提前结束，与stb一样保留已经解码的部分。*/
+        return RET_OK;
+      }
+      bits |= (uint32_t)b << nbits;
+      nbits += 8;
+    }
+
+    code = bits & mask;
+    bits >>= code_size;
+    nbits -= code_size;
+
+    if (code == clear)
+    {
+      code_size = min_code_size + 1;
+      mask = (1 << code_size) - 1;
+      avail = clear + 2;
+      old = -1;
+      continue;
+    }
+    else if (code == clear + 1)
+    {
+      return RET_OK;
+    }
+
+    if (old < 0)
+    {
+      return_value_if_fail(code < clear, RET_FAIL);
+      first = (uint8_t)code;
+      old = code;
+      *sp++ = first;
+      if (!gif_frame_output(ctx, sp))
+      {
+        return RET_OK;
+      }
+      continue;
+    }
+
+    in = code;
+    if (code >= avail)
+    {
+      return_value_if_fail(code == avail, RET_FAIL);
+      *sp++ = first;
+      code = old;
+    }
+
+    while (code >= clear)
+    {
+      *sp++ = ctx->suffix[code];
+      code = ctx->prefix[code];
+    }
+    first = ctx->suffix[code];
+    *sp++ = first;
+
+    if (avail < GIF_LZW_MAX_CODES)
+    {
+      ctx->prefix[avail] = (uint16_t)old;
+      ctx->suffix[avail] = first;
+      avail++;
+      if ((avail & mask) == 0 && avail < GIF_LZW_MAX_CODES)
+      {
+        code_size++;
+        mask = (1 << code_size) - 1;
+      }
+    }
+    old = in;
+
+    if (!gif_frame_output(ctx, sp))
+    {
+      return RET_OK;
+    }
+  }
+}
+
+static ret_t gif_decoder_fill_rect(gif_decoder_t *gif, uint8_t *fb, const rect_t *r,
+                                   const uint8_t *src)
+{
+  int32_t y = 0;
+  bitmap_t *bitmap = gif->bitmap;
+  uint32_t bpp = bitmap_get_bpp(bitmap);
+  uint32_t size = r->w * bpp;
+  uint32_t line_length = bitmap_get_physical_line_length(bitmap);
+
+  for (y = 0; y < r->h; y++)
+  {
+    uint8_t *d = fb + (r->y + y) * line_length + r->x * bpp;
+    if (src != NULL)
+    {
+      memcpy(d, src, size);
+      src += size;
+    }
+    else
+    {
+      memset(d, 0x00, size);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t gif_decoder_save_rect(gif_decoder_t *gif, uint8_t *fb, const rect_t *r)
+{
+  int32_t y = 0;
+  uint8_t *d = NULL;
+  bitmap_t *bitmap = gif->bitmap;
+  uint32_t bpp = bitmap_get_bpp(bitmap);
+  uint32_t size = r->w * bpp;
+  uint32_t line_length = bitmap_get_physical_line_length(bitmap);
+
+  gif->saved = (uint8_t *)TKMEM_ALLOC(size * r->h + 1);
+  return_value_if_fail(gif->saved != NULL, RET_OOM);
+
+  d = gif->saved;
+  for (y = 0; y < r->h; y++)
+  {
+    memcpy(d, fb + (r->y + y) * line_length + r->x * bpp, size);
+    d += size;
+  }
+
+  return RET_OK;
+}
+
+/*按照上一帧的处置方式恢复它占用的区域，返回需要重绘的区域。*/
+static rect_t gif_decoder_dispose(gif_decoder_t *gif, uint8_t *fb)
+{
+  rect_t dirty = rect_init(0, 0, 0, 0);
+
+  if (gif->dispose == GIF_DISPOSE_BACKGROUND)
+  {
+    gif_decoder_fill_rect(gif, fb, &(gif->rect), NULL);
+    dirty = gif->rect;
+  }
+  else if (gif->dispose == GIF_DISPOSE_PREVIOUS && gif->saved != NULL)
+  {
+    gif_decoder_fill_rect(gif, fb, &(gif->rect), gif->saved);
+    dirty = gif->rect;
+  }
+
+  TKMEM_FREE(gif->saved);
+  gif->dispose = 0;
+
+  return dirty;
+}
+
+static ret_t gif_decoder_decode_frame(gif_decoder_t *gif, uint8_t *fb, gif_frame_ctx_t *ctx)
+{
+  uint8_t lflags = 0;
+  uint8_t dispose = 0;
+  uint32_t delay = 0;
+  const uint8_t *colors = NULL;
+  uint32_t colors_nr = 0;
+  uint32_t i = 0;
+  const uint8_t *p = gif->data + gif->offset;
+  const uint8_t *end = gif->data + gif->size;
+  bitmap_format_t format = gif->bitmap->format;
+
+  ctx->transparent = -1;
+  for (;;)
+  {
+    uint8_t tag = 0;
+    return_value_if_fail(p != NULL && p < end, RET_FAIL);
+
+    tag = *p++;
+    if (tag == GIF_TAG_EXTENSION)
+    {
+      return_value_if_fail(p + 1 < end, RET_FAIL);
+      if (p[0] == GIF_EXT_GRAPHIC_CONTROL && p[1] == 4 && p + 6 < end)
+      {
+        dispose = (p[2] >> 2) & 0x07;
+        delay = gif_get16(p + 3) * 10;
+        ctx->transparent = (p[2] & 0x01) ? p[5] : -1;
+      }
+      p = gif_skip_sub_blocks(p + 1, end);
+    }
+    else if (tag == GIF_TAG_DESCRIPTOR)
+    {
+      break;
+    }
+    else
+    {
+      return RET_FAIL;
+    }
+  }
+
+  /*图像描述符和帧数据已经在gif_decoder_scan中检查过*/
+  ctx->rect = rect_init(gif_get16(p), gif_get16(p + 2), gif_get16(p + 4), gif_get16(p + 6));
+  lflags = p[8];
+  p += GIF_DESCRIPTOR_SIZE;
+  if (lflags & 0x80)
+  {
+    colors = p;
+    colors_nr = 2 << (lflags & 0x07);
+    p += gif_palette_size(lflags);
+  }
+  else
+  {
+    colors = gif->data + GIF_HEADER_SIZE;
+    colors_nr = gif_palette_size(gif->data[10]) / 3;
+  }
+
+  for (i = 0; i < colors_nr; i++)
+  {
+    ctx->palette[i] = gif_color_to_pixel(format, colors + i * 3);
+  }
+  for (; i < ARRAY_SIZE(ctx->palette); i++)
+  {
+    ctx->palette[i] = 0;
+  }
+
+  if (dispose == GIF_DISPOSE_PREVIOUS && ctx->rect.w > 0 && ctx->rect.h > 0)
+  {
+    return_value_if_fail(gif_decoder_save_rect(gif, fb, &(ctx->rect)) == RET_OK, RET_OOM);
+  }
+
+  ctx->p = p + 1;
+  ctx->end = gif_skip_sub_blocks(ctx->p, end);
+  return_value_if_fail(ctx->end != NULL, RET_FAIL);
+  ctx->block_left = 0;
+  ctx->fb = fb;
+  ctx->bpp = bitmap_get_bpp(gif->bitmap);
+  ctx->line_length = bitmap_get_physical_line_length(gif->bitmap);
+  ctx->col = 0;
+  ctx->row = 0;
+  ctx->pass = 0;
+  ctx->interlaced = (lflags & 0x40) != 0;
+  ctx->dst = fb + ctx->rect.y * ctx->line_length + ctx->rect.x * ctx->bpp;
+
+  if (ctx->rect.w > 0 && ctx->rect.h > 0)
+  {
+    return_value_if_fail(gif_frame_decode(ctx, *p) == RET_OK, RET_FAIL);
+  }
+
+  gif->offset = ctx->end - gif->data;
+  gif->dispose = dispose;
+  gif->rect = ctx->rect;
+  gif->delay = delay > GIF_MIN_DELAY ? delay : GIF_DEFAULT_DELAY;
+
+  return RET_OK;
+}
+
+static ret_t gif_decoder_rewind(gif_decoder_t *gif, uint8_t *fb)
+{
+  rect_t r = rect_init(0, 0, gif->w, gif->h);
+
+  TKMEM_FREE(gif->saved);
+  gif->dispose = 0;
+  gif->offset = gif->first_offset;
+
+  return gif_decoder_fill_rect(gif, fb, &r, NULL);
+}
+
+static ret_t gif_decoder_step(gif_decoder_t *gif, uint8_t *fb, gif_frame_ctx_t *ctx,
+                              rect_t *dirty)
+{
+  ret_t ret = RET_OK;
+
+  if (gif->frame + 1 >= gif->frames_nr)
+  {
+    gif_decoder_rewind(gif, fb);
+    ret = gif_decoder_decode_frame(gif, fb, ctx);
+    gif->frame = 0;
+    *dirty = rect_init(0, 0, gif->w, gif->h);
+  }
+  else
+  {
+    rect_t r = gif_decoder_dispose(gif, fb);
+
+    ret = gif_decoder_decode_frame(gif, fb, ctx);
+    gif->frame++;
+    rect_merge(&r, &(gif->rect));
+    rect_merge(dirty, &r);
+  }
+
+  return ret;
+}
+
+static ret_t gif_decoder_run(gif_decoder_t *gif, uint32_t frame, bool_t rewind, rect_t *dirty)
+{
+  ret_t ret = RET_OK;
+  uint8_t *fb = NULL;
+  gif_frame_ctx_t *ctx = gif->ctx;
+  rect_t r = rect_init(0, 0, 0, 0);
+
+  fb = bitmap_lock_buffer_for_write(gif->bitmap);
+  return_value_if_fail(fb != NULL, RET_FAIL);
+
+  if (rewind)
+  {
+    /*回到最后一帧之后，下一次从第一帧开始*/
+    gif->frame = gif->frames_nr - 1;
+  }
+
+  do
+  {
+    ret = gif_decoder_step(gif, fb, ctx, &r);
+  } while (ret == RET_OK && gif->frame != frame);
+
+  gif->bitmap->flags |= BITMAP_FLAG_CHANGED;
+  bitmap_unlock_buffer(gif->bitmap);
+
+  if (dirty != NULL)
+  {
+    *dirty = r;
+  }
+
+  return ret;
+}
+
+gif_decoder_t *gif_decoder_create(const uint8_t *data, uint32_t size)
+{
+  bool_t opaque = FALSE;
+  gif_decoder_t *gif = NULL;
+  bitmap_format_t format = BITMAP_FMT_NONE;
+  return_value_if_fail(data != NULL && size > GIF_HEADER_SIZE, NULL);
+  return_value_if_fail(memcmp(data, "GIF87a", 6) == 0 || memcmp(data, "GIF89a", 6) == 0, NULL);
+
+#if !defined(WITH_GPU) && !defined(WITH_VGCANVAS_CAIRO) && defined(WITH_FAST_LCD_PORTRAIT) && \
+    !defined(WITHOUT_FAST_LCD_PORTRAIT_FOR_IMAGE)
+  if (system_info()->flags & SYSTEM_INFO_FLAG_FAST_LCD_PORTRAIT)
+  {
+    return NULL;
+  }
+#endif
+
+  gif = TKMEM_ZALLOC(gif_decoder_t);
+  return_value_if_fail(gif != NULL, NULL);
+
+  gif->data = data;
+  gif->size = size;
+  gif->w = gif_get16(data + 6);
+  gif->h = gif_get16(data + 8);
+  gif->first_offset = GIF_HEADER_SIZE + gif_palette_size(data[10]);
+  goto_error_if_fail(gif->w > 0 && gif->h > 0 && gif->first_offset < size);
+  goto_error_if_fail(gif_decoder_scan(gif, &opaque) == RET_OK);
+  gif->ctx = TKMEM_ZALLOC(gif_frame_ctx_t);
+  goto_error_if_fail(gif->ctx != NULL);
+
+  format = gif_decoder_get_format(opaque);
+  goto_error_if_fail(format != BITMAP_FMT_NONE);
+
+  gif->bitmap = bitmap_create_ex(gif->w, gif->h, 0, format);
+  goto_error_if_fail(gif->bitmap != NULL);
+  if (opaque)
+  {
+    gif->bitmap->flags |= BITMAP_FLAG_OPAQUE;
+  }
+#ifdef WITH_BITMAP_PREMULTI_ALPHA
+  else
+  {
+    /*GIF的alpha只有0和0xff两种，不需要再预乘*/
+    gif->bitmap->flags |= BITMAP_FLAG_PREMULTI_ALPHA;
+  }
+#endif /*WITH_BITMAP_PREMULTI_ALPHA*/
+
+  goto_error_if_fail(gif_decoder_run(gif, 0, TRUE, NULL) == RET_OK);
+
+  return gif;
+error:
+  gif_decoder_destroy(gif);
+
+  return NULL;
+}
+
+ret_t gif_decoder_next(gif_decoder_t *gif, rect_t *dirty)
+{
+  return_value_if_fail(gif != NULL && gif->bitmap != NULL, RET_BAD_PARAMS);
+
+  return gif_decoder_run(gif, (gif->frame + 1) % gif->frames_nr, FALSE, dirty);
+}
+
+ret_t gif_decoder_seek(gif_decoder_t *gif, uint32_t frame, rect_t *dirty)
+{
+  return_value_if_fail(gif != NULL && gif->bitmap != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(frame < gif->frames_nr, RET_BAD_PARAMS);
+
+  if (frame == gif->frame)
+  {
+    if (dirty != NULL)
+    {
+      *dirty = rect_init(0, 0, 0, 0);
+    }
+    return RET_OK;
+  }
+
+  return gif_decoder_run(gif, frame, frame < gif->frame, dirty);
+}
+
+ret_t gif_decoder_destroy(gif_decoder_t *gif)
+{
+  return_value_if_fail(gif != NULL, RET_BAD_PARAMS);
+
+  if (gif->bitmap != NULL)
+  {
+    bitmap_destroy(gif->bitmap);
+    gif->bitmap = NULL;
+  }
+  TKMEM_FREE(gif->saved);
+  TKMEM_FREE(gif->ctx);
+  TKMEM_FREE(gif);
+
+  return RET_OK;
+}
@@ -0,0 +1,146 @@
+﻿/**
+ * File:   gif_decoder.h
+ * Author: AWTK Develop Team
+ * Brief:  frame by frame gif decoder
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_GIF_DECODER_H
+#define TK_GIF_DECODER_H
+
+#include "../tkc/rect.h"
+#include "../base/bitmap.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class gif_decoder_t
+ * 逐帧解码的GIF解码器。
+ *
+ * stb一次把全部帧解码成一张竖直排列的大图，内存需求与帧数成正比。
+ * gif\_decoder\_t只引用压缩数据(不拷贝)，内存中只保留一帧合成后的图像，每次调用gif\_decoder\_next解码下一帧，
+ * 并返回与上一帧相比发生变化的区域(GIF图像描述符给出的区域，以及上一帧需要恢复的区域)。
+ *
+ * 位图格式的选择规则与stb图片加载器相同：所有帧都不透明时使用WITH\_BITMAP\_XXX指定的格式(如BGR565)，
+ * 否则使用RGBA8888/BGRA8888。
+ * > LCD为单色屏或者启用了快速旋转(WITH\_FAST\_LCD\_PORTRAIT)时不支持，gif\_decoder\_create返回NULL。
+ *
+ * ```c
+ * rect_t dirty;
+ * gif_decoder_t* gif = gif_decoder_create(asset->data, asset->size);
+ * ...
+ * gif_decoder_next(gif, &dirty);
+ * canvas_draw_image(c, gif->bitmap, &src, &dst);
+ * ...
+ * gif_decoder_destroy(gif);
+ * ```
+ */
+typedef struct _gif_decoder_t
+{
+  /**
+   * @property {uint32_t} w
+   * @annotation ["readable"]
+   * 宽度。
+   */
+  uint32_t w;
+  /**
+   * @property {uint32_t} h
+   * @annotation ["readable"]
+   * 高度。
+   */
+  uint32_t h;
+  /**
+   * @property {uint32_t} frames_nr
+   * @annotation ["readable"]
+   * 帧数。
+   */
+  uint32_t frames_nr;
+  /**
+   * @property {uint32_t} frame
+   * @annotation ["readable"]
+   * 当前帧的序号。
+   */
+  uint32_t frame;
+  /**
+   * @property {uint32_t} delay
+   * @annotation ["readable"]
+   * 当前帧的显示时间(毫秒)。
+   */
+  uint32_t delay;
+  /**
+   * @property {bitmap_t*} bitmap
+   * @annotation ["readable"]
+   * 当前帧合成后的图像。
+   */
+  bitmap_t *bitmap;
+
+  /*private*/
+  const uint8_t *data;
+  uint32_t size;
+  uint32_t offset;
+  uint32_t first_offset;
+  uint8_t dispose;
+  rect_t rect;
+  uint8_t *saved;
+  struct _gif_frame_ctx_t *ctx;
+} gif_decoder_t;
+
+/**
+ * @method gif_decoder_create
+ * 创建GIF解码器，并解码第一帧。
+ * @annotation ["constructor"]
+ * @param {const uint8_t*} data GIF数据(在解码器销毁之前必须一直有效)。
+ * @param {uint32_t} size GIF数据的长度。
+ *
+ * @return {gif_decoder_t*} 返回解码器对象，数据无效或者不支持时返回NULL。
+ */
+gif_decoder_t *gif_decoder_create(const uint8_t *data, uint32_t size);
+
+/**
+ * @method gif_decoder_next
+ * 解码下一帧，最后一帧之后回到第一帧。
+ * @param {gif_decoder_t*} gif 解码器对象。
+ * @param {rect_t*} dirty 返回发生变化的区域(图像坐标)，可以为NULL。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t gif_decoder_next(gif_decoder_t *gif, rect_t *dirty);
+
+/**
+ * @method gif_decoder_seek
+ * 解码到指定的帧。
+ * > 往回跳时需要从第一帧开始重新解码。
+ * @param {gif_decoder_t*} gif 解码器对象。
+ * @param {uint32_t} frame 帧的序号。
+ * @param {rect_t*} dirty 返回发生变化的区域(图像坐标)，可以为NULL。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t gif_decoder_seek(gif_decoder_t *gif, uint32_t frame, rect_t *dirty);
+
+/**
+ * @method gif_decoder_destroy
+ * 销毁解码器。
+ * @param {gif_decoder_t*} gif 解码器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t gif_decoder_destroy(gif_decoder_t *gif);
+
+END_C_DECLS
+
+#endif /*TK_GIF_DECODER_H*/
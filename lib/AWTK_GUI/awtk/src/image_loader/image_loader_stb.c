@@ -29,6 +29,7 @@
 #include "../../3rd/stb/stb_image.h"
 #include "../base/system_info.h"
 #include "../image_loader/image_loader_stb.h"
+#include "../base/pixel_pack_unpack.h"
 
 static uint8_t *convert_2_to_4(uint8_t *src, uint32_t w, uint32_t h)
 {
@@ -57,6 +58,309 @@ static uint8_t *convert_2_to_4(uint8_t *src, uint32_t w, uint32_t h)
   return data;
 }
 
+static bool_t stb_data_is_opaque(const uint8_t *data, uint32_t w, uint32_t h, int n)
+{
+  if (n == 2)
+  {
+    uint32_t i = 0;
+    uint32_t size = w * h;
+
+    for (i = 0; i < size; i++)
+    {
+      if (data[i * 2 + 1] != 0xff)
+      {
+        return FALSE;
+      }
+    }
+
+    return TRUE;
+  }
+
+  return rgba_data_is_opaque(data, w, h, n);
+}
+
+/*
+ * 在stb解码出的缓冲区中直接转换成目标格式，并把缓冲区交给位图，不再分配第二份位图数据。
+ * 目标格式每像素的字节数不超过n时才能原地转换(写入位置始终不超过读取位置)。
+ */
+static ret_t stb_init_bitmap_in_place(bitmap_t *image, uint8_t *data, uint32_t w, uint32_t h,
+                                      int n, bool_t bgr, bool_t opaque, bitmap_format_t format)
+{
+  uint32_t i = 0;
+  uint8_t r = 0;
+  uint8_t g = 0;
+  uint8_t b = 0;
+  uint8_t a = 0xff;
+  uint8_t *d = data;
+  const uint8_t *s = data;
+  uint32_t size = w * h;
+  uint32_t bpp = bitmap_get_bpp_of_format(format);
+  uint8_t *shrinked = NULL;
+
+  for (i = 0; i < size; i++)
+  {
+    if (n < 3)
+    {
+      r = g = b = s[0];
+      a = (n == 2) ? s[1] : 0xff;
+    }
+    else
+    {
+      r = bgr ? s[2] : s[0];
+      g = s[1];
+      b = bgr ? s[0] : s[2];
+      a = (n == 4) ? s[3] : 0xff;
+    }
+
+    switch (format)
+    {
+    case BITMAP_FMT_BGR565:
+      *(uint16_t *)d = rgb_to_bgr565(r, g, b);
+      break;
+    case BITMAP_FMT_RGB565:
+      *(uint16_t *)d = rgb_to_rgb565(r, g, b);
+      break;
+    case BITMAP_FMT_BGR888:
+      d[0] = b;
+      d[1] = g;
+      d[2] = r;
+      break;
+    case BITMAP_FMT_RGB888:
+      d[0] = r;
+      d[1] = g;
+      d[2] = b;
+      break;
+    case BITMAP_FMT_BGRA8888:
+      d[0] = b;
+      d[1] = g;
+      d[2] = r;
+      d[3] = a;
+      break;
+    default:
+      d[0] = r;
+      d[1] = g;
+      d[2] = b;
+      d[3] = a;
+      break;
+    }
+
+    s += n;
+    d += bpp;
+  }
+
+  if (bpp < (uint32_t)n)
+  {
+    shrinked = (uint8_t *)TKMEM_REALLOC(data, size * bpp);
+    if (shrinked != NULL)
+    {
+      data = shrinked;
+    }
+  }
+
+  memset(image, 0x00, sizeof(bitmap_t));
+  image->w = w;
+  image->h = h;
+  image->format = format;
+  image->flags = BITMAP_FLAG_IMMUTABLE;
+  if (opaque)
+  {
+    image->flags |= BITMAP_FLAG_OPAQUE;
+  }
+  bitmap_set_line_length(image, 0);
+
+  image->buffer = GRAPHIC_BUFFER_CREATE_WITH_DATA(data, w, h, format);
+  if (image->buffer == NULL)
+  {
+    TKMEM_FREE(data);
+    return RET_OOM;
+  }
+  image->data_free_ptr = data;
+  image->should_free_data = TRUE;
+
+  return RET_OK;
+}
+
+#if !defined(STBI_NO_JPEG) && !defined(HAS_STB_YUV_TO_RGB_G2D)
+/*
+ * 直接把jpg解码成16位色的位图：与stb的load_jpeg_image相同，逐行重采样和颜色转换，
+ * 但每行转换后立即写入位图，不再生成完整的RGB缓冲区。
+ * 仅支持灰度和YCbCr/RGB三通道的图片，其它情况返回RET_NOT_IMPL，由调用者走通用流程。
+ */
+static ret_t stb_load_jpeg_to_565(const uint8_t *buff, uint32_t buff_size, bitmap_t *image,
+                                  bitmap_format_t format)
+{
+  int k = 0;
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t w = 0;
+  uint32_t h = 0;
+  int img_n = 0;
+  bool_t is_rgb = FALSE;
+  ret_t ret = RET_OK;
+  stbi__context s;
+  stbi__jpeg *z = NULL;
+  uint8_t *row = NULL;
+  uint8_t *bdata = NULL;
+  uint32_t line_length = 0;
+  stbi_uc *coutput[3] = {NULL, NULL, NULL};
+  stbi__resample res_comp[3];
+
+  z = (stbi__jpeg *)STBI_MALLOC(sizeof(stbi__jpeg));
+  return_value_if_fail(z != NULL, RET_OOM);
+
+  stbi__start_mem(&s, buff, buff_size);
+  z->s = &s;
+  stbi__setup_jpeg(z);
+  z->s->img_n = 0;
+
+  if (!stbi__decode_jpeg_image(z))
+  {
+    stbi__cleanup_jpeg(z);
+    STBI_FREE(z);
+    return RET_FAIL;
+  }
+
+  w = z->s->img_x;
+  h = z->s->img_y;
+  img_n = z->s->img_n;
+  if (img_n != 1 && img_n != 3)
+  {
+    stbi__cleanup_jpeg(z);
+    STBI_FREE(z);
+    return RET_NOT_IMPL;
+  }
+  is_rgb = img_n == 3 && (z->rgb == 3 || (z->app14_color_transform == 0 && !z->jfif));
+
+  for (k = 0; k < img_n; k++)
+  {
+    stbi__resample *r = &res_comp[k];
+
+    z->img_comp[k].linebuf = (stbi_uc *)STBI_MALLOC(w + 3);
+    goto_error_if_fail(z->img_comp[k].linebuf != NULL);
+
+    r->hs = z->img_h_max / z->img_comp[k].h;
+    r->vs = z->img_v_max / z->img_comp[k].v;
+    r->ystep = r->vs >> 1;
+    r->w_lores = (w + r->hs - 1) / r->hs;
+    r->ypos = 0;
+    r->line0 = r->line1 = z->img_comp[k].data;
+
+    if (r->hs == 1 && r->vs == 1)
+    {
+      r->resample = resample_row_1;
+    }
+    else if (r->hs == 1 && r->vs == 2)
+    {
+      r->resample = stbi__resample_row_v_2;
+    }
+    else if (r->hs == 2 && r->vs == 1)
+    {
+      r->resample = stbi__resample_row_h_2;
+    }
+    else if (r->hs == 2 && r->vs == 2)
+    {
+      r->resample = z->resample_row_hv_2_kernel;
+    }
+    else
+    {
+      r->resample = stbi__resample_row_generic;
+    }
+  }
+
+  /*YCbCr_to_RGB_kernel总是多写一个字节(alpha)*/
+  row = (uint8_t *)STBI_MALLOC(w * 3 + 1);
+  goto_error_if_fail(row != NULL);
+  memset(image, 0x00, sizeof(bitmap_t));
+  goto_error_if_fail(bitmap_init(image, w, h, format, NULL) == RET_OK);
+  image->flags |= BITMAP_FLAG_IMMUTABLE | BITMAP_FLAG_OPAQUE;
+
+  line_length = bitmap_get_physical_line_length(image);
+  bdata = bitmap_lock_buffer_for_write(image);
+  goto_error_if_fail(bdata != NULL);
+
+  for (j = 0; j < h; j++)
+  {
+    uint8_t *p = row;
+    uint16_t *d = (uint16_t *)(bdata + j * line_length);
+
+    for (k = 0; k < img_n; k++)
+    {
+      stbi__resample *r = &res_comp[k];
+      int y_bot = r->ystep >= (r->vs >> 1);
+
+      coutput[k] = r->resample(z->img_comp[k].linebuf, y_bot ? r->line1 : r->line0,
+                               y_bot ? r->line0 : r->line1, r->w_lores, r->hs);
+      if (++r->ystep >= r->vs)
+      {
+        r->ystep = 0;
+        r->line0 = r->line1;
+        if (++r->ypos < z->img_comp[k].y)
+        {
+          r->line1 += z->img_comp[k].w2;
+        }
+      }
+    }
+
+    if (img_n == 1)
+    {
+      for (i = 0; i < w; i++)
+      {
+        p[0] = p[1] = p[2] = coutput[0][i];
+        p += 3;
+      }
+    }
+    else if (is_rgb)
+    {
+      for (i = 0; i < w; i++)
+      {
+        p[0] = coutput[0][i];
+        p[1] = coutput[1][i];
+        p[2] = coutput[2][i];
+        p += 3;
+      }
+    }
+    else
+    {
+      z->YCbCr_to_RGB_kernel(row, coutput[0], coutput[1], coutput[2], w, 3);
+    }
+
+    p = row;
+    if (format == BITMAP_FMT_BGR565)
+    {
+      for (i = 0; i < w; i++, p += 3)
+      {
+        d[i] = rgb_to_bgr565(p[0], p[1], p[2]);
+      }
+    }
+    else
+    {
+      for (i = 0; i < w; i++, p += 3)
+      {
+        d[i] = rgb_to_rgb565(p[0], p[1], p[2]);
+      }
+    }
+  }
+  bitmap_unlock_buffer(image);
+
+  STBI_FREE(row);
+  stbi__cleanup_jpeg(z);
+  STBI_FREE(z);
+
+  return RET_OK;
+error:
+  if (image->buffer != NULL)
+  {
+    bitmap_destroy(image);
+  }
+  ret = RET_OOM;
+  STBI_FREE(row);
+  stbi__cleanup_jpeg(z);
+  STBI_FREE(z);
+
+  return ret;
+}
+#endif /*!STBI_NO_JPEG && !HAS_STB_YUV_TO_RGB_G2D*/
+
 ret_t stb_load_image(int32_t subtype, const uint8_t *buff, uint32_t buff_size, bitmap_t *image,
                      bitmap_format_t transparent_bitmap_format,
                      bitmap_format_t opaque_bitmap_format, lcd_orientation_t o)
@@ -66,6 +370,18 @@ ret_t stb_load_image(int32_t subtype, const uint8_t *buff, uint32_t buff_size, b
   int n = 0;
   ret_t ret = RET_FAIL;
 
+#if !defined(STBI_NO_JPEG) && !defined(HAS_STB_YUV_TO_RGB_G2D)
+  if (subtype == ASSET_TYPE_IMAGE_JPG && o == LCD_ORIENTATION_0 &&
+      (opaque_bitmap_format == BITMAP_FMT_BGR565 || opaque_bitmap_format == BITMAP_FMT_RGB565))
+  {
+    ret = stb_load_jpeg_to_565(buff, buff_size, image, opaque_bitmap_format);
+    if (ret != RET_NOT_IMPL)
+    {
+      return ret;
+    }
+  }
+#endif /*!STBI_NO_JPEG && !HAS_STB_YUV_TO_RGB_G2D*/
+
   if (subtype != ASSET_TYPE_IMAGE_GIF)
   {
     uint8_t *data = NULL;
@@ -74,6 +390,30 @@ ret_t stb_load_image(int32_t subtype, const uint8_t *buff, uint32_t buff_size, b
         stbi_load_from_memory_ex(buff, buff_size, &w, &h, &n, &out_channel_order, 0);
     return_value_if_fail(stb_data != NULL, RET_FAIL);
 
+    if (opaque_bitmap_format != BITMAP_FMT_MONO && o == LCD_ORIENTATION_0)
+    {
+      bool_t opaque = stb_data_is_opaque(stb_data, w, h, n);
+      bitmap_format_t format = transparent_bitmap_format;
+
+      if (opaque && (opaque_bitmap_format == BITMAP_FMT_BGR565 ||
+                     opaque_bitmap_format == BITMAP_FMT_RGB565 ||
+                     opaque_bitmap_format == BITMAP_FMT_BGR888 ||
+                     opaque_bitmap_format == BITMAP_FMT_RGB888))
+      {
+        format = opaque_bitmap_format;
+      }
+      else if (format != BITMAP_FMT_BGRA8888)
+      {
+        format = BITMAP_FMT_RGBA8888;
+      }
+
+      if (bitmap_get_bpp_of_format(format) <= (uint32_t)n)
+      {
+        return stb_init_bitmap_in_place(image, stb_data, w, h, n,
+                                        out_channel_order != STBI_ORDER_RGB, opaque, format);
+      }
+    }
+
     if (n == 2)
     {
       n = 4;
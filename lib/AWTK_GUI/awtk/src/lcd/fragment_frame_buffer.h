@@ -152,8 +152,12 @@ static inline pixel_t fragment_frame_buffer_get_pixel(fragment_frame_buffer_t *f
 
 static inline ret_t fragment_frame_buffer_end_frame(fragment_frame_buffer_t *ffb)
 {
-  uint32_t i = 0;
   pixel_t *p = ffb->data;
+
+#ifdef lcd_draw_bitmap_impl
+  lcd_draw_bitmap_impl(ffb->x, ffb->y, ffb->w, ffb->h, p);
+#else
+  uint32_t i = 0;
   uint32_t nr = ffb->w * ffb->h;
 
   set_window_func(ffb->x, ffb->y, ffb->x + ffb->w - 1, ffb->y + ffb->h - 1);
@@ -161,6 +165,7 @@ static inline ret_t fragment_frame_buffer_end_frame(fragment_frame_buffer_t *ffb
   {
     write_data_func(*p);
   }
+#endif /*lcd_draw_bitmap_impl*/
 
   return RET_OK;
 }
@@ -34,6 +34,23 @@ BEGIN_C_DECLS
  * 在一些低端平台没有足够的内存提供一个完整的framebuffer，此时我们用一小块内存模拟framebuffer，
  * 每次只画屏幕上一小块。这样可以有些避免屏幕闪烁的问题。
  *
+ * 移植时需要在包含 lcd_mem_fragment.inc 之前提供刷新函数：
+ *
+ * * 定义 lcd_draw_bitmap_impl(x, y, w, h, p) 宏时，每个片段一次性整块提交给 LCD(推荐)，
+ *   可以在一次传输中完成设置窗口、字节序转换和发送数据。
+ * * 否则调用 set_window_func 设置窗口后，对每个像素调用一次 write_data_func。
+ *
+ * ```c
+ * #define lcd_draw_bitmap_impl(x, y, w, h, p) draw_bitmap_func(x, y, w, h, p)
+ * #include "lcd/lcd_mem_fragment.inc"
+ * ```
+ *
+ * 如果传输接口支持异步(如 DMA)，可以定义 FRAGMENT_FRAME_BUFFER_NR 大于 1，把 FRAGMENT_FRAME_BUFFER_SIZE
+ * 平分为多个片段缓冲区，并提供 lcd_draw_bitmap_async_impl(x, y, w, h, p) 宏启动传输。
+ * 此时 CPU 绘制下一个片段的同时，上一个片段仍在传输。每次传输完成后，需要调用
+ * lcd_mem_fragment_flush_done 通知 lcd。复用缓冲区前如果传输还没完成，会反复调用
+ * lcd_draw_bitmap_wait_impl() 宏(可选)等待。
+ *
  */
 
 /**
@@ -60,6 +77,19 @@ lcd_t *lcd_mem_fragment_create(wh_t w, wh_t h);
  */
 uint8_t *lcd_mem_fragment_get_buff(lcd_t *lcd);
 
+/**
+ * @method lcd_mem_fragment_flush_done
+ * @export none
+ *
+ * 通知 lcd 最早提交的一个片段已经传输完成，其缓冲区可以再次使用。
+ * 仅在定义了 lcd_draw_bitmap_async_impl 时有效，可以在传输完成的回调中调用。
+ *
+ * @param {lcd_t*} lcd lcd对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t lcd_mem_fragment_flush_done(lcd_t *lcd);
+
 END_C_DECLS
 
 #endif /*LCD_MEM_FRAGMENT_H*/
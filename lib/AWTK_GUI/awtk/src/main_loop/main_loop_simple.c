@@ -270,6 +270,68 @@ static ret_t main_loop_simple_step(main_loop_t *l)
     return RET_OK;
 }
 
+uint32_t main_loop_simple_get_sleep_time(main_loop_simple_t *loop)
+{
+    uint64_t now = 0;
+    uint64_t next_time = 0;
+    uint32_t sleep_time = 0;
+    event_queue_t *q = NULL;
+    widget_t *wm = NULL;
+    return_value_if_fail(loop != NULL, 0);
+
+    wm = loop->base.wm;
+    q = loop->queue;
+    if (q->r != q->w || q->full || idle_count() > 0)
+    {
+        return 0;
+    }
+
+    now = timer_manager()->get_time();
+    next_time = timer_manager_next_time(timer_manager());
+    sleep_time = next_time > now ? (uint32_t)(next_time - now) : 0;
+    sleep_time = tk_min(sleep_time, loop->base.curr_expected_sleep_time);
+
+    /*窗口动画由绘制驱动，没有定时器，脏矩形也要等下一帧，最多睡一个帧间隔*/
+    if (window_manager_is_animating(wm) || window_manager_has_dirty_rect(wm))
+    {
+        uint32_t max_fps = WINDOW_MANAGER(wm)->max_fps;
+
+        sleep_time = tk_min(sleep_time, max_fps > 0 ? 1000 / max_fps : 0);
+    }
+
+    return sleep_time;
+}
+
+static ret_t main_loop_simple_sleep(main_loop_t *l)
+{
+    uint64_t start = 0;
+    uint32_t sleep_time = 0;
+    main_loop_simple_t *loop = (main_loop_simple_t *)l;
+
+    if (loop->wait_event == NULL)
+    {
+        return main_loop_sleep_default(l);
+    }
+
+    sleep_time = main_loop_simple_get_sleep_time(loop);
+    if (sleep_time > 0)
+    {
+        start = time_now_ms();
+        if (loop->wait_event(loop, sleep_time) == RET_OK)
+        {
+            loop->wakeup_nr++;
+        }
+        else
+        {
+            loop->timeout_nr++;
+        }
+        loop->sleep_ms += time_now_ms() - start;
+    }
+    l->last_loop_time = time_now_ms();
+
+    return RET_OK;
+}
+
 static ret_t main_loop_simple_run(main_loop_t *l)
 {
     main_loop_simple_t *loop = (main_loop_simple_t *)l;
@@ -317,6 +379,7 @@ main_loop_simple_t *main_loop_simple_init(int w, int h, main_loop_queue_event_t
 
     loop->base.run = main_loop_simple_run;
     loop->base.step = main_loop_simple_step;
+    loop->base.sleep = main_loop_simple_sleep;
 
     if (recv_event != NULL && queue_event != NULL)
     {
@@ -36,6 +36,8 @@ struct _main_loop_simple_t;
 typedef struct _main_loop_simple_t main_loop_simple_t;
 
 typedef ret_t (*main_loop_dispatch_input_t)(main_loop_simple_t *loop);
+/*等待事件，被唤醒返回RET_OK，超时返回RET_TIMEOUT*/
+typedef ret_t (*main_loop_wait_event_t)(main_loop_simple_t *loop, uint32_t timeout_ms);
 
 struct _main_loop_simple_t
 {
@@ -56,12 +58,25 @@ struct _main_loop_simple_t
   void *user4;
   event_source_manager_t *event_source_manager;
   main_loop_dispatch_input_t dispatch_input;
+
+  /*
+   * tickless模式：设置了wait_event时，主循环不再按固定间隔轮询，而是阻塞到下一个定时器到期、
+   * 有idle需要处理，或者被main_loop_wakeup(如输入中断/投递事件)唤醒为止。
+   */
+  main_loop_wait_event_t wait_event;
+  /*被事件唤醒的次数*/
+  uint32_t wakeup_nr;
+  /*等待超时(定时器/动画到期)醒来的次数*/
+  uint32_t timeout_nr;
+  /*累计休眠时间(毫秒)*/
+  uint64_t sleep_ms;
 };
 
 main_loop_simple_t *main_loop_simple_init(int w, int h, main_loop_queue_event_t queue_event,
                                           main_loop_recv_event_t recv_event);
 
 ret_t main_loop_simple_reset(main_loop_simple_t *loop);
+uint32_t main_loop_simple_get_sleep_time(main_loop_simple_t *loop);
 ret_t main_loop_post_key_event(main_loop_t *l, bool_t pressed, uint8_t key);
 ret_t main_loop_post_pointer_event(main_loop_t *l, bool_t pressed, xy_t x, xy_t y);
 ret_t main_loop_post_multi_gesture_event(main_loop_t *l, multi_gesture_event_t *event);
@@ -237,7 +237,12 @@ typedef enum _asset_image_type_t
    * @const ASSET_TYPE_IMAGE_OTHER
    * 其它图片类型。
    */
-  ASSET_TYPE_IMAGE_OTHER
+  ASSET_TYPE_IMAGE_OTHER,
+  /**
+   * @const ASSET_TYPE_IMAGE_RLE
+   * 按行RLE压缩的Raw图片类型(参考bitmap\_rle\_t)。
+   */
+  ASSET_TYPE_IMAGE_RLE
 } asset_image_type_t;
 
 /**
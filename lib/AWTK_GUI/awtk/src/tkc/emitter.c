@@ -57,7 +57,70 @@ emitter_t *emitter_init(emitter_t *emitter)
 #include <emscripten.h>
 #endif /*AWTK_WEB_JS*/
 
-static ret_t emitter_item_destroy(emitter_item_t *iter)
+#ifdef WITH_WIDGET_POOL
+#include "mem_slab.h"
+
+#ifndef TK_EMITTER_ITEM_POOL_BLOCK_NR
+#define TK_EMITTER_ITEM_POOL_BLOCK_NR 32
+#endif /*TK_EMITTER_ITEM_POOL_BLOCK_NR*/
+
+/*控件的事件处理项数量多、大小固定，从slab中分配，避免堆碎片(slab没有加锁，只给pooled的emitter用)*/
+static mem_slab_t s_emitter_item_slab;
+
+static emitter_item_t *emitter_item_alloc(emitter_t *emitter)
+{
+  if (!emitter->pooled)
+  {
+    return TKMEM_ZALLOC(emitter_item_t);
+  }
+
+  if (s_emitter_item_slab.block_size == 0)
+  {
+    mem_slab_init(&s_emitter_item_slab, sizeof(emitter_item_t), TK_EMITTER_ITEM_POOL_BLOCK_NR);
+  }
+
+  return (emitter_item_t *)mem_slab_alloc(&s_emitter_item_slab);
+}
+
+static ret_t emitter_item_free(emitter_t *emitter, emitter_item_t *iter)
+{
+  if (!emitter->pooled)
+  {
+    TKMEM_FREE(iter);
+    return RET_OK;
+  }
+
+  return mem_slab_free(&s_emitter_item_slab, iter);
+}
+
+ret_t emitter_pool_trim(void)
+{
+  mem_slab_trim(&s_emitter_item_slab);
+
+  return RET_OK;
+}
+#else
+static emitter_item_t *emitter_item_alloc(emitter_t *emitter)
+{
+  (void)emitter;
+  return TKMEM_ZALLOC(emitter_item_t);
+}
+
+static ret_t emitter_item_free(emitter_t *emitter, emitter_item_t *iter)
+{
+  (void)emitter;
+  TKMEM_FREE(iter);
+
+  return RET_OK;
+}
+
+ret_t emitter_pool_trim(void)
+{
+  return RET_OK;
+}
+#endif /*WITH_WIDGET_POOL*/
+
+static ret_t emitter_item_destroy(emitter_t *emitter, emitter_item_t *iter)
 {
   if (iter->on_destroy)
   {
@@ -69,14 +132,50 @@ static ret_t emitter_item_destroy(emitter_item_t *iter)
 #endif /*AWTK_WEB_JS*/
 
   memset(iter, 0x00, sizeof(emitter_item_t));
-  TKMEM_FREE(iter);
 
-  return RET_OK;
+  return emitter_item_free(emitter, iter);
 }
 
-static ret_t emitter_remove(emitter_t *emitter, emitter_item_t *prev, emitter_item_t *iter)
+static emitter_bucket_t *emitter_find_bucket(emitter_t *emitter, uint32_t etype)
 {
-  return_value_if_fail(emitter != NULL && iter != NULL, RET_BAD_PARAMS);
+  emitter_bucket_t *iter = emitter->buckets;
+
+  while (iter != NULL)
+  {
+    if (iter->type == etype)
+    {
+      return iter;
+    }
+    iter = iter->next;
+  }
+
+  return NULL;
+}
+
+/*最后一个回调函数移除后释放bucket，注册/注销不同类型的事件时bucket链表不会一直增长*/
+static ret_t emitter_remove_bucket(emitter_t *emitter, emitter_bucket_t *bucket)
+{
+  emitter_bucket_t **prev = &(emitter->buckets);
+
+  while (*prev != NULL)
+  {
+    if (*prev == bucket)
+    {
+      *prev = bucket->next;
+      TKMEM_FREE(bucket);
+
+      return RET_OK;
+    }
+    prev = &((*prev)->next);
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t emitter_remove(emitter_t *emitter, emitter_bucket_t *bucket, emitter_item_t *prev,
+                            emitter_item_t *iter)
+{
+  return_value_if_fail(emitter != NULL && bucket != NULL && iter != NULL, RET_BAD_PARAMS);
 
   if (emitter->curr_iter == iter)
   {
@@ -84,40 +183,46 @@ static ret_t emitter_remove(emitter_t *emitter, emitter_item_t *prev, emitter_it
     return RET_OK;
   }
 
-  if (iter == emitter->items)
+  if (iter == bucket->items)
   {
-    emitter->items = iter->next;
+    bucket->items = iter->next;
   }
   else
   {
     prev->next = iter->next;
   }
 
-  emitter_item_destroy(iter);
+  emitter_item_destroy(emitter, iter);
+
+  /*dispatch开始后只沿item链表遍历，不再访问bucket；正在分发的项只标记pending_remove*/
+  if (bucket->items == NULL)
+  {
+    emitter_remove_bucket(emitter, bucket);
+  }
 
   return RET_OK;
 }
 
 ret_t emitter_remove_item(emitter_t *emitter, emitter_item_t *item)
 {
-  return_value_if_fail(emitter != NULL, RET_BAD_PARAMS);
+  emitter_bucket_t *bucket = NULL;
+  return_value_if_fail(emitter != NULL && item != NULL, RET_BAD_PARAMS);
 
-  if (emitter->items)
+  bucket = emitter_find_bucket(emitter, item->type);
+  if (bucket != NULL)
   {
-    emitter_item_t *iter = emitter->items;
-    emitter_item_t *prev = emitter->items;
+    emitter_item_t *iter = bucket->items;
+    emitter_item_t *prev = bucket->items;
 
     while (iter != NULL)
     {
-      emitter_item_t *next = iter->next;
-
       if (iter == item)
       {
-        return emitter_remove(emitter, prev, iter);
+        return emitter_remove(emitter, bucket, prev, iter);
       }
 
       prev = iter;
-      iter = next;
+      iter = iter->next;
     }
   }
 
@@ -127,48 +232,58 @@ ret_t emitter_remove_item(emitter_t *emitter, emitter_item_t *item)
 ret_t emitter_dispatch(emitter_t *emitter, event_t *e)
 {
   ret_t ret = RET_OK;
+  emitter_bucket_t *bucket = NULL;
   emitter_item_t *emitter_curr_iter = NULL;
   return_value_if_fail(emitter != NULL && e != NULL, RET_BAD_PARAMS);
 
-  if (!(e->time))
+  if (e->target == NULL)
   {
-    e->time = time_now_ms();
+    e->target = emitter;
   }
 
-  if (e->target == NULL)
+  if (emitter->disable != 0)
   {
-    e->target = emitter;
+    return RET_OK;
   }
+
+  bucket = emitter_find_bucket(emitter, e->type);
+  if (bucket == NULL || bucket->items == NULL)
+  {
+    return RET_OK;
+  }
+
+  /*没有处理函数的事件不需要时间戳*/
+  if (!(e->time))
+  {
+    e->time = time_now_ms();
+  }
+
   emitter_curr_iter = emitter->curr_iter;
-  if (emitter->disable == 0 && emitter->items)
   {
-    emitter_item_t *iter = emitter->items;
+    emitter_item_t *iter = bucket->items;
 
     while (iter != NULL)
     {
       emitter->curr_iter = iter;
-      if (iter->type == e->type)
+      ret = iter->handler(iter->ctx, e);
+      if (ret == RET_STOP)
       {
-        ret = iter->handler(iter->ctx, e);
-        if (ret == RET_STOP)
+        emitter->curr_iter = emitter_curr_iter;
+        if (iter->pending_remove)
         {
-          emitter->curr_iter = emitter_curr_iter;
-          if (iter->pending_remove)
-          {
-            emitter_remove_item(emitter, iter);
-          }
-          return ret;
+          emitter_remove_item(emitter, iter);
         }
-        else if (ret == RET_REMOVE || iter->pending_remove)
-        {
-          emitter_item_t *next = iter->next;
+        return ret;
+      }
+      else if (ret == RET_REMOVE || iter->pending_remove)
+      {
+        emitter_item_t *next = iter->next;
 
-          emitter->curr_iter = NULL;
-          emitter_remove_item(emitter, iter);
-          iter = next;
+        emitter->curr_iter = NULL;
+        emitter_remove_item(emitter, iter);
+        iter = next;
 
-          continue;
-        }
+        continue;
       }
 
       iter = iter->next;
@@ -183,9 +298,21 @@ uint32_t emitter_on_with_tag(emitter_t *emitter, uint32_t etype, event_func_t ha
                              uint32_t tag)
 {
   emitter_item_t *iter = NULL;
+  emitter_bucket_t *bucket = NULL;
   return_value_if_fail(emitter != NULL && handler != NULL, TK_INVALID_ID);
 
-  iter = TKMEM_ZALLOC(emitter_item_t);
+  bucket = emitter_find_bucket(emitter, etype);
+  if (bucket == NULL)
+  {
+    bucket = TKMEM_ZALLOC(emitter_bucket_t);
+    return_value_if_fail(bucket != NULL, TK_INVALID_ID);
+
+    bucket->type = etype;
+    bucket->next = emitter->buckets;
+    emitter->buckets = bucket;
+  }
+
+  iter = emitter_item_alloc(emitter);
   return_value_if_fail(iter != NULL, TK_INVALID_ID);
 
   iter->tag = tag;
@@ -193,23 +320,25 @@ uint32_t emitter_on_with_tag(emitter_t *emitter, uint32_t etype, event_func_t ha
   iter->type = etype;
   iter->handler = handler;
   iter->id = emitter_next_id(emitter);
-  iter->next = emitter->items;
-  emitter->items = iter;
+  iter->next = bucket->items;
+  bucket->items = iter;
 
   return iter->id;
 }
 
 bool_t emitter_exist(emitter_t *emitter, uint32_t etype, event_func_t handler, void *ctx)
 {
+  emitter_bucket_t *bucket = NULL;
   return_value_if_fail(emitter != NULL, FALSE);
 
-  if (emitter->items)
+  bucket = emitter_find_bucket(emitter, etype);
+  if (bucket != NULL)
   {
-    emitter_item_t *iter = emitter->items;
+    emitter_item_t *iter = bucket->items;
 
     while (iter != NULL)
     {
-      if (iter->handler == handler && iter->type == etype && iter->ctx == ctx)
+      if (iter->handler == handler && iter->ctx == ctx)
       {
         return TRUE;
       }
@@ -219,7 +348,6 @@ bool_t emitter_exist(emitter_t *emitter, uint32_t etype, event_func_t handler, v
   }
 
   return FALSE;
-  ;
 }
 
 uint32_t emitter_on(emitter_t *emitter, uint32_t etype, event_func_t handler, void *ctx)
@@ -229,11 +357,12 @@ uint32_t emitter_on(emitter_t *emitter, uint32_t etype, event_func_t handler, vo
 
 emitter_item_t *emitter_find(emitter_t *emitter, uint32_t id)
 {
+  emitter_bucket_t *bucket = NULL;
   return_value_if_fail(emitter != NULL, NULL);
 
-  if (emitter->items)
+  for (bucket = emitter->buckets; bucket != NULL; bucket = bucket->next)
   {
-    emitter_item_t *iter = emitter->items;
+    emitter_item_t *iter = bucket->items;
 
     while (iter != NULL)
     {
@@ -252,11 +381,12 @@ emitter_item_t *emitter_find(emitter_t *emitter, uint32_t id)
 uint32_t emitter_size(emitter_t *emitter)
 {
   uint32_t size = 0;
+  emitter_bucket_t *bucket = NULL;
   return_value_if_fail(emitter != NULL, size);
 
-  if (emitter->items)
+  for (bucket = emitter->buckets; bucket != NULL; bucket = bucket->next)
   {
-    emitter_item_t *iter = emitter->items;
+    emitter_item_t *iter = bucket->items;
 
     while (iter != NULL)
     {
@@ -270,18 +400,19 @@ uint32_t emitter_size(emitter_t *emitter)
 
 static ret_t emitter_off_ex(emitter_t *emitter, tk_compare_t cmp, void *ctx)
 {
+  emitter_bucket_t *bucket = NULL;
   return_value_if_fail(emitter != NULL, RET_BAD_PARAMS);
 
-  if (emitter->items)
+  for (bucket = emitter->buckets; bucket != NULL; bucket = bucket->next)
   {
-    emitter_item_t *iter = emitter->items;
-    emitter_item_t *prev = emitter->items;
+    emitter_item_t *iter = bucket->items;
+    emitter_item_t *prev = bucket->items;
 
     while (iter != NULL)
     {
       if (!iter->pending_remove && cmp(iter, ctx) == 0)
       {
-        return emitter_remove(emitter, prev, iter);
+        return emitter_remove(emitter, bucket, prev, iter);
       }
 
       prev = iter;
@@ -413,20 +544,27 @@ ret_t emitter_disable(emitter_t *emitter)
 
 ret_t emitter_deinit(emitter_t *emitter)
 {
+  emitter_bucket_t *bucket = NULL;
   return_value_if_fail(emitter != NULL, RET_BAD_PARAMS);
-  if (emitter->items)
+
+  bucket = emitter->buckets;
+  while (bucket != NULL)
   {
-    emitter_item_t *iter = emitter->items;
-    emitter_item_t *next = emitter->items;
+    emitter_bucket_t *next_bucket = bucket->next;
+    emitter_item_t *iter = bucket->items;
+    emitter_item_t *next = NULL;
 
     while (iter != NULL)
     {
       next = iter->next;
-      emitter_item_destroy(iter);
+      emitter_item_destroy(emitter, iter);
       iter = next;
     }
-    emitter->items = NULL;
+
+    TKMEM_FREE(bucket);
+    bucket = next_bucket;
   }
+  emitter->buckets = NULL;
 
   return RET_OK;
 }
@@ -462,16 +600,24 @@ emitter_t *emitter_cast(emitter_t *emitter)
 emitter_item_t *emitter_get_item(emitter_t *emitter, uint32_t index)
 {
   uint32_t i = 0;
-  emitter_item_t *iter = NULL;
+  emitter_bucket_t *bucket = NULL;
   return_value_if_fail(emitter != NULL && index < emitter_size(emitter), NULL);
 
-  iter = emitter->items;
-  for (i = 0; i < index && iter != NULL; i++)
+  for (bucket = emitter->buckets; bucket != NULL; bucket = bucket->next)
   {
-    iter = iter->next;
+    emitter_item_t *iter = bucket->items;
+
+    while (iter != NULL)
+    {
+      if (i++ == index)
+      {
+        return iter;
+      }
+      iter = iter->next;
+    }
   }
 
-  return iter;
+  return NULL;
 }
 
 ret_t emitter_dispatch_simple_event(emitter_t *emitter, uint32_t type)
@@ -29,6 +29,9 @@ BEGIN_C_DECLS
 struct _emitter_item_t;
 typedef struct _emitter_item_t emitter_item_t;
 
+struct _emitter_bucket_t;
+typedef struct _emitter_bucket_t emitter_bucket_t;
+
 struct _emitter_item_t
 {
   void *ctx;
@@ -43,6 +46,14 @@ struct _emitter_item_t
   emitter_item_t *next;
 };
 
+/*同一事件类型的回调函数，dispatch时只需遍历对应类型的链表*/
+struct _emitter_bucket_t
+{
+  uint32_t type;
+  emitter_item_t *items;
+  emitter_bucket_t *next;
+};
+
 /**
  * @class emitter_t
  * @order -10
@@ -53,11 +64,11 @@ struct _emitter_item_t
 typedef struct _emitter_t
 {
   /**
-   * @property {emitter_item_t*} items
+   * @property {emitter_bucket_t*} buckets
    * @annotation ["private"]
-   * 注册的回调函数集合。
+   * 注册的回调函数集合(按事件类型分组)。
    */
-  emitter_item_t *items;
+  emitter_bucket_t *buckets;
   /**
    * @property {uint32_t} next_id
    * @annotation ["private"]
@@ -77,6 +88,13 @@ typedef struct _emitter_t
    * 当前正在dispatch的项。
    */
   emitter_item_t *curr_iter;
+  /**
+   * @property {bool_t} pooled
+   * @annotation ["private"]
+   * 回调项从内存池分配(定义WITH_WIDGET_POOL时有效)。
+   * 内存池没有加锁，只给控件的emitter使用(由widget_on设置)，必须在注册回调函数之前设置。
+   */
+  bool_t pooled;
 } emitter_t;
 
 /**
@@ -316,6 +334,15 @@ ret_t emitter_forward(void *ctx, event_t *e);
     emitter_disable(EMITTER(emitter)); \
   }
 
+/**
+ * @method emitter_pool_trim
+ * 把回调项内存池中全部空闲的chunk归还给堆(没有定义WITH_WIDGET_POOL时什么也不做)。
+ * > 只能在GUI线程中调用。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t emitter_pool_trim(void);
+
 /*public for test*/
 ret_t emitter_remove_item(emitter_t *emitter, emitter_item_t *item);
 emitter_item_t *emitter_get_item(emitter_t *emitter, uint32_t index);
@@ -0,0 +1,195 @@
+﻿/**
+ * File:   mem_slab.c
+ * Author: AWTK Develop Team
+ * Brief:  fixed size block allocator
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#include "mem.h"
+#include "mem_slab.h"
+
+#define MEM_SLAB_ALIGN(size) (((size) + 7) & ~7)
+
+struct _mem_slab_chunk_t
+{
+  mem_slab_chunk_t *next;
+  uint8_t *start;
+  /*mem_slab_trim时统计的空闲块个数*/
+  uint32_t free_nr;
+};
+
+mem_slab_t *mem_slab_init(mem_slab_t *slab, uint32_t block_size, uint32_t block_nr)
+{
+  return_value_if_fail(slab != NULL && block_size > 0 && block_nr > 0, NULL);
+
+  memset(slab, 0x00, sizeof(mem_slab_t));
+  slab->block_size = MEM_SLAB_ALIGN(tk_max(block_size, sizeof(void *)));
+  slab->block_nr = block_nr;
+
+  return slab;
+}
+
+static ret_t mem_slab_add_chunk(mem_slab_t *slab)
+{
+  uint32_t i = 0;
+  uint8_t *block = NULL;
+  uint32_t head_size = MEM_SLAB_ALIGN(sizeof(mem_slab_chunk_t));
+  mem_slab_chunk_t *chunk =
+      (mem_slab_chunk_t *)TKMEM_ALLOC(head_size + slab->block_size * slab->block_nr);
+  return_value_if_fail(chunk != NULL, RET_OOM);
+
+  chunk->start = (uint8_t *)chunk + head_size;
+  chunk->next = slab->chunks;
+  slab->chunks = chunk;
+  slab->chunk_nr++;
+
+  /*把新chunk中的内存块串到空闲链表中*/
+  for (i = 0; i < slab->block_nr; i++)
+  {
+    block = chunk->start + i * slab->block_size;
+    *(void **)block = slab->free_list;
+    slab->free_list = block;
+  }
+
+  return RET_OK;
+}
+
+void *mem_slab_alloc(mem_slab_t *slab)
+{
+  void *block = NULL;
+  return_value_if_fail(slab != NULL && slab->block_size > 0, NULL);
+
+  if (slab->free_list == NULL)
+  {
+    return_value_if_fail(mem_slab_add_chunk(slab) == RET_OK, NULL);
+  }
+
+  block = slab->free_list;
+  slab->free_list = *(void **)block;
+  slab->used++;
+  memset(block, 0x00, slab->block_size);
+
+  return block;
+}
+
+static mem_slab_chunk_t *mem_slab_find_chunk(mem_slab_t *slab, uint8_t *addr)
+{
+  mem_slab_chunk_t *iter = slab->chunks;
+
+  while (iter != NULL)
+  {
+    if (addr >= iter->start && addr < (iter->start + slab->block_size * slab->block_nr))
+    {
+      return iter;
+    }
+    iter = iter->next;
+  }
+
+  return NULL;
+}
+
+ret_t mem_slab_free(mem_slab_t *slab, void *ptr)
+{
+  uint8_t *addr = (uint8_t *)ptr;
+  mem_slab_chunk_t *chunk = NULL;
+  return_value_if_fail(slab != NULL && ptr != NULL, RET_BAD_PARAMS);
+
+  chunk = mem_slab_find_chunk(slab, addr);
+  if (chunk == NULL)
+  {
+    return RET_NOT_FOUND;
+  }
+
+  assert(((addr - chunk->start) % slab->block_size) == 0);
+  *(void **)addr = slab->free_list;
+  slab->free_list = addr;
+  slab->used--;
+
+  return RET_OK;
+}
+
+uint32_t mem_slab_trim(mem_slab_t *slab)
+{
+  uint32_t nr = 0;
+  void *free_list = NULL;
+  uint8_t *block = NULL;
+  mem_slab_chunk_t *iter = NULL;
+  mem_slab_chunk_t **prev = NULL;
+  return_value_if_fail(slab != NULL, 0);
+
+  /*统计每个chunk中空闲块的个数*/
+  for (iter = slab->chunks; iter != NULL; iter = iter->next)
+  {
+    iter->free_nr = 0;
+  }
+  for (block = (uint8_t *)(slab->free_list); block != NULL; block = *(uint8_t **)block)
+  {
+    mem_slab_chunk_t *chunk = mem_slab_find_chunk(slab, block);
+    assert(chunk != NULL);
+    chunk->free_nr++;
+  }
+
+  /*重建空闲链表，去掉全部空闲的chunk中的块*/
+  block = (uint8_t *)(slab->free_list);
+  while (block != NULL)
+  {
+    uint8_t *next = *(uint8_t **)block;
+    if (mem_slab_find_chunk(slab, block)->free_nr < slab->block_nr)
+    {
+      *(void **)block = free_list;
+      free_list = block;
+    }
+    block = next;
+  }
+  slab->free_list = free_list;
+
+  prev = &(slab->chunks);
+  while (*prev != NULL)
+  {
+    iter = *prev;
+    if (iter->free_nr == slab->block_nr)
+    {
+      *prev = iter->next;
+      TKMEM_FREE(iter);
+      slab->chunk_nr--;
+      nr++;
+    }
+    else
+    {
+      prev = &(iter->next);
+    }
+  }
+
+  return nr;
+}
+
+ret_t mem_slab_deinit(mem_slab_t *slab)
+{
+  mem_slab_chunk_t *iter = NULL;
+  return_value_if_fail(slab != NULL, RET_BAD_PARAMS);
+
+  iter = slab->chunks;
+  while (iter != NULL)
+  {
+    mem_slab_chunk_t *next = iter->next;
+    TKMEM_FREE(iter);
+    iter = next;
+  }
+  memset(slab, 0x00, sizeof(mem_slab_t));
+
+  return RET_OK;
+}
@@ -0,0 +1,126 @@
+﻿/**
+ * File:   mem_slab.h
+ * Author: AWTK Develop Team
+ * Brief:  fixed size block allocator
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_MEM_SLAB_H
+#define TK_MEM_SLAB_H
+
+#include "types_def.h"
+
+BEGIN_C_DECLS
+
+struct _mem_slab_chunk_t;
+typedef struct _mem_slab_chunk_t mem_slab_chunk_t;
+
+/**
+ * @class mem_slab_t
+ * 固定大小内存块的分配器。
+ *
+ * 每次从堆中分配一个包含block\_nr个内存块的chunk，释放的内存块放回空闲链表供下次使用，
+ * 全部空闲的chunk在mem\_slab\_trim或mem\_slab\_deinit时归还给堆。
+ * 适用于反复创建/销毁的同类对象(如控件)，避免打开/关闭窗口时产生堆碎片。
+ *
+ * > 非线程安全。
+ */
+typedef struct _mem_slab_t
+{
+  /**
+   * @property {uint32_t} block_size
+   * @annotation ["readable"]
+   * 内存块的大小(按8字节对齐)。
+   */
+  uint32_t block_size;
+  /**
+   * @property {uint32_t} block_nr
+   * @annotation ["readable"]
+   * 每个chunk中内存块的个数。
+   */
+  uint32_t block_nr;
+  /**
+   * @property {uint32_t} chunk_nr
+   * @annotation ["readable"]
+   * 已经分配的chunk个数。
+   */
+  uint32_t chunk_nr;
+  /**
+   * @property {uint32_t} used
+   * @annotation ["readable"]
+   * 正在使用的内存块个数。
+   */
+  uint32_t used;
+
+  /*private*/
+  void *free_list;
+  mem_slab_chunk_t *chunks;
+} mem_slab_t;
+
+/**
+ * @method mem_slab_init
+ * 初始化mem_slab对象。
+ * @param {mem_slab_t*} slab mem_slab对象。
+ * @param {uint32_t} block_size 内存块的大小。
+ * @param {uint32_t} block_nr 每个chunk中内存块的个数。
+ *
+ * @return {mem_slab_t*} 返回mem_slab对象。
+ */
+mem_slab_t *mem_slab_init(mem_slab_t *slab, uint32_t block_size, uint32_t block_nr);
+
+/**
+ * @method mem_slab_alloc
+ * 分配一个内存块(内容清零)。
+ * @param {mem_slab_t*} slab mem_slab对象。
+ *
+ * @return {void*} 成功返回内存块，失败返回NULL。
+ */
+void *mem_slab_alloc(mem_slab_t *slab);
+
+/**
+ * @method mem_slab_free
+ * 释放内存块。
+ * @param {mem_slab_t*} slab mem_slab对象。
+ * @param {void*} ptr 内存块。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，ptr不是本slab分配的返回RET_NOT_FOUND。
+ */
+ret_t mem_slab_free(mem_slab_t *slab, void *ptr);
+
+/**
+ * @method mem_slab_trim
+ * 把全部内存块都空闲的chunk归还给堆。
+ *
+ * > 需要遍历空闲链表，不宜频繁调用(如在关闭窗口后调用)。
+ * @param {mem_slab_t*} slab mem_slab对象。
+ *
+ * @return {uint32_t} 返回归还的chunk个数。
+ */
+uint32_t mem_slab_trim(mem_slab_t *slab);
+
+/**
+ * @method mem_slab_deinit
+ * 释放全部chunk。
+ * @param {mem_slab_t*} slab mem_slab对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t mem_slab_deinit(mem_slab_t *slab);
+
+END_C_DECLS
+
+#endif /*TK_MEM_SLAB_H*/
@@ -0,0 +1,147 @@
+﻿/**
+ * File:   str_intern.c
+ * Author: AWTK Develop Team
+ * Brief:  shared read-only strings
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#include "mem.h"
+#include "str_intern.h"
+
+#ifndef TK_STR_INTERN_BUCKETS
+#define TK_STR_INTERN_BUCKETS 64
+#endif /*TK_STR_INTERN_BUCKETS*/
+
+typedef struct _str_intern_item_t
+{
+  struct _str_intern_item_t *next;
+  uint32_t hash;
+  uint32_t ref;
+} str_intern_item_t;
+
+/*字符串紧跟在str_intern_item_t之后*/
+#define STR_INTERN_ITEM_STR(item) ((char *)((item) + 1))
+
+static str_intern_item_t *s_str_intern_buckets[TK_STR_INTERN_BUCKETS];
+
+static uint32_t str_intern_hash(const char *str)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*str)
+  {
+    hash = (hash ^ (uint8_t)(*str++)) * 16777619u;
+  }
+
+  return hash;
+}
+
+static str_intern_item_t *str_intern_item_of(const char *str)
+{
+  return ((str_intern_item_t *)str) - 1;
+}
+
+char *tk_str_intern_ref(const char *str)
+{
+  uint32_t size = 0;
+  uint32_t hash = 0;
+  str_intern_item_t *iter = NULL;
+  str_intern_item_t **bucket = NULL;
+
+  if (str == NULL)
+  {
+    return NULL;
+  }
+
+  hash = str_intern_hash(str);
+  bucket = s_str_intern_buckets + (hash % TK_STR_INTERN_BUCKETS);
+  for (iter = *bucket; iter != NULL; iter = iter->next)
+  {
+    if (iter->hash == hash && strcmp(STR_INTERN_ITEM_STR(iter), str) == 0)
+    {
+      iter->ref++;
+      return STR_INTERN_ITEM_STR(iter);
+    }
+  }
+
+  size = strlen(str) + 1;
+  iter = (str_intern_item_t *)TKMEM_ALLOC(sizeof(str_intern_item_t) + size);
+  return_value_if_fail(iter != NULL, NULL);
+
+  memcpy(STR_INTERN_ITEM_STR(iter), str, size);
+  iter->ref = 1;
+  iter->hash = hash;
+  iter->next = *bucket;
+  *bucket = iter;
+
+  return STR_INTERN_ITEM_STR(iter);
+}
+
+ret_t tk_str_intern_unref(const char *str)
+{
+  str_intern_item_t *item = NULL;
+  str_intern_item_t **iter = NULL;
+  return_value_if_fail(str != NULL, RET_BAD_PARAMS);
+
+  item = str_intern_item_of(str);
+  return_value_if_fail(item->ref > 0, RET_BAD_PARAMS);
+
+  if (--item->ref > 0)
+  {
+    return RET_OK;
+  }
+
+  iter = s_str_intern_buckets + (item->hash % TK_STR_INTERN_BUCKETS);
+  while (*iter != NULL)
+  {
+    if (*iter == item)
+    {
+      *iter = item->next;
+      TKMEM_FREE(item);
+      return RET_OK;
+    }
+    iter = &((*iter)->next);
+  }
+
+  assert(!"not interned string");
+
+  return RET_NOT_FOUND;
+}
+
+char *tk_str_intern_copy(char *dst, const char *src)
+{
+  char *str = NULL;
+
+  if (src == NULL)
+  {
+    /*同tk_str_copy：src为NULL时，dst变为空字符串*/
+    src = dst != NULL ? "" : NULL;
+  }
+
+  if (dst != NULL && src != NULL && strcmp(dst, src) == 0)
+  {
+    return dst;
+  }
+
+  str = tk_str_intern_ref(src);
+  if (dst != NULL)
+  {
+    tk_str_intern_unref(dst);
+  }
+
+  return str;
+}
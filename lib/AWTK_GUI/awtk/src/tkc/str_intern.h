@@ -0,0 +1,73 @@
+﻿/**
+ * File:   str_intern.h
+ * Author: AWTK Develop Team
+ * Brief:  shared read-only strings
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_STR_INTERN_H
+#define TK_STR_INTERN_H
+
+#include "types_def.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class str_intern_t
+ * @annotation ["fake"]
+ * 字符串驻留表。
+ *
+ * 相同内容的字符串只保存一份，带引用计数，引用计数为0时释放。
+ * 用于控件的name/style/state等大量重复、很少修改的字符串，减少小块内存的分配和堆碎片。
+ *
+ * > 驻留的字符串是只读的，只能用tk\_str\_intern\_copy/tk\_str\_intern\_unref修改/释放。非线程安全。
+ */
+
+/**
+ * @method tk_str_intern_ref
+ * 获取字符串的驻留副本，引用计数加一。
+ * @annotation ["static"]
+ * @param {const char*} str 字符串。
+ *
+ * @return {char*} 返回驻留的字符串，str为NULL时返回NULL。
+ */
+char *tk_str_intern_ref(const char *str);
+
+/**
+ * @method tk_str_intern_unref
+ * 驻留字符串的引用计数减一，为0时释放。
+ * @annotation ["static"]
+ * @param {const char*} str 由tk\_str\_intern\_ref/tk\_str\_intern\_copy返回的字符串。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_str_intern_unref(const char *str);
+
+/**
+ * @method tk_str_intern_copy
+ * 用驻留字符串替换dst(语义同tk\_str\_copy)。
+ * @annotation ["static"]
+ * @param {char*} dst 原来的驻留字符串(可以为NULL)。
+ * @param {const char*} src 新的字符串。
+ *
+ * @return {char*} 返回新的驻留字符串。
+ */
+char *tk_str_intern_copy(char *dst, const char *src);
+
+END_C_DECLS
+
+#endif /*TK_STR_INTERN_H*/
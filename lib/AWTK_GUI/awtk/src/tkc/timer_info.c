@@ -55,6 +55,7 @@ timer_info_t *timer_info_create(timer_manager_t *tm, uint32_t id, timer_func_t o
   return_value_if_fail(timer != NULL, NULL);
 
   timer->ctx = ctx;
+  timer->heap_index = -1;
   timer->suspend = FALSE;
   timer->on_timer = on_timer;
   timer->duration = duration;
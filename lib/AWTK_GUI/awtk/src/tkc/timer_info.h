@@ -134,6 +134,9 @@ struct _timer_info_t
   uint16_t timer_info_type;
   uint64_t last_dispatch_time;
   timer_manager_t *timer_manager;
+  /*在定时器管理器最小堆中的位置和排序用的到期时间*/
+  int32_t heap_index;
+  uint64_t deadline;
 };
 
 /**
@@ -22,8 +22,243 @@
 #include "mem.h"
 #include "timer_manager.h"
 
+#define TIMER_MANAGER_NEVER ((uint64_t)-1)
+
 static timer_manager_t *s_timer_manager;
 
+static void timer_manager_set_at(timer_manager_t *timer_manager, uint32_t index,
+                                 timer_info_t *timer)
+{
+  timer_manager->timers.elms[index] = timer;
+  timer->heap_index = index;
+}
+
+static uint32_t timer_manager_sift_up(timer_manager_t *timer_manager, uint32_t index)
+{
+  void **elms = timer_manager->timers.elms;
+  timer_info_t *timer = TIMER_INFO(elms[index]);
+
+  while (index > 0)
+  {
+    uint32_t parent = (index - 1) >> 1;
+    timer_info_t *p = TIMER_INFO(elms[parent]);
+    if (p->deadline <= timer->deadline)
+    {
+      break;
+    }
+    timer_manager_set_at(timer_manager, index, p);
+    index = parent;
+  }
+  timer_manager_set_at(timer_manager, index, timer);
+
+  return index;
+}
+
+static uint32_t timer_manager_sift_down(timer_manager_t *timer_manager, uint32_t index)
+{
+  void **elms = timer_manager->timers.elms;
+  uint32_t size = timer_manager->timers.size;
+  timer_info_t *timer = TIMER_INFO(elms[index]);
+
+  while (TRUE)
+  {
+    uint32_t child = 2 * index + 1;
+    timer_info_t *c = NULL;
+    if (child >= size)
+    {
+      break;
+    }
+    if (child + 1 < size &&
+        TIMER_INFO(elms[child + 1])->deadline < TIMER_INFO(elms[child])->deadline)
+    {
+      child++;
+    }
+    c = TIMER_INFO(elms[child]);
+    if (timer->deadline <= c->deadline)
+    {
+      break;
+    }
+    timer_manager_set_at(timer_manager, index, c);
+    index = child;
+  }
+  timer_manager_set_at(timer_manager, index, timer);
+
+  return index;
+}
+
+static bool_t timer_manager_is_in_heap(timer_manager_t *timer_manager, timer_info_t *timer)
+{
+  int32_t index = timer->heap_index;
+
+  return index >= 0 && (uint32_t)index < timer_manager->timers.size &&
+         timer_manager->timers.elms[index] == timer;
+}
+
+static ret_t timer_manager_rekey(timer_manager_t *timer_manager, timer_info_t *timer,
+                                 uint64_t deadline)
+{
+  uint32_t index = timer->heap_index;
+
+  timer->deadline = deadline;
+  if (timer_manager_sift_up(timer_manager, index) == index)
+  {
+    timer_manager_sift_down(timer_manager, index);
+  }
+
+  return RET_OK;
+}
+
+static uint32_t timer_manager_hash(timer_manager_t *timer_manager, uint32_t id)
+{
+  return (id * 2654435761u) & timer_manager->ids_mask;
+}
+
+static uint32_t timer_manager_find_slot(timer_manager_t *timer_manager, uint32_t id)
+{
+  uint32_t mask = timer_manager->ids_mask;
+  uint32_t i = timer_manager_hash(timer_manager, id);
+
+  while (timer_manager->ids[i] != NULL && timer_manager->ids[i]->id != id)
+  {
+    i = (i + 1) & mask;
+  }
+
+  return i;
+}
+
+static ret_t timer_manager_ensure_ids(timer_manager_t *timer_manager, uint32_t nr)
+{
+  uint32_t i = 0;
+  uint32_t old_nr = timer_manager->ids != NULL ? timer_manager->ids_mask + 1 : 0;
+  uint32_t new_nr = old_nr > 0 ? old_nr : 16;
+  timer_info_t **old_ids = timer_manager->ids;
+  timer_info_t **ids = NULL;
+
+  /*装载因子不超过 1/2，探测链保持很短*/
+  while (new_nr < nr * 2)
+  {
+    new_nr <<= 1;
+  }
+  if (new_nr == old_nr)
+  {
+    return RET_OK;
+  }
+
+  ids = TKMEM_ZALLOCN(timer_info_t *, new_nr);
+  return_value_if_fail(ids != NULL, RET_OOM);
+
+  timer_manager->ids = ids;
+  timer_manager->ids_mask = new_nr - 1;
+  for (i = 0; i < old_nr; i++)
+  {
+    if (old_ids[i] != NULL)
+    {
+      ids[timer_manager_find_slot(timer_manager, old_ids[i]->id)] = old_ids[i];
+    }
+  }
+  TKMEM_FREE(old_ids);
+
+  return RET_OK;
+}
+
+static void timer_manager_unindex(timer_manager_t *timer_manager, timer_info_t *timer)
+{
+  uint32_t j = 0;
+  uint32_t mask = timer_manager->ids_mask;
+  timer_info_t **ids = timer_manager->ids;
+  uint32_t i = timer_manager_find_slot(timer_manager, timer->id);
+
+  return_if_fail(ids[i] == timer);
+  ids[i] = NULL;
+
+  /*线性探测：把后面的项往前挪，保证探测链不断开*/
+  for (j = (i + 1) & mask; ids[j] != NULL; j = (j + 1) & mask)
+  {
+    uint32_t home = timer_manager_hash(timer_manager, ids[j]->id);
+
+    if (((j - home) & mask) >= ((j - i) & mask))
+    {
+      ids[i] = ids[j];
+      ids[j] = NULL;
+      i = j;
+    }
+  }
+}
+
+static timer_info_t *timer_manager_lookup(timer_manager_t *timer_manager, uint32_t id)
+{
+  if (timer_manager->ids == NULL)
+  {
+    return NULL;
+  }
+
+  return timer_manager->ids[timer_manager_find_slot(timer_manager, id)];
+}
+
+static ret_t timer_manager_remove_at(timer_manager_t *timer_manager, uint32_t index)
+{
+  darray_t *timers = &(timer_manager->timers);
+  timer_info_t *timer = TIMER_INFO(timers->elms[index]);
+  timer_info_t *last = TIMER_INFO(timers->elms[timers->size - 1]);
+
+  timers->size--;
+  timers->elms[timers->size] = NULL;
+  timer->heap_index = -1;
+  timer_manager_unindex(timer_manager, timer);
+
+  if (last != timer)
+  {
+    timer_manager_set_at(timer_manager, index, last);
+    timer_manager_rekey(timer_manager, last, last->deadline);
+  }
+
+  /*堆调整完成后再释放，on_destroy 回调中可以安全地访问定时器管理器*/
+  tk_object_unref((tk_object_t *)timer);
+
+  return RET_OK;
+}
+
+static ret_t timer_manager_remove_all(timer_manager_t *timer_manager, tk_compare_t cmp,
+                                      void *ctx)
+{
+  uint32_t i = 0;
+  uint32_t nr = 0;
+  uint32_t *ids = NULL;
+  darray_t *timers = &(timer_manager->timers);
+
+  for (i = 0; i < timers->size; i++)
+  {
+    nr += cmp(timers->elms[i], ctx) == 0;
+  }
+  if (nr == 0)
+  {
+    return RET_OK;
+  }
+
+  /*先记下 id 再逐个删除：on_destroy 回调中可能增删其它定时器*/
+  ids = TKMEM_ZALLOCN(uint32_t, nr);
+  return_value_if_fail(ids != NULL, RET_OOM);
+  for (i = 0, nr = 0; i < timers->size; i++)
+  {
+    if (cmp(timers->elms[i], ctx) == 0)
+    {
+      ids[nr++] = TIMER_INFO(timers->elms[i])->id;
+    }
+  }
+
+  for (i = 0; i < nr; i++)
+  {
+    timer_info_t *timer = timer_manager_lookup(timer_manager, ids[i]);
+    if (timer != NULL && cmp(timer, ctx) == 0)
+    {
+      timer_manager_remove_at(timer_manager, timer->heap_index);
+    }
+  }
+  TKMEM_FREE(ids);
+
+  return RET_OK;
+}
+
 timer_manager_t *timer_manager(void)
 {
   return s_timer_manager;
@@ -54,7 +289,7 @@ timer_manager_t *timer_manager_init(timer_manager_t *timer_manager, timer_get_ti
   timer_manager->next_timer_id = TK_INVALID_ID + 1;
   timer_manager->last_dispatch_time = get_time();
   timer_manager->get_time = get_time;
-  slist_init(&(timer_manager->timers), (tk_destroy_t)tk_object_unref, timer_info_compare_by_id);
+  darray_init(&(timer_manager->timers), 0, (tk_destroy_t)tk_object_unref, timer_info_compare_by_id);
 
   return timer_manager;
 }
@@ -63,7 +298,10 @@ ret_t timer_manager_deinit(timer_manager_t *timer_manager)
 {
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
-  slist_deinit(&(timer_manager->timers));
+  /*先清空索引，销毁定时器时的回调里就查不到正在销毁的定时器*/
+  TKMEM_FREE(timer_manager->ids);
+  timer_manager->ids_mask = 0;
+  darray_deinit(&(timer_manager->timers));
 
   return RET_OK;
 }
@@ -95,9 +333,19 @@ uint32_t timer_manager_get_next_timer_id(timer_manager_t *timer_manager)
 
 ret_t timer_manager_append(timer_manager_t *timer_manager, timer_info_t *timer)
 {
+  darray_t *timers = NULL;
   return_value_if_fail(timer_manager != NULL && timer != NULL, RET_BAD_PARAMS);
 
-  return slist_append(&(timer_manager->timers), timer);
+  timers = &(timer_manager->timers);
+  return_value_if_fail(timer_manager_ensure_ids(timer_manager, timers->size + 1) == RET_OK,
+                       RET_OOM);
+  return_value_if_fail(darray_push(timers, timer) == RET_OK, RET_OOM);
+  timer_manager->ids[timer_manager_find_slot(timer_manager, timer->id)] = timer;
+
+  timer->deadline = timer->start + timer->duration;
+  timer_manager_sift_up(timer_manager, timers->size - 1);
+
+  return RET_OK;
 }
 
 uint32_t timer_manager_add(timer_manager_t *timer_manager, timer_func_t on_timer, void *ctx,
@@ -150,25 +398,40 @@ ret_t timer_manager_all_remove_by_ctx_and_type(timer_manager_t *timer_manager, u
   timer_info_t timer;
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
-  return slist_remove_with_compare(&(timer_manager->timers),
-                                   timer_info_init_dummy_with_ctx_and_type(&timer, type, ctx),
-                                   timer_info_compare_by_ctx_and_type, -1);
+  return timer_manager_remove_all(timer_manager, timer_info_compare_by_ctx_and_type,
+                                  timer_info_init_dummy_with_ctx_and_type(&timer, type, ctx));
 }
 
 ret_t timer_manager_all_remove_by_ctx(timer_manager_t *timer_manager, void *ctx)
 {
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
-  return slist_remove_with_compare(&(timer_manager->timers), ctx, timer_info_compare_by_ctx, -1);
+  return timer_manager_remove_all(timer_manager, timer_info_compare_by_ctx, ctx);
 }
 
 ret_t timer_manager_remove(timer_manager_t *timer_manager, uint32_t timer_id)
 {
-  timer_info_t timer;
+  timer_info_t *timer = NULL;
   return_value_if_fail(timer_id != TK_INVALID_ID, RET_BAD_PARAMS);
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
-  return slist_remove(&(timer_manager->timers), timer_info_init_dummy(&timer, timer_id));
+  timer = timer_manager_lookup(timer_manager, timer_id);
+  if (timer == NULL)
+  {
+    return RET_NOT_FOUND;
+  }
+
+  return timer_manager_remove_at(timer_manager, timer->heap_index);
+}
+
+ret_t timer_manager_update(timer_manager_t *timer_manager, timer_info_t *timer)
+{
+  return_value_if_fail(timer_manager != NULL && timer != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(timer_manager_is_in_heap(timer_manager, timer), RET_NOT_FOUND);
+
+  timer_manager_rekey(timer_manager, timer, timer->start + timer->duration);
+
+  return RET_OK;
 }
 
 ret_t timer_manager_reset(timer_manager_t *timer_manager, uint32_t timer_id)
@@ -177,71 +440,78 @@ ret_t timer_manager_reset(timer_manager_t *timer_manager, uint32_t timer_id)
   return_value_if_fail(info != NULL, RET_NOT_FOUND);
   info->start = timer_manager->get_time();
 
-  return RET_OK;
+  return timer_manager_update(timer_manager, info);
 }
 
 const timer_info_t *timer_manager_find(timer_manager_t *timer_manager, uint32_t timer_id)
 {
-  timer_info_t timer;
   return_value_if_fail(timer_id != TK_INVALID_ID, NULL);
   return_value_if_fail(timer_manager != NULL, NULL);
 
-  return slist_find(&(timer_manager->timers), timer_info_init_dummy(&timer, timer_id));
+  return timer_manager_lookup(timer_manager, timer_id);
 }
 
-static ret_t timer_manager_dispatch_one(timer_manager_t *timer_manager, uint64_t now,
-                                        int32_t delta_time)
+static ret_t timer_manager_dispatch_one(timer_manager_t *timer_manager, uint64_t now)
 {
-  slist_node_t *iter = timer_manager->timers.first;
+  timer_info_t *timer = NULL;
+  darray_t *timers = &(timer_manager->timers);
 
-  while (iter != NULL && !timer_info_is_available(TIMER_INFO(iter->data), now))
+  if (timers->size == 0 || TIMER_INFO(timers->elms[0])->deadline > now)
   {
-    iter = iter->next;
+    return RET_DONE;
   }
 
-  if (iter != NULL)
-  {
-    timer_info_t *timer = (timer_info_t *)tk_object_ref((tk_object_t *)(iter->data));
-    return_value_if_fail(timer != NULL, RET_BAD_PARAMS);
+  timer = (timer_info_t *)tk_object_ref((tk_object_t *)(timers->elms[0]));
+  return_value_if_fail(timer != NULL, RET_BAD_PARAMS);
 
+  if (timer->suspend)
+  {
+    /*挂起的定时器在 resume 时会被重置，这里把它移到堆底，避免反复检查*/
+    timer_manager_rekey(timer_manager, timer, TIMER_MANAGER_NEVER);
+  }
+  else if (!timer_info_is_available(timer, now) || (timer->start + timer->duration) > now)
+  {
+    /*正在执行(嵌套的主循环)、本轮已经执行过或 duration 被直接改大的定时器*/
+    timer_manager_rekey(timer_manager, timer,
+                        tk_max(timer->start + timer->duration, now + 1));
+  }
+  else
+  {
     timer->now = now;
-    if (!timer->suspend && (timer->start + timer->duration) <= now)
+    /*先移出堆顶，回调中可以安全地增删定时器或者进入嵌套的主循环*/
+    timer_manager_rekey(timer_manager, timer, now + tk_max(timer->duration, 1));
+
+    if (timer_info_on_timer(timer, now) != RET_REPEAT)
     {
-      if (timer_info_on_timer(timer, now) != RET_REPEAT)
-      {
-        timer_manager_remove(timer_manager, timer->id);
-      }
-      else
-      {
-        timer->start = now;
-      }
+      timer_manager_remove(timer_manager, timer->id);
+    }
+    else if (timer_manager_is_in_heap(timer_manager, timer))
+    {
+      timer->start = now;
+      timer_manager_rekey(timer_manager, timer, tk_max(now + timer->duration, now + 1));
     }
-
-    tk_object_unref((tk_object_t *)timer);
-
-    return RET_OK;
   }
 
-  return RET_DONE;
+  tk_object_unref((tk_object_t *)timer);
+
+  return RET_OK;
 }
 
 ret_t timer_manager_dispatch(timer_manager_t *timer_manager)
 {
   uint64_t now = 0;
-  int32_t delta_time = 0;
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
   now = timer_manager->get_time();
-  delta_time = now - timer_manager->last_dispatch_time;
 
-  if (timer_manager->timers.first == NULL)
+  if (timer_manager->timers.size == 0)
   {
     timer_manager->last_dispatch_time = now;
     return RET_OK;
   }
 
   timer_manager->last_dispatch_time = now;
-  while (timer_manager_dispatch_one(timer_manager, now, delta_time) == RET_OK)
+  while (timer_manager_dispatch_one(timer_manager, now) == RET_OK)
   {
     if (timer_manager->last_dispatch_time != now)
     {
@@ -256,24 +526,22 @@ uint32_t timer_manager_count(timer_manager_t *timer_manager)
 {
   return_value_if_fail(timer_manager != NULL, 0);
 
-  return slist_size(&(timer_manager->timers));
+  return timer_manager->timers.size;
 }
 
 uint64_t timer_manager_next_time(timer_manager_t *timer_manager)
 {
-  slist_node_t *iter = NULL;
-  uint64_t t = timer_manager->get_time() + 0xffff;
-  return_value_if_fail(timer_manager != NULL, t);
+  uint64_t t = 0;
+  return_value_if_fail(timer_manager != NULL, 0);
 
-  iter = timer_manager->timers.first;
-  while (iter != NULL)
+  t = timer_manager->get_time() + 0xffff;
+  if (timer_manager->timers.size > 0)
   {
-    timer_info_t *timer = TIMER_INFO(iter->data);
-    if ((timer->start + timer->duration) < t)
+    timer_info_t *timer = TIMER_INFO(timer_manager->timers.elms[0]);
+    if (timer->deadline < t)
     {
-      t = timer->start + timer->duration;
+      t = timer->deadline;
     }
-    iter = iter->next;
   }
 
   return t;
@@ -22,7 +22,7 @@
 #ifndef TK_TIMER_MANAGER_H
 #define TK_TIMER_MANAGER_H
 
-#include "slist.h"
+#include "darray.h"
 #include "timer_info.h"
 
 BEGIN_C_DECLS
@@ -32,6 +32,9 @@ BEGIN_C_DECLS
  * @annotation ["scriptable"]
  *
  * 定时器管理器。
+ *
+ * > 定时器按到期时间保存在最小堆中，dispatch 和 next_time 只需查看堆顶，
+ * > 添加/删除/重置定时器的复杂度为 O(log n)。
  */
 struct _timer_manager_t
 {
@@ -39,7 +42,11 @@ struct _timer_manager_t
   uint64_t last_dispatch_time;
   timer_get_time_t get_time;
 
-  slist_t timers;
+  /*private*/
+  darray_t timers;
+  /*按 id 索引定时器的哈希表(开放寻址)，查找和删除不需要遍历*/
+  timer_info_t **ids;
+  uint32_t ids_mask;
 };
 
 /**
@@ -227,6 +234,11 @@ uint32_t timer_manager_add_with_type(timer_manager_t *timer_manager, timer_func_
 uint32_t timer_manager_add_with_type_and_id(timer_manager_t *timer_manager, uint32_t id,
                                             timer_func_t on_timer, void *ctx, uint32_t duration,
                                             uint16_t timer_info_type, bool_t is_check_id);
+/**
+ * @method timer_manager_update
+ * 直接修改定时器的 start/duration/suspend 后，调用本函数更新它在堆中的位置。
+ */
+ret_t timer_manager_update(timer_manager_t *timer_manager, timer_info_t *timer);
 
 END_C_DECLS
 
@@ -46,6 +46,10 @@
 #if defined(HAS_AWTK_CONFIG)
 #include "../../../awtk-port/awtk_config.h"
 #ifdef FRAGMENT_FRAME_BUFFER_SIZE
+#ifndef FRAGMENT_FRAME_BUFFER_NR
+#define FRAGMENT_FRAME_BUFFER_NR 1
+#endif /*FRAGMENT_FRAME_BUFFER_NR*/
+#define FRAGMENT_FRAME_BUFFER_STRIP_SIZE ((FRAGMENT_FRAME_BUFFER_SIZE) / (FRAGMENT_FRAME_BUFFER_NR))
 #endif /*FRAGMENT_FRAME_BUFFER_SIZE*/
 #endif /*HAS_AWTK_CONFIG*/
 
@@ -22,8 +22,12 @@
 #include "../tkc/buffer.h"
 #include "../base/enums.h"
 #include "../tkc/utf8.h"
+#include "../tkc/utils.h"
 #include "../tkc/value.h"
+#include "../base/style.h"
 #include "../base/ui_builder.h"
+#include "../base/widget_prop_ids.h"
+#include "../layouters/self_layouter_default.h"
 #include "ui_loader_default.h"
 #include "ui_binary_writer.h"
 
@@ -71,3 +75,298 @@ ui_builder_t *ui_binary_writer_init(ui_binary_writer_t *writer, wbuffer_t *wbuff
 
   return &(writer->builder);
 }
+
+/*字符串表已满或内存不足时ui_binary_writer_intern返回该值，它不是合法的字符串序号*/
+#define UI_BINARY_WRITER_STR_NONE 0xffff
+
+static uint16_t ui_binary_writer_intern(ui_binary_writer_t *writer, const char *str)
+{
+  uint32_t i = 0;
+  char *dup = NULL;
+  darray_t *strs = &(writer->strs);
+
+  for (i = 0; i < strs->size; i++)
+  {
+    if (tk_str_eq((const char *)(strs->elms[i]), str))
+    {
+      return (uint16_t)i;
+    }
+  }
+
+  if (strs->size < UI_BINARY_WRITER_STR_NONE)
+  {
+    dup = tk_strdup(str);
+    if (dup != NULL && darray_push(strs, dup) == RET_OK)
+    {
+      return (uint16_t)i;
+    }
+    TKMEM_FREE(dup);
+  }
+
+  /*丢掉一项后数据就不完整了，记下失败，on_end时不输出*/
+  writer->failed = TRUE;
+  log_warn("ui_binary_writer: intern \"%s\" failed\n", str);
+
+  return UI_BINARY_WRITER_STR_NONE;
+}
+
+/*body中任何一次写入失败(内存不足)，数据就不完整了，记下失败，on_end时不输出*/
+static ret_t ui_binary_writer_check(ui_binary_writer_t *writer, ret_t ret)
+{
+  if (ret != RET_OK)
+  {
+    writer->failed = TRUE;
+  }
+
+  return ret;
+}
+
+static ret_t ui_binary_writer_write_uint8(ui_binary_writer_t *writer, uint8_t value)
+{
+  return ui_binary_writer_check(writer, wbuffer_write_uint8(&(writer->body), value));
+}
+
+static ret_t ui_binary_writer_write_uint16(ui_binary_writer_t *writer, uint16_t value)
+{
+  return ui_binary_writer_check(writer, wbuffer_write_uint16(&(writer->body), value));
+}
+
+static ret_t ui_binary_writer_write_int32(ui_binary_writer_t *writer, int32_t value)
+{
+  return ui_binary_writer_check(writer, wbuffer_write_int32(&(writer->body), value));
+}
+
+static ret_t ui_binary_writer_write_uint32(ui_binary_writer_t *writer, uint32_t value)
+{
+  return ui_binary_writer_check(writer, wbuffer_write_uint32(&(writer->body), value));
+}
+
+static ret_t ui_binary_writer_write_double(ui_binary_writer_t *writer, double value)
+{
+  return ui_binary_writer_check(writer, wbuffer_write_double(&(writer->body), value));
+}
+
+static ret_t ui_binary_writer_write_string(ui_binary_writer_t *writer, const char *value)
+{
+  return ui_binary_writer_check(writer, wbuffer_write_string(&(writer->body), value));
+}
+
+static ret_t ui_binary_writer_write_prop_head(ui_binary_writer_t *writer, uint8_t op,
+                                              const char *name)
+{
+  uint16_t id = ui_binary_writer_intern(writer, name);
+  return_value_if_fail(id != UI_BINARY_WRITER_STR_NONE, RET_FAIL);
+
+  ui_binary_writer_write_uint8(writer, op);
+
+  return ui_binary_writer_write_uint16(writer, id);
+}
+
+static ret_t ui_binary_writer_write_self_layout(ui_binary_writer_t *writer, const char *value)
+{
+  self_layouter_t *layouter = NULL;
+  self_layouter_default_t *l = NULL;
+
+  if (!tk_str_start_with(value, SELF_LAYOUTER_DEFAULT "("))
+  {
+    return RET_NOT_IMPL;
+  }
+
+  layouter = self_layouter_default_create();
+  return_value_if_fail(layouter != NULL, RET_OOM);
+
+  str_set(&(layouter->params), value);
+  if (self_layouter_reinit(layouter) != RET_OK)
+  {
+    self_layouter_destroy(layouter);
+    return RET_FAIL;
+  }
+
+  l = (self_layouter_default_t *)layouter;
+  ui_binary_writer_write_uint8(writer, UI_DATA_OP_SELF_LAYOUT);
+  ui_binary_writer_write_uint8(writer, l->x_attr);
+  ui_binary_writer_write_uint8(writer, l->y_attr);
+  ui_binary_writer_write_uint8(writer, l->w_attr);
+  ui_binary_writer_write_uint8(writer, l->h_attr);
+  ui_binary_writer_write_double(writer, l->x);
+  ui_binary_writer_write_double(writer, l->y);
+  ui_binary_writer_write_double(writer, l->w);
+  ui_binary_writer_write_double(writer, l->h);
+  self_layouter_destroy(layouter);
+
+  return RET_OK;
+}
+
+static ret_t ui_binary_writer_write_style(ui_binary_writer_t *writer, const char *name,
+                                          const char *value)
+{
+  value_t v;
+  uint8_t op = UI_DATA_OP_PROP_INT;
+  const char *style_name = name + 6;
+  const char *p = strchr(style_name, ':');
+
+  /*和widget_set_style一样拆分状态和style名*/
+  if (p == NULL)
+  {
+    p = strchr(style_name, '.');
+  }
+  if (p != NULL)
+  {
+    style_name = p + 1;
+  }
+
+  value_set_int(&v, 0);
+  style_normalize_value(style_name, value, &v);
+  if (v.type == VALUE_TYPE_UINT32 && strstr(style_name, "color") != NULL)
+  {
+    op = UI_DATA_OP_PROP_COLOR;
+  }
+  else if (v.type != VALUE_TYPE_UINT32 && v.type != VALUE_TYPE_INT32)
+  {
+    value_reset(&v);
+    return RET_NOT_IMPL;
+  }
+
+  return_value_if_fail(ui_binary_writer_write_prop_head(writer, op, name) == RET_OK, RET_FAIL);
+  if (op == UI_DATA_OP_PROP_COLOR)
+  {
+    return ui_binary_writer_write_uint32(writer, value_uint32(&v));
+  }
+  else
+  {
+    return ui_binary_writer_write_int32(writer, value_int32(&v));
+  }
+}
+
+static ret_t ui_binary_writer_on_widget_start_v2(ui_builder_t *b, const widget_desc_t *desc)
+{
+  ui_binary_writer_t *writer = (ui_binary_writer_t *)b;
+  uint16_t type = ui_binary_writer_intern(writer, desc->type);
+  return_value_if_fail(type != UI_BINARY_WRITER_STR_NONE, RET_FAIL);
+
+  ui_binary_writer_write_uint8(writer, UI_DATA_OP_WIDGET_START);
+  ui_binary_writer_write_uint16(writer, type);
+  ui_binary_writer_write_int32(writer, desc->layout.x);
+  ui_binary_writer_write_int32(writer, desc->layout.y);
+  ui_binary_writer_write_int32(writer, desc->layout.w);
+
+  return ui_binary_writer_write_int32(writer, desc->layout.h);
+}
+
+static ret_t ui_binary_writer_on_widget_prop_v2(ui_builder_t *b, const char *name,
+                                                const char *value)
+{
+  ui_binary_writer_t *writer = (ui_binary_writer_t *)b;
+
+  /*只转换widget_set_prop按数值读取的内置属性，控件自己的属性可能按字符串读取*/
+  switch (widget_prop_id(name))
+  {
+  case WIDGET_PROP_ID_SELF_LAYOUT:
+  {
+    if (ui_binary_writer_write_self_layout(writer, value) == RET_OK)
+    {
+      return RET_OK;
+    }
+    break;
+  }
+  case WIDGET_PROP_ID_VISIBLE:
+  case WIDGET_PROP_ID_SENSITIVE:
+  case WIDGET_PROP_ID_FLOATING:
+  case WIDGET_PROP_ID_FOCUSABLE:
+  case WIDGET_PROP_ID_FOCUSED:
+  case WIDGET_PROP_ID_FOCUS:
+  case WIDGET_PROP_ID_WITH_FOCUS_STATE:
+  case WIDGET_PROP_ID_ENABLE:
+  case WIDGET_PROP_ID_FEEDBACK:
+  case WIDGET_PROP_ID_AUTO_ADJUST_SIZE:
+  {
+    return_value_if_fail(
+        ui_binary_writer_write_prop_head(writer, UI_DATA_OP_PROP_BOOL, name) == RET_OK, RET_FAIL);
+    return ui_binary_writer_write_uint8(writer, tk_atob(value) ? 1 : 0);
+  }
+  case WIDGET_PROP_ID_OPACITY:
+  case WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE:
+  {
+    return_value_if_fail(
+        ui_binary_writer_write_prop_head(writer, UI_DATA_OP_PROP_INT, name) == RET_OK, RET_FAIL);
+    return ui_binary_writer_write_int32(writer, tk_atoi(value));
+  }
+  default:
+  {
+    if (tk_str_start_with(name, "style:") || tk_str_start_with(name, "style."))
+    {
+      if (ui_binary_writer_write_style(writer, name, value) == RET_OK)
+      {
+        return RET_OK;
+      }
+    }
+    break;
+  }
+  }
+
+  return_value_if_fail(
+      ui_binary_writer_write_prop_head(writer, UI_DATA_OP_PROP_STR, name) == RET_OK, RET_FAIL);
+  return ui_binary_writer_write_string(writer, value);
+}
+
+static ret_t ui_binary_writer_on_widget_prop_end_v2(ui_builder_t *b)
+{
+  ui_binary_writer_t *writer = (ui_binary_writer_t *)b;
+
+  return ui_binary_writer_write_uint8(writer, UI_DATA_OP_PROP_END);
+}
+
+static ret_t ui_binary_writer_on_widget_end_v2(ui_builder_t *b)
+{
+  ui_binary_writer_t *writer = (ui_binary_writer_t *)b;
+
+  return ui_binary_writer_write_uint8(writer, UI_DATA_OP_WIDGET_END);
+}
+
+static ret_t ui_binary_writer_on_end_v2(ui_builder_t *b)
+{
+  uint32_t i = 0;
+  ui_binary_writer_t *writer = (ui_binary_writer_t *)b;
+  wbuffer_t *wbuffer = writer->wbuffer;
+  return_value_if_fail(!writer->failed, RET_FAIL);
+
+  return_value_if_fail(wbuffer_write_uint32(wbuffer, UI_DATA_MAGIC_V2) == RET_OK, RET_OOM);
+  return_value_if_fail(wbuffer_write_uint16(wbuffer, (uint16_t)(writer->strs.size)) == RET_OK,
+                       RET_OOM);
+  for (i = 0; i < writer->strs.size; i++)
+  {
+    const char *str = (const char *)(writer->strs.elms[i]);
+    return_value_if_fail(wbuffer_write_string(wbuffer, str) == RET_OK, RET_OOM);
+  }
+
+  return wbuffer_write_binary(wbuffer, writer->body.data, writer->body.cursor);
+}
+
+ui_builder_t *ui_binary_writer_init_v2(ui_binary_writer_t *writer, wbuffer_t *wbuffer)
+{
+  return_value_if_fail(writer != NULL && wbuffer != NULL, NULL);
+
+  memset(writer, 0x00, sizeof(ui_binary_writer_t));
+
+  writer->wbuffer = wbuffer;
+  wbuffer_init_extendable(&(writer->body));
+  darray_init(&(writer->strs), 32, default_destroy, NULL);
+
+  writer->builder.on_widget_start = ui_binary_writer_on_widget_start_v2;
+  writer->builder.on_widget_prop = ui_binary_writer_on_widget_prop_v2;
+  writer->builder.on_widget_prop_end = ui_binary_writer_on_widget_prop_end_v2;
+  writer->builder.on_widget_end = ui_binary_writer_on_widget_end_v2;
+  writer->builder.on_end = ui_binary_writer_on_end_v2;
+
+  return &(writer->builder);
+}
+
+ret_t ui_binary_writer_deinit(ui_binary_writer_t *writer)
+{
+  return_value_if_fail(writer != NULL, RET_BAD_PARAMS);
+
+  wbuffer_deinit(&(writer->body));
+  darray_deinit(&(writer->strs));
+
+  return RET_OK;
+}
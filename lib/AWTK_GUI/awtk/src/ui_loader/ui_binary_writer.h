@@ -23,6 +23,7 @@
 #define TK_UI_BINARY_WRITER_H
 
 #include "../tkc/buffer.h"
+#include "../tkc/darray.h"
 #include "../base/ui_builder.h"
 
 BEGIN_C_DECLS
@@ -33,11 +34,18 @@ BEGIN_C_DECLS
  *
  * 生成二进制格式的UI描述数据。
  *
+ * ui\_binary\_writer\_init生成v1格式，ui\_binary\_writer\_init\_v2生成v2格式(见ui\_data\_op\_t)。
+ *
  */
 typedef struct _ui_binary_writer_t
 {
   ui_builder_t builder;
   wbuffer_t *wbuffer;
+
+  /*private*/
+  wbuffer_t body;
+  darray_t strs;
+  bool_t failed;
 } ui_binary_writer_t;
 
 /**
@@ -53,6 +61,39 @@ typedef struct _ui_binary_writer_t
  */
 ui_builder_t *ui_binary_writer_init(ui_binary_writer_t *writer, wbuffer_t *wbuffer);
 
+/**
+ * @method ui_binary_writer_init_v2
+ * @annotation ["constructor"]
+ *
+ * 初始化ui\_binary\_writer对象，生成v2格式的UI数据。
+ *
+ * > 控件类型名和属性名保存为字符串表的下标，内置的布尔/整数属性、style中的整数/颜色，
+ * > 以及缺省布局器的self\_layout参数预先转换好。其它属性值保持为字符串。
+ * > 数据在ui\_builder\_on\_end时写入wbuffer，用完后需调用ui\_binary\_writer\_deinit。
+ * > 字符串表超过65535项或内存不足时，ui\_builder\_on\_end返回RET\_FAIL，不写入任何数据。
+ * >
+ * > v2格式面向运行时加载：style中的枚举值(如text\_align\_h)保存为转换后的整数，
+ * > 交给不支持on\_widget\_prop\_value的builder(如ui\_xml\_writer)时不能还原为原来的字符串。
+ *
+ * @param {ui_binary_writer_t*} writer writer对象。
+ * @param {wbuffer_t*} wbuffer 保存结果的buffer。
+ *
+ * @return {ui_builder_t*} 返回ui\_builder对象。
+ */
+ui_builder_t *ui_binary_writer_init_v2(ui_binary_writer_t *writer, wbuffer_t *wbuffer);
+
+/**
+ * @method ui_binary_writer_deinit
+ * @annotation ["deconstructor"]
+ *
+ * 释放ui\_binary\_writer对象内部的资源。
+ *
+ * @param {ui_binary_writer_t*} writer writer对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t ui_binary_writer_deinit(ui_binary_writer_t *writer);
+
 END_C_DECLS
 
 #endif /*TK_UI_BINARY_WRITER_H*/
@@ -66,6 +66,25 @@ static ret_t ui_builder_default_on_widget_prop(ui_builder_t *b, const char *name
   return RET_OK;
 }
 
+static ret_t ui_builder_default_on_widget_prop_value(ui_builder_t *b, const char *name,
+                                                     const value_t *value)
+{
+  widget_set_prop(b->widget, name, value);
+
+  return RET_OK;
+}
+
+static ret_t ui_builder_default_on_widget_self_layout(ui_builder_t *b, self_layouter_t *layouter)
+{
+  if (b->widget == NULL)
+  {
+    self_layouter_destroy(layouter);
+    return RET_BAD_PARAMS;
+  }
+
+  return widget_set_self_layouter(b->widget, layouter);
+}
+
 static ret_t ui_builder_default_on_widget_prop_end(ui_builder_t *b)
 {
   return RET_OK;
@@ -121,6 +140,8 @@ ui_builder_t *ui_builder_default_create(const char *name)
 
   builder->on_widget_start = ui_builder_default_on_widget_start;
   builder->on_widget_prop = ui_builder_default_on_widget_prop;
+  builder->on_widget_prop_value = ui_builder_default_on_widget_prop_value;
+  builder->on_widget_self_layout = ui_builder_default_on_widget_self_layout;
   builder->on_widget_prop_end = ui_builder_default_on_widget_prop_end;
   builder->on_widget_end = ui_builder_default_on_widget_end;
   builder->on_end = ui_builder_default_on_end;
@@ -20,50 +20,44 @@
  */
 
 #include "../tkc/mem.h"
+#include "../tkc/utils.h"
 #include "../tkc/buffer.h"
+#include "../layouters/self_layouter_default.h"
 #include "ui_loader_default.h"
 
-ret_t ui_loader_load_default(ui_loader_t *loader, const uint8_t *data, uint32_t size,
-                             ui_builder_t *b)
+static ret_t ui_loader_load_default_v1(rbuffer_t *rbuffer, ui_builder_t *b)
 {
-  rbuffer_t rbuffer;
   widget_desc_t desc;
-  uint32_t magic = 0;
   uint8_t widget_end_mark = 0;
 
-  return_value_if_fail(loader != NULL && data != NULL && b != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(rbuffer_init(&rbuffer, data, size) != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(rbuffer_read_uint32(&rbuffer, &magic) == RET_OK, RET_BAD_PARAMS);
-  return_value_if_fail(magic == UI_DATA_MAGIC, RET_BAD_PARAMS);
-
   ui_builder_on_start(b);
-  while ((rbuffer.cursor + sizeof(desc)) <= rbuffer.capacity)
+  while ((rbuffer->cursor + sizeof(desc)) <= rbuffer->capacity)
   {
     const char *key = NULL;
     const char *value = NULL;
-    return_value_if_fail(rbuffer_read_binary(&rbuffer, &desc, sizeof(desc)) == RET_OK,
+    return_value_if_fail(rbuffer_read_binary(rbuffer, &desc, sizeof(desc)) == RET_OK,
                          RET_BAD_PARAMS);
     ui_builder_on_widget_start(b, &desc);
 
-    return_value_if_fail(rbuffer_read_string(&rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
+    return_value_if_fail(rbuffer_read_string(rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
     while (*key)
     {
-      return_value_if_fail(rbuffer_read_string(&rbuffer, &value) == RET_OK, RET_BAD_PARAMS);
+      return_value_if_fail(rbuffer_read_string(rbuffer, &value) == RET_OK, RET_BAD_PARAMS);
       ui_builder_on_widget_prop(b, key, value);
-      return_value_if_fail(rbuffer_read_string(&rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
+      return_value_if_fail(rbuffer_read_string(rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
     }
     ui_builder_on_widget_prop_end(b);
 
-    if (rbuffer_has_more(&rbuffer))
+    if (rbuffer_has_more(rbuffer))
     {
-      return_value_if_fail(rbuffer_peek_uint8(&rbuffer, &widget_end_mark) == RET_OK,
+      return_value_if_fail(rbuffer_peek_uint8(rbuffer, &widget_end_mark) == RET_OK,
                            RET_BAD_PARAMS);
       while (widget_end_mark == 0)
       {
-        rbuffer_read_uint8(&rbuffer, &widget_end_mark);
+        rbuffer_read_uint8(rbuffer, &widget_end_mark);
         ui_builder_on_widget_end(b);
-        if ((rbuffer.cursor + 1) >= rbuffer.capacity ||
-            rbuffer_peek_uint8(&rbuffer, &widget_end_mark) != RET_OK)
+        if ((rbuffer->cursor + 1) >= rbuffer->capacity ||
+            rbuffer_peek_uint8(rbuffer, &widget_end_mark) != RET_OK)
         {
           break;
         }
@@ -77,6 +71,179 @@ ret_t ui_loader_load_default(ui_loader_t *loader, const uint8_t *data, uint32_t
   return RET_OK;
 }
 
+static ret_t ui_loader_read_str(rbuffer_t *rbuffer, const char **strs, uint32_t nr,
+                                const char **str)
+{
+  uint16_t index = 0;
+  return_value_if_fail(rbuffer_read_uint16(rbuffer, &index) == RET_OK, RET_BAD_PARAMS);
+  return_value_if_fail(index < nr, RET_BAD_PARAMS);
+
+  *str = strs[index];
+
+  return RET_OK;
+}
+
+static ret_t ui_loader_load_widget_start_v2(rbuffer_t *rbuffer, const char **strs, uint32_t nr,
+                                            ui_builder_t *b)
+{
+  widget_desc_t desc;
+  const char *type = NULL;
+  return_value_if_fail(ui_loader_read_str(rbuffer, strs, nr, &type) == RET_OK, RET_BAD_PARAMS);
+  return_value_if_fail(rbuffer_read_int32(rbuffer, &(desc.layout.x)) == RET_OK, RET_BAD_PARAMS);
+  return_value_if_fail(rbuffer_read_int32(rbuffer, &(desc.layout.y)) == RET_OK, RET_BAD_PARAMS);
+  return_value_if_fail(rbuffer_read_int32(rbuffer, &(desc.layout.w)) == RET_OK, RET_BAD_PARAMS);
+  return_value_if_fail(rbuffer_read_int32(rbuffer, &(desc.layout.h)) == RET_OK, RET_BAD_PARAMS);
+  tk_strncpy(desc.type, type, TK_NAME_LEN);
+
+  return ui_builder_on_widget_start(b, &desc);
+}
+
+static ret_t ui_loader_load_self_layout_v2(rbuffer_t *rbuffer, ui_builder_t *b)
+{
+  self_layouter_default_t *l = NULL;
+  self_layouter_t *layouter = self_layouter_default_create();
+  return_value_if_fail(layouter != NULL, RET_OOM);
+
+  l = (self_layouter_default_t *)layouter;
+  if (rbuffer_read_uint8(rbuffer, &(l->x_attr)) != RET_OK ||
+      rbuffer_read_uint8(rbuffer, &(l->y_attr)) != RET_OK ||
+      rbuffer_read_uint8(rbuffer, &(l->w_attr)) != RET_OK ||
+      rbuffer_read_uint8(rbuffer, &(l->h_attr)) != RET_OK ||
+      rbuffer_read_double(rbuffer, &(l->x)) != RET_OK ||
+      rbuffer_read_double(rbuffer, &(l->y)) != RET_OK ||
+      rbuffer_read_double(rbuffer, &(l->w)) != RET_OK ||
+      rbuffer_read_double(rbuffer, &(l->h)) != RET_OK)
+  {
+    self_layouter_destroy(layouter);
+    return RET_BAD_PARAMS;
+  }
+
+  return ui_builder_on_widget_self_layout(b, layouter);
+}
+
+static ret_t ui_loader_load_prop_v2(rbuffer_t *rbuffer, uint8_t op, const char **strs,
+                                    uint32_t nr, ui_builder_t *b)
+{
+  value_t v;
+  const char *name = NULL;
+  return_value_if_fail(ui_loader_read_str(rbuffer, strs, nr, &name) == RET_OK, RET_BAD_PARAMS);
+
+  switch (op)
+  {
+  case UI_DATA_OP_PROP_STR:
+  {
+    const char *value = NULL;
+    return_value_if_fail(rbuffer_read_string(rbuffer, &value) == RET_OK, RET_BAD_PARAMS);
+    return ui_builder_on_widget_prop(b, name, value);
+  }
+  case UI_DATA_OP_PROP_INT:
+  {
+    int32_t value = 0;
+    return_value_if_fail(rbuffer_read_int32(rbuffer, &value) == RET_OK, RET_BAD_PARAMS);
+    return ui_builder_on_widget_prop_value(b, name, value_set_int32(&v, value));
+  }
+  case UI_DATA_OP_PROP_BOOL:
+  {
+    uint8_t value = 0;
+    return_value_if_fail(rbuffer_read_uint8(rbuffer, &value) == RET_OK, RET_BAD_PARAMS);
+    return ui_builder_on_widget_prop_value(b, name, value_set_bool(&v, value != 0));
+  }
+  case UI_DATA_OP_PROP_COLOR:
+  {
+    color_t c;
+    return_value_if_fail(rbuffer_read_uint32(rbuffer, &(c.color)) == RET_OK, RET_BAD_PARAMS);
+    if (b->on_widget_prop_value == NULL)
+    {
+      char str[TK_COLOR_HEX_LEN + 1];
+      return ui_builder_on_widget_prop(b, name, color_hex_str(c, str));
+    }
+    return ui_builder_on_widget_prop_value(b, name, value_set_uint32(&v, c.color));
+  }
+  default:
+    break;
+  }
+
+  return RET_BAD_PARAMS;
+}
+
+static ret_t ui_loader_load_default_v2(rbuffer_t *rbuffer, ui_builder_t *b)
+{
+  uint8_t op = 0;
+  uint16_t i = 0;
+  uint16_t nr = 0;
+  ret_t ret = RET_OK;
+  const char **strs = NULL;
+
+  return_value_if_fail(rbuffer_read_uint16(rbuffer, &nr) == RET_OK, RET_BAD_PARAMS);
+  if (nr > 0)
+  {
+    strs = TKMEM_ZALLOCN(const char *, nr);
+    return_value_if_fail(strs != NULL, RET_OOM);
+  }
+
+  for (i = 0; i < nr; i++)
+  {
+    if (rbuffer_read_string(rbuffer, strs + i) != RET_OK)
+    {
+      TKMEM_FREE(strs);
+      return RET_BAD_PARAMS;
+    }
+  }
+
+  ui_builder_on_start(b);
+  while (ret != RET_BAD_PARAMS && rbuffer_read_uint8(rbuffer, &op) == RET_OK)
+  {
+    if (op == UI_DATA_OP_WIDGET_START)
+    {
+      ret = ui_loader_load_widget_start_v2(rbuffer, strs, nr, b);
+    }
+    else if (op == UI_DATA_OP_PROP_END)
+    {
+      ret = ui_builder_on_widget_prop_end(b);
+    }
+    else if (op == UI_DATA_OP_WIDGET_END)
+    {
+      ui_builder_on_widget_end(b);
+      if (b->widget == NULL)
+      {
+        break;
+      }
+    }
+    else if (op == UI_DATA_OP_SELF_LAYOUT)
+    {
+      ret = ui_loader_load_self_layout_v2(rbuffer, b);
+    }
+    else
+    {
+      ret = ui_loader_load_prop_v2(rbuffer, op, strs, nr, b);
+    }
+  }
+  ui_builder_on_end(b);
+  TKMEM_FREE(strs);
+
+  return ret == RET_BAD_PARAMS ? RET_BAD_PARAMS : RET_OK;
+}
+
+ret_t ui_loader_load_default(ui_loader_t *loader, const uint8_t *data, uint32_t size,
+                             ui_builder_t *b)
+{
+  rbuffer_t rbuffer;
+  uint32_t magic = 0;
+
+  return_value_if_fail(loader != NULL && data != NULL && b != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(rbuffer_init(&rbuffer, data, size) != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(rbuffer_read_uint32(&rbuffer, &magic) == RET_OK, RET_BAD_PARAMS);
+
+  if (magic == UI_DATA_MAGIC_V2)
+  {
+    return ui_loader_load_default_v2(&rbuffer, b);
+  }
+
+  return_value_if_fail(magic == UI_DATA_MAGIC, RET_BAD_PARAMS);
+
+  return ui_loader_load_default_v1(&rbuffer, b);
+}
+
 static const ui_loader_t s_default_ui_loader = {.load = ui_loader_load_default};
 
 ui_loader_t *default_ui_loader()
@@ -26,12 +26,75 @@
 
 BEGIN_C_DECLS
 
+/**
+ * @enum ui_data_op_t
+ * @prefix UI_DATA_OP_
+ * v2格式UI数据(UI\_DATA\_MAGIC\_V2)中的操作码。
+ *
+ * v2格式的布局：
+ *
+ * ```
+ * uint32_t magic;
+ * uint16_t str_nr;
+ * char strs[str_nr][]; //以'\0'结尾的字符串表(控件类型名和属性名)。
+ * uint8_t op; ...      //操作码及其参数。
+ * ```
+ *
+ * 属性名和控件类型名用字符串表的下标(uint16\_t)表示。
+ */
+typedef enum _ui_data_op_t
+{
+  /**
+   * @const UI_DATA_OP_WIDGET_END
+   * 控件结束。
+   */
+  UI_DATA_OP_WIDGET_END = 0,
+  /**
+   * @const UI_DATA_OP_WIDGET_START
+   * 控件开始。参数：uint16\_t type, int32\_t x, y, w, h。
+   */
+  UI_DATA_OP_WIDGET_START,
+  /**
+   * @const UI_DATA_OP_PROP_END
+   * 控件属性结束。
+   */
+  UI_DATA_OP_PROP_END,
+  /**
+   * @const UI_DATA_OP_PROP_STR
+   * 字符串属性。参数：uint16\_t name, char value[]。
+   */
+  UI_DATA_OP_PROP_STR,
+  /**
+   * @const UI_DATA_OP_PROP_INT
+   * 整数属性。参数：uint16\_t name, int32\_t value。
+   */
+  UI_DATA_OP_PROP_INT,
+  /**
+   * @const UI_DATA_OP_PROP_BOOL
+   * 布尔属性。参数：uint16\_t name, uint8\_t value。
+   */
+  UI_DATA_OP_PROP_BOOL,
+  /**
+   * @const UI_DATA_OP_PROP_COLOR
+   * 颜色属性。参数：uint16\_t name, uint32\_t value。
+   */
+  UI_DATA_OP_PROP_COLOR,
+  /**
+   * @const UI_DATA_OP_SELF_LAYOUT
+   * 预先解析好的缺省布局器参数。参数：uint8\_t x_attr, y_attr, w_attr, h_attr, double x, y, w, h。
+   */
+  UI_DATA_OP_SELF_LAYOUT
+} ui_data_op_t;
+
 /**
  * @class ui_loader_default_t
  * @parent ui_loader_t
  *
  * 二进制格式的UI资源加载器。
  *
+ * 同时支持v1格式(UI\_DATA\_MAGIC，属性名和属性值都是字符串)和
+ * v2格式(UI\_DATA\_MAGIC\_V2，属性值已经转换为对应的类型，加载时不需要再解析)。
+ *
  * @annotation["fake"]
  *
  */
@@ -41,6 +41,8 @@ typedef struct _vgcanvas_nanovg_t
     NVGcontext *vg;
     uint32_t text_align_v;
     uint32_t text_align_h;
+    /*上一次绑定的片段的 y，用来判断新的一帧*/
+    int32_t fragment_y;
 } vgcanvas_nanovg_t;
 
 #include "vgcanvas_nanovg_soft.inc"
@@ -24,6 +24,7 @@
 #include "../tkc/utils.h"
 #include "button.h"
 #include "../base/widget_vtable.h"
+#include "../base/widget_prop_ids.h"
 
 static ret_t button_remove_timer(widget_t *widget)
 {
@@ -346,24 +347,27 @@ ret_t button_set_enable_preview(widget_t *widget, bool_t enable_preview)
 static ret_t button_get_prop(widget_t *widget, const char *name, value_t *v)
 {
   button_t *button = BUTTON(widget);
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
   return_value_if_fail(button != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_REPEAT))
+  id = widget_prop_id(name);
+
+  if (id == WIDGET_PROP_ID_REPEAT)
   {
     value_set_int(v, button->repeat);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_LONG_PRESS_TIME))
+  else if (id == WIDGET_PROP_ID_LONG_PRESS_TIME)
   {
     value_set_int(v, button->long_press_time);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_ENABLE_LONG_PRESS))
+  else if (id == WIDGET_PROP_ID_ENABLE_LONG_PRESS)
   {
     value_set_bool(v, button->enable_long_press);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_ENABLE_PREVIEW))
+  else if (id == WIDGET_PROP_ID_ENABLE_PREVIEW)
   {
     value_set_bool(v, button->enable_preview);
     return RET_OK;
@@ -402,21 +406,24 @@ static ret_t button_get_prop_default_value(widget_t *widget, const char *name, v
 
 static ret_t button_set_prop(widget_t *widget, const char *name, const value_t *v)
 {
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
   return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_REPEAT))
+  id = widget_prop_id(name);
+
+  if (id == WIDGET_PROP_ID_REPEAT)
   {
     return button_set_repeat(widget, value_int(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_LONG_PRESS_TIME))
+  else if (id == WIDGET_PROP_ID_LONG_PRESS_TIME)
   {
     return button_set_long_press_time(widget, value_int(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_ENABLE_LONG_PRESS))
+  else if (id == WIDGET_PROP_ID_ENABLE_LONG_PRESS)
   {
     return button_set_enable_long_press(widget, value_bool(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_ENABLE_PREVIEW))
+  else if (id == WIDGET_PROP_ID_ENABLE_PREVIEW)
   {
     return button_set_enable_preview(widget, value_bool(v));
   }
@@ -24,6 +24,7 @@
 #include "label.h"
 #include "../base/line_parser.h"
 #include "../base/widget_vtable.h"
+#include "../base/widget_prop_ids.h"
 #include "../base/window_manager.h"
 
 static ret_t label_paint_text_mlines(widget_t *widget, canvas_t *c, line_parser_t *p, int32_t x,
@@ -191,31 +192,34 @@ ret_t label_set_word_wrap(widget_t *widget, bool_t word_wrap)
 static ret_t label_get_prop(widget_t *widget, const char *name, value_t *v)
 {
   label_t *label = LABEL(widget);
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
   return_value_if_fail(label != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_VALUE))
+  id = widget_prop_id(name);
+
+  if (id == WIDGET_PROP_ID_VALUE)
   {
     double d = 0;
     ret_t ret = wstr_to_float(&(widget->text), &d);
     value_set_double(v, d);
     return ret;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_LENGTH))
+  else if (id == WIDGET_PROP_ID_LENGTH)
   {
     value_set_int(v, label->length);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_MAX_W))
+  else if (id == WIDGET_PROP_ID_MAX_W)
   {
     value_set_int(v, label->max_w);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_LINE_WRAP))
+  else if (id == WIDGET_PROP_ID_LINE_WRAP)
   {
     value_set_bool(v, label->line_wrap);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_WORD_WRAP))
+  else if (id == WIDGET_PROP_ID_WORD_WRAP)
   {
     value_set_bool(v, label->word_wrap);
     return RET_OK;
@@ -226,30 +230,33 @@ static ret_t label_get_prop(widget_t *widget, const char *name, value_t *v)
 
 static ret_t label_set_prop(widget_t *widget, const char *name, const value_t *v)
 {
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
   return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
+  id = widget_prop_id(name);
+
   if (widget->auto_adjust_size)
   {
     widget_set_need_relayout(widget);
   }
-  if (tk_str_eq(name, WIDGET_PROP_VALUE) || tk_str_eq(name, WIDGET_PROP_TEXT))
+  if (id == WIDGET_PROP_ID_VALUE || id == WIDGET_PROP_ID_TEXT)
   {
     wstr_from_value(&(widget->text), v);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_LENGTH))
+  else if (id == WIDGET_PROP_ID_LENGTH)
   {
     return label_set_length(widget, tk_roundi(value_float(v)));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_MAX_W))
+  else if (id == WIDGET_PROP_ID_MAX_W)
   {
     return label_set_max_w(widget, value_int(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_LINE_WRAP))
+  else if (id == WIDGET_PROP_ID_LINE_WRAP)
   {
     return label_set_line_wrap(widget, value_bool(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_WORD_WRAP))
+  else if (id == WIDGET_PROP_ID_WORD_WRAP)
   {
     return label_set_word_wrap(widget, value_bool(v));
   }
@@ -22,6 +22,7 @@
 #include "../tkc/mem.h"
 #include "../tkc/utils.h"
 #include "../base/widget_vtable.h"
+#include "../base/widget_prop_ids.h"
 #include "../base/image_manager.h"
 #include "progress_bar.h"
 
@@ -199,34 +200,37 @@ static ret_t progress_bar_on_destroy(widget_t *widget)
 static ret_t progress_bar_get_prop(widget_t *widget, const char *name, value_t *v)
 {
   progress_bar_t *progress_bar = PROGRESS_BAR(widget);
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
   return_value_if_fail(progress_bar != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_VALUE))
+  id = widget_prop_id(name);
+
+  if (id == WIDGET_PROP_ID_VALUE)
   {
     value_set_float(v, progress_bar->value);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_MAX))
+  else if (id == WIDGET_PROP_ID_MAX)
   {
     value_set_float(v, progress_bar->max);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_FORMAT))
+  else if (id == WIDGET_PROP_ID_FORMAT)
   {
     value_set_str(v, progress_bar->format);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_VERTICAL))
+  else if (id == WIDGET_PROP_ID_VERTICAL)
   {
     value_set_bool(v, progress_bar->vertical);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_SHOW_TEXT))
+  else if (id == WIDGET_PROP_ID_SHOW_TEXT)
   {
     value_set_bool(v, progress_bar->show_text);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_REVERSE))
+  else if (id == WIDGET_PROP_ID_REVERSE)
   {
     value_set_bool(v, progress_bar->reverse);
     return RET_OK;
@@ -237,29 +241,32 @@ static ret_t progress_bar_get_prop(widget_t *widget, const char *name, value_t *
 
 static ret_t progress_bar_set_prop(widget_t *widget, const char *name, const value_t *v)
 {
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
   return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_VALUE))
+  id = widget_prop_id(name);
+
+  if (id == WIDGET_PROP_ID_VALUE)
   {
     return progress_bar_set_value(widget, value_float(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_MAX))
+  else if (id == WIDGET_PROP_ID_MAX)
   {
     return progress_bar_set_max(widget, value_float(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_FORMAT))
+  else if (id == WIDGET_PROP_ID_FORMAT)
   {
     return progress_bar_set_format(widget, value_str(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_VERTICAL))
+  else if (id == WIDGET_PROP_ID_VERTICAL)
   {
     return progress_bar_set_vertical(widget, value_bool(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_SHOW_TEXT))
+  else if (id == WIDGET_PROP_ID_SHOW_TEXT)
   {
     return progress_bar_set_show_text(widget, value_bool(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_REVERSE))
+  else if (id == WIDGET_PROP_ID_REVERSE)
   {
     return progress_bar_set_reverse(widget, value_bool(v));
   }
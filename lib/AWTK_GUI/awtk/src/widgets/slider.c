@@ -25,6 +25,7 @@
 #include "../base/keys.h"
 #include "slider.h"
 #include "../base/widget_vtable.h"
+#include "../base/widget_prop_ids.h"
 #include "../base/image_manager.h"
 
 static ret_t slider_load_icon(widget_t *widget, bitmap_t *img)
@@ -736,34 +737,37 @@ ret_t slider_set_line_cap(widget_t *widget, const char *line_cap)
 static ret_t slider_get_prop(widget_t *widget, const char *name, value_t *v)
 {
   slider_t *slider = SLIDER(widget);
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
   return_value_if_fail(slider != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_VALUE))
+  id = widget_prop_id(name);
+
+  if (id == WIDGET_PROP_ID_VALUE)
   {
     value_set_double(v, slider->value);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_VERTICAL))
+  else if (id == WIDGET_PROP_ID_VERTICAL)
   {
     value_set_bool(v, slider->vertical);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_MIN))
+  else if (id == WIDGET_PROP_ID_MIN)
   {
     value_set_double(v, slider->min);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_MAX))
+  else if (id == WIDGET_PROP_ID_MAX)
   {
     value_set_double(v, slider->max);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_STEP))
+  else if (id == WIDGET_PROP_ID_STEP)
   {
     value_set_double(v, slider->step);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_BAR_SIZE))
+  else if (id == WIDGET_PROP_ID_BAR_SIZE)
   {
     value_set_uint32(v, slider->bar_size);
     return RET_OK;
@@ -783,7 +787,7 @@ static ret_t slider_get_prop(widget_t *widget, const char *name, value_t *v)
     value_set_bool(v, slider->slide_with_bar);
     return RET_OK;
   }
-  else if (tk_str_eq(name, WIDGET_PROP_INPUTING))
+  else if (id == WIDGET_PROP_ID_INPUTING)
   {
     value_set_bool(v, slider->dragging);
     return RET_OK;
@@ -800,29 +804,32 @@ static ret_t slider_get_prop(widget_t *widget, const char *name, value_t *v)
 static ret_t slider_set_prop(widget_t *widget, const char *name, const value_t *v)
 {
   slider_t *slider = SLIDER(widget);
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
   return_value_if_fail(slider != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_VALUE))
+  id = widget_prop_id(name);
+
+  if (id == WIDGET_PROP_ID_VALUE)
   {
     return slider_set_value(widget, value_double(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_VERTICAL))
+  else if (id == WIDGET_PROP_ID_VERTICAL)
   {
     return slider_set_vertical(widget, value_bool(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_MIN))
+  else if (id == WIDGET_PROP_ID_MIN)
   {
     return slider_set_min(widget, value_double(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_MAX))
+  else if (id == WIDGET_PROP_ID_MAX)
   {
     return slider_set_max(widget, value_double(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_STEP))
+  else if (id == WIDGET_PROP_ID_STEP)
   {
     return slider_set_step(widget, value_double(v));
   }
-  else if (tk_str_eq(name, WIDGET_PROP_BAR_SIZE))
+  else if (id == WIDGET_PROP_ID_BAR_SIZE)
   {
     return slider_set_bar_size(widget, value_uint32(v));
   }
@@ -88,8 +88,13 @@ static ret_t window_animator_center_scale_draw_curr(window_animator_t *wa)
   vgcanvas_set_global_alpha(vg, 0xff);
   return RET_OK;
 #else
-  assert(!"not supported");
-  return RET_FAIL;
+  /*没有GPU时不能缩放控件，退化为淡入淡出。*/
+  uint8_t alpha = (1 - (1 - scale) / (1 - START_PERCENT)) * 0xff;
+
+  canvas_set_global_alpha(c, alpha);
+  widget_paint(win, c);
+  canvas_set_global_alpha(c, 0xff);
+  return RET_OK;
 #endif /*WITH_GPU*/
 
 #endif /*WITHOUT_WINDOW_ANIMATOR_CACHE*/
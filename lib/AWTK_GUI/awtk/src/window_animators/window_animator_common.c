@@ -102,7 +102,7 @@ ret_t window_animator_to_left_draw_curr(window_animator_t *wa)
 
   return lcd_draw_image(c->lcd, &(wa->curr_img), rectf_scale(&src, wa->ratio), &dst);
 #else
-  int32_t x = -win->w * (1 - percent);
+  int32_t x = win->w * (1 - percent);
 
   canvas_translate(c, x, 0);
   widget_paint(win, c);
@@ -129,7 +129,7 @@ ret_t window_animator_to_right_draw_curr(window_animator_t *wa)
 
   return lcd_draw_image(c->lcd, &(wa->curr_img), rectf_scale(&src, wa->ratio), &dst);
 #else
-  int32_t x = win->w * (1 - percent);
+  int32_t x = -win->w * (1 - percent);
 
   canvas_translate(c, x, 0);
   widget_paint(win, c);
@@ -167,7 +167,7 @@ static ret_t window_animator_close_destroy(window_animator_t *wa)
   return window_animator_open_destroy(wa);
 }
 
-ret_t window_animator_update(window_animator_t *wa, uint64_t time_ms)
+ret_t window_animator_step(window_animator_t *wa, uint64_t time_ms)
 {
   return_value_if_fail(wa != NULL, RET_FAIL);
 
@@ -183,10 +183,28 @@ ret_t window_animator_update(window_animator_t *wa, uint64_t time_ms)
   }
 
   ENSURE(window_animator_update_percent(wa) == RET_OK);
+
+  return wa->time_percent >= 1 ? RET_DONE : RET_OK;
+}
+
+ret_t window_animator_draw(window_animator_t *wa)
+{
+  return_value_if_fail(wa != NULL, RET_FAIL);
+
   ENSURE(window_animator_draw_prev_window(wa) == RET_OK);
   ENSURE(window_animator_draw_curr_window(wa) == RET_OK);
 
-  return wa->time_percent >= 1 ? RET_DONE : RET_OK;
+  return RET_OK;
+}
+
+ret_t window_animator_update(window_animator_t *wa, uint64_t time_ms)
+{
+  ret_t ret = window_animator_step(wa, time_ms);
+  return_value_if_fail(ret == RET_OK || ret == RET_DONE, ret);
+
+  window_animator_draw(wa);
+
+  return ret;
 }
 
 ret_t window_animator_destroy(window_animator_t *wa)
@@ -245,8 +263,6 @@ static ret_t window_animator_init(window_animator_t *wa)
 ret_t window_animator_prepare(window_animator_t *wa, canvas_t *c, widget_t *prev_win,
                               widget_t *curr_win)
 {
-  widget_t *wm = prev_win->parent;
-
   wa->canvas = c;
   wa->prev_win = prev_win;
   wa->curr_win = curr_win;
@@ -255,6 +271,7 @@ ret_t window_animator_prepare(window_animator_t *wa, canvas_t *c, widget_t *prev
 
   window_animator_init(wa);
 #ifndef WITHOUT_WINDOW_ANIMATOR_CACHE
+  widget_t *wm = prev_win->parent;
   window_manager_snap_prev_window(wm, prev_win, &(wa->prev_img));
   window_manager_snap_curr_window(wm, curr_win, &(wa->curr_img));
   wa->dialog_highlighter = window_manager_get_dialog_highlighter(wm);
@@ -362,10 +379,15 @@ ret_t window_animator_overlap_default_draw_prev(window_animator_t *wa)
 }
 
 ret_t window_animator_begin_frame(window_animator_t *wa)
+{
+  return window_animator_begin_frame_ex(wa, NULL);
+}
+
+ret_t window_animator_begin_frame_ex(window_animator_t *wa, const dirty_rects_t *dirty_rects)
 {
   return_value_if_fail(wa != NULL && wa->vt != NULL, RET_OK);
 
-  ENSURE(canvas_begin_frame(wa->canvas, NULL, LCD_DRAW_ANIMATION) == RET_OK);
+  ENSURE(canvas_begin_frame(wa->canvas, dirty_rects, LCD_DRAW_ANIMATION) == RET_OK);
   if (!tk_str_eq(wa->vt->type, WINDOW_ANIMATOR_VTRANSLATE))
   {
     window_animator_paint_system_bar(wa);
@@ -34,12 +34,14 @@ static ret_t window_animator_fade_draw_curr(window_animator_t *wa)
   lcd_set_global_alpha(c->lcd, global_alpha);
 
   ret = lcd_draw_image(c->lcd, &(wa->curr_img), rectf_scale(&src, wa->ratio), &dst);
+  lcd_set_global_alpha(c->lcd, 0xff);
 #else
-  lcd_set_global_alpha(c->lcd, global_alpha);
+  /*设置画布的透明度，窗口中的控件在绘制时会与自己的opacity相乘。*/
+  canvas_set_global_alpha(c, global_alpha);
 
   ret = widget_paint(win, c);
+  canvas_set_global_alpha(c, 0xff);
 #endif /*WITHOUT_WINDOW_ANIMATOR_CACHE*/
-  lcd_set_global_alpha(c->lcd, 0xff);
   return ret;
 }
 
@@ -42,9 +42,9 @@ static ret_t window_animator_htranslate_draw_prev(window_animator_t *wa)
   widget_t *win = wa->prev_win;
   float_t percent = wa->percent;
   float_t x = tk_roundi(win->w * percent);
-  float_t w = win->w - x;
 
 #ifndef WITHOUT_WINDOW_ANIMATOR_CACHE
+  float_t w = win->w - x;
   rectf_t src = rectf_init(x, win->y, w, win->h);
   rectf_t dst = rectf_init(0.0f, win->y, w, win->h);
   return lcd_draw_image(c->lcd, &(wa->prev_img), rectf_scale(&src, wa->ratio), &dst);
@@ -62,9 +62,9 @@ static ret_t window_animator_htranslate_draw_curr(window_animator_t *wa)
   widget_t *win = wa->curr_win;
   float_t percent = wa->percent;
   float_t x = tk_roundi(win->w * (1 - percent));
-  float_t w = win->w - x;
 
 #ifndef WITHOUT_WINDOW_ANIMATOR_CACHE
+  float_t w = win->w - x;
   rectf_t src = rectf_init(0.0f, win->y, w, win->h);
   rectf_t dst = rectf_init(x, win->y, w, win->h);
   return lcd_draw_image(c->lcd, &(wa->curr_img), rectf_scale(&src, wa->ratio), &dst);
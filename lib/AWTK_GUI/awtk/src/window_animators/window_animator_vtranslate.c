@@ -51,9 +51,9 @@ static ret_t window_animator_vtranslate_draw_prev(window_animator_t *wa)
   window_animator_vtranslate_t *wav = (window_animator_vtranslate_t *)wa;
   uint32_t range = wav->prev_win_y_range ? wav->prev_win_y_range : curr_win->h;
   float_t y = tk_roundi(range * percent);
-  float_t h = win->h - y;
 
 #ifndef WITHOUT_WINDOW_ANIMATOR_CACHE
+  float_t h = win->h - y;
   rectf_t src = rectf_init(win->x, y + win->y, win->w, h);
   rectf_t dst = rectf_init(win->x, win->y, win->w, h);
   return lcd_draw_image(c->lcd, &(wa->prev_img), rectf_scale(&src, wa->ratio), &dst);
@@ -29,6 +29,7 @@
 #include "../base/dialog.h"
 #include "../base/locale_info.h"
 #include "../base/system_info.h"
+#include "../base/render_trace.h"
 #include "../base/input_method.h"
 #include "../base/image_manager.h"
 #include "../base/canvas_offline.h"
@@ -793,15 +794,89 @@ static ret_t window_manager_update_cursor(widget_t *widget, int32_t x, int32_t y
   return RET_OK;
 }
 
-static ret_t window_manager_paint_normal(widget_t *widget, canvas_t *c)
+static bool_t window_manager_is_window_in_clip_rect(widget_t *win, canvas_t *c)
 {
+  int32_t tolerance = win->dirty_rect_tolerance;
+  int32_t left = c->ox + win->x - tolerance;
+  int32_t top = c->oy + win->y - tolerance;
+  int32_t bottom = top + win->h + 2 * tolerance;
+  int32_t right = left + win->w + 2 * tolerance;
+
+  if (win->vt->allow_draw_outside)
+  {
+    return TRUE;
+  }
+
+  return canvas_is_rect_in_clip_rect(c, left, top, right, bottom);
+}
+
 #ifdef FRAGMENT_FRAME_BUFFER_SIZE
+typedef ret_t (*window_manager_paint_strip_t)(widget_t *widget, canvas_t *c,
+                                              const dirty_rects_t *dirty_rects);
+
+static ret_t window_manager_paint_normal_strip(widget_t *widget, canvas_t *c,
+                                               const dirty_rects_t *dirty_rects)
+{
+  canvas_begin_frame(c, dirty_rects, LCD_DRAW_NORMAL);
+  widget_paint(widget, c);
+  window_manager_paint_cursor(widget, c);
+#ifdef ENABLE_RENDER_TRACE
+  render_trace_strip_flush_begin();
+#endif /*ENABLE_RENDER_TRACE*/
+
+  return canvas_end_frame(c);
+}
+
+static ret_t window_manager_paint_fragment_rect(widget_t *widget, canvas_t *c, rect_t r,
+                                                window_manager_paint_strip_t paint_strip)
+{
   uint32_t i = 0;
-  uint32_t y = 0;
-  uint32_t h = 0;
+  uint32_t y = r.y;
+  uint32_t h = r.h;
   uint32_t tmp_h = 0;
   uint32_t number = 0;
-#endif
+  return_value_if_fail(r.w > 0 && r.w <= FRAGMENT_FRAME_BUFFER_STRIP_SIZE, RET_BAD_PARAMS);
+
+  tmp_h = FRAGMENT_FRAME_BUFFER_STRIP_SIZE / r.w;
+  number = r.h / tmp_h;
+
+  for (i = 0; i <= number; i++)
+  {
+    dirty_rects_t tmp_dirty_rects;
+    r.y = y + i * tmp_h;
+    if (i == number)
+    {
+      tmp_h = h % tmp_h;
+    }
+    r.h = tmp_h;
+    if (r.h == 0)
+    {
+      break;
+    }
+    dirty_rects_init(&(tmp_dirty_rects));
+    dirty_rects_add(&(tmp_dirty_rects), (const rect_t *)&r);
+    c->visited_widgets_nr = 0;
+    c->painted_widgets_nr = 0;
+#ifdef ENABLE_RENDER_TRACE
+    render_trace_strip_begin(&r);
+#endif /*ENABLE_RENDER_TRACE*/
+    paint_strip(widget, c, (const dirty_rects_t *)&tmp_dirty_rects);
+#ifdef ENABLE_RENDER_TRACE
+    render_trace_strip_end(c->visited_widgets_nr, c->painted_widgets_nr);
+#endif /*ENABLE_RENDER_TRACE*/
+    dirty_rects_deinit(&(tmp_dirty_rects));
+#ifdef ENABLE_PERFORMANCE_PROFILE
+    log_debug("strip(%d %d %d %d) visited=%u painted=%u\n", r.x, r.y, r.w, r.h,
+              c->visited_widgets_nr, c->painted_widgets_nr);
+#endif /*ENABLE_PERFORMANCE_PROFILE*/
+  }
+
+  return RET_OK;
+}
+#endif /*FRAGMENT_FRAME_BUFFER_SIZE*/
+
+static ret_t window_manager_paint_normal(widget_t *widget, canvas_t *c)
+{
   uint64_t start_time = time_now_ms();
   window_manager_default_t *wm = WINDOW_MANAGER_DEFAULT(widget);
 
@@ -829,45 +904,47 @@ static ret_t window_manager_paint_normal(widget_t *widget, canvas_t *c)
 #ifdef FRAGMENT_FRAME_BUFFER_SIZE
   if (wm->native_window->dirty_rects.max.w > 0 && wm->native_window->dirty_rects.max.h > 0)
   {
-    rect_t r = native_window_calc_dirty_rect(wm->native_window);
-    if (r.w > 0 && r.h > 0)
-    {
-      assert(r.w <= FRAGMENT_FRAME_BUFFER_SIZE);
-      y = r.y;
-      h = r.h;
-      tmp_h = FRAGMENT_FRAME_BUFFER_SIZE / r.w;
-      number = r.h / tmp_h;
+    native_window_t *nw = wm->native_window;
+    dirty_rects_t *dirty_rects = &(nw->dirty_rects);
+    canvas_t *c = native_window_get_canvas(nw);
 
-      for (i = 0; i <= number; i++)
+#ifdef ENABLE_RENDER_TRACE
+    render_trace_frame_begin();
+#endif /*ENABLE_RENDER_TRACE*/
+    if (dirty_rects->disable_multiple || dirty_rects->nr == 0)
+    {
+      rect_t r = native_window_calc_dirty_rect(nw);
+      if (r.w > 0 && r.h > 0)
       {
-        dirty_rects_t tmp_dirty_rects;
-        r.y = y + i * tmp_h;
-        if (i == number)
-        {
-          tmp_h = h % tmp_h;
-        }
-        r.h = tmp_h;
-        if (r.h == 0)
+        window_manager_paint_fragment_rect(widget, c, r, window_manager_paint_normal_strip);
+      }
+    }
+    else
+    {
+      /* 每个脏矩形分别切成片段绘制，避免重绘和传输脏矩形之间未改变的区域。*/
+      uint32_t i = 0;
+      for (i = 0; i < dirty_rects->nr; i++)
+      {
+        rect_t r = rect_fix(dirty_rects->rects + i, nw->rect.w, nw->rect.h);
+        if (r.w > 0 && r.h > 0)
         {
-          break;
+          window_manager_paint_fragment_rect(widget, c, r, window_manager_paint_normal_strip);
         }
-        dirty_rects_init(&(tmp_dirty_rects));
-        dirty_rects_add(&(tmp_dirty_rects), (const rect_t *)&r);
-        canvas_t *c = native_window_get_canvas(wm->native_window);
-        canvas_begin_frame(c, (const dirty_rects_t *)&tmp_dirty_rects, LCD_DRAW_NORMAL);
-        widget_paint(WIDGET(wm), c);
-        window_manager_paint_cursor(widget, c);
-        canvas_end_frame(c);
-        dirty_rects_deinit(&(tmp_dirty_rects));
       }
-
-      native_window_update_last_dirty_rect(wm->native_window);
     }
-    native_window_clear_dirty_rect(wm->native_window);
+
+    native_window_update_last_dirty_rect(nw);
+    native_window_clear_dirty_rect(nw);
+#ifdef ENABLE_RENDER_TRACE
+    render_trace_frame_end();
+#endif /*ENABLE_RENDER_TRACE*/
   }
 #else
   if (native_window_begin_frame(wm->native_window, LCD_DRAW_NORMAL) == RET_OK)
   {
+#ifdef ENABLE_RENDER_TRACE
+    render_trace_frame_begin();
+#endif /*ENABLE_RENDER_TRACE*/
     if (widget->children == NULL || widget->children->size == 0)
     {
       color_t bg = color_init(0xff, 0xff, 0xff, 0xff);
@@ -889,6 +966,9 @@ static ret_t window_manager_paint_normal(widget_t *widget, canvas_t *c)
     }
     window_manager_paint_cursor(widget, c);
     native_window_end_frame(wm->native_window);
+#ifdef ENABLE_RENDER_TRACE
+    render_trace_frame_end();
+#endif /*ENABLE_RENDER_TRACE*/
   }
 #endif
   wm->last_paint_time = time_now_ms();
@@ -1070,6 +1150,58 @@ static ret_t window_manager_animate_done(widget_t *widget)
   return RET_OK;
 }
 
+#ifdef FRAGMENT_FRAME_BUFFER_SIZE
+static ret_t window_manager_paint_animation_strip(widget_t *widget, canvas_t *c,
+                                                  const dirty_rects_t *dirty_rects)
+{
+  paint_event_t e;
+  window_manager_default_t *wm = WINDOW_MANAGER_DEFAULT(widget);
+
+  ENSURE(window_animator_begin_frame_ex(wm->animator, dirty_rects) == RET_OK);
+
+  widget_dispatch(widget, paint_event_init(&e, EVT_BEFORE_PAINT, widget, c));
+
+  window_animator_draw(wm->animator);
+  window_manager_default_paint_always_on_top(widget, c);
+
+  widget_dispatch(widget, paint_event_init(&e, EVT_AFTER_PAINT, widget, c));
+#ifdef ENABLE_RENDER_TRACE
+  render_trace_strip_flush_begin();
+#endif /*ENABLE_RENDER_TRACE*/
+
+  return window_animator_end_frame(wm->animator);
+}
+
+static ret_t window_manager_paint_animation(widget_t *widget, canvas_t *c)
+{
+  uint64_t start_time = time_now_ms();
+  window_manager_default_t *wm = WINDOW_MANAGER_DEFAULT(widget);
+  rect_t r = rect_init(0, 0, wm->native_window->rect.w, wm->native_window->rect.h);
+  /*
+   * 片段帧缓存放不下窗口的截图，所以一帧只计算一次动画的进度，
+   * 然后逐个片段把前后两个窗口按偏移和透明度直接绘制到片段帧缓存中。
+   */
+  ret_t ret = window_animator_step(wm->animator, start_time);
+
+#ifdef ENABLE_RENDER_TRACE
+  render_trace_frame_begin();
+#endif /*ENABLE_RENDER_TRACE*/
+  window_manager_paint_fragment_rect(widget, c, r, window_manager_paint_animation_strip);
+#ifdef ENABLE_RENDER_TRACE
+  render_trace_frame_end();
+#endif /*ENABLE_RENDER_TRACE*/
+
+  wm->last_paint_cost = time_now_ms() - start_time;
+  fps_inc(&(wm->fps));
+
+  if (ret == RET_DONE)
+  {
+    window_manager_animate_done(widget);
+  }
+
+  return RET_OK;
+}
+#else
 static ret_t window_manager_paint_animation(widget_t *widget, canvas_t *c)
 {
   paint_event_t e;
@@ -1097,6 +1229,7 @@ static ret_t window_manager_paint_animation(widget_t *widget, canvas_t *c)
 
   return RET_OK;
 }
+#endif /*FRAGMENT_FRAME_BUFFER_SIZE*/
 #else
 static ret_t window_manager_animate_done(widget_t *widget)
 {
@@ -1236,7 +1369,17 @@ static ret_t window_manager_default_on_paint_children(widget_t *widget, canvas_t
         (wm->dialog_highlighter != NULL && wm->dialog_highlighter->dialog != NULL &&
          widget_is_normal_window(iter)))
     {
-      widget_paint(iter, c);
+      /*对话框等窗口不在当前裁剪区(如当前片段)时，不需要遍历其控件树*/
+      c->visited_widgets_nr++;
+      if (window_manager_is_window_in_clip_rect(iter, c))
+      {
+        c->painted_widgets_nr++;
+        widget_paint(iter, c);
+      }
+      else
+      {
+        iter->dirty = FALSE;
+      }
     }
   }
   WIDGET_FOR_EACH_CHILD_END()
@@ -1390,6 +1533,14 @@ static ret_t window_manager_default_is_animating(widget_t *widget, bool_t *playi
   return RET_OK;
 }
 
+static bool_t window_manager_default_has_dirty_rect(widget_t *widget)
+{
+  window_manager_default_t *wm = WINDOW_MANAGER_DEFAULT(widget);
+  return_value_if_fail(wm != NULL && wm->native_window != NULL, FALSE);
+
+  return wm->native_window->dirty_rects.max.w > 0 && wm->native_window->dirty_rects.max.h > 0;
+}
+
 static ret_t window_manager_default_orientation(widget_t *widget, wh_t w, wh_t h,
                                                 lcd_orientation_t old_orientation,
                                                 lcd_orientation_t new_orientation)
@@ -1734,8 +1885,8 @@ ret_t window_manager_paint_system_bar(widget_t *widget, canvas_t *c)
 
 static ret_t window_manager_default_reset_window_animator(widget_t *widget)
 {
-  window_manager_default_t *wm = WINDOW_MANAGER_DEFAULT(widget);
 #ifndef WITHOUT_WINDOW_ANIMATOR_CACHE
+  window_manager_default_t *wm = WINDOW_MANAGER_DEFAULT(widget);
   if (wm->animator != NULL)
   {
     window_animator_t *wa = wm->animator;
@@ -1824,6 +1975,7 @@ static window_manager_vtable_t s_window_manager_self_vtable = {
     .set_screen_saver_time = window_manager_default_set_screen_saver_time,
     .get_pointer = window_manager_default_get_pointer,
     .is_animating = window_manager_default_is_animating,
+    .has_dirty_rect = window_manager_default_has_dirty_rect,
     .snap_curr_window = window_manager_default_snap_curr_window,
     .snap_prev_window = window_manager_default_snap_prev_window,
     .get_dialog_highlighter = window_manager_default_get_dialog_highlighter,
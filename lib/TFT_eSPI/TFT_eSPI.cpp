@@ -4608,6 +4608,37 @@ void TFT_eSPI::esp32_set_window_func(uint16_t xs, uint16_t ys, uint16_t xe, uint
   end_tft_write();
 }
 
+// Push a whole block of pixels in one SPI transaction, the byte swap is done while streaming
+void TFT_eSPI::esp32_draw_bitmap_func(uint16_t xs, uint16_t ys, uint16_t w, uint16_t h, uint16_t *data)
+{
+  bool swap = _swapBytes;
+
+  begin_tft_write();
+  setWindow(xs, ys, xs + w - 1, ys + h - 1);
+  _swapBytes = true;
+  pushPixels(data, (uint32_t)w * h);
+  _swapBytes = swap;
+  end_tft_write();
+}
+
+// Start a DMA transfer of a block of pixels and return at once, the bytes are swapped in place
+void TFT_eSPI::esp32_draw_bitmap_dma_func(uint16_t xs, uint16_t ys, uint16_t w, uint16_t h, uint16_t *data)
+{
+  bool swap = _swapBytes;
+
+  if (!inTransaction) startWrite();
+  _swapBytes = true;
+  pushImageDMA(xs, ys, w, h, data);
+  _swapBytes = swap;
+}
+
+// Wait for the DMA transfer to complete and release the SPI bus
+void TFT_eSPI::esp32_wait_bitmap_dma_func(void)
+{
+  dmaWait();
+  if (inTransaction) endWrite();
+}
+
 
 
 
@@ -400,6 +400,9 @@ public:
   // ΪֲAWTK,
   void esp32_write_data_func(uint16_t dat);
   void esp32_set_window_func(uint16_t xs, uint16_t ys, uint16_t xe, uint16_t ye);
+  void esp32_draw_bitmap_func(uint16_t xs, uint16_t ys, uint16_t w, uint16_t h, uint16_t *data);
+  void esp32_draw_bitmap_dma_func(uint16_t xs, uint16_t ys, uint16_t w, uint16_t h, uint16_t *data);
+  void esp32_wait_bitmap_dma_func(void);
   
   // The TFT_eSprite class inherits the following functions (not all are useful to Sprite class
   void setAddrWindow(int32_t xs, int32_t ys, int32_t w, int32_t h), // Note: start coordinates + width and height
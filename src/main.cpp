@@ -10,6 +10,9 @@ void setup()
 {
   Serial.begin(115200);
   tft.begin();
+#if FRAGMENT_FRAME_BUFFER_NR > 1
+  tft.initDMA(); // LCD is flushed by DMA while the next strip is rendered
+#endif
   tft.setRotation(3);        // ʾ
   tft.fillScreen(TFT_BLACK); // 
 }
@@ -0,0 +1,4 @@
+/**
+ * 主机(native)测试环境使用和设备相同的内置资源(demos/demo.h 在设备上包含它)。
+ */
+#include "../../lib/AWTK_GUI/awtk/res/assets.inc"
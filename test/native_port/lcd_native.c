@@ -0,0 +1,56 @@
+/**
+ * 主机(native)测试环境的 lcd，对应 awtk-port/lcd_esp32_raw.cpp，片段通过模拟总线送到屏幕。
+ *
+ * 定义 NATIVE_LCD_PER_PIXEL 时不提供 lcd_draw_bitmap_impl，走逐像素 write_data_func 的旧路径。
+ * FRAGMENT_FRAME_BUFFER_NR > 1 时片段异步(模拟 DMA)推送，推送期间继续绘制下一个片段。
+ */
+#include "tkc/mem.h"
+#include "lcd/lcd_mem_fragment.h"
+#include "mock_bus.h"
+
+typedef uint16_t pixel_t;
+
+#define LCD_FORMAT BITMAP_FMT_BGR565
+#define pixel_from_rgb(r, g, b) ((((r) >> 3) << 11) | (((g) >> 2) << 5) | ((b) >> 3))
+#define pixel_from_rgba(r, g, b, a) ((((r) >> 3) << 11) | (((g) >> 2) << 5) | ((b) >> 3))
+#define pixel_to_rgba(p)                                                         \
+  {                                                                              \
+    (0xff & ((p >> 11) << 3)), (0xff & ((p >> 5) << 2)), (0xff & (p << 3)), 0xff \
+  }
+
+void write_data_func(uint16_t dat)
+{
+  mock_bus_write_pixel(dat);
+}
+
+void set_window_func(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end)
+{
+  mock_bus_set_window(x_start, y_start, x_end, y_end);
+}
+
+#ifndef NATIVE_LCD_PER_PIXEL
+#define lcd_draw_bitmap_impl(x, y, w, h, p) mock_bus_write_block(x, y, w, h, p)
+
+#if FRAGMENT_FRAME_BUFFER_NR > 1
+static void draw_bitmap_async_func(uint16_t x, uint16_t y, uint16_t w, uint16_t h, pixel_t *data);
+
+#define lcd_draw_bitmap_async_impl(x, y, w, h, p) draw_bitmap_async_func(x, y, w, h, p)
+#define lcd_draw_bitmap_wait_impl() mock_bus_wait()
+#endif /*FRAGMENT_FRAME_BUFFER_NR > 1*/
+#endif /*NATIVE_LCD_PER_PIXEL*/
+
+#include "base/pixel.h"
+#include "blend/pixel_ops.inc"
+#include "lcd/lcd_mem_fragment.inc"
+
+#ifdef LCD_MEM_FRAGMENT_ASYNC_FLUSH
+static void draw_bitmap_done(void)
+{
+  lcd_mem_fragment_flush_done((lcd_t *)&s_lcd_mem_fragment);
+}
+
+static void draw_bitmap_async_func(uint16_t x, uint16_t y, uint16_t w, uint16_t h, pixel_t *data)
+{
+  mock_bus_write_block_async(x, y, w, h, data, draw_bitmap_done);
+}
+#endif /*LCD_MEM_FRAGMENT_ASYNC_FLUSH*/
@@ -0,0 +1,21 @@
+/**
+ * 主机(native)测试环境的主循环，对应 awtk-port/main_loop_esp32_raw.cpp。
+ */
+#include "base/main_loop.h"
+#include "lcd/lcd_mem_fragment.h"
+#include "main_loop/main_loop_simple.h"
+#include "mock_bus.h"
+
+ret_t platform_disaptch_input(main_loop_t *l)
+{
+  return RET_OK;
+}
+
+lcd_t *platform_create_lcd(wh_t w, wh_t h)
+{
+  return_value_if_fail(mock_bus_init(w, h) == RET_OK, NULL);
+
+  return lcd_mem_fragment_create(w, h);
+}
+
+#include "main_loop/main_loop_raw.inc"
@@ -0,0 +1,212 @@
+/**
+ * 主机(native)测试环境的模拟 SPI 屏幕总线。
+ */
+#include "tkc/mem.h"
+#include "tkc/time_now.h"
+#include "mock_bus.h"
+
+typedef struct _mock_bus_t
+{
+  uint16_t *screen;
+  uint32_t w;
+  uint32_t h;
+
+  uint32_t bytes_per_sec;
+  uint32_t transaction_us;
+  bool_t async;
+
+  /*set_window 设置的窗口，write_pixel 按行依次写入*/
+  uint32_t win_x0;
+  uint32_t win_y0;
+  uint32_t win_x1;
+  uint32_t cur_x;
+  uint32_t cur_y;
+
+  /*进行中的异步传输，DMA 在完成时才读取数据，这样提前复用缓冲区会被发现*/
+  bool_t pending;
+  uint32_t pending_x;
+  uint32_t pending_y;
+  uint32_t pending_w;
+  uint32_t pending_h;
+  const uint16_t *pending_data;
+  mock_bus_done_t pending_done;
+  uint64_t busy_until;
+
+  mock_bus_stats_t stats;
+} mock_bus_t;
+
+static mock_bus_t s_bus;
+
+static uint64_t mock_bus_transfer_us(uint64_t bytes)
+{
+  if (s_bus.bytes_per_sec == 0)
+  {
+    return 0;
+  }
+
+  return s_bus.transaction_us + bytes * 1000000 / s_bus.bytes_per_sec;
+}
+
+static void mock_bus_spin_until(uint64_t t)
+{
+  uint64_t now = time_now_us();
+
+  if (t > now)
+  {
+    s_bus.stats.wait_us += t - now;
+    while (time_now_us() < t)
+    {
+    }
+  }
+}
+
+static void mock_bus_copy(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint16_t *data)
+{
+  uint32_t j = 0;
+
+  for (j = 0; j < h && y + j < s_bus.h; j++)
+  {
+    memcpy(s_bus.screen + (y + j) * s_bus.w + x, data + j * w, w * sizeof(uint16_t));
+  }
+}
+
+static uint64_t mock_bus_start(uint64_t bytes)
+{
+  uint64_t now = time_now_us();
+  uint64_t dur = mock_bus_transfer_us(bytes);
+  uint64_t start = tk_max(now, s_bus.busy_until);
+
+  s_bus.stats.transactions++;
+  s_bus.stats.bytes += bytes;
+  s_bus.stats.busy_us += dur;
+  s_bus.busy_until = start + dur;
+
+  return s_bus.busy_until;
+}
+
+ret_t mock_bus_init(uint32_t w, uint32_t h)
+{
+  TKMEM_FREE(s_bus.screen);
+  memset(&s_bus, 0x00, sizeof(s_bus));
+
+  s_bus.screen = TKMEM_ZALLOCN(uint16_t, w * h);
+  return_value_if_fail(s_bus.screen != NULL, RET_OOM);
+  s_bus.w = w;
+  s_bus.h = h;
+  s_bus.async = TRUE;
+
+  return RET_OK;
+}
+
+ret_t mock_bus_set_speed(uint32_t bytes_per_sec, uint32_t transaction_us)
+{
+  s_bus.bytes_per_sec = bytes_per_sec;
+  s_bus.transaction_us = transaction_us;
+
+  return RET_OK;
+}
+
+ret_t mock_bus_set_async(bool_t async)
+{
+  mock_bus_wait();
+  s_bus.async = async;
+
+  return RET_OK;
+}
+
+ret_t mock_bus_reset_stats(void)
+{
+  memset(&(s_bus.stats), 0x00, sizeof(s_bus.stats));
+
+  return RET_OK;
+}
+
+const mock_bus_stats_t *mock_bus_get_stats(void)
+{
+  return &(s_bus.stats);
+}
+
+uint16_t *mock_bus_get_screen(void)
+{
+  return s_bus.screen;
+}
+
+ret_t mock_bus_set_window(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1)
+{
+  s_bus.win_x0 = x0;
+  s_bus.win_y0 = y0;
+  s_bus.win_x1 = x1;
+  s_bus.cur_x = x0;
+  s_bus.cur_y = y0;
+  mock_bus_spin_until(mock_bus_start(0));
+
+  return RET_OK;
+}
+
+ret_t mock_bus_write_pixel(uint16_t pixel)
+{
+  if (s_bus.cur_x < s_bus.w && s_bus.cur_y < s_bus.h)
+  {
+    s_bus.screen[s_bus.cur_y * s_bus.w + s_bus.cur_x] = pixel;
+  }
+  if (++s_bus.cur_x > s_bus.win_x1)
+  {
+    s_bus.cur_x = s_bus.win_x0;
+    s_bus.cur_y++;
+  }
+  mock_bus_spin_until(mock_bus_start(sizeof(pixel)));
+
+  return RET_OK;
+}
+
+ret_t mock_bus_write_block(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint16_t *data)
+{
+  mock_bus_wait();
+  mock_bus_copy(x, y, w, h, data);
+  mock_bus_spin_until(mock_bus_start(w * h * sizeof(uint16_t)));
+
+  return RET_OK;
+}
+
+ret_t mock_bus_write_block_async(uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+                                 const uint16_t *data, mock_bus_done_t on_done)
+{
+  if (!s_bus.async)
+  {
+    mock_bus_write_block(x, y, w, h, data);
+    if (on_done != NULL)
+    {
+      on_done();
+    }
+    return RET_OK;
+  }
+
+  mock_bus_wait();
+  s_bus.pending = TRUE;
+  s_bus.pending_x = x;
+  s_bus.pending_y = y;
+  s_bus.pending_w = w;
+  s_bus.pending_h = h;
+  s_bus.pending_data = data;
+  s_bus.pending_done = on_done;
+  mock_bus_start(w * h * sizeof(uint16_t));
+
+  return RET_OK;
+}
+
+ret_t mock_bus_wait(void)
+{
+  if (s_bus.pending)
+  {
+    mock_bus_spin_until(s_bus.busy_until);
+    s_bus.pending = FALSE;
+    mock_bus_copy(s_bus.pending_x, s_bus.pending_y, s_bus.pending_w, s_bus.pending_h,
+                  s_bus.pending_data);
+    if (s_bus.pending_done != NULL)
+    {
+      s_bus.pending_done();
+    }
+  }
+
+  return RET_OK;
+}
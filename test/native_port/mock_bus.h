@@ -0,0 +1,69 @@
+/**
+ * 主机(native)测试环境的模拟 SPI 屏幕总线。
+ *
+ * 对应 TFT_eSPI 的 esp32_*_func：每次片选(begin_tft_write..end_tft_write)算一次事务，
+ * 统计事务数、字节数以及按设定速度模拟出来的传输时间，像素写入内存中的屏幕，便于校验。
+ */
+#ifndef TK_MOCK_BUS_H
+#define TK_MOCK_BUS_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+typedef void (*mock_bus_done_t)(void);
+
+typedef struct _mock_bus_stats_t
+{
+  /*事务数*/
+  uint32_t transactions;
+  /*传输的像素字节数*/
+  uint64_t bytes;
+  /*总线传输的(模拟)时间*/
+  uint64_t busy_us;
+  /*CPU 等待总线空闲的时间*/
+  uint64_t wait_us;
+} mock_bus_stats_t;
+
+/**
+ * 初始化屏幕，清除统计，不模拟传输时间。
+ */
+ret_t mock_bus_init(uint32_t w, uint32_t h);
+
+/**
+ * 设置模拟的总线速度。bytes_per_sec 为 0 表示传输不耗时。
+ * transaction_us 为每次事务的固定开销(片选、设置窗口等)。
+ */
+ret_t mock_bus_set_speed(uint32_t bytes_per_sec, uint32_t transaction_us);
+
+/**
+ * 异步传输是否真的异步。为 FALSE 时 mock_bus_write_block_async 等传输完成才返回。
+ */
+ret_t mock_bus_set_async(bool_t async);
+
+ret_t mock_bus_reset_stats(void);
+const mock_bus_stats_t *mock_bus_get_stats(void);
+
+/**
+ * 屏幕内容，每行 w 个像素。
+ */
+uint16_t *mock_bus_get_screen(void);
+
+ret_t mock_bus_set_window(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1);
+ret_t mock_bus_write_pixel(uint16_t pixel);
+ret_t mock_bus_write_block(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint16_t *data);
+
+/**
+ * 启动一次传输(如 DMA)，完成时调用 on_done。同一时间只有一次传输，前一次没完成时先等待。
+ */
+ret_t mock_bus_write_block_async(uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+                                 const uint16_t *data, mock_bus_done_t on_done);
+
+/**
+ * 等待进行中的传输完成。
+ */
+ret_t mock_bus_wait(void);
+
+END_C_DECLS
+
+#endif /*TK_MOCK_BUS_H*/
@@ -0,0 +1,91 @@
+/**
+ * 主机(native)测试环境的公共函数。
+ */
+#include <malloc.h>
+#include "base/idle.h"
+#include "base/timer.h"
+#include "native_app.h"
+
+extern ret_t assets_init(void);
+
+ret_t native_app_init(wh_t w, wh_t h)
+{
+  return_value_if_fail(tk_init(w, h, APP_MOBILE, "native", NULL) == RET_OK, RET_FAIL);
+  return_value_if_fail(assets_init() == RET_OK, RET_FAIL);
+  tk_ext_widgets_init();
+  /*测的是绘制的开销，不按帧率限制*/
+  WINDOW_MANAGER(window_manager())->max_fps = 0;
+
+  return RET_OK;
+}
+
+ret_t native_app_pump(void)
+{
+  idle_dispatch();
+  timer_dispatch();
+
+  return RET_OK;
+}
+
+widget_t *native_app_create_sample_window(const char *title)
+{
+  uint32_t i = 0;
+  widget_t *w = NULL;
+  widget_t *win = window_create(NULL, 0, 0, 0, 0);
+  wh_t W = win->w;
+  wh_t rh = win->h / 5;
+
+  w = label_create(win, 4, 2, W - 8, rh);
+  widget_set_text_utf8(w, title);
+  for (i = 0; i < 3; i++)
+  {
+    char name[32];
+    tk_snprintf(name, sizeof(name), "%c%u", title[0], i + 1);
+    w = button_create(win, 4 + i * (W / 3), rh + 4, W / 3 - 8, rh);
+    widget_set_text_utf8(w, name);
+  }
+  w = progress_bar_create(win, 4, 2 * rh + 8, W - 8, rh / 2);
+  widget_set_value(w, 60);
+  w = check_button_create(win, 4, 3 * rh, W / 2 - 8, rh);
+  widget_set_text_utf8(w, "Enable");
+  w = label_create(win, W / 2, 3 * rh, W / 2 - 4, rh);
+  widget_set_text_utf8(w, "Volume 60%");
+  w = slider_create(win, 4, 4 * rh, W - 8, rh - 2);
+  widget_set_value(w, 40);
+
+  return win;
+}
+
+double native_app_paint_frames(uint32_t nr)
+{
+  uint32_t i = 0;
+  uint64_t start = 0;
+  widget_t *wm = window_manager();
+
+  /*先把打开窗口等待处理的事件和首帧处理掉*/
+  native_app_pump();
+  window_manager_paint(wm);
+
+  start = time_now_us();
+  for (i = 0; i < nr; i++)
+  {
+    widget_invalidate_force(wm, NULL);
+    window_manager_paint(wm);
+  }
+
+  return (double)(time_now_us() - start) / nr;
+}
+
+uint64_t native_app_heap_used(void)
+{
+  struct mallinfo2 info = mallinfo2();
+
+  return info.uordblks + info.hblkhd;
+}
+
+uint64_t native_app_heap_free(void)
+{
+  struct mallinfo2 info = mallinfo2();
+
+  return info.fordblks;
+}
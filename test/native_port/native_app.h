@@ -0,0 +1,43 @@
+/**
+ * 主机(native)测试环境的公共函数：初始化 AWTK、构造示例页面、计时绘制。
+ */
+#ifndef TK_NATIVE_APP_H
+#define TK_NATIVE_APP_H
+
+#include "awtk.h"
+
+BEGIN_C_DECLS
+
+/**
+ * 按设备的配置初始化 AWTK(lcd_mem_fragment + 模拟总线)，并加载内置资源。
+ */
+ret_t native_app_init(wh_t w, wh_t h);
+
+/**
+ * 处理已到期的定时器和 idle。
+ */
+ret_t native_app_pump(void);
+
+/**
+ * 创建一个和 demo 相当的页面：标题、按钮、进度条、勾选框、滑块。
+ */
+widget_t *native_app_create_sample_window(const char *title);
+
+/**
+ * 整屏刷新 nr 帧，返回平均每帧的时间(微秒)。
+ */
+double native_app_paint_frames(uint32_t nr);
+
+/**
+ * 当前堆上已分配的字节数(glibc mallinfo2)。
+ */
+uint64_t native_app_heap_used(void);
+
+/**
+ * 堆中空闲(已经从系统取得、但没有分配出去)的字节数(glibc mallinfo2)，用于观察碎片。
+ */
+uint64_t native_app_heap_free(void);
+
+END_C_DECLS
+
+#endif /*TK_NATIVE_APP_H*/
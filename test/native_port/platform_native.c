@@ -0,0 +1,31 @@
+/**
+ * 主机(native)测试环境的平台函数，对应 awtk-port/platform.cpp。
+ */
+#include <time.h>
+#include <unistd.h>
+#include "tkc/mem.h"
+#include "tkc/fs.h"
+#include "tkc/platform.h"
+
+uint64_t get_time_us64(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+uint64_t get_time_ms64(void)
+{
+  return get_time_us64() / 1000ULL;
+}
+
+void sleep_ms(uint32_t ms)
+{
+  usleep(ms * 1000);
+}
+
+ret_t platform_prepare(void)
+{
+  return RET_OK;
+}
@@ -0,0 +1,211 @@
+/**
+ * user-013: emitter 按事件类型分组(bucket)。
+ *
+ * 最后一个回调函数移除后 bucket 被释放，包括在分发过程中移除的情况；
+ * 注册 1/8/64 个回调函数时 emitter_dispatch 的开销。
+ */
+#include <unity.h>
+#include "awtk.h"
+#include "native_app.h"
+
+#define BENCH_NR 100000
+#define BENCH_ROUNDS 5
+
+static uint32_t s_called = 0;
+
+void setUp(void)
+{
+  s_called = 0;
+}
+
+void tearDown(void)
+{
+}
+
+static uint32_t bucket_nr(emitter_t *emitter)
+{
+  uint32_t nr = 0;
+  emitter_bucket_t *iter = NULL;
+
+  for (iter = emitter->buckets; iter != NULL; iter = iter->next)
+  {
+    nr++;
+  }
+
+  return nr;
+}
+
+static ret_t on_count(void *ctx, event_t *e)
+{
+  s_called++;
+
+  return RET_OK;
+}
+
+static ret_t on_remove(void *ctx, event_t *e)
+{
+  s_called++;
+
+  return RET_REMOVE;
+}
+
+static ret_t on_off_self(void *ctx, event_t *e)
+{
+  emitter_t *emitter = EMITTER(ctx);
+
+  s_called++;
+  emitter_off_by_func(emitter, e->type, on_off_self, ctx);
+
+  return RET_OK;
+}
+
+static void test_bucket_freed_on_off(void)
+{
+  uint32_t i = 0;
+  uint32_t ids[16];
+  emitter_t *emitter = emitter_create();
+
+  for (i = 0; i < ARRAY_SIZE(ids); i++)
+  {
+    ids[i] = emitter_on(emitter, EVT_USER_START + i, on_count, NULL);
+  }
+  emitter_on(emitter, EVT_USER_START, on_count, NULL);
+  TEST_ASSERT_EQUAL_UINT32(ARRAY_SIZE(ids), bucket_nr(emitter));
+
+  /*同一类型还有回调函数时 bucket 保留*/
+  emitter_off(emitter, ids[0]);
+  TEST_ASSERT_EQUAL_UINT32(ARRAY_SIZE(ids), bucket_nr(emitter));
+
+  for (i = 1; i < ARRAY_SIZE(ids); i++)
+  {
+    emitter_off(emitter, ids[i]);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, bucket_nr(emitter));
+
+  emitter_off_by_func(emitter, EVT_USER_START, on_count, NULL);
+  TEST_ASSERT_NULL(emitter->buckets);
+  TEST_ASSERT_EQUAL_UINT32(0, emitter_size(emitter));
+
+  emitter_dispatch_simple_event(emitter, EVT_USER_START);
+  TEST_ASSERT_EQUAL_UINT32(0, s_called);
+
+  emitter_destroy(emitter);
+}
+
+static void test_bucket_freed_in_dispatch(void)
+{
+  emitter_t *emitter = emitter_create();
+
+  /*返回 RET_REMOVE*/
+  emitter_on(emitter, EVT_USER_START, on_remove, NULL);
+  emitter_on(emitter, EVT_USER_START, on_remove, NULL);
+  emitter_on(emitter, EVT_USER_START + 1, on_count, NULL);
+  emitter_dispatch_simple_event(emitter, EVT_USER_START);
+  TEST_ASSERT_EQUAL_UINT32(2, s_called);
+  TEST_ASSERT_EQUAL_UINT32(1, bucket_nr(emitter));
+
+  /*在回调函数中注销自己(pending_remove)*/
+  emitter_on(emitter, EVT_USER_START + 2, on_off_self, emitter);
+  emitter_dispatch_simple_event(emitter, EVT_USER_START + 2);
+  TEST_ASSERT_EQUAL_UINT32(3, s_called);
+  TEST_ASSERT_EQUAL_UINT32(1, bucket_nr(emitter));
+  emitter_dispatch_simple_event(emitter, EVT_USER_START + 2);
+  TEST_ASSERT_EQUAL_UINT32(3, s_called);
+
+  emitter_dispatch_simple_event(emitter, EVT_USER_START + 1);
+  TEST_ASSERT_EQUAL_UINT32(4, s_called);
+
+  emitter_destroy(emitter);
+}
+
+static void test_widget_off(void)
+{
+  widget_t *win = window_create(NULL, 0, 0, 0, 0);
+  widget_t *button = button_create(win, 0, 0, 80, 30);
+  uint32_t id = widget_on(button, EVT_USER_START, on_count, NULL);
+
+  widget_on(button, EVT_USER_START + 1, on_count, NULL);
+  TEST_ASSERT_EQUAL_UINT32(2, bucket_nr(button->emitter));
+  widget_off(button, id);
+  widget_off_by_func(button, EVT_USER_START + 1, on_count, NULL);
+  TEST_ASSERT_NULL(button->emitter->buckets);
+
+  widget_destroy(win);
+  native_app_pump();
+}
+
+/*取几轮中最快的一轮，减少主机上其它负载的干扰，返回每次分发的时间(纳秒)*/
+static double bench_dispatch(emitter_t *emitter, uint32_t type)
+{
+  uint32_t i = 0;
+  uint32_t r = 0;
+  uint64_t best = 0xffffffff;
+  /*event_init 会读取时间，放在循环外面，只测分发本身*/
+  event_t e = event_init(type, NULL);
+
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    uint64_t start = time_now_us();
+    for (i = 0; i < BENCH_NR; i++)
+    {
+      emitter_dispatch(emitter, &e);
+    }
+    best = tk_min(best, time_now_us() - start);
+  }
+
+  return best * 1000.0 / BENCH_NR;
+}
+
+/*
+ * same:  nr 个回调函数都是同一类型，分发该类型(每个都要调用)。
+ * mixed: nr 个回调函数分属 nr 种类型，分发其中一种(只调用一个)。
+ * miss:  nr 个回调函数分属 nr 种类型，分发没有回调函数的类型。
+ */
+static void bench_handlers(uint32_t nr)
+{
+  uint32_t i = 0;
+  char msg[128];
+  double same = 0;
+  double mixed = 0;
+  double miss = 0;
+  emitter_t *emitter = emitter_create();
+
+  for (i = 0; i < nr; i++)
+  {
+    emitter_on(emitter, EVT_USER_START, on_count, NULL);
+  }
+  same = bench_dispatch(emitter, EVT_USER_START);
+  emitter_destroy(emitter);
+
+  emitter = emitter_create();
+  for (i = 0; i < nr; i++)
+  {
+    emitter_on(emitter, EVT_USER_START + i, on_count, NULL);
+  }
+  mixed = bench_dispatch(emitter, EVT_USER_START + nr / 2);
+  miss = bench_dispatch(emitter, EVT_USER_START + nr);
+  emitter_destroy(emitter);
+
+  tk_snprintf(msg, sizeof(msg), "%2u handlers: same %7.1fns  mixed %6.1fns  miss %6.1fns", nr,
+              same, mixed, miss);
+  TEST_MESSAGE(msg);
+}
+
+static void test_bench(void)
+{
+  bench_handlers(1);
+  bench_handlers(8);
+  bench_handlers(64);
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(320, 240);
+  RUN_TEST(test_bucket_freed_on_off);
+  RUN_TEST(test_bucket_freed_in_dispatch);
+  RUN_TEST(test_widget_off);
+  RUN_TEST(test_bench);
+  tk_exit();
+  return UNITY_END();
+}
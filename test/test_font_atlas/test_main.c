@@ -0,0 +1,170 @@
+/**
+ * user-006: 预先光栅化的位图字体(default_18)与运行时用 stb 光栅化的比较。
+ *
+ * 检查 "字体名_字号" 的位图字体优先、缺字时回退到 Truetype 字体，
+ * 并比较首帧绘制时间和堆的占用。
+ */
+#include <unity.h>
+#include "base/font_manager.h"
+#include "font_loader/font_loader_bitmap.h"
+#include "font_loader/font_loader_truetype.h"
+#include "native_app.h"
+
+#define TEXT "Volume 60% Brightness 80% Wi-Fi: on"
+
+static const asset_info_t *s_ttf = NULL;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void test_atlas_preferred(void)
+{
+  font_t *font = font_manager_get_font(font_manager(), "default", 18);
+
+  TEST_ASSERT_NOT_NULL(font);
+  TEST_ASSERT_EQUAL_STRING("default_18", font->name);
+  font = font_manager_get_font(font_manager(), "default", 16);
+  TEST_ASSERT_NOT_NULL(font);
+  TEST_ASSERT_EQUAL_STRING("default", font->name);
+}
+
+static void test_atlas_fallback(void)
+{
+  glyph_t g;
+  glyph_t ttf_g;
+  font_t *font = font_manager_get_font(font_manager(), "default", 18);
+  font_t *ttf = font_manager_get_font(font_manager(), "default", 16);
+
+  /*'A' 在位图字体里，字模直接在 flash 中*/
+  TEST_ASSERT_EQUAL_INT(RET_OK, font_get_glyph(font, 'A', 18, &g));
+  TEST_ASSERT_TRUE(g.w > 0 && g.data != NULL);
+
+  /*U+2014 只在 default.ttf 里，由同名的 Truetype 字体渲染*/
+  TEST_ASSERT_EQUAL_INT(RET_OK, font_get_glyph(font, 0x2014, 18, &g));
+  TEST_ASSERT_EQUAL_INT(RET_OK, font_get_glyph(ttf, 0x2014, 18, &ttf_g));
+  TEST_ASSERT_TRUE(g.w > 0);
+  TEST_ASSERT_EQUAL_INT(ttf_g.w, g.w);
+  TEST_ASSERT_EQUAL_INT(ttf_g.h, g.h);
+
+  /*两边都没有的字符仍然找不到*/
+  TEST_ASSERT_TRUE(font_get_glyph(font, 0x4e2d, 18, &g) != RET_OK);
+}
+
+typedef struct _first_paint_t
+{
+  double paint_us;
+  double glyph_us;
+  int64_t heap;
+} first_paint_t;
+
+typedef font_t *(*create_font_t)(void);
+
+static void unload_fonts(void)
+{
+  font_manager_unload_all(font_manager());
+  /*和切换主题时一样，画布不能再引用卸载了的字体*/
+  widget_reset_canvas(window_manager());
+}
+
+static font_t *create_atlas(void)
+{
+  const asset_info_t *info = assets_manager_ref(assets_manager(), ASSET_TYPE_FONT, "default_18");
+  font_t *font = font_bitmap_create("default_18", info->data, info->size);
+  assets_manager_unref(assets_manager(), info);
+
+  return font;
+}
+
+static font_t *create_stb(void)
+{
+  /*同名的 stb 字体顶替位图字体，字模都要在运行时光栅化*/
+  return font_truetype_create("default_18", s_ttf->data, s_ttf->size);
+}
+
+static first_paint_t first_paint(create_font_t create)
+{
+  font_t *font = NULL;
+  uint32_t i = 0;
+  glyph_t g;
+  first_paint_t r;
+  uint64_t start = 0;
+  uint64_t heap = 0;
+  widget_t *win = NULL;
+  const char *text = TEXT;
+
+  unload_fonts();
+  font = create();
+  font_manager_add_font(font_manager(), font);
+
+  /*取一遍字符串里的字模：位图字体直接读，stb 要光栅化并放进 glyph cache*/
+  start = time_now_us();
+  for (i = 0; text[i]; i++)
+  {
+    font_get_glyph(font, text[i], 18, &g);
+  }
+  r.glyph_us = time_now_us() - start;
+  unload_fonts();
+
+  win = window_create(NULL, 0, 0, 0, 0);
+  for (i = 0; i < 3; i++)
+  {
+    widget_t *label = label_create(win, 0, i * 26, win->w, 26);
+    widget_set_text_utf8(label, text + i * 12);
+  }
+  /*先画一次，窗口和画布的首次分配不算在内，只换成新建(字模未缓存)的字体再画*/
+  native_app_pump();
+  window_manager_paint(window_manager());
+  unload_fonts();
+  heap = native_app_heap_used();
+  font_manager_add_font(font_manager(), create());
+
+  start = time_now_us();
+  widget_invalidate_force(window_manager(), NULL);
+  window_manager_paint(window_manager());
+  r.paint_us = time_now_us() - start;
+  r.heap = (int64_t)native_app_heap_used() - (int64_t)heap;
+
+  window_close_force(win);
+  native_app_pump();
+  window_manager_paint(window_manager());
+
+  return r;
+}
+
+static void test_first_paint(void)
+{
+  char msg[160];
+  first_paint_t atlas;
+  first_paint_t stb;
+
+  atlas = first_paint(create_atlas);
+  stb = first_paint(create_stb);
+
+  tk_snprintf(msg, sizeof(msg), "atlas: glyphs %.0fus, first paint %.0fus, heap %+lld bytes",
+              atlas.glyph_us, atlas.paint_us, (long long)atlas.heap);
+  TEST_MESSAGE(msg);
+  tk_snprintf(msg, sizeof(msg), "stb:   glyphs %.0fus, first paint %.0fus, heap %+lld bytes",
+              stb.glyph_us, stb.paint_us, (long long)stb.heap);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(atlas.glyph_us < stb.glyph_us);
+  TEST_ASSERT_TRUE(atlas.paint_us < stb.paint_us);
+  TEST_ASSERT_TRUE(atlas.heap <= stb.heap);
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(160, 80);
+  s_ttf = assets_manager_ref(assets_manager(), ASSET_TYPE_FONT, "default");
+  RUN_TEST(test_atlas_preferred);
+  RUN_TEST(test_atlas_fallback);
+  RUN_TEST(test_first_paint);
+  assets_manager_unref(assets_manager(), s_ttf);
+  tk_exit();
+  return UNITY_END();
+}
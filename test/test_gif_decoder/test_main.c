@@ -0,0 +1,198 @@
+/**
+ * user-021: 逐帧解码的 GIF。
+ *
+ * 64x64、30 帧的 GIF，第一帧整张，之后每帧只更新一个 16x16 的方块。检查每帧返回的变化区域，
+ * 并给出每次 gif_decoder_next 的时间。解码用的 LZW 表在创建解码器时分配一次，每帧不再分配。
+ */
+#include <unity.h>
+#include "awtk.h"
+#include "image_loader/gif_decoder.h"
+#include "native_app.h"
+
+#define GIF_W 64
+#define GIF_H 64
+#define GIF_FRAMES 30
+#define BLOCK_SIZE 16
+#define BENCH_LOOPS 20
+#define BENCH_ROUNDS 5
+
+/*最小编码长度为7时编码为8位：每个字节一个编码，不需要按位打包*/
+#define LZW_MIN_CODE_SIZE 7
+#define LZW_CLEAR 0x80
+#define LZW_EOI 0x81
+/*在编码长度变成9位之前清空编码表*/
+#define LZW_CLEAR_INTERVAL 100
+
+static wbuffer_t s_gif;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static rect_t block_rect(uint32_t frame)
+{
+  uint32_t i = frame - 1;
+
+  return rect_init((i % 4) * BLOCK_SIZE, ((i / 4) % 4) * BLOCK_SIZE, BLOCK_SIZE, BLOCK_SIZE);
+}
+
+static void write_frame(wbuffer_t *wb, uint32_t frame, const rect_t *r)
+{
+  uint32_t i = 0;
+  uint32_t n = 0;
+  uint32_t nr = r->w * r->h;
+  uint8_t block[256];
+
+  /*Graphic Control Extension：延时 50 毫秒，不透明*/
+  wbuffer_write_uint8(wb, 0x21);
+  wbuffer_write_uint8(wb, 0xf9);
+  wbuffer_write_uint8(wb, 4);
+  wbuffer_write_uint8(wb, 0);
+  wbuffer_write_uint16(wb, 5);
+  wbuffer_write_uint8(wb, 0);
+  wbuffer_write_uint8(wb, 0);
+
+  /*图像描述符*/
+  wbuffer_write_uint8(wb, 0x2c);
+  wbuffer_write_uint16(wb, r->x);
+  wbuffer_write_uint16(wb, r->y);
+  wbuffer_write_uint16(wb, r->w);
+  wbuffer_write_uint16(wb, r->h);
+  wbuffer_write_uint8(wb, 0);
+
+  wbuffer_write_uint8(wb, LZW_MIN_CODE_SIZE);
+  for (i = 0; i <= nr; i++)
+  {
+    uint8_t code = LZW_EOI;
+
+    if (i < nr)
+    {
+      if (i % LZW_CLEAR_INTERVAL == 0)
+      {
+        block[n++] = LZW_CLEAR;
+      }
+      code = (uint8_t)((i % r->w + i / r->w + frame * 7) % LZW_CLEAR);
+    }
+    block[n++] = code;
+
+    if (n >= 254 || i == nr)
+    {
+      wbuffer_write_uint8(wb, n);
+      wbuffer_write_binary(wb, block, n);
+      n = 0;
+    }
+  }
+  wbuffer_write_uint8(wb, 0);
+}
+
+static void build_gif(wbuffer_t *wb)
+{
+  uint32_t i = 0;
+  rect_t full = rect_init(0, 0, GIF_W, GIF_H);
+
+  wbuffer_init_extendable(wb);
+  wbuffer_write_binary(wb, "GIF89a", 6);
+  wbuffer_write_uint16(wb, GIF_W);
+  wbuffer_write_uint16(wb, GIF_H);
+  /*128 色的全局调色板*/
+  wbuffer_write_uint8(wb, 0x80 | 0x70 | (LZW_MIN_CODE_SIZE - 1));
+  wbuffer_write_uint8(wb, 0);
+  wbuffer_write_uint8(wb, 0);
+  for (i = 0; i < LZW_CLEAR; i++)
+  {
+    wbuffer_write_uint8(wb, i * 2);
+    wbuffer_write_uint8(wb, 255 - i);
+    wbuffer_write_uint8(wb, (i * 37) & 0xff);
+  }
+
+  write_frame(wb, 0, &full);
+  for (i = 1; i < GIF_FRAMES; i++)
+  {
+    rect_t r = block_rect(i);
+    write_frame(wb, i, &r);
+  }
+  wbuffer_write_uint8(wb, 0x3b);
+}
+
+static void test_frames(void)
+{
+  uint32_t i = 0;
+  rect_t dirty;
+  gif_decoder_t *gif = gif_decoder_create(s_gif.data, s_gif.cursor);
+
+  TEST_ASSERT_NOT_NULL(gif);
+  TEST_ASSERT_EQUAL_UINT32(GIF_FRAMES, gif->frames_nr);
+  TEST_ASSERT_EQUAL_UINT32(0, gif->frame);
+
+  /*之后每帧只有一个方块变化*/
+  for (i = 1; i < GIF_FRAMES; i++)
+  {
+    rect_t r = block_rect(i);
+
+    TEST_ASSERT_EQUAL_INT(RET_OK, gif_decoder_next(gif, &dirty));
+    TEST_ASSERT_EQUAL_UINT32(i, gif->frame);
+    TEST_ASSERT_EQUAL_UINT32(50, gif->delay);
+    TEST_ASSERT_EQUAL_INT(r.x, dirty.x);
+    TEST_ASSERT_EQUAL_INT(r.y, dirty.y);
+    TEST_ASSERT_EQUAL_INT(r.w, dirty.w);
+    TEST_ASSERT_EQUAL_INT(r.h, dirty.h);
+  }
+
+  /*最后一帧之后回到第一帧，整张都变化*/
+  TEST_ASSERT_EQUAL_INT(RET_OK, gif_decoder_next(gif, &dirty));
+  TEST_ASSERT_EQUAL_UINT32(0, gif->frame);
+  TEST_ASSERT_EQUAL_INT(GIF_W, dirty.w);
+  TEST_ASSERT_EQUAL_INT(GIF_H, dirty.h);
+
+  /*往回跳从第一帧重新解码*/
+  TEST_ASSERT_EQUAL_INT(RET_OK, gif_decoder_seek(gif, 20, NULL));
+  TEST_ASSERT_EQUAL_INT(RET_OK, gif_decoder_seek(gif, 3, NULL));
+  TEST_ASSERT_EQUAL_UINT32(3, gif->frame);
+
+  gif_decoder_destroy(gif);
+}
+
+static void test_bench(void)
+{
+  uint32_t i = 0;
+  uint32_t r = 0;
+  char msg[128];
+  uint64_t best = 0xffffffff;
+  uint64_t heap = native_app_heap_used();
+  gif_decoder_t *gif = gif_decoder_create(s_gif.data, s_gif.cursor);
+
+  TEST_ASSERT_NOT_NULL(gif);
+  heap = native_app_heap_used() - heap;
+
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    uint64_t start = time_now_us();
+    for (i = 0; i < BENCH_LOOPS * GIF_FRAMES; i++)
+    {
+      gif_decoder_next(gif, NULL);
+    }
+    best = tk_min(best, time_now_us() - start);
+  }
+
+  tk_snprintf(msg, sizeof(msg), "%ux%u %u frames: %.2fus/frame, decoder heap %u bytes", GIF_W,
+              GIF_H, GIF_FRAMES, (double)best / (BENCH_LOOPS * GIF_FRAMES), (uint32_t)heap);
+  TEST_MESSAGE(msg);
+
+  gif_decoder_destroy(gif);
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(320, 240);
+  build_gif(&s_gif);
+  RUN_TEST(test_frames);
+  RUN_TEST(test_bench);
+  wbuffer_deinit(&s_gif);
+  tk_exit();
+  return UNITY_END();
+}
@@ -0,0 +1,220 @@
+/**
+ * user-005: glyph_cache 查找的开销。
+ *
+ * 缓存 64/256/1024 个字形，比较哈希查找和原来逐项比较(每次命中还要取一次时间)的查找，
+ * 并给出一个文字较多的页面每帧的绘制时间。
+ *
+ * user-019: 只有高度不小于 GLYPH_CACHE_SPAN_MIN_H 的字模生成 spans。
+ */
+#include <unity.h>
+#include "tkc/mem.h"
+#include "base/glyph_cache.h"
+#include "native_app.h"
+
+#define LOOKUPS 200000
+
+typedef struct _linear_item_t
+{
+  font_size_t size;
+  wchar_t code;
+  glyph_t *g;
+  uint32_t last_access_time;
+} linear_item_t;
+
+/*原来的实现：逐项比较 code 和 size，命中时记录访问时间*/
+static ret_t linear_lookup(linear_item_t *items, uint32_t nr, wchar_t code, font_size_t size,
+                           glyph_t *g)
+{
+  uint32_t i = 0;
+
+  for (i = 0; i < nr; i++)
+  {
+    linear_item_t *item = items + i;
+    if (item->code == code && item->size == size)
+    {
+      *g = *(item->g);
+      item->last_access_time = time_now_ms();
+
+      return RET_OK;
+    }
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static uint32_t s_seed = 1;
+
+static uint32_t next_rand(void)
+{
+  s_seed = s_seed * 1103515245 + 12345;
+  return (s_seed >> 16) & 0x7fff;
+}
+
+static wchar_t code_of(uint32_t i)
+{
+  /*常用汉字区间里分散取字*/
+  return (wchar_t)(0x4e00 + i * 7);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void bench_lookup(uint32_t nr)
+{
+  char msg[128];
+  uint32_t i = 0;
+  glyph_t g;
+  uint32_t hits = 0;
+  uint64_t start = 0;
+  double hash_ns = 0;
+  double linear_ns = 0;
+  glyph_cache_t cache;
+  wchar_t *codes = TKMEM_ZALLOCN(wchar_t, LOOKUPS);
+  linear_item_t *items = TKMEM_ZALLOCN(linear_item_t, nr);
+
+  glyph_cache_init(&cache, nr, (tk_destroy_t)glyph_destroy);
+  for (i = 0; i < nr; i++)
+  {
+    glyph_t *item = glyph_create();
+    item->w = 16;
+    item->h = 16;
+    TEST_ASSERT_EQUAL_INT(RET_OK, glyph_cache_add(&cache, code_of(i), 16, item));
+    items[i].code = code_of(i);
+    items[i].size = 16;
+    items[i].g = item;
+  }
+
+  /*十分之一查不到，和页面上偶尔出现新字差不多*/
+  for (i = 0; i < LOOKUPS; i++)
+  {
+    uint32_t r = next_rand();
+    codes[i] = (r % 10 == 0) ? code_of(nr + r % 64) : code_of(r % nr);
+  }
+
+  start = time_now_us();
+  for (i = 0; i < LOOKUPS; i++)
+  {
+    hits += glyph_cache_lookup(&cache, codes[i], 16, &g) == RET_OK;
+  }
+  hash_ns = (time_now_us() - start) * 1000.0 / LOOKUPS;
+
+  start = time_now_us();
+  for (i = 0; i < LOOKUPS; i++)
+  {
+    hits -= linear_lookup(items, nr, codes[i], 16, &g) == RET_OK;
+  }
+  linear_ns = (time_now_us() - start) * 1000.0 / LOOKUPS;
+
+  /*两种查找结果一致*/
+  TEST_ASSERT_EQUAL_UINT32(0, hits);
+  tk_snprintf(msg, sizeof(msg), "%4u glyphs: hash=%.1fns linear=%.1fns (%.1fx)", nr, hash_ns,
+              linear_ns, linear_ns / hash_ns);
+  TEST_MESSAGE(msg);
+  if (nr >= 256)
+  {
+    TEST_ASSERT_TRUE(hash_ns < linear_ns);
+  }
+
+  glyph_cache_deinit(&cache);
+  TKMEM_FREE(items);
+  TKMEM_FREE(codes);
+}
+
+static void test_lookup_64(void)
+{
+  bench_lookup(64);
+}
+
+static void test_lookup_256(void)
+{
+  bench_lookup(256);
+}
+
+static void test_lookup_1024(void)
+{
+  bench_lookup(1024);
+}
+
+/*每行左右两边透明，中间不透明，段很长*/
+static glyph_t *create_bar_glyph(uint32_t h)
+{
+  uint32_t i = 0;
+  uint32_t w = 32;
+  glyph_t *g = glyph_create();
+  uint8_t *data = TKMEM_ZALLOCN(uint8_t, w * h);
+
+  for (i = 0; i < w * h; i++)
+  {
+    uint32_t x = i % w;
+    data[i] = (x >= 8 && x < 24) ? 0xff : 0;
+  }
+  g->w = w;
+  g->h = h;
+  g->format = GLYPH_FMT_ALPHA;
+  g->data = data;
+
+  return g;
+}
+
+static void destroy_bar_glyph(glyph_t *g)
+{
+  TKMEM_FREE(g->data);
+  glyph_destroy(g);
+}
+
+static void test_spans_by_height(void)
+{
+  glyph_t g;
+  glyph_cache_t cache;
+
+  glyph_cache_init(&cache, 8, (tk_destroy_t)destroy_bar_glyph);
+  glyph_cache_add(&cache, 'a', 16, create_bar_glyph(12));
+  glyph_cache_add(&cache, 'b', 24, create_bar_glyph(18));
+  glyph_cache_add(&cache, 'c', 32, create_bar_glyph(24));
+
+  /*16/24px 的字逐像素绘制更快，不生成 spans*/
+  TEST_ASSERT_EQUAL_INT(RET_OK, glyph_cache_lookup(&cache, 'a', 16, &g));
+  TEST_ASSERT_NULL(g.spans);
+  TEST_ASSERT_EQUAL_INT(RET_OK, glyph_cache_lookup(&cache, 'b', 24, &g));
+  TEST_ASSERT_NULL(g.spans);
+  TEST_ASSERT_EQUAL_INT(RET_OK, glyph_cache_lookup(&cache, 'c', 32, &g));
+  TEST_ASSERT_NOT_NULL(g.spans);
+
+  glyph_cache_deinit(&cache);
+}
+
+static void test_text_frame_time(void)
+{
+  char msg[64];
+  uint32_t i = 0;
+  double us = 0;
+  widget_t *win = window_create(NULL, 0, 0, 0, 0);
+
+  for (i = 0; i < 4; i++)
+  {
+    widget_t *label = label_create(win, 2, i * 20, win->w - 4, 20);
+    widget_set_text_utf8(label, "The quick brown fox jumps 0123456789");
+  }
+  us = native_app_paint_frames(50);
+  tk_snprintf(msg, sizeof(msg), "text page 160x80: %.0fus/frame", us);
+  TEST_MESSAGE(msg);
+  window_close_force(win);
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(160, 80);
+  RUN_TEST(test_lookup_64);
+  RUN_TEST(test_lookup_256);
+  RUN_TEST(test_lookup_1024);
+  RUN_TEST(test_spans_by_height);
+  RUN_TEST(test_text_frame_time);
+  tk_exit();
+  return UNITY_END();
+}
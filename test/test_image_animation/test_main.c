@@ -0,0 +1,184 @@
+/**
+ * user-022: image_animation 在空闲时预取后面的帧。
+ *
+ * 30 帧的序列，interval 为 33 毫秒，绘制后卸载(unload_after_paint)。解码由 image_manager 的
+ * fallback_get_bitmap 模拟：每帧 12 毫秒，每 5 帧有一帧更慢。分别在不预取和预取 4 帧时按真实时间
+ * 播放，统计实际的帧率、帧间隔的抖动(标准差)、最大间隔和丢帧数。
+ */
+#include <math.h>
+#include <unity.h>
+#include "awtk.h"
+#include "ext_widgets/image_animation/image_animation.h"
+#include "native_app.h"
+
+#define FRAMES_NR 30
+#define LOOPS 3
+#define INTERVAL 33
+#define FRAME_SIZE 64
+#define DECODE_MS 12
+#define PREFETCH_FRAMES 4
+
+static uint32_t s_slow_decode_ms = 0;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*模拟解码：按帧号忙等一段时间，再生成一张不透明的图片*/
+static ret_t decode_frame(image_manager_t *imm, const char *name, bitmap_t *image)
+{
+  uint32_t i = 0;
+  uint32_t index = 0;
+  uint16_t *data = NULL;
+  uint64_t end = 0;
+
+  if (strncmp(name, "anim", 4) != 0)
+  {
+    return RET_NOT_FOUND;
+  }
+
+  index = tk_atoi(name + 4);
+  end = time_now_us() + ((index % 5 == 4) ? s_slow_decode_ms : DECODE_MS) * 1000;
+  while (time_now_us() < end)
+  {
+  }
+
+  return_value_if_fail(bitmap_init(image, FRAME_SIZE, FRAME_SIZE, BITMAP_FMT_BGR565, NULL) == RET_OK,
+                       RET_OOM);
+  data = (uint16_t *)bitmap_lock_buffer_for_write(image);
+  for (i = 0; i < FRAME_SIZE * FRAME_SIZE; i++)
+  {
+    data[i] = (uint16_t)(index * 2111 + i);
+  }
+  bitmap_unlock_buffer(image);
+  image->flags |= BITMAP_FLAG_OPAQUE;
+
+  return image_manager_add(imm, name, image);
+}
+
+typedef struct _play_result_t
+{
+  double fps;
+  double jitter;
+  double max_interval;
+  image_animation_stats_t stats;
+} play_result_t;
+
+static void play(uint32_t prefetch_mem_size, play_result_t *result)
+{
+  uint32_t n = 0;
+  uint32_t frames = 0;
+  uint64_t first = 0;
+  uint64_t last = 0;
+  double sum = 0;
+  double sum2 = 0;
+  widget_t *wm = window_manager();
+  widget_t *win = window_create(NULL, 0, 0, 0, 0);
+  widget_t *anim = image_animation_create(win, 10, 10, FRAME_SIZE, FRAME_SIZE);
+
+  image_manager_unload_all(image_manager());
+  image_animation_set_image(anim, "anim");
+  image_animation_set_range_sequence(anim, 0, FRAMES_NR - 1);
+  image_animation_set_interval(anim, INTERVAL);
+  image_animation_set_loop(anim, TRUE);
+  image_animation_set_unload_after_paint(anim, TRUE);
+  image_animation_set_prefetch_mem_size(anim, prefetch_mem_size);
+  image_animation_play(anim);
+
+  /*和主循环一样：定时器、空闲回调，然后绘制。记录每一帧第一次绘制的时间*/
+  while (frames < FRAMES_NR * LOOPS)
+  {
+    image_animation_stats_t stats;
+
+    native_app_pump();
+    window_manager_paint(wm);
+    image_animation_get_stats(anim, &stats);
+    if (stats.frames != frames)
+    {
+      uint64_t now = time_now_us();
+
+      if (first == 0)
+      {
+        first = now;
+      }
+      else
+      {
+        double interval = (now - last) / 1000.0;
+        sum += interval;
+        sum2 += interval * interval;
+        result->max_interval = tk_max(result->max_interval, interval);
+        n++;
+      }
+      last = now;
+      frames = stats.frames;
+    }
+  }
+
+  image_animation_get_stats(anim, &(result->stats));
+  result->fps = n * 1000000.0 / (last - first);
+  result->jitter = sqrt(sum2 / n - (sum / n) * (sum / n));
+
+  widget_destroy(win);
+  native_app_pump();
+}
+
+static void report(const char *name, const play_result_t *r)
+{
+  char msg[160];
+
+  tk_snprintf(msg, sizeof(msg),
+              "%-16s %5.1f fps  jitter %5.1fms  max %5.1fms  dropped %2u/%u  prefetched %2u/%u",
+              name, r->fps, r->jitter, r->max_interval, r->stats.dropped, r->stats.frames,
+              r->stats.prefetched, r->stats.frames);
+  TEST_MESSAGE(msg);
+}
+
+static void bench(uint32_t slow_decode_ms)
+{
+  char name[32];
+  play_result_t off;
+  play_result_t on;
+
+  memset(&off, 0x00, sizeof(off));
+  memset(&on, 0x00, sizeof(on));
+  s_slow_decode_ms = slow_decode_ms;
+  play(0, &off);
+  play(PREFETCH_FRAMES * FRAME_SIZE * FRAME_SIZE * 2, &on);
+
+  tk_snprintf(name, sizeof(name), "slow %ums, off", slow_decode_ms);
+  report(name, &off);
+  tk_snprintf(name, sizeof(name), "slow %ums, on", slow_decode_ms);
+  report(name, &on);
+
+  /*预取后绘制时不再解码，第一圈之后的帧都来自预取*/
+  TEST_ASSERT_EQUAL_UINT32(0, off.stats.prefetched);
+  TEST_ASSERT_GREATER_THAN(FRAMES_NR * (LOOPS - 1), on.stats.prefetched);
+}
+
+/*慢的一帧加上其它开销仍在一个 interval 之内*/
+static void test_slow_frame_within_interval(void)
+{
+  bench(28);
+}
+
+/*慢的一帧超过了空闲的时间，单线程下仍然会推迟下一帧*/
+static void test_slow_frame_over_interval(void)
+{
+  bench(45);
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(320, 240);
+  image_manager_set_fallback_get_bitmap(image_manager(), decode_frame, NULL);
+  RUN_TEST(test_slow_frame_within_interval);
+  RUN_TEST(test_slow_frame_over_interval);
+  image_manager_set_fallback_get_bitmap(image_manager(), NULL, NULL);
+  tk_exit();
+  return UNITY_END();
+}
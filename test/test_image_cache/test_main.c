@@ -0,0 +1,255 @@
+/**
+ * user-014: 图片缓存(按名称/buffer 哈希，按字节数限制的 LRU)。
+ *
+ * 200 个图标的网格页面，图标为 RLE 或未压缩(raw)的资源。RLE 图片按压缩数据的大小计入缓存，
+ * 缓存上限小于全部图标解压后的大小时也能全部放下，绘制时不再反复淘汰和重新加载。
+ */
+#include <unity.h>
+#include "awtk.h"
+#include "base/bitmap_rle.h"
+#include "native_app.h"
+
+#define ICONS_NR 200
+#define ICON_SIZE 16
+#define ICON_BPP 2
+#define GRID_COLS 20
+#define BENCH_FRAMES 50
+#define BENCH_ROUNDS 5
+#define HEADER_SIZE (sizeof(bitmap_header_t) - sizeof(((bitmap_header_t *)NULL)->data))
+
+/*缓存上限：能放下全部 RLE 图标，放不下全部解压后的图标(200 * 512 字节)*/
+#define CACHE_MAX_MEM_SIZE (64 * 1024)
+
+static asset_info_t *s_assets[ICONS_NR * 2];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*每个图标颜色和半径不同：底色上画一个圆*/
+static void icon_row(uint32_t index, uint32_t y, uint16_t *row)
+{
+  uint32_t x = 0;
+  int32_t r = 4 + index % 4;
+  int32_t dy = (int32_t)y - ICON_SIZE / 2;
+  uint16_t bg = (uint16_t)(0x1082 * (index % 7));
+  uint16_t fg = (uint16_t)(0xf800 - index * 97);
+
+  for (x = 0; x < ICON_SIZE; x++)
+  {
+    int32_t dx = (int32_t)x - ICON_SIZE / 2;
+    row[x] = (dx * dx + dy * dy <= r * r) ? fg : bg;
+  }
+}
+
+/*和 tools/image_gen 相同的编码：0x80|(n-1) 后面跟一个像素，否则 (n-1) 后面跟 n 个像素*/
+static uint32_t rle_encode_row(const uint16_t *row, uint8_t *out)
+{
+  uint32_t i = 0;
+  uint32_t size = 0;
+
+  while (i < ICON_SIZE)
+  {
+    uint32_t n = 1;
+    while (i + n < ICON_SIZE && row[i + n] == row[i])
+    {
+      n++;
+    }
+
+    if (n >= 3)
+    {
+      out[size++] = 0x80 | (n - 1);
+      memcpy(out + size, row + i, ICON_BPP);
+      size += ICON_BPP;
+    }
+    else
+    {
+      out[size++] = n - 1;
+      memcpy(out + size, row + i, n * ICON_BPP);
+      size += n * ICON_BPP;
+    }
+    i += n;
+  }
+
+  return size;
+}
+
+static asset_info_t *create_icon(const char *name, uint32_t index, bool_t rle)
+{
+  uint32_t y = 0;
+  uint32_t size = 0;
+  uint16_t row[ICON_SIZE];
+  uint8_t rows[ICON_SIZE * (ICON_SIZE * ICON_BPP + ICON_SIZE)];
+  uint32_t offsets[ICON_SIZE + 1];
+  bitmap_header_t header;
+  asset_info_t *info = NULL;
+
+  for (y = 0; y < ICON_SIZE; y++)
+  {
+    icon_row(index, y, row);
+    offsets[y] = size;
+    if (rle)
+    {
+      size += rle_encode_row(row, rows + size);
+    }
+    else
+    {
+      memcpy(rows + size, row, sizeof(row));
+      size += sizeof(row);
+    }
+  }
+  offsets[ICON_SIZE] = size;
+
+  memset(&header, 0x00, sizeof(header));
+  header.w = ICON_SIZE;
+  header.h = ICON_SIZE;
+  header.flags = BITMAP_FLAG_IMMUTABLE | BITMAP_FLAG_OPAQUE;
+  header.format = BITMAP_FMT_BGR565;
+
+  if (rle)
+  {
+    info = asset_info_create(ASSET_TYPE_IMAGE, ASSET_TYPE_IMAGE_RLE, name,
+                             HEADER_SIZE + sizeof(offsets) + size);
+    memcpy(info->data, &header, HEADER_SIZE);
+    memcpy(info->data + HEADER_SIZE, offsets, sizeof(offsets));
+    memcpy(info->data + HEADER_SIZE + sizeof(offsets), rows, size);
+  }
+  else
+  {
+    info = asset_info_create(ASSET_TYPE_IMAGE, ASSET_TYPE_IMAGE_RAW, name, HEADER_SIZE + size);
+    memcpy(info->data, &header, HEADER_SIZE);
+    memcpy(info->data + HEADER_SIZE, rows, size);
+  }
+  assets_manager_add(assets_manager(), info);
+
+  return info;
+}
+
+static void add_icons(void)
+{
+  uint32_t i = 0;
+  char name[TK_NAME_LEN + 1];
+
+  for (i = 0; i < ICONS_NR; i++)
+  {
+    tk_snprintf(name, sizeof(name), "rle_icon%u", i);
+    s_assets[i] = create_icon(name, i, TRUE);
+    tk_snprintf(name, sizeof(name), "raw_icon%u", i);
+    s_assets[ICONS_NR + i] = create_icon(name, i, FALSE);
+  }
+}
+
+static void remove_icons(void)
+{
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(s_assets); i++)
+  {
+    assets_manager_clear_cache_ex(assets_manager(), ASSET_TYPE_IMAGE, s_assets[i]->name);
+    asset_info_unref(s_assets[i]);
+  }
+}
+
+static widget_t *open_grid(const char *prefix)
+{
+  uint32_t i = 0;
+  char name[TK_NAME_LEN + 1];
+  widget_t *win = window_create(NULL, 0, 0, 0, 0);
+
+  for (i = 0; i < ICONS_NR; i++)
+  {
+    widget_t *icon = image_create(win, (i % GRID_COLS) * 16, (i / GRID_COLS) * 24, 16, 24);
+    tk_snprintf(name, sizeof(name), "%s%u", prefix, i);
+    image_set_image(icon, name);
+  }
+
+  return win;
+}
+
+/*打开网格页面，绘制 BENCH_FRAMES 帧，取几轮中最快的一轮，返回每帧的时间(微秒)*/
+static double bench_grid(const char *prefix, image_manager_stats_t *stats)
+{
+  uint32_t r = 0;
+  double best = 1e9;
+  widget_t *win = NULL;
+
+  image_manager_unload_all(image_manager());
+  image_manager_reset_stats(image_manager());
+  win = open_grid(prefix);
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    best = tk_min(best, native_app_paint_frames(BENCH_FRAMES));
+  }
+  image_manager_get_stats(image_manager(), stats);
+  widget_destroy(win);
+  native_app_pump();
+
+  return best;
+}
+
+static void report(const char *name, double us, const image_manager_stats_t *stats)
+{
+  char msg[160];
+
+  tk_snprintf(msg, sizeof(msg),
+              "%s: %8.1fus/frame  cached %3u images %6u bytes  hits %6u misses %6u evictions %6u",
+              name, us, stats->nr, stats->mem_size, stats->hits, stats->misses, stats->evictions);
+  TEST_MESSAGE(msg);
+}
+
+static void test_rle_mem_size(void)
+{
+  bitmap_t image;
+  image_manager_stats_t stats;
+  const asset_info_t *info = s_assets[0];
+
+  image_manager_unload_all(image_manager());
+  TEST_ASSERT_EQUAL_INT(RET_OK, image_manager_get_bitmap(image_manager(), info->name, &image));
+  TEST_ASSERT_TRUE(bitmap_is_rle(&image));
+
+  /*行索引加行数据，不含 bitmap_header_t*/
+  TEST_ASSERT_EQUAL_UINT32(info->size - HEADER_SIZE, bitmap_rle_get_mem_size(&image));
+  image_manager_get_stats(image_manager(), &stats);
+  TEST_ASSERT_EQUAL_UINT32(info->size - HEADER_SIZE, stats.mem_size);
+
+  image_manager_unload_all(image_manager());
+  image_manager_get_stats(image_manager(), &stats);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.mem_size);
+}
+
+static void test_bench(void)
+{
+  double us = 0;
+  image_manager_stats_t stats;
+
+  image_manager_set_max_mem_size_of_cached_images(image_manager(), CACHE_MAX_MEM_SIZE);
+
+  us = bench_grid("rle_icon", &stats);
+  report("rle", us, &stats);
+  /*全部 RLE 图标都在缓存中，首帧之后不再加载*/
+  TEST_ASSERT_EQUAL_UINT32(ICONS_NR, stats.nr);
+  TEST_ASSERT_EQUAL_UINT32(ICONS_NR, stats.misses);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.evictions);
+
+  us = bench_grid("raw_icon", &stats);
+  report("raw", us, &stats);
+
+  image_manager_set_max_mem_size_of_cached_images(image_manager(), 0);
+  image_manager_unload_all(image_manager());
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(320, 240);
+  add_icons();
+  RUN_TEST(test_rle_mem_size);
+  RUN_TEST(test_bench);
+  remove_icons();
+  tk_exit();
+  return UNITY_END();
+}
@@ -0,0 +1,112 @@
+/**
+ * user-002: 片段双缓冲异步推送。
+ *
+ * 模拟一条慢总线(DMA)，比较推送与绘制重叠(async)和不重叠(每次推送等完成)时的帧时间，
+ * 并检查绘制下一个片段时没有改写仍在传输中的缓冲区。
+ * pio test -e native_async -f test_lcd_async
+ */
+#include <unity.h>
+#include "tkc/mem.h"
+#include "native_app.h"
+#include "mock_bus.h"
+
+/*比设备的 160x80 大，一帧分成多个片段，片段之间才会重叠*/
+#define LCD_W 320
+#define LCD_H 240
+#define FRAMES 20
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static double paint_on_bus(bool_t async, uint32_t bytes_per_sec, uint32_t transaction_us)
+{
+  double us = 0;
+
+  native_app_pump();
+  window_manager_paint(window_manager());
+  mock_bus_wait();
+  mock_bus_set_async(async);
+  mock_bus_set_speed(bytes_per_sec, transaction_us);
+  mock_bus_reset_stats();
+  us = native_app_paint_frames(FRAMES);
+  mock_bus_wait();
+  mock_bus_set_speed(0, 0);
+
+  return us;
+}
+
+static void test_async_strips(void)
+{
+  const mock_bus_stats_t *stats = mock_bus_get_stats();
+  uint32_t pixels = LCD_W * LCD_H;
+  uint32_t strips = (pixels + FRAGMENT_FRAME_BUFFER_STRIP_SIZE - 1) / FRAGMENT_FRAME_BUFFER_STRIP_SIZE;
+
+  TEST_ASSERT_GREATER_THAN_UINT32(1, FRAGMENT_FRAME_BUFFER_NR);
+  paint_on_bus(TRUE, 0, 0);
+  TEST_ASSERT_EQUAL_UINT32(strips * FRAMES, stats->transactions);
+  TEST_ASSERT_EQUAL_UINT64((uint64_t)pixels * 2 * FRAMES, stats->bytes);
+}
+
+static void test_async_same_screen(void)
+{
+  uint32_t size = LCD_W * LCD_H * sizeof(uint16_t);
+  uint16_t *sync_screen = TKMEM_ALLOC(size);
+
+  /*async 时 DMA 在完成时才读缓冲区，缓冲区提前被复用的话屏幕内容会不同*/
+  paint_on_bus(FALSE, 0, 0);
+  memcpy(sync_screen, mock_bus_get_screen(), size);
+  memset(mock_bus_get_screen(), 0x00, size);
+  paint_on_bus(TRUE, 0, 0);
+  TEST_ASSERT_EQUAL_MEMORY(sync_screen, mock_bus_get_screen(), size);
+
+  TKMEM_FREE(sync_screen);
+}
+
+static void report_overlap(const char *name, uint32_t bytes_per_sec)
+{
+  char msg[160];
+  const mock_bus_stats_t *stats = mock_bus_get_stats();
+  double sync_us = paint_on_bus(FALSE, bytes_per_sec, 1);
+  double sync_wait = (double)stats->wait_us / FRAMES;
+  double async_us = paint_on_bus(TRUE, bytes_per_sec, 1);
+  double async_wait = (double)stats->wait_us / FRAMES;
+  double bus_us = (double)stats->busy_us / FRAMES;
+
+  tk_snprintf(msg, sizeof(msg),
+              "%s: bus=%.0fus sync=%.0fus(wait %.0fus) async=%.0fus(wait %.0fus) saved=%.0f%%",
+              name, bus_us, sync_us, sync_wait, async_us, async_wait,
+              100.0 * (sync_us - async_us) / sync_us);
+  TEST_MESSAGE(msg);
+  /*重叠后 CPU 等总线的时间只会更少*/
+  TEST_ASSERT_TRUE(async_wait <= sync_wait);
+}
+
+static void test_async_overlap(void)
+{
+  double render_us = paint_on_bus(TRUE, 0, 0);
+  /*总线时间和绘制时间相当时重叠的收益最大*/
+  uint32_t matched = (uint32_t)(LCD_W * LCD_H * 2 * 1000000.0 / render_us);
+  char msg[64];
+
+  tk_snprintf(msg, sizeof(msg), "render only: %.0fus/frame", render_us);
+  TEST_MESSAGE(msg);
+  report_overlap("40MHz SPI", 5000000);
+  report_overlap("bus matched to render", matched);
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(LCD_W, LCD_H);
+  native_app_create_sample_window("Home");
+  RUN_TEST(test_async_strips);
+  RUN_TEST(test_async_same_screen);
+  RUN_TEST(test_async_overlap);
+  tk_exit();
+  return UNITY_END();
+}
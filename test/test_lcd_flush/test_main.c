@@ -0,0 +1,100 @@
+/**
+ * user-001: lcd_mem_fragment 片段整块推送 vs 逐像素推送。
+ *
+ * 按 40MHz SPI(5MB/s，每次事务约 1us)模拟总线，统计每帧的事务数、字节数和帧时间。
+ * pio test -e native -f test_lcd_flush 测整块路径，-e native_per_pixel 测逐像素路径。
+ */
+#include <unity.h>
+#include "native_app.h"
+#include "mock_bus.h"
+
+#define LCD_W 160
+#define LCD_H 80
+#define FRAMES 20
+
+static uint32_t s_strips = 0;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static double paint_on_bus(uint32_t bytes_per_sec, uint32_t transaction_us)
+{
+  double us = 0;
+
+  /*先把首帧画掉，paint_frames 的预热帧就不会再推送*/
+  native_app_pump();
+  window_manager_paint(window_manager());
+  mock_bus_set_speed(bytes_per_sec, transaction_us);
+  mock_bus_reset_stats();
+  us = native_app_paint_frames(FRAMES);
+  mock_bus_set_speed(0, 0);
+
+  return us;
+}
+
+static void test_flush_transactions(void)
+{
+  const mock_bus_stats_t *stats = mock_bus_get_stats();
+  uint32_t pixels = LCD_W * LCD_H;
+  uint32_t strips = (pixels + (FRAGMENT_FRAME_BUFFER_SIZE) - 1) / (FRAGMENT_FRAME_BUFFER_SIZE);
+
+  paint_on_bus(0, 0);
+  TEST_ASSERT_EQUAL_UINT64((uint64_t)pixels * 2 * FRAMES, stats->bytes);
+#ifdef NATIVE_LCD_PER_PIXEL
+  TEST_ASSERT_EQUAL_UINT32((pixels + strips) * FRAMES, stats->transactions);
+#else
+  TEST_ASSERT_EQUAL_UINT32(strips * FRAMES, stats->transactions);
+#endif /*NATIVE_LCD_PER_PIXEL*/
+  s_strips = strips;
+}
+
+static void test_flush_screen_content(void)
+{
+  uint32_t i = 0;
+  uint32_t drawn = 0;
+  const uint16_t *screen = mock_bus_get_screen();
+
+  /*背景之外画出了控件，而不是只有一片背景色或停在片段缓冲区里*/
+  for (i = 0; i < LCD_W * LCD_H; i++)
+  {
+    drawn += screen[i] != screen[0];
+  }
+  TEST_ASSERT_GREATER_THAN_UINT32(LCD_W * LCD_H / 10, drawn);
+}
+
+static void test_flush_frame_time(void)
+{
+  char msg[128];
+  const mock_bus_stats_t *stats = mock_bus_get_stats();
+  double cpu_us = paint_on_bus(0, 0);
+  double spi_us = paint_on_bus(5000000, 1);
+
+  tk_snprintf(msg, sizeof(msg),
+              "%s: strips=%u tx/frame=%u render=%.0fus frame@40MHz=%.0fus bus=%.0fus",
+#ifdef NATIVE_LCD_PER_PIXEL
+              "per-pixel",
+#else
+              "block",
+#endif /*NATIVE_LCD_PER_PIXEL*/
+              s_strips, stats->transactions / FRAMES, cpu_us, spi_us,
+              (double)stats->busy_us / FRAMES);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(spi_us >= cpu_us);
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(LCD_W, LCD_H);
+  native_app_create_sample_window("Home");
+  RUN_TEST(test_flush_transactions);
+  RUN_TEST(test_flush_screen_content);
+  RUN_TEST(test_flush_frame_time);
+  tk_exit();
+  return UNITY_END();
+}
@@ -0,0 +1,241 @@
+/**
+ * user-008: tickless 主循环。
+ *
+ * 空闲时每秒醒来几次、模拟按键(另一个线程投递)时每次输入醒来一次，
+ * 以及有脏矩形或窗口动画时不会睡过一个帧间隔。
+ */
+#include <pthread.h>
+#include <unity.h>
+#include "awtk.h"
+#include "main_loop/main_loop_simple.h"
+#include "native_app.h"
+
+#define TEST_MAX_FPS 60
+#define INPUT_HZ 20
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_cond = PTHREAD_COND_INITIALIZER;
+static bool_t s_signaled = FALSE;
+static bool_t s_input_running = FALSE;
+static uint32_t s_key_down_nr = 0;
+static uint64_t s_run_end = 0;
+
+static ret_t native_wait_event(main_loop_simple_t *loop, uint32_t timeout_ms)
+{
+  ret_t ret = RET_TIMEOUT;
+  struct timespec ts;
+  uint64_t now = time_now_ms();
+
+  /*没有定时器时会一直睡到被唤醒，测试只等到本轮结束*/
+  if (now + timeout_ms > s_run_end)
+  {
+    timeout_ms = s_run_end > now ? (uint32_t)(s_run_end - now) : 0;
+  }
+
+  clock_gettime(CLOCK_REALTIME, &ts);
+  ts.tv_sec += timeout_ms / 1000;
+  ts.tv_nsec += (timeout_ms % 1000) * 1000000L;
+  if (ts.tv_nsec >= 1000000000L)
+  {
+    ts.tv_sec++;
+    ts.tv_nsec -= 1000000000L;
+  }
+
+  pthread_mutex_lock(&s_lock);
+  while (!s_signaled && pthread_cond_timedwait(&s_cond, &s_lock, &ts) == 0)
+  {
+  }
+  if (s_signaled)
+  {
+    s_signaled = FALSE;
+    ret = RET_OK;
+  }
+  pthread_mutex_unlock(&s_lock);
+
+  return ret;
+}
+
+static ret_t native_wakeup(main_loop_t *l)
+{
+  pthread_mutex_lock(&s_lock);
+  s_signaled = TRUE;
+  pthread_cond_signal(&s_cond);
+  pthread_mutex_unlock(&s_lock);
+
+  return RET_OK;
+}
+
+static void *fake_input_thread(void *args)
+{
+  while (s_input_running)
+  {
+    usleep(1000000 / INPUT_HZ / 2);
+    main_loop_post_key_event(main_loop(), TRUE, TK_KEY_LEFT);
+    usleep(1000000 / INPUT_HZ / 2);
+    main_loop_post_key_event(main_loop(), FALSE, TK_KEY_LEFT);
+  }
+
+  return NULL;
+}
+
+static ret_t on_key_down(void *ctx, event_t *e)
+{
+  s_key_down_nr++;
+  return RET_OK;
+}
+
+/*运行主循环 ms 毫秒，返回循环的次数*/
+static uint32_t run_loop(uint32_t ms)
+{
+  uint32_t nr = 0;
+  main_loop_t *l = main_loop();
+
+  s_run_end = time_now_ms() + ms;
+  while (time_now_ms() < s_run_end)
+  {
+    main_loop_step(l);
+    main_loop_sleep(l);
+    nr++;
+  }
+
+  return nr;
+}
+
+static void set_tickless(bool_t tickless)
+{
+  main_loop_simple_t *loop = (main_loop_simple_t *)main_loop();
+
+  loop->wait_event = tickless ? native_wait_event : NULL;
+  loop->base.wakeup = tickless ? native_wakeup : NULL;
+  loop->wakeup_nr = 0;
+  loop->timeout_nr = 0;
+  loop->sleep_ms = 0;
+}
+
+static widget_t *s_win = NULL;
+
+void setUp(void)
+{
+  WINDOW_MANAGER(window_manager())->max_fps = TEST_MAX_FPS;
+  s_win = native_app_create_sample_window("MainLoop");
+  widget_on(s_win, EVT_KEY_DOWN, on_key_down, NULL);
+  run_loop(200);
+}
+
+void tearDown(void)
+{
+  set_tickless(FALSE);
+  window_manager_close_all(window_manager());
+  run_loop(100);
+}
+
+static void test_idle_wakeups(void)
+{
+  char msg[160];
+  uint32_t polling = 0;
+  uint32_t tickless = 0;
+  main_loop_simple_t *loop = (main_loop_simple_t *)main_loop();
+
+  set_tickless(FALSE);
+  polling = run_loop(1000);
+
+  set_tickless(TRUE);
+  tickless = run_loop(1000);
+
+  tk_snprintf(msg, sizeof(msg),
+              "idle: polling %u loops/s, tickless %u loops/s (wakeups %u, timeouts %u, slept %ums)",
+              polling, tickless, loop->wakeup_nr, loop->timeout_nr, (uint32_t)loop->sleep_ms);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_LESS_THAN_UINT32(polling / 4, tickless);
+  TEST_ASSERT_GREATER_THAN_UINT32(900, (uint32_t)loop->sleep_ms);
+}
+
+static void test_input_wakeups(void)
+{
+  char msg[160];
+  uint32_t loops = 0;
+  pthread_t tid;
+  main_loop_simple_t *loop = (main_loop_simple_t *)main_loop();
+
+  set_tickless(TRUE);
+  widget_set_focused(s_win, TRUE);
+  s_key_down_nr = 0;
+  s_input_running = TRUE;
+  pthread_create(&tid, NULL, fake_input_thread, NULL);
+  loops = run_loop(1000);
+  s_input_running = FALSE;
+  pthread_join(tid, NULL);
+  run_loop(100);
+
+  tk_snprintf(msg, sizeof(msg),
+              "%u Hz key input: %u loops/s, wakeups %u, timeouts %u, key down %u, slept %ums",
+              INPUT_HZ, loops, loop->wakeup_nr, loop->timeout_nr, s_key_down_nr,
+              (uint32_t)loop->sleep_ms);
+  TEST_MESSAGE(msg);
+  /*每次按下/松开都要把主循环叫醒，按键不会等到下一个定时器才处理*/
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(INPUT_HZ * 3 / 4, s_key_down_nr);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2 * s_key_down_nr - 2, loop->wakeup_nr);
+}
+
+static void test_dirty_rect_limits_sleep(void)
+{
+  main_loop_simple_t *loop = (main_loop_simple_t *)main_loop();
+
+  set_tickless(TRUE);
+  run_loop(100);
+  TEST_ASSERT_FALSE(window_manager_has_dirty_rect(window_manager()));
+
+  /*绘制之后才产生的脏矩形(如绘制时被跳过的帧)，不能一直睡到下一个定时器*/
+  widget_invalidate(widget_get_child(s_win, 0), NULL);
+  TEST_ASSERT_TRUE(window_manager_has_dirty_rect(window_manager()));
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(1000 / TEST_MAX_FPS, main_loop_simple_get_sleep_time(loop));
+
+  WINDOW_MANAGER(window_manager())->max_fps = 0;
+  TEST_ASSERT_EQUAL_UINT32(0, main_loop_simple_get_sleep_time(loop));
+}
+
+static void test_window_animation_limits_sleep(void)
+{
+  uint32_t frames = 0;
+  uint32_t max_sleep = 0;
+  widget_t *win = NULL;
+  main_loop_t *l = main_loop();
+  main_loop_simple_t *loop = (main_loop_simple_t *)l;
+
+  set_tickless(TRUE);
+  win = window_create(NULL, 0, 0, 0, 0);
+  widget_set_prop_str(win, WIDGET_PROP_ANIM_HINT, "htranslate(duration=300)");
+
+  s_run_end = time_now_ms() + 1000;
+  while (time_now_ms() < s_run_end)
+  {
+    main_loop_step(l);
+    if (window_manager_is_animating(window_manager()))
+    {
+      max_sleep = tk_max(max_sleep, main_loop_simple_get_sleep_time(loop));
+      frames++;
+    }
+    main_loop_sleep(l);
+  }
+
+  {
+    char msg[128];
+    tk_snprintf(msg, sizeof(msg), "window animation: %u frames in 300ms, max sleep %ums",
+                frames, max_sleep);
+    TEST_MESSAGE(msg);
+  }
+  TEST_ASSERT_GREATER_THAN_UINT32(5, frames);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(1000 / TEST_MAX_FPS, max_sleep);
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(320, 240);
+  RUN_TEST(test_idle_wakeups);
+  RUN_TEST(test_input_wakeups);
+  RUN_TEST(test_dirty_rect_limits_sleep);
+  RUN_TEST(test_window_animation_limits_sleep);
+  tk_exit();
+  return UNITY_END();
+}
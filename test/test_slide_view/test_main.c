@@ -0,0 +1,218 @@
+/**
+ * user-023: slide_view 滑动时把页面缓存到离线画布(cache_pages)。
+ *
+ * 240x320 的屏幕，slide_view 有 3 页，每页 40 个图标和 40 个标签。模拟手指拖动一页，
+ * 统计开始拖动的一帧(绘制离线画布)和之后每帧的时间(帧率)，以及离线画布占用的堆。
+ */
+#include <unity.h>
+#include "awtk.h"
+#include "ext_widgets/slide_view/slide_view.h"
+#include "native_app.h"
+
+#define LCD_W 240
+#define LCD_H 320
+#define PAGES_NR 3
+#define CELLS_NR 40
+#define CELL_COLS 4
+#define ICON_SIZE 24
+#define DRAG_STEP 8
+#define DRAG_FRAMES 25
+#define BENCH_ROUNDS 5
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*图标由 image_manager 的 fallback_get_bitmap 生成：底色上画一个圆*/
+static ret_t create_icon(image_manager_t *imm, const char *name, bitmap_t *image)
+{
+  int32_t x = 0;
+  int32_t y = 0;
+  uint32_t index = 0;
+  uint16_t *data = NULL;
+  int32_t r = ICON_SIZE / 2 - 2;
+
+  if (strncmp(name, "icon", 4) != 0)
+  {
+    return RET_NOT_FOUND;
+  }
+
+  index = tk_atoi(name + 4);
+  return_value_if_fail(bitmap_init(image, ICON_SIZE, ICON_SIZE, BITMAP_FMT_BGR565, NULL) == RET_OK,
+                       RET_OOM);
+  data = (uint16_t *)bitmap_lock_buffer_for_write(image);
+  for (y = 0; y < ICON_SIZE; y++)
+  {
+    for (x = 0; x < ICON_SIZE; x++)
+    {
+      int32_t dx = x - ICON_SIZE / 2;
+      int32_t dy = y - ICON_SIZE / 2;
+      data[y * ICON_SIZE + x] = (dx * dx + dy * dy <= r * r) ? (uint16_t)(0xf800 - index * 997)
+                                                             : (uint16_t)0x2104;
+    }
+  }
+  bitmap_unlock_buffer(image);
+  image->flags |= BITMAP_FLAG_OPAQUE;
+
+  return image_manager_add(imm, name, image);
+}
+
+static void create_page(widget_t *slide_view, uint32_t index)
+{
+  uint32_t i = 0;
+  char text[TK_NAME_LEN + 1];
+  widget_t *page = view_create(slide_view, 0, 0, LCD_W, LCD_H);
+  wh_t cw = LCD_W / CELL_COLS;
+  wh_t ch = LCD_H / (CELLS_NR / CELL_COLS);
+
+  /*页面背景不透明，离线画布使用 LCD 的格式*/
+  widget_set_style_color(page, "normal:bg_color", 0xff303030);
+  for (i = 0; i < CELLS_NR; i++)
+  {
+    xy_t x = (i % CELL_COLS) * cw;
+    xy_t y = (i / CELL_COLS) * ch;
+    widget_t *icon = image_create(page, x + 2, y + (ch - ICON_SIZE) / 2, ICON_SIZE, ICON_SIZE);
+    widget_t *label = label_create(page, x + ICON_SIZE + 4, y, cw - ICON_SIZE - 4, ch);
+
+    tk_snprintf(text, sizeof(text), "icon%u", index * CELLS_NR + i);
+    image_set_image(icon, text);
+    tk_snprintf(text, sizeof(text), "%u", index * CELLS_NR + i);
+    widget_set_text_utf8(label, text);
+  }
+}
+
+static void send_pointer(event_type_t type, xy_t x)
+{
+  pointer_event_t e;
+
+  pointer_event_init(&e, type, NULL, x, LCD_H / 2);
+  e.pressed = type != EVT_POINTER_UP;
+  window_manager_dispatch_input_event(window_manager(), (event_t *)&e);
+}
+
+typedef struct _swipe_result_t
+{
+  double start_us;
+  double drag_us;
+  uint32_t layers_heap;
+} swipe_result_t;
+
+/*拖动一页再松开：dir 为 1 时向左拖(下一页)，为 -1 时向右拖(上一页)*/
+static void swipe(widget_t *slide_view, int32_t dir, swipe_result_t *result)
+{
+  uint32_t i = 0;
+  uint64_t start = 0;
+  uint64_t heap = native_app_heap_used();
+  xy_t x = dir > 0 ? LCD_W - 20 : 20;
+  widget_t *wm = window_manager();
+
+  send_pointer(EVT_POINTER_DOWN, x);
+  window_manager_paint(wm);
+
+  /*移动超过 drag_threshold 后开始拖动，这一帧绘制离线画布，不计入拖动的帧时间*/
+  x -= dir * DRAG_STEP * 2;
+  start = time_now_us();
+  send_pointer(EVT_POINTER_MOVE, x);
+  window_manager_paint(wm);
+  result->start_us = (double)(time_now_us() - start);
+  result->layers_heap = (uint32_t)(native_app_heap_used() - heap);
+
+  start = time_now_us();
+  for (i = 0; i < DRAG_FRAMES; i++)
+  {
+    x -= dir * DRAG_STEP;
+    send_pointer(EVT_POINTER_MOVE, x);
+    window_manager_paint(wm);
+  }
+  result->drag_us = (double)(time_now_us() - start) / DRAG_FRAMES;
+
+  /*松开后动画滑到下一页*/
+  send_pointer(EVT_POINTER_UP, x);
+  while (SLIDE_VIEW(slide_view)->animating)
+  {
+    native_app_pump();
+    window_manager_paint(wm);
+  }
+  native_app_pump();
+  window_manager_paint(wm);
+}
+
+static void bench(bool_t cache_pages, swipe_result_t *best)
+{
+  uint32_t r = 0;
+  uint32_t i = 0;
+  widget_t *win = window_create(NULL, 0, 0, 0, 0);
+  widget_t *slide_view = slide_view_create(win, 0, 0, LCD_W, LCD_H);
+
+  for (i = 0; i < PAGES_NR; i++)
+  {
+    create_page(slide_view, i);
+  }
+  slide_view_set_cache_pages(slide_view, cache_pages);
+  native_app_paint_frames(1);
+
+  best->start_us = 1e9;
+  best->drag_us = 1e9;
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    swipe_result_t result;
+
+    /*0 -> 1 -> 0，回到第一页*/
+    swipe(slide_view, 1, &result);
+    TEST_ASSERT_EQUAL_UINT32(1, SLIDE_VIEW(slide_view)->active);
+    swipe(slide_view, -1, &result);
+    TEST_ASSERT_EQUAL_UINT32(0, SLIDE_VIEW(slide_view)->active);
+
+    best->start_us = tk_min(best->start_us, result.start_us);
+    best->drag_us = tk_min(best->drag_us, result.drag_us);
+    best->layers_heap = result.layers_heap;
+  }
+
+  /*滑动结束后离线画布已经释放*/
+  TEST_ASSERT_NULL(SLIDE_VIEW(slide_view)->layers[0].canvas);
+  TEST_ASSERT_NULL(SLIDE_VIEW(slide_view)->layers[1].canvas);
+
+  widget_destroy(win);
+  native_app_pump();
+}
+
+static void report(const char *name, const swipe_result_t *r)
+{
+  char msg[128];
+
+  tk_snprintf(msg, sizeof(msg), "%s: start %6.0fus  drag %6.0fus/frame (%6.1f fps)  heap +%u",
+              name, r->start_us, r->drag_us, 1000000.0 / r->drag_us, r->layers_heap);
+  TEST_MESSAGE(msg);
+}
+
+static void test_swipe(void)
+{
+  swipe_result_t off;
+  swipe_result_t on;
+
+  memset(&off, 0x00, sizeof(off));
+  memset(&on, 0x00, sizeof(on));
+  bench(FALSE, &off);
+  bench(TRUE, &on);
+  report("cache_pages=false", &off);
+  report("cache_pages=true ", &on);
+
+  /*两个 LCD 格式的离线画布*/
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2 * LCD_W * LCD_H * 2, on.layers_heap);
+  TEST_ASSERT_LESS_THAN(off.drag_us, on.drag_us);
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(LCD_W, LCD_H);
+  image_manager_set_fallback_get_bitmap(image_manager(), create_icon, NULL);
+  RUN_TEST(test_swipe);
+  image_manager_set_fallback_get_bitmap(image_manager(), NULL, NULL);
+  tk_exit();
+  return UNITY_END();
+}
@@ -0,0 +1,216 @@
+/**
+ * user-007: timer_manager 的最小堆和按 id 的索引。
+ *
+ * 10/100/1000 个定时器时 add/find/remove/dispatch/remove_all 的开销，
+ * 以及随机增删时到期顺序和 find 的结果是否正确。
+ */
+#include <unity.h>
+#include "tkc/mem.h"
+#include "tkc/time_now.h"
+#include "tkc/timer_manager.h"
+
+static uint64_t s_now = 0;
+static uint32_t s_fired = 0;
+static uint64_t s_last_fired = 0;
+static uint32_t s_seed = 1;
+
+static uint64_t fake_time(void)
+{
+  return s_now;
+}
+
+static uint32_t next_rand(void)
+{
+  s_seed = s_seed * 1103515245 + 12345;
+  return (s_seed >> 16) & 0x7fff;
+}
+
+static ret_t on_timer_once(const timer_info_t *timer)
+{
+  /*按到期时间的顺序触发*/
+  TEST_ASSERT_TRUE(timer->start + timer->duration >= s_last_fired);
+  s_last_fired = timer->start + timer->duration;
+  s_fired++;
+
+  return RET_REMOVE;
+}
+
+static ret_t on_timer_repeat(const timer_info_t *timer)
+{
+  s_fired++;
+  return RET_REPEAT;
+}
+
+void setUp(void)
+{
+  s_now = 1000;
+  s_fired = 0;
+  s_last_fired = 0;
+}
+
+void tearDown(void)
+{
+}
+
+static void test_random_add_remove(void)
+{
+  uint32_t i = 0;
+  uint32_t alive = 0;
+  uint32_t ids[512];
+  timer_manager_t *tm = timer_manager_create(fake_time);
+
+  for (i = 0; i < ARRAY_SIZE(ids); i++)
+  {
+    ids[i] = timer_manager_add(tm, on_timer_once, NULL, 1 + next_rand() % 1000);
+  }
+  /*删掉一半，剩下的都还能找到*/
+  for (i = 0; i < ARRAY_SIZE(ids); i += 2)
+  {
+    TEST_ASSERT_EQUAL_INT(RET_OK, timer_manager_remove(tm, ids[i]));
+    TEST_ASSERT_NULL(timer_manager_find(tm, ids[i]));
+    TEST_ASSERT_EQUAL_INT(RET_NOT_FOUND, timer_manager_remove(tm, ids[i]));
+  }
+  for (i = 1; i < ARRAY_SIZE(ids); i += 2)
+  {
+    const timer_info_t *timer = timer_manager_find(tm, ids[i]);
+    TEST_ASSERT_NOT_NULL(timer);
+    TEST_ASSERT_EQUAL_UINT32(ids[i], timer->id);
+    alive++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(alive, timer_manager_count(tm));
+  TEST_ASSERT_EQUAL_UINT32(TK_INVALID_ID,
+                           timer_manager_add_with_id(tm, ids[1], on_timer_once, NULL, 10));
+
+  s_now += 2000;
+  timer_manager_dispatch(tm);
+  TEST_ASSERT_EQUAL_UINT32(alive, s_fired);
+  TEST_ASSERT_EQUAL_UINT32(0, timer_manager_count(tm));
+
+  timer_manager_destroy(tm);
+}
+
+static void test_remove_by_ctx(void)
+{
+  uint32_t i = 0;
+  int a = 0;
+  int b = 0;
+  timer_manager_t *tm = timer_manager_create(fake_time);
+
+  for (i = 0; i < 300; i++)
+  {
+    timer_manager_add(tm, on_timer_repeat, (i % 3) == 0 ? &a : &b, 10 + i);
+  }
+  TEST_ASSERT_EQUAL_INT(RET_OK, timer_manager_all_remove_by_ctx(tm, &a));
+  TEST_ASSERT_EQUAL_UINT32(200, timer_manager_count(tm));
+  TEST_ASSERT_EQUAL_INT(RET_OK, timer_manager_all_remove_by_ctx(tm, &b));
+  TEST_ASSERT_EQUAL_UINT32(0, timer_manager_count(tm));
+
+  timer_manager_destroy(tm);
+}
+
+static void bench(uint32_t nr)
+{
+  char msg[160];
+  uint32_t i = 0;
+  uint32_t r = 0;
+  uint64_t start = 0;
+  double add_ns = 0;
+  double find_ns = 0;
+  double remove_ns = 0;
+  double dispatch_ns = 0;
+  double remove_all_ns = 0;
+  int ctx = 0;
+  uint32_t rounds = 100000 / nr;
+  uint32_t *ids = TKMEM_ZALLOCN(uint32_t, nr);
+  timer_manager_t *tm = timer_manager_create(fake_time);
+
+  start = time_now_us();
+  for (r = 0; r < rounds; r++)
+  {
+    for (i = 0; i < nr; i++)
+    {
+      ids[i] = timer_manager_add(tm, on_timer_repeat, &ctx, 16 + next_rand() % 1000);
+    }
+
+    for (i = 0; i < nr; i++)
+    {
+      timer_manager_remove(tm, ids[(i * 7919) % nr]);
+    }
+  }
+  /*add 和 remove 分开计时太短，这里先整体计时，下面再单独计 remove*/
+  add_ns = (time_now_us() - start) * 1000.0 / (rounds * nr);
+
+  for (i = 0; i < nr; i++)
+  {
+    ids[i] = timer_manager_add(tm, on_timer_repeat, &ctx, 16 + next_rand() % 1000);
+  }
+  start = time_now_us();
+  for (r = 0; r < rounds; r++)
+  {
+    for (i = 0; i < nr; i++)
+    {
+      TEST_ASSERT_NOT_NULL(timer_manager_find(tm, ids[(i * 7919) % nr]));
+    }
+  }
+  find_ns = (time_now_us() - start) * 1000.0 / (rounds * nr);
+
+  /*每 16ms 一轮，到期的重复定时器重新入堆*/
+  start = time_now_us();
+  for (r = 0; r < 1000; r++)
+  {
+    s_now += 16;
+    timer_manager_dispatch(tm);
+  }
+  dispatch_ns = (time_now_us() - start) * 1000.0 / 1000;
+
+  start = time_now_us();
+  for (i = 0; i < nr; i++)
+  {
+    timer_manager_remove(tm, ids[(i * 7919) % nr]);
+  }
+  remove_ns = (time_now_us() - start) * 1000.0 / nr;
+
+  for (i = 0; i < nr; i++)
+  {
+    timer_manager_add(tm, on_timer_repeat, &ctx, 16 + next_rand() % 1000);
+  }
+  start = time_now_us();
+  timer_manager_all_remove_by_ctx(tm, &ctx);
+  remove_all_ns = (time_now_us() - start) * 1000.0;
+  TEST_ASSERT_EQUAL_UINT32(0, timer_manager_count(tm));
+
+  tk_snprintf(msg, sizeof(msg),
+              "%4u timers: add+remove %.0fns, find %.0fns, remove %.0fns, dispatch %.0fns/tick, "
+              "remove_all %.1fus",
+              nr, add_ns, find_ns, remove_ns, dispatch_ns, remove_all_ns / 1000);
+  TEST_MESSAGE(msg);
+
+  timer_manager_destroy(tm);
+  TKMEM_FREE(ids);
+}
+
+static void test_bench_10(void)
+{
+  bench(10);
+}
+
+static void test_bench_100(void)
+{
+  bench(100);
+}
+
+static void test_bench_1000(void)
+{
+  bench(1000);
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_random_add_remove);
+  RUN_TEST(test_remove_by_ctx);
+  RUN_TEST(test_bench_10);
+  RUN_TEST(test_bench_100);
+  RUN_TEST(test_bench_1000);
+  return UNITY_END();
+}
@@ -0,0 +1,274 @@
+/**
+ * user-011: v2 格式的 UI 数据。
+ *
+ * 同一份界面分别生成 v1/v2 数据，加载出来的控件树应该一样；比较两者打开窗口(加载控件树)的时间，
+ * 页面为资源里的 home_page 和 500 个控件的合成页面。
+ */
+#include <unity.h>
+#include "awtk.h"
+#include "ui_loader/ui_loader_xml.h"
+#include "ui_loader/ui_serializer.h"
+#include "ui_loader/ui_loader_default.h"
+#include "ui_loader/ui_binary_writer.h"
+#include "ui_loader/ui_builder_default.h"
+#include "native_app.h"
+
+#define BENCH_NR 20
+#define BENCH_ROUNDS 5
+#define SYNTH_WIDGETS_NR 500
+
+/*和 res/assets/default/inc/ui/home_page.data 相同的界面*/
+static const char *s_home_page_xml =
+    "<window name=\"home_page\">"
+    "<progress_bar name=\"progress_bar\" x=\"10\" y=\"48\" w=\"100\" h=\"11\" "
+    "animation=\"value(duration=1000,yoyo_times=0,easing=linear,from=10,to=100)\" "
+    "show_text=\"true\" value=\"10\"/>"
+    "<progress_bar name=\"progress_bar1\" x=\"120\" y=\"10\" w=\"30\" h=\"60\" vertical=\"true\" "
+    "animation=\"value(duration=1000,yoyo_times=0,easing=linear,from=10,to=100)\" "
+    "show_text=\"true\" value=\"10\"/>"
+    "</window>";
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static ret_t encode(const char *xml, bool_t v2, wbuffer_t *wbuffer)
+{
+  ret_t ret = RET_OK;
+  ui_builder_t *builder = NULL;
+  ui_binary_writer_t writer;
+
+  wbuffer_init_extendable(wbuffer);
+  if (v2)
+  {
+    builder = ui_binary_writer_init_v2(&writer, wbuffer);
+  }
+  else
+  {
+    builder = ui_binary_writer_init(&writer, wbuffer);
+  }
+
+  ret = ui_loader_load(xml_ui_loader(), (const uint8_t *)xml, strlen(xml), builder);
+  if (ret == RET_OK && writer.failed)
+  {
+    ret = RET_FAIL;
+  }
+  ui_binary_writer_deinit(&writer);
+
+  return ret;
+}
+
+static widget_t *load(const uint8_t *data, uint32_t size)
+{
+  widget_t *root = NULL;
+  ui_builder_t *builder = ui_builder_default_create("ui_v2");
+
+  ui_loader_load(default_ui_loader(), data, size, builder);
+  root = builder->root;
+  ui_builder_destroy(builder);
+
+  return root;
+}
+
+static void close_window(widget_t *win)
+{
+  widget_destroy(win);
+  native_app_pump();
+}
+
+static void assert_same_tree(widget_t *expected, widget_t *actual)
+{
+  str_t s1;
+  str_t s2;
+
+  TEST_ASSERT_NOT_NULL(expected);
+  TEST_ASSERT_NOT_NULL(actual);
+  str_init(&s1, 1024);
+  str_init(&s2, 1024);
+  widget_to_xml(expected, &s1);
+  widget_to_xml(actual, &s2);
+  TEST_ASSERT_EQUAL_STRING(s1.str, s2.str);
+  str_reset(&s1);
+  str_reset(&s2);
+}
+
+static void build_synth_page(str_t *xml)
+{
+  uint32_t i = 0;
+  char line[256];
+
+  str_set(xml, "<window name=\"synth\" style:normal:bg_color=\"#202020\">");
+  for (i = 0; i < SYNTH_WIDGETS_NR; i++)
+  {
+    uint32_t x = (i % 10) * 32;
+    uint32_t y = (i / 10) * 24;
+
+    switch (i % 5)
+    {
+    case 0:
+      tk_snprintf(line, sizeof(line),
+                  "<label name=\"l%u\" x=\"%u\" y=\"%u\" w=\"30\" h=\"20\" text=\"L%u\" "
+                  "style:normal:text_color=\"#ff0000\" style:normal:font_size=\"14\"/>",
+                  i, x, y, i);
+      break;
+    case 1:
+      tk_snprintf(line, sizeof(line),
+                  "<button name=\"b%u\" x=\"%u\" y=\"%u\" w=\"30\" h=\"20\" text=\"B%u\" "
+                  "repeat=\"300\" enable_long_press=\"true\"/>",
+                  i, x, y, i);
+      break;
+    case 2:
+      tk_snprintf(line, sizeof(line),
+                  "<progress_bar name=\"p%u\" x=\"%u\" y=\"%u\" w=\"30\" h=\"20\" value=\"%u\" "
+                  "max=\"500\" show_text=\"true\"/>",
+                  i, x, y, i);
+      break;
+    case 3:
+      tk_snprintf(line, sizeof(line),
+                  "<slider name=\"s%u\" x=\"%u\" y=\"%u\" w=\"30%%\" h=\"20\" min=\"0\" "
+                  "max=\"100\" step=\"5\" value=\"%u\" visible=\"true\"/>",
+                  i, x, y, i % 100);
+      break;
+    default:
+      tk_snprintf(line, sizeof(line),
+                  "<check_button name=\"c%u\" x=\"c\" y=\"%u\" w=\"50%%\" h=\"20\" "
+                  "value=\"%s\" text=\"C%u\"/>",
+                  i, y, (i & 1) ? "true" : "false", i);
+      break;
+    }
+    str_append(xml, line);
+  }
+  str_append(xml, "</window>");
+}
+
+static void test_equivalent(void)
+{
+  str_t xml;
+  wbuffer_t v1;
+  wbuffer_t v2;
+  widget_t *w1 = NULL;
+  widget_t *w2 = NULL;
+
+  str_init(&xml, 64 * 1024);
+  build_synth_page(&xml);
+  TEST_ASSERT_EQUAL_INT(RET_OK, encode(xml.str, FALSE, &v1));
+  TEST_ASSERT_EQUAL_INT(RET_OK, encode(xml.str, TRUE, &v2));
+  TEST_ASSERT_LESS_THAN_UINT32(v1.cursor, v2.cursor);
+
+  w1 = load(v1.data, v1.cursor);
+  w2 = load(v2.data, v2.cursor);
+  TEST_ASSERT_EQUAL_INT(SYNTH_WIDGETS_NR, widget_count_children(w2));
+  assert_same_tree(w1, w2);
+  close_window(w1);
+  close_window(w2);
+
+  /*资源里的 home_page 已经是 v2 格式，和同一界面的 v1 数据加载的结果一样*/
+  wbuffer_deinit(&v1);
+  TEST_ASSERT_EQUAL_INT(RET_OK, encode(s_home_page_xml, FALSE, &v1));
+  w1 = load(v1.data, v1.cursor);
+  w2 = ui_loader_load_widget("home_page");
+  TEST_ASSERT_NOT_NULL(widget_lookup(w2, "progress_bar1", FALSE));
+  assert_same_tree(w1, w2);
+  close_window(w1);
+  close_window(w2);
+
+  wbuffer_deinit(&v1);
+  wbuffer_deinit(&v2);
+  str_reset(&xml);
+}
+
+static void test_write_failed(void)
+{
+  uint8_t buff[16];
+  wbuffer_t wbuffer;
+  ui_builder_t *builder = NULL;
+  ui_binary_writer_t writer;
+
+  wbuffer_init_extendable(&wbuffer);
+  builder = ui_binary_writer_init_v2(&writer, &wbuffer);
+
+  /*模拟内存不足：body 换成不能扩展的小缓冲区，写入会失败*/
+  wbuffer_deinit(&(writer.body));
+  wbuffer_init(&(writer.body), buff, sizeof(buff));
+
+  ui_loader_load(xml_ui_loader(), (const uint8_t *)s_home_page_xml, strlen(s_home_page_xml),
+                 builder);
+  TEST_ASSERT_TRUE(writer.failed);
+  TEST_ASSERT_EQUAL_UINT32(0, wbuffer.cursor);
+
+  ui_binary_writer_deinit(&writer);
+  wbuffer_deinit(&wbuffer);
+}
+
+/*加载 BENCH_NR 次，取几轮中最快的一轮，返回每次的时间(微秒)。控件的销毁不计时*/
+static double bench_load(const wbuffer_t *wbuffer)
+{
+  uint32_t i = 0;
+  uint32_t r = 0;
+  uint64_t best = 0xffffffff;
+  widget_t *wins[BENCH_NR];
+
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    uint64_t start = time_now_us();
+    for (i = 0; i < BENCH_NR; i++)
+    {
+      wins[i] = load(wbuffer->data, wbuffer->cursor);
+    }
+    best = tk_min(best, time_now_us() - start);
+
+    for (i = 0; i < BENCH_NR; i++)
+    {
+      close_window(wins[i]);
+    }
+  }
+
+  return (double)best / BENCH_NR;
+}
+
+static void bench_page(const char *name, const char *xml)
+{
+  char msg[128];
+  wbuffer_t v1;
+  wbuffer_t v2;
+  double v1_us = 0;
+  double v2_us = 0;
+
+  TEST_ASSERT_EQUAL_INT(RET_OK, encode(xml, FALSE, &v1));
+  TEST_ASSERT_EQUAL_INT(RET_OK, encode(xml, TRUE, &v2));
+  v1_us = bench_load(&v1);
+  v2_us = bench_load(&v2);
+
+  tk_snprintf(msg, sizeof(msg), "%-10s v1 %6u bytes %9.1fus  v2 %6u bytes %9.1fus  (%.2fx)", name,
+              v1.cursor, v1_us, v2.cursor, v2_us, v1_us / v2_us);
+  TEST_MESSAGE(msg);
+
+  wbuffer_deinit(&v1);
+  wbuffer_deinit(&v2);
+}
+
+static void test_bench(void)
+{
+  str_t xml;
+
+  str_init(&xml, 64 * 1024);
+  build_synth_page(&xml);
+  bench_page("home_page", s_home_page_xml);
+  bench_page("synth_500", xml.str);
+  str_reset(&xml);
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(320, 240);
+  RUN_TEST(test_equivalent);
+  RUN_TEST(test_write_failed);
+  RUN_TEST(test_bench);
+  tk_exit();
+  return UNITY_END();
+}
@@ -0,0 +1,173 @@
+/**
+ * user-025: lcd_mem_fragment 上的 vgcanvas(nanovg + agge)。
+ *
+ * 320x240 的屏幕，片段帧缓存每次只能放下约 100 行，一帧分 3 个片段绘制。页面上有 4 个
+ * progress_circle、2 个 gauge_pointer 和一个画折线图、圆角矩形的 canvas_widget，路径跨越片段。
+ * 统计每帧的时间，只有普通控件时占用的堆，以及第一次绘制矢量控件时创建 vgcanvas 的开销。
+ * 路径在第一个片段展开后，后面的片段复用，输出和每个片段重新展开时相同(屏幕校验和)。
+ */
+#include <unity.h>
+#include "awtk.h"
+#include "ext_widgets/canvas_widget/canvas_widget.h"
+#include "ext_widgets/gauge/gauge_pointer.h"
+#include "ext_widgets/progress_circle/progress_circle.h"
+#include "native_app.h"
+#include "mock_bus.h"
+
+#define LCD_W 320
+#define LCD_H 240
+#define CHART_POINTS 120
+#define BENCH_FRAMES 20
+#define BENCH_ROUNDS 5
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static ret_t on_paint_chart(void *ctx, event_t *e)
+{
+  uint32_t i = 0;
+  widget_t *widget = WIDGET(ctx);
+  canvas_t *c = paint_event_cast(e)->c;
+  vgcanvas_t *vg = canvas_get_vgcanvas(c);
+  float_t x = c->ox;
+  float_t y = c->oy;
+  float_t step = (float_t)widget->w / (CHART_POINTS - 1);
+
+  vgcanvas_save(vg);
+  vgcanvas_begin_path(vg);
+  vgcanvas_rounded_rect(vg, x + 4, y + 4, widget->w - 8, widget->h - 8, 10);
+  vgcanvas_set_fill_color(vg, color_init(0x20, 0x40, 0x60, 0xff));
+  vgcanvas_fill(vg);
+  vgcanvas_set_line_width(vg, 2);
+  vgcanvas_set_stroke_color(vg, color_init(0xc0, 0xc0, 0xc0, 0xff));
+  vgcanvas_stroke(vg);
+
+  /*跨越所有片段的折线*/
+  vgcanvas_begin_path(vg);
+  for (i = 0; i < CHART_POINTS; i++)
+  {
+    float_t px = x + i * step;
+    float_t py = y + widget->h / 2 + ((i * 37) % 41 - 20) * widget->h / 48.0f;
+
+    if (i == 0)
+    {
+      vgcanvas_move_to(vg, px, py);
+    }
+    else
+    {
+      vgcanvas_line_to(vg, px, py);
+    }
+  }
+  vgcanvas_set_line_width(vg, 3);
+  vgcanvas_set_stroke_color(vg, color_init(0xff, 0xa0, 0x20, 0xff));
+  vgcanvas_stroke(vg);
+  vgcanvas_restore(vg);
+
+  return RET_OK;
+}
+
+static widget_t *open_vector_page(void)
+{
+  uint32_t i = 0;
+  widget_t *win = window_create(NULL, 0, 0, 0, 0);
+  widget_t *chart = canvas_widget_create(win, 10, 20, LCD_W / 2 - 20, LCD_H - 40);
+
+  widget_on(chart, EVT_PAINT, on_paint_chart, chart);
+  for (i = 0; i < 4; i++)
+  {
+    widget_t *w = progress_circle_create(win, LCD_W / 2 + (i % 2) * 75, 40 + (i / 2) * 90, 70, 70);
+    progress_circle_set_line_width(w, 8);
+    progress_circle_set_show_text(w, FALSE);
+    progress_circle_set_value(w, 20 + i * 20);
+  }
+  for (i = 0; i < 2; i++)
+  {
+    widget_t *w = gauge_pointer_create(win, LCD_W / 2 + i * 75, 60, 70, 120);
+    gauge_pointer_set_angle(w, 30 + i * 60);
+  }
+
+  return win;
+}
+
+/*屏幕内容的校验和，用于比较不同实现的输出是否一致*/
+static uint32_t screen_checksum(void)
+{
+  uint32_t i = 0;
+  uint32_t sum = 0;
+  const uint16_t *screen = mock_bus_get_screen();
+
+  for (i = 0; i < LCD_W * LCD_H; i++)
+  {
+    sum = sum * 31 + screen[i];
+  }
+
+  return sum;
+}
+
+static void test_vgcanvas_heap(void)
+{
+  char msg[128];
+  uint64_t plain = 0;
+  uint64_t vector = 0;
+  widget_t *win = native_app_create_sample_window("Plain");
+  lcd_t *lcd = widget_get_canvas(win)->lcd;
+
+  /*普通控件不需要 vgcanvas，绘制两次后缓存都已加载*/
+  native_app_paint_frames(2);
+  plain = native_app_heap_used();
+  TEST_ASSERT_NULL(lcd_peek_vgcanvas(lcd));
+  widget_destroy(win);
+  native_app_pump();
+
+  win = open_vector_page();
+  native_app_pump();
+  vector = native_app_heap_used();
+  native_app_paint_frames(1);
+  vector = native_app_heap_used() - vector;
+  TEST_ASSERT_NOT_NULL(lcd_peek_vgcanvas(lcd));
+  widget_destroy(win);
+  native_app_pump();
+
+  tk_snprintf(msg, sizeof(msg), "heap used with plain widgets %u, first vector paint +%u",
+              (uint32_t)plain, (uint32_t)vector);
+  TEST_MESSAGE(msg);
+}
+
+static void test_vgcanvas_bench(void)
+{
+  uint32_t r = 0;
+  char msg[128];
+  double best = 1e9;
+  uint32_t sum = 0;
+  widget_t *win = open_vector_page();
+
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    best = tk_min(best, native_app_paint_frames(BENCH_FRAMES));
+  }
+  sum = screen_checksum();
+
+  tk_snprintf(msg, sizeof(msg), "%ux%u, %u strips: %.1fus/frame, screen checksum %08x", LCD_W,
+              LCD_H, (LCD_H + FRAGMENT_FRAME_BUFFER_STRIP_SIZE / LCD_W - 1) /
+                         (FRAGMENT_FRAME_BUFFER_STRIP_SIZE / LCD_W),
+              best, sum);
+  TEST_MESSAGE(msg);
+
+  widget_destroy(win);
+  native_app_pump();
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(LCD_W, LCD_H);
+  RUN_TEST(test_vgcanvas_heap);
+  RUN_TEST(test_vgcanvas_bench);
+  tk_exit();
+  return UNITY_END();
+}
@@ -0,0 +1,162 @@
+/**
+ * user-012: 控件和事件处理项的内存池。
+ *
+ * 反复打开/关闭窗口，关闭后内存池把空闲的 chunk 还给堆，堆的占用不随次数增长；
+ * 其它线程使用的(非控件的)emitter 不经过内存池，和 GUI 线程同时注册/注销事件不会破坏内存池。
+ */
+#include <pthread.h>
+#include <unity.h>
+#include "awtk.h"
+#include "native_app.h"
+
+#define SOAK_CYCLES 500
+#define PAGE_WIDGETS_NR 200
+#define THREAD_LOOPS 20000
+
+static volatile bool_t s_thread_done = FALSE;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static ret_t on_dummy_event(void *ctx, event_t *e)
+{
+  return RET_OK;
+}
+
+static widget_t *open_page(void)
+{
+  uint32_t i = 0;
+  widget_t *win = window_create(NULL, 0, 0, 0, 0);
+
+  for (i = 0; i < PAGE_WIDGETS_NR; i++)
+  {
+    widget_t *w = NULL;
+    xy_t x = (i % 10) * 32;
+    xy_t y = (i / 10) * 12;
+
+    switch (i % 3)
+    {
+    case 0:
+      w = label_create(win, x, y, 30, 10);
+      widget_set_text_utf8(w, "label");
+      break;
+    case 1:
+      w = button_create(win, x, y, 30, 10);
+      widget_on(w, EVT_CLICK, on_dummy_event, NULL);
+      break;
+    default:
+      w = progress_bar_create(win, x, y, 30, 10);
+      widget_set_value(w, i % 100);
+      break;
+    }
+    widget_set_name(w, "item");
+    widget_on(w, EVT_VALUE_CHANGED, on_dummy_event, NULL);
+  }
+  native_app_pump();
+
+  return win;
+}
+
+static void close_page(widget_t *win)
+{
+  widget_destroy(win);
+  native_app_pump();
+}
+
+static void report(uint32_t cycle, uint64_t used, uint64_t base)
+{
+  char msg[128];
+
+  tk_snprintf(msg, sizeof(msg), "cycle %4u: heap used %7u (%+6d)  heap free %7u", cycle,
+              (uint32_t)used, (int32_t)(used - base), (uint32_t)native_app_heap_free());
+  TEST_MESSAGE(msg);
+}
+
+static void test_soak(void)
+{
+  uint32_t i = 0;
+  uint64_t base = 0;
+  uint64_t used = 0;
+  uint64_t peak = 0;
+  uint64_t used_10 = 0;
+  char msg[128];
+
+  /*先打开/关闭一次，把字体、图片等缓存加载好*/
+  close_page(open_page());
+  base = native_app_heap_used();
+
+  for (i = 1; i <= SOAK_CYCLES; i++)
+  {
+    widget_t *win = open_page();
+    peak = tk_max(peak, native_app_heap_used());
+    close_page(win);
+
+    used = native_app_heap_used();
+    if (i == 1 || i == 10 || i == 100 || i == SOAK_CYCLES)
+    {
+      report(i, used, base);
+    }
+    if (i == 10)
+    {
+      used_10 = used;
+    }
+  }
+
+  tk_snprintf(msg, sizeof(msg), "%u widgets per window, peak heap used %u (%+d)",
+              PAGE_WIDGETS_NR, (uint32_t)peak, (int32_t)(peak - base));
+  TEST_MESSAGE(msg);
+
+  /*前几次打开时字体等缓存还在增长。之后关闭窗口后空闲的 chunk 还给了堆，反复打开/关闭不会让占用增长*/
+  TEST_ASSERT_LESS_OR_EQUAL(used_10 + 1024, used);
+}
+
+static void *emitter_thread(void *args)
+{
+  uint32_t i = 0;
+
+  for (i = 0; i < THREAD_LOOPS; i++)
+  {
+    emitter_t *emitter = emitter_create();
+    uint32_t id = emitter_on(emitter, EVT_PROP_CHANGED, on_dummy_event, NULL);
+
+    emitter_on(emitter, EVT_PROPS_CHANGED, on_dummy_event, NULL);
+    emitter_off(emitter, id);
+    emitter_destroy(emitter);
+  }
+  s_thread_done = TRUE;
+
+  return NULL;
+}
+
+static void test_other_thread_emitter(void)
+{
+  pthread_t tid;
+  uint32_t n = 0;
+
+  s_thread_done = FALSE;
+  pthread_create(&tid, NULL, emitter_thread, NULL);
+  while (!s_thread_done)
+  {
+    close_page(open_page());
+    n++;
+  }
+  pthread_join(tid, NULL);
+
+  TEST_ASSERT_GREATER_THAN(0, n);
+  close_page(open_page());
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(320, 240);
+  RUN_TEST(test_soak);
+  RUN_TEST(test_other_thread_emitter);
+  tk_exit();
+  return UNITY_END();
+}
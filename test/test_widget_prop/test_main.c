@@ -0,0 +1,181 @@
+/**
+ * user-010: 属性按整数 ID 分发。
+ *
+ * button/label/slider/progress_bar 的 widget_get_prop/widget_set_prop 每次调用的开销，
+ * 以及按 ID 分发后每个属性仍然读写到正确的字段。
+ */
+#include <unity.h>
+#include "awtk.h"
+#include "base/widget_prop_ids.h"
+#include "native_app.h"
+
+#define BENCH_NR 100000
+#define BENCH_ROUNDS 5
+
+static widget_t *s_win = NULL;
+
+void setUp(void)
+{
+  s_win = window_create(NULL, 0, 0, 0, 0);
+}
+
+void tearDown(void)
+{
+  widget_destroy(s_win);
+  s_win = NULL;
+}
+
+static void test_prop_ids(void)
+{
+  TEST_ASSERT_EQUAL_INT(WIDGET_PROP_ID_X, widget_prop_id(WIDGET_PROP_X));
+  TEST_ASSERT_EQUAL_INT(WIDGET_PROP_ID_VALUE, widget_prop_id(WIDGET_PROP_VALUE));
+  TEST_ASSERT_EQUAL_INT(WIDGET_PROP_ID_REVERSE, widget_prop_id(WIDGET_PROP_REVERSE));
+  TEST_ASSERT_EQUAL_INT(WIDGET_PROP_ID_NONE, widget_prop_id("no_such_prop"));
+  TEST_ASSERT_EQUAL_INT(WIDGET_PROP_ID_NONE, widget_prop_id(""));
+}
+
+static void test_props_roundtrip(void)
+{
+  widget_t *button = button_create(s_win, 0, 0, 80, 30);
+  widget_t *label = label_create(s_win, 0, 30, 80, 30);
+  widget_t *slider = slider_create(s_win, 0, 60, 80, 30);
+  widget_t *bar = progress_bar_create(s_win, 0, 90, 80, 30);
+
+  widget_set_prop_int(button, WIDGET_PROP_REPEAT, 300);
+  widget_set_prop_int(button, WIDGET_PROP_LONG_PRESS_TIME, 900);
+  widget_set_prop_bool(button, WIDGET_PROP_ENABLE_LONG_PRESS, TRUE);
+  widget_set_prop_bool(button, WIDGET_PROP_ENABLE_PREVIEW, TRUE);
+  TEST_ASSERT_EQUAL_INT(300, BUTTON(button)->repeat);
+  TEST_ASSERT_EQUAL_INT(900, widget_get_prop_int(button, WIDGET_PROP_LONG_PRESS_TIME, 0));
+  TEST_ASSERT_TRUE(widget_get_prop_bool(button, WIDGET_PROP_ENABLE_LONG_PRESS, FALSE));
+  TEST_ASSERT_TRUE(widget_get_prop_bool(button, WIDGET_PROP_ENABLE_PREVIEW, FALSE));
+
+  widget_set_prop_str(label, WIDGET_PROP_TEXT, "12.5");
+  TEST_ASSERT_EQUAL_INT(12, widget_get_prop_int(label, WIDGET_PROP_VALUE, 0));
+  widget_set_prop_int(label, WIDGET_PROP_LENGTH, 3);
+  widget_set_prop_int(label, WIDGET_PROP_MAX_W, 60);
+  widget_set_prop_bool(label, WIDGET_PROP_LINE_WRAP, TRUE);
+  widget_set_prop_bool(label, WIDGET_PROP_WORD_WRAP, TRUE);
+  TEST_ASSERT_EQUAL_INT(3, LABEL(label)->length);
+  TEST_ASSERT_EQUAL_INT(60, widget_get_prop_int(label, WIDGET_PROP_MAX_W, 0));
+  TEST_ASSERT_TRUE(widget_get_prop_bool(label, WIDGET_PROP_LINE_WRAP, FALSE));
+  TEST_ASSERT_TRUE(widget_get_prop_bool(label, WIDGET_PROP_WORD_WRAP, FALSE));
+
+  widget_set_prop_int(slider, WIDGET_PROP_MIN, 10);
+  widget_set_prop_int(slider, WIDGET_PROP_MAX, 50);
+  widget_set_prop_int(slider, WIDGET_PROP_STEP, 5);
+  widget_set_prop_int(slider, WIDGET_PROP_VALUE, 20);
+  widget_set_prop_bool(slider, WIDGET_PROP_VERTICAL, TRUE);
+  widget_set_prop_int(slider, WIDGET_PROP_BAR_SIZE, 7);
+  widget_set_prop_int(slider, SLIDER_PROP_DRAGGER_SIZE, 9);
+  TEST_ASSERT_EQUAL_INT(20, widget_get_prop_int(slider, WIDGET_PROP_VALUE, 0));
+  TEST_ASSERT_EQUAL_INT(10, widget_get_prop_int(slider, WIDGET_PROP_MIN, 0));
+  TEST_ASSERT_EQUAL_INT(50, widget_get_prop_int(slider, WIDGET_PROP_MAX, 0));
+  TEST_ASSERT_EQUAL_INT(5, widget_get_prop_int(slider, WIDGET_PROP_STEP, 0));
+  TEST_ASSERT_EQUAL_INT(7, widget_get_prop_int(slider, WIDGET_PROP_BAR_SIZE, 0));
+  TEST_ASSERT_EQUAL_INT(9, widget_get_prop_int(slider, SLIDER_PROP_DRAGGER_SIZE, 0));
+  TEST_ASSERT_TRUE(widget_get_prop_bool(slider, WIDGET_PROP_VERTICAL, FALSE));
+  TEST_ASSERT_FALSE(widget_get_prop_bool(slider, WIDGET_PROP_INPUTING, TRUE));
+
+  widget_set_prop_int(bar, WIDGET_PROP_MAX, 200);
+  widget_set_prop_int(bar, WIDGET_PROP_VALUE, 150);
+  widget_set_prop_str(bar, WIDGET_PROP_FORMAT, "%d");
+  widget_set_prop_bool(bar, WIDGET_PROP_SHOW_TEXT, TRUE);
+  widget_set_prop_bool(bar, WIDGET_PROP_REVERSE, TRUE);
+  widget_set_prop_bool(bar, WIDGET_PROP_VERTICAL, TRUE);
+  TEST_ASSERT_EQUAL_INT(150, widget_get_prop_int(bar, WIDGET_PROP_VALUE, 0));
+  TEST_ASSERT_EQUAL_INT(200, widget_get_prop_int(bar, WIDGET_PROP_MAX, 0));
+  TEST_ASSERT_EQUAL_STRING("%d", widget_get_prop_str(bar, WIDGET_PROP_FORMAT, NULL));
+  TEST_ASSERT_TRUE(widget_get_prop_bool(bar, WIDGET_PROP_SHOW_TEXT, FALSE));
+  TEST_ASSERT_TRUE(widget_get_prop_bool(bar, WIDGET_PROP_REVERSE, FALSE));
+  TEST_ASSERT_TRUE(widget_get_prop_bool(bar, WIDGET_PROP_VERTICAL, FALSE));
+
+  /*基类的属性和不存在的属性*/
+  widget_set_prop_int(bar, WIDGET_PROP_X, 5);
+  TEST_ASSERT_EQUAL_INT(5, widget_get_prop_int(bar, WIDGET_PROP_X, 0));
+  TEST_ASSERT_EQUAL_INT(-1, widget_get_prop_int(bar, "no_such_prop", -1));
+}
+
+/*取几轮中最快的一轮，减少主机上其它负载的干扰*/
+static double bench_get(widget_t *widget, const char *name)
+{
+  value_t v;
+  uint32_t i = 0;
+  uint32_t r = 0;
+  uint64_t best = 0xffffffff;
+
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    uint64_t start = time_now_us();
+    for (i = 0; i < BENCH_NR; i++)
+    {
+      widget_get_prop(widget, name, &v);
+    }
+    best = tk_min(best, time_now_us() - start);
+  }
+
+  return best * 1000.0 / BENCH_NR;
+}
+
+static double bench_set(widget_t *widget, const char *name, const value_t *v)
+{
+  uint32_t i = 0;
+  uint32_t r = 0;
+  uint64_t best = 0xffffffff;
+
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    uint64_t start = time_now_us();
+    for (i = 0; i < BENCH_NR; i++)
+    {
+      widget_set_prop(widget, name, v);
+    }
+    best = tk_min(best, time_now_us() - start);
+  }
+
+  return best * 1000.0 / BENCH_NR;
+}
+
+static void report(const char *type, const char *name, double get_ns, double set_ns)
+{
+  char msg[128];
+
+  tk_snprintf(msg, sizeof(msg), "%-12s %-18s get %6.1fns  set %6.1fns", type, name, get_ns,
+              set_ns);
+  TEST_MESSAGE(msg);
+}
+
+static void bench_prop(widget_t *widget, const char *name, const value_t *v)
+{
+  report(widget->vt->type, name, bench_get(widget, name), bench_set(widget, name, v));
+}
+
+static void test_bench(void)
+{
+  value_t v;
+  widget_t *button = button_create(s_win, 0, 0, 80, 30);
+  widget_t *label = label_create(s_win, 0, 30, 80, 30);
+  widget_t *slider = slider_create(s_win, 0, 60, 80, 30);
+  widget_t *bar = progress_bar_create(s_win, 0, 90, 80, 30);
+
+  bench_prop(button, WIDGET_PROP_ENABLE_PREVIEW, value_set_bool(&v, FALSE));
+  bench_prop(label, WIDGET_PROP_WORD_WRAP, value_set_bool(&v, FALSE));
+  bench_prop(label, WIDGET_PROP_TEXT, value_set_str(&v, "42"));
+  bench_prop(slider, WIDGET_PROP_VALUE, value_set_int(&v, 30));
+  bench_prop(slider, WIDGET_PROP_STEP, value_set_int(&v, 1));
+  bench_prop(bar, WIDGET_PROP_VALUE, value_set_int(&v, 30));
+  bench_prop(bar, WIDGET_PROP_REVERSE, value_set_bool(&v, FALSE));
+  bench_prop(bar, WIDGET_PROP_X, value_set_int(&v, 0));
+  bench_prop(bar, "no_such_prop", value_set_int(&v, 0));
+}
+
+int main(int argc, char *argv[])
+{
+  UNITY_BEGIN();
+  native_app_init(320, 240);
+  RUN_TEST(test_prop_ids);
+  RUN_TEST(test_props_roundtrip);
+  RUN_TEST(test_bench);
+  tk_exit();
+  return UNITY_END();
+}
@@ -0,0 +1,426 @@
+/**
+ * File:   font_gen.c
+ * Author: AWTK Develop Team
+ * Brief:  generate bitmap font(glyph atlas) from truetype font
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/*
+ * 把 truetype 字体中用到的字符预先光栅化为指定大小的位图字体，输出为资源文件(.data)，
+ * 格式与 src/font_loader/font_loader_bitmap.h 一致，运行时直接从 flash 中读取，不需要拷贝。
+ *
+ * 用法：
+ *   font_gen [-b 8|4] [-n name] [-a] [-c chars] [-t charset] ttf font_size output [xml...]
+ *
+ *   -b  点阵位数，8(GLYPH_FMT_ALPHA) 或 4(GLYPH_FMT_ALPHA4)，缺省为 8。
+ *   -n  资源名，缺省为 default_<font_size>(font_manager 按 "字体名_字号" 查找位图字体)。
+ *   -a  包含全部可打印的 ASCII 字符。
+ *   -c  包含指定的字符(UTF-8)。
+ *   -t  字符集文件(UTF-8)，包含其中的全部字符，可以多次指定。
+ *       界面文字在 C 代码中构造时(不在 xml 中)，用它列出这些字符。
+ *   xml 从中提取字符的界面文件，只提取 text/tr_text 属性和 text 属性节点的值。
+ *       不是 .xml 的文件当作字符集文件。
+ *
+ * 编译：
+ *   gcc -O2 -o font_gen font_gen.c -lm
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../../lib/AWTK_GUI/awtk/3rd/stb/stb_truetype.h"
+
+/* keep in sync with src/tkc/asset_info.h and src/font_loader/font_loader_bitmap.h */
+#define TK_NAME_LEN 31
+#define ASSET_TYPE_FONT 1
+#define ASSET_TYPE_FONT_BMP 2
+#define GLYPH_FMT_ALPHA 0
+#define GLYPH_FMT_ALPHA4 4
+#define FONT_BITMAP_HEADER_SIZE 16
+#define FONT_BITMAP_INDEX_SIZE 8
+#define FONT_BITMAP_GLYPH_SIZE 12
+#define MAX_CHARS 0x10000
+
+typedef struct _buffer_t {
+  uint8_t* data;
+  uint32_t size;
+  uint32_t capacity;
+} buffer_t;
+
+static void buffer_ensure(buffer_t* b, uint32_t size) {
+  if (b->capacity < size) {
+    uint32_t capacity = b->capacity ? b->capacity : 4096;
+    while (capacity < size) {
+      capacity *= 2;
+    }
+    b->data = (uint8_t*)realloc(b->data, capacity);
+    memset(b->data + b->capacity, 0x00, capacity - b->capacity);
+    b->capacity = capacity;
+  }
+}
+
+static void buffer_write_u8(buffer_t* b, uint32_t offset, uint8_t v) {
+  buffer_ensure(b, offset + 1);
+  b->data[offset] = v;
+  if (b->size < offset + 1) {
+    b->size = offset + 1;
+  }
+}
+
+static void buffer_write_u16(buffer_t* b, uint32_t offset, uint16_t v) {
+  buffer_write_u8(b, offset, v & 0xff);
+  buffer_write_u8(b, offset + 1, v >> 8);
+}
+
+static void buffer_write_u32(buffer_t* b, uint32_t offset, uint32_t v) {
+  buffer_write_u16(b, offset, v & 0xffff);
+  buffer_write_u16(b, offset + 2, v >> 16);
+}
+
+static uint8_t* read_file(const char* filename, uint32_t* size) {
+  long len = 0;
+  uint8_t* data = NULL;
+  FILE* fp = fopen(filename, "rb");
+
+  if (fp == NULL) {
+    fprintf(stderr, "open %s failed\n", filename);
+    return NULL;
+  }
+
+  fseek(fp, 0, SEEK_END);
+  len = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+
+  data = (uint8_t*)calloc(1, len + 1);
+  if (data != NULL && fread(data, 1, len, fp) == (size_t)len) {
+    *size = (uint32_t)len;
+  } else {
+    free(data);
+    data = NULL;
+  }
+  fclose(fp);
+
+  return data;
+}
+
+static const char* utf8_next(const char* p, uint32_t* c) {
+  const uint8_t* s = (const uint8_t*)p;
+
+  if (s[0] < 0x80) {
+    *c = s[0];
+    return p + 1;
+  } else if ((s[0] & 0xe0) == 0xc0 && s[1]) {
+    *c = ((s[0] & 0x1f) << 6) | (s[1] & 0x3f);
+    return p + 2;
+  } else if ((s[0] & 0xf0) == 0xe0 && s[1] && s[2]) {
+    *c = ((s[0] & 0x0f) << 12) | ((s[1] & 0x3f) << 6) | (s[2] & 0x3f);
+    return p + 3;
+  } else if ((s[0] & 0xf8) == 0xf0 && s[1] && s[2] && s[3]) {
+    *c = ((s[0] & 0x07) << 18) | ((s[1] & 0x3f) << 12) | ((s[2] & 0x3f) << 6) | (s[3] & 0x3f);
+    return p + 4;
+  }
+
+  *c = 0;
+  return p + 1;
+}
+
+static void add_chars(uint8_t* used, const char* start, const char* end) {
+  uint32_t c = 0;
+  const char* p = start;
+
+  while (p < end && *p) {
+    p = utf8_next(p, &c);
+    /* glyph_t and the index store 16-bit codes */
+    if (c >= 0x20 && c < MAX_CHARS) {
+      used[c] = 1;
+    }
+  }
+}
+
+static void add_chars_from_xml(uint8_t* used, const char* xml) {
+  const char* p = xml;
+
+  while ((p = strstr(p, "text")) != NULL) {
+    const char* start = NULL;
+    const char* end = NULL;
+    int is_attr = p > xml && (p[-1] == ' ' || p[-1] == '_' || p[-1] == '\t' || p[-1] == '\n');
+
+    p += 4;
+    if (is_attr && *p == '=' && (p[1] == '"' || p[1] == '\'')) {
+      /* text="..." or tr_text="..." */
+      char quote = p[1];
+      start = p + 2;
+      end = strchr(start, quote);
+    } else if (strncmp(p, "\">", 2) == 0 || strncmp(p, "'>", 2) == 0) {
+      /* <property name="text">...</property> */
+      start = p + 2;
+      end = strchr(start, '<');
+    }
+
+    if (start != NULL && end != NULL) {
+      add_chars(used, start, end);
+      p = end;
+    }
+  }
+}
+
+static int is_xml(const char* filename) {
+  size_t len = strlen(filename);
+
+  return len > 4 && strcmp(filename + len - 4, ".xml") == 0;
+}
+
+static uint32_t glyph_put(buffer_t* b, uint32_t offset, const stbtt_fontinfo* sf, float scale,
+                          uint32_t c, int bpp) {
+  int x = 0;
+  int y = 0;
+  int w = 0;
+  int h = 0;
+  int lsb = 0;
+  int advance = 0;
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t pitch = 0;
+  uint8_t* bitmap = NULL;
+
+  stbtt_GetCodepointHMetrics(sf, c, &advance, &lsb);
+  if (c != ' ') {
+    bitmap = stbtt_GetCodepointBitmap(sf, 0, scale, c, &w, &h, &x, &y);
+  }
+  pitch = bpp == 4 ? (w + 1) / 2 : w;
+
+  /* same layout as glyph_t without the data pointer */
+  buffer_write_u16(b, offset, (uint16_t)x);
+  buffer_write_u16(b, offset + 2, (uint16_t)y);
+  buffer_write_u16(b, offset + 4, (uint16_t)w);
+  buffer_write_u16(b, offset + 6, (uint16_t)h);
+  buffer_write_u16(b, offset + 8, (uint16_t)(advance * scale));
+  buffer_write_u8(b, offset + 10, bpp == 4 ? GLYPH_FMT_ALPHA4 : GLYPH_FMT_ALPHA);
+  buffer_write_u8(b, offset + 11, (uint8_t)(bpp == 4 ? pitch : 0));
+  offset += FONT_BITMAP_GLYPH_SIZE;
+
+  for (j = 0; j < (uint32_t)h; j++) {
+    for (i = 0; i < (uint32_t)w; i++) {
+      uint8_t a = bitmap[j * w + i];
+      if (bpp == 4) {
+        /* even pixel in the low nibble, as lcd_mem_draw_glyph4 expects */
+        uint32_t o = offset + j * pitch + i / 2;
+        uint8_t v = (uint8_t)((a + 8) > 0xff ? 0x0f : (a + 8) >> 4);
+        buffer_ensure(b, o + 1);
+        v = (i % 2) == 0 ? (b->data[o] & 0xf0) | v : (b->data[o] & 0x0f) | (v << 4);
+        buffer_write_u8(b, o, v);
+      } else {
+        buffer_write_u8(b, offset + j * pitch + i, a);
+      }
+    }
+  }
+
+  if (bitmap != NULL) {
+    stbtt_FreeBitmap(bitmap, NULL);
+  }
+
+  return offset + pitch * h;
+}
+
+static int write_asset(const char* filename, const char* name, const buffer_t* font) {
+  uint32_t i = 0;
+  buffer_t asset = {NULL, 0, 0};
+  FILE* fp = fopen(filename, "wb");
+
+  if (fp == NULL) {
+    fprintf(stderr, "open %s failed\n", filename);
+    return -1;
+  }
+
+  /* asset_info_t: type, subtype, is_in_rom, size, refcount, name */
+  buffer_write_u16(&asset, 0, ASSET_TYPE_FONT);
+  buffer_write_u8(&asset, 2, ASSET_TYPE_FONT_BMP);
+  buffer_write_u8(&asset, 3, 1);
+  buffer_write_u32(&asset, 4, font->size);
+  buffer_write_u32(&asset, 8, 0);
+  for (i = 0; i <= TK_NAME_LEN; i++) {
+    buffer_write_u8(&asset, 12 + i, i < strlen(name) && i < TK_NAME_LEN ? name[i] : 0);
+  }
+  for (i = 0; i < font->size; i++) {
+    buffer_write_u8(&asset, 12 + TK_NAME_LEN + 1 + i, font->data[i]);
+  }
+
+  fprintf(fp, "TK_CONST_DATA_ALIGN(const unsigned char font_%s[]) = {", name);
+  for (i = 0; i < asset.size; i++) {
+    if ((i % 20) == 0) {
+      fprintf(fp, "\n");
+    }
+    fprintf(fp, "0x%02x,", asset.data[i]);
+  }
+  fprintf(fp, "};/*%u*/\n", asset.size);
+  fclose(fp);
+  free(asset.data);
+
+  return 0;
+}
+
+static void usage(const char* app) {
+  fprintf(stderr,
+          "Usage: %s [-b 8|4] [-n name] [-a] [-c chars] [-t charset] ttf font_size output "
+          "[xml...]\n",
+          app);
+  exit(1);
+}
+
+static int add_chars_from_file(uint8_t* used, const char* filename, int xml) {
+  uint32_t size = 0;
+  char* text = (char*)read_file(filename, &size);
+
+  if (text == NULL) {
+    return -1;
+  }
+
+  if (xml) {
+    add_chars_from_xml(used, text);
+  } else {
+    add_chars(used, text, text + size);
+  }
+  free(text);
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  int i = 1;
+  int bpp = 8;
+  int ascii = 0;
+  uint32_t c = 0;
+  uint32_t nr = 0;
+  uint32_t offset = 0;
+  int font_size = 0;
+  float scale = 0;
+  int ascent = 0;
+  int descent = 0;
+  int line_gap = 0;
+  uint32_t ttf_size = 0;
+  uint8_t* ttf = NULL;
+  const char* name = NULL;
+  const char* chars = NULL;
+  const char* output = NULL;
+  char default_name[TK_NAME_LEN + 1];
+  stbtt_fontinfo sf;
+  buffer_t font = {NULL, 0, 0};
+  uint8_t* used = (uint8_t*)calloc(MAX_CHARS, 1);
+
+  for (; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+      bpp = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      name = argv[++i];
+    } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+      chars = argv[++i];
+    } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+      if (add_chars_from_file(used, argv[++i], 0) != 0) {
+        return 1;
+      }
+    } else if (strcmp(argv[i], "-a") == 0) {
+      ascii = 1;
+    } else {
+      usage(argv[0]);
+    }
+  }
+
+  if (argc - i < 3 || (bpp != 8 && bpp != 4)) {
+    usage(argv[0]);
+  }
+
+  ttf = read_file(argv[i], &ttf_size);
+  font_size = atoi(argv[i + 1]);
+  output = argv[i + 2];
+  if (ttf == NULL || font_size <= 0 ||
+      !stbtt_InitFont(&sf, ttf, stbtt_GetFontOffsetForIndex(ttf, 0))) {
+    fprintf(stderr, "invalid font %s\n", argv[i]);
+    return 1;
+  }
+
+  if (name == NULL) {
+    snprintf(default_name, sizeof(default_name), "default_%d", font_size);
+    name = default_name;
+  }
+
+  used[' '] = 1;
+  if (ascii) {
+    for (c = 0x20; c < 0x7f; c++) {
+      used[c] = 1;
+    }
+  }
+  if (chars != NULL) {
+    add_chars(used, chars, chars + strlen(chars));
+  }
+  for (i += 3; i < argc; i++) {
+    if (add_chars_from_file(used, argv[i], is_xml(argv[i])) != 0) {
+      return 1;
+    }
+  }
+
+  for (c = 0; c < MAX_CHARS; c++) {
+    if (used[c] && stbtt_FindGlyphIndex(&sf, c) == 0 && c != ' ') {
+      fprintf(stderr, "warning: 0x%04x not in font\n", c);
+      used[c] = 0;
+    }
+    nr += used[c];
+  }
+
+  /* same as font_stb_get_vmetrics/font_stb_get_glyph */
+  scale = stbtt_ScaleForPixelHeight(&sf, font_size);
+  if (scale == INFINITY) {
+    scale = stbtt_ScaleForMappingEmToPixels(&sf, font_size);
+  }
+  stbtt_GetFontVMetrics(&sf, &ascent, &descent, &line_gap);
+
+  buffer_write_u16(&font, 0, 1);
+  buffer_write_u16(&font, 2, bpp == 4 ? GLYPH_FMT_ALPHA4 : GLYPH_FMT_ALPHA);
+  buffer_write_u16(&font, 4, (uint16_t)nr);
+  buffer_write_u16(&font, 6, (uint16_t)font_size);
+  buffer_write_u16(&font, 8, (uint16_t)(int16_t)(ascent * scale));
+  buffer_write_u16(&font, 10, (uint16_t)(int16_t)(descent * scale));
+  buffer_write_u16(&font, 12, (uint16_t)(int16_t)(line_gap * scale));
+  buffer_write_u16(&font, 14, 0);
+
+  offset = FONT_BITMAP_HEADER_SIZE + nr * FONT_BITMAP_INDEX_SIZE;
+  for (c = 0, i = 0; c < MAX_CHARS; c++) {
+    if (used[c]) {
+      uint32_t index = FONT_BITMAP_HEADER_SIZE + i * FONT_BITMAP_INDEX_SIZE;
+      uint32_t end = glyph_put(&font, offset, &sf, scale, c, bpp);
+
+      /* index is sorted by code, font_bitmap_get_glyph does a binary search */
+      buffer_write_u16(&font, index, (uint16_t)c);
+      buffer_write_u16(&font, index + 2, (uint16_t)(end - offset));
+      buffer_write_u32(&font, index + 4, offset);
+
+      offset = (end + 3) & ~3u;
+      i++;
+    }
+  }
+  /* older font_bitmap_get_glyph copied a whole glyph_t: pad for the last glyph */
+  offset += sizeof(void*);
+  buffer_ensure(&font, offset);
+  font.size = offset;
+
+  if (write_asset(output, name, &font) != 0) {
+    return 1;
+  }
+
+  printf("%s: %u chars, %u bytes, %d bpp\n", name, nr, font.size, bpp);
+  free(font.data);
+  free(used);
+  free(ttf);
+
+  return 0;
+}
@@ -0,0 +1,319 @@
+/**
+ * File:   image_gen.c
+ * Author: AWTK Develop Team
+ * Brief:  convert png/jpg/bmp to (rle compressed) raw image asset
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/*
+ * 把图片转换为 raw 图片资源(.data)，缺省按行做 RLE 压缩(ASSET_TYPE_IMAGE_RLE)，
+ * 格式与 src/base/bitmap_rle.h 一致。运行时 image_copy/image_blend 只解码可见的行，
+ * 不需要把整张图片解压到内存中。
+ *
+ * 用法：
+ *   image_gen [-f format] [-n name] [-r] image output
+ *
+ *   -f  像素格式：bgr565(缺省)、rgb565、bgra8888 或 rgba8888。
+ *   -n  资源名，缺省为图片的文件名(不含路径和扩展名)。
+ *   -r  不压缩，输出普通的 raw 图片(ASSET_TYPE_IMAGE_RAW)，用于比较。
+ *
+ * 编译：
+ *   gcc -O2 -o image_gen image_gen.c -lm
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../../lib/AWTK_GUI/awtk/3rd/stb/stb_image.h"
+
+/* keep in sync with src/tkc/asset_info.h, src/base/types_def.h and src/base/bitmap_rle.h */
+#define TK_NAME_LEN 31
+#define ASSET_TYPE_IMAGE 2
+#define ASSET_TYPE_IMAGE_RAW 1
+#define ASSET_TYPE_IMAGE_RLE 10
+#define BITMAP_FMT_RGBA8888 1
+#define BITMAP_FMT_BGRA8888 3
+#define BITMAP_FMT_RGB565 5
+#define BITMAP_FMT_BGR565 6
+#define BITMAP_FLAG_OPAQUE 1
+#define BITMAP_FLAG_IMMUTABLE 2
+#define BITMAP_HEADER_SIZE 12
+#define RLE_MAX_COUNT 128
+#define RLE_MIN_RUN 3
+
+typedef struct _buffer_t {
+  uint8_t* data;
+  uint32_t size;
+  uint32_t capacity;
+} buffer_t;
+
+static void buffer_ensure(buffer_t* b, uint32_t size) {
+  if (b->capacity < size) {
+    uint32_t capacity = b->capacity ? b->capacity : 4096;
+    while (capacity < size) {
+      capacity *= 2;
+    }
+    b->data = (uint8_t*)realloc(b->data, capacity);
+    memset(b->data + b->capacity, 0x00, capacity - b->capacity);
+    b->capacity = capacity;
+  }
+}
+
+static void buffer_write_u8(buffer_t* b, uint32_t offset, uint8_t v) {
+  buffer_ensure(b, offset + 1);
+  b->data[offset] = v;
+  if (b->size < offset + 1) {
+    b->size = offset + 1;
+  }
+}
+
+static void buffer_write_u16(buffer_t* b, uint32_t offset, uint16_t v) {
+  buffer_write_u8(b, offset, v & 0xff);
+  buffer_write_u8(b, offset + 1, v >> 8);
+}
+
+static void buffer_write_u32(buffer_t* b, uint32_t offset, uint32_t v) {
+  buffer_write_u16(b, offset, v & 0xffff);
+  buffer_write_u16(b, offset + 2, v >> 16);
+}
+
+static void buffer_write(buffer_t* b, uint32_t offset, const uint8_t* data, uint32_t size) {
+  buffer_ensure(b, offset + size);
+  memcpy(b->data + offset, data, size);
+  if (b->size < offset + size) {
+    b->size = offset + size;
+  }
+}
+
+static uint32_t pixel_put(uint8_t* d, int format, const uint8_t* s) {
+  uint16_t v = 0;
+
+  switch (format) {
+    case BITMAP_FMT_BGR565: {
+      /* same as rgb_to_bgr565 in src/base/pixel_pack_unpack.h */
+      v = ((s[0] >> 3) << 11) | ((s[1] >> 2) << 5) | (s[2] >> 3);
+      d[0] = v & 0xff;
+      d[1] = v >> 8;
+      return 2;
+    }
+    case BITMAP_FMT_RGB565: {
+      v = ((s[2] >> 3) << 11) | ((s[1] >> 2) << 5) | (s[0] >> 3);
+      d[0] = v & 0xff;
+      d[1] = v >> 8;
+      return 2;
+    }
+    case BITMAP_FMT_BGRA8888: {
+      d[0] = s[2];
+      d[1] = s[1];
+      d[2] = s[0];
+      d[3] = s[3];
+      return 4;
+    }
+    default: {
+      memcpy(d, s, 4);
+      return 4;
+    }
+  }
+}
+
+static uint32_t run_length(const uint8_t* p, uint32_t n, uint32_t bpp) {
+  uint32_t i = 1;
+
+  while (i < n && i < RLE_MAX_COUNT && memcmp(p, p + i * bpp, bpp) == 0) {
+    i++;
+  }
+
+  return i;
+}
+
+/* 见 src/base/bitmap_rle.h：c & 0x80 为重复的像素，否则为 c + 1 个原样保存的像素 */
+static uint32_t rle_encode_row(buffer_t* b, uint32_t offset, const uint8_t* p, uint32_t w,
+                               uint32_t bpp) {
+  uint32_t i = 0;
+
+  while (i < w) {
+    uint32_t n = run_length(p + i * bpp, w - i, bpp);
+
+    if (n >= RLE_MIN_RUN) {
+      buffer_write_u8(b, offset++, 0x80 | (n - 1));
+      buffer_write(b, offset, p + i * bpp, bpp);
+      offset += bpp;
+    } else {
+      n = 0;
+      while (i + n < w && n < RLE_MAX_COUNT &&
+             run_length(p + (i + n) * bpp, w - i - n, bpp) < RLE_MIN_RUN) {
+        n++;
+      }
+      buffer_write_u8(b, offset++, n - 1);
+      buffer_write(b, offset, p + i * bpp, n * bpp);
+      offset += n * bpp;
+    }
+    i += n;
+  }
+
+  return offset;
+}
+
+static int write_asset(const char* filename, const char* name, int subtype, const buffer_t* image) {
+  uint32_t i = 0;
+  buffer_t asset = {NULL, 0, 0};
+  FILE* fp = fopen(filename, "wb");
+
+  if (fp == NULL) {
+    fprintf(stderr, "open %s failed\n", filename);
+    return -1;
+  }
+
+  /* asset_info_t: type, subtype, is_in_rom, size, refcount, name */
+  buffer_write_u16(&asset, 0, ASSET_TYPE_IMAGE);
+  buffer_write_u8(&asset, 2, subtype);
+  buffer_write_u8(&asset, 3, 1);
+  buffer_write_u32(&asset, 4, image->size);
+  buffer_write_u32(&asset, 8, 0);
+  for (i = 0; i <= TK_NAME_LEN; i++) {
+    buffer_write_u8(&asset, 12 + i, i < strlen(name) && i < TK_NAME_LEN ? name[i] : 0);
+  }
+  buffer_write(&asset, 12 + TK_NAME_LEN + 1, image->data, image->size);
+
+  fprintf(fp, "TK_CONST_DATA_ALIGN(const unsigned char image_%s[]) = {", name);
+  for (i = 0; i < asset.size; i++) {
+    if ((i % 20) == 0) {
+      fprintf(fp, "\n");
+    }
+    fprintf(fp, "0x%02x,", asset.data[i]);
+  }
+  fprintf(fp, "};/*%u*/\n", asset.size);
+  fclose(fp);
+  free(asset.data);
+
+  return 0;
+}
+
+static int format_from_name(const char* name) {
+  if (strcmp(name, "bgr565") == 0) {
+    return BITMAP_FMT_BGR565;
+  } else if (strcmp(name, "rgb565") == 0) {
+    return BITMAP_FMT_RGB565;
+  } else if (strcmp(name, "bgra8888") == 0) {
+    return BITMAP_FMT_BGRA8888;
+  } else if (strcmp(name, "rgba8888") == 0) {
+    return BITMAP_FMT_RGBA8888;
+  }
+
+  return 0;
+}
+
+static void usage(const char* app) {
+  fprintf(stderr, "Usage: %s [-f bgr565|rgb565|bgra8888|rgba8888] [-n name] [-r] image output\n",
+          app);
+  exit(1);
+}
+
+int main(int argc, char* argv[]) {
+  int i = 1;
+  int w = 0;
+  int h = 0;
+  int n = 0;
+  int raw = 0;
+  int opaque = 1;
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint32_t bpp = 0;
+  uint32_t offset = 0;
+  uint8_t* rgba = NULL;
+  uint8_t* row = NULL;
+  const char* name = NULL;
+  const char* output = NULL;
+  int format = BITMAP_FMT_BGR565;
+  char default_name[TK_NAME_LEN + 1];
+  buffer_t image = {NULL, 0, 0};
+
+  for (; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+      format = format_from_name(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      name = argv[++i];
+    } else if (strcmp(argv[i], "-r") == 0) {
+      raw = 1;
+    } else {
+      usage(argv[0]);
+    }
+  }
+
+  if (argc - i < 2 || format == 0) {
+    usage(argv[0]);
+  }
+
+  rgba = stbi_load(argv[i], &w, &h, &n, 4);
+  output = argv[i + 1];
+  if (rgba == NULL || w > 0xffff || h > 0xffff) {
+    fprintf(stderr, "invalid image %s\n", argv[i]);
+    return 1;
+  }
+
+  if (name == NULL) {
+    const char* p = strrchr(argv[i], '/');
+    p = p != NULL ? p + 1 : argv[i];
+    snprintf(default_name, sizeof(default_name), "%s", p);
+    if (strchr(default_name, '.') != NULL) {
+      *strchr(default_name, '.') = '\0';
+    }
+    name = default_name;
+  }
+
+  for (x = 0; x < (uint32_t)(w * h); x++) {
+    opaque = opaque && rgba[x * 4 + 3] == 0xff;
+  }
+  bpp = (format == BITMAP_FMT_BGR565 || format == BITMAP_FMT_RGB565) ? 2 : 4;
+  if (!opaque && bpp == 2) {
+    fprintf(stderr, "warning: alpha channel of %s is dropped\n", argv[i]);
+  }
+
+  /* bitmap_header_t: w, h, flags, format, orientation */
+  buffer_write_u16(&image, 0, (uint16_t)w);
+  buffer_write_u16(&image, 2, (uint16_t)h);
+  opaque = opaque || bpp == 2;
+  buffer_write_u16(&image, 4, BITMAP_FLAG_IMMUTABLE | (opaque ? BITMAP_FLAG_OPAQUE : 0));
+  buffer_write_u16(&image, 6, (uint16_t)format);
+  buffer_write_u32(&image, 8, 0);
+
+  row = (uint8_t*)malloc(w * bpp);
+  offset = BITMAP_HEADER_SIZE + (raw ? 0 : (h + 1) * 4);
+  for (y = 0; y < (uint32_t)h; y++) {
+    for (x = 0; x < (uint32_t)w; x++) {
+      pixel_put(row + x * bpp, format, rgba + (y * w + x) * 4);
+    }
+
+    if (raw) {
+      buffer_write(&image, offset, row, w * bpp);
+      offset += w * bpp;
+    } else {
+      uint32_t start = BITMAP_HEADER_SIZE + (h + 1) * 4;
+      buffer_write_u32(&image, BITMAP_HEADER_SIZE + y * 4, offset - start);
+      offset = rle_encode_row(&image, offset, row, w, bpp);
+      buffer_write_u32(&image, BITMAP_HEADER_SIZE + (y + 1) * 4, offset - start);
+    }
+  }
+
+  if (write_asset(output, name, raw ? ASSET_TYPE_IMAGE_RAW : ASSET_TYPE_IMAGE_RLE, &image) != 0) {
+    return 1;
+  }
+
+  printf("%s: %dx%d, %u bytes (raw %u bytes)\n", name, w, h, image.size,
+         BITMAP_HEADER_SIZE + w * h * bpp);
+  free(image.data);
+  free(row);
+  stbi_image_free(rgba);
+
+  return 0;
+}
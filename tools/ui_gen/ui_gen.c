@@ -0,0 +1,257 @@
+/**
+ * File:   ui_gen.c
+ * Author: AWTK Develop Team
+ * Brief:  convert ui xml (or ui asset) to binary ui asset
+ *
+ * Copyright (c) 2018 - 2022  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/*
+ * 把界面描述文件转换为 UI 资源(.data)。输入可以是 xml，也可以是已有的 .data，用于在 v1/v2 之间转换。
+ *
+ * 用法：
+ *   ui_gen [-2] [-n name] input output
+ *
+ *   -2  输出 v2 格式(UI_DATA_MAGIC_V2，见 src/ui_loader/ui_binary_writer.h)：类型名和属性名保存为
+ *       字符串表的下标，内置的布尔/整数属性、style 和 self_layout 预先转换好，打开窗口时不再解析。
+ *       缺省输出 v1 格式。
+ *   -n  资源名，缺省为输入的文件名(不含路径和扩展名)。
+ *
+ * 编译：
+ *   和 AWTK 的源码一起编译(与 native 测试环境使用同一份 awtk_config.h)：
+ *   pio run -e ui_gen
+ *   .pio/build/ui_gen/program -2 home_page.data home_page.data
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/buffer.h"
+#include "tkc/platform.h"
+#include "tkc/asset_info.h"
+#include "ui_loader/ui_loader_xml.h"
+#include "ui_loader/ui_loader_default.h"
+#include "ui_loader/ui_binary_writer.h"
+
+/* 资源中 asset_info_t 的头部，数据紧跟在 name 后面(data 字段) */
+#define ASSET_HEADER_SIZE offsetof(asset_info_t, data)
+
+static uint8_t* read_file(const char* filename, uint32_t* size) {
+  long len = 0;
+  uint8_t* data = NULL;
+  FILE* fp = fopen(filename, "rb");
+
+  if (fp == NULL) {
+    return NULL;
+  }
+
+  fseek(fp, 0, SEEK_END);
+  len = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  data = (uint8_t*)calloc(1, len + 1);
+  if (data != NULL && fread(data, 1, len, fp) != (size_t)len) {
+    free(data);
+    data = NULL;
+  }
+  fclose(fp);
+  *size = (uint32_t)len;
+
+  return data;
+}
+
+/* 从 .data(C 数组)中取出字节，返回字节数 */
+static uint32_t parse_asset_bytes(const char* text, uint8_t* out) {
+  uint32_t n = 0;
+  const char* p = strchr(text, '{');
+
+  while (p != NULL && (p = strstr(p, "0x")) != NULL) {
+    out[n++] = (uint8_t)strtoul(p, (char**)&p, 16);
+  }
+
+  return n;
+}
+
+static int write_asset(const char* filename, const char* name, const wbuffer_t* ui) {
+  uint32_t i = 0;
+  asset_info_t info;
+  const uint8_t* header = (const uint8_t*)&info;
+  FILE* fp = fopen(filename, "wb");
+
+  if (fp == NULL) {
+    fprintf(stderr, "open %s failed\n", filename);
+    return -1;
+  }
+
+  memset(&info, 0x00, sizeof(info));
+  info.type = ASSET_TYPE_UI;
+  info.subtype = ASSET_TYPE_UI_BIN;
+  info.is_in_rom = TRUE;
+  info.size = ui->cursor;
+  tk_strncpy(info.name, name, TK_NAME_LEN);
+
+  /* 和 AWTK 的资源生成工具一样，总长度为 sizeof(asset_info_t) + size，末尾补 0 */
+  fprintf(fp, "TK_CONST_DATA_ALIGN(const unsigned char ui_%s[]) = {", name);
+  for (i = 0; i < sizeof(info) + ui->cursor; i++) {
+    uint8_t c = 0;
+    if (i < ASSET_HEADER_SIZE) {
+      c = header[i];
+    } else if (i < ASSET_HEADER_SIZE + ui->cursor) {
+      c = ui->data[i - ASSET_HEADER_SIZE];
+    }
+    if ((i % 20) == 0) {
+      fprintf(fp, "\n");
+    }
+    fprintf(fp, "0x%02x,", c);
+  }
+  fprintf(fp, "};/*%u*/\n", (uint32_t)(sizeof(info) + ui->cursor));
+  fclose(fp);
+
+  return 0;
+}
+
+/*
+ * default_ui_loader 读完一个控件后检查 b->widget，为 NULL 时认为根控件已经结束。
+ * writer 不创建控件，这里按嵌套层次设置 b->widget，否则 .data 输入只会转换根控件。
+ * v1 数据最后一个结束标记不会回调 on_widget_end，on_end 时补上没有结束的控件。
+ */
+static widget_t s_placeholder;
+static uint32_t s_level = 0;
+static ui_builder_on_widget_start_t s_on_widget_start = NULL;
+static ui_builder_on_widget_end_t s_on_widget_end = NULL;
+static ui_builder_on_end_t s_on_end = NULL;
+
+static ret_t on_widget_start(ui_builder_t* b, const widget_desc_t* desc) {
+  s_level++;
+  b->widget = &s_placeholder;
+
+  return s_on_widget_start(b, desc);
+}
+
+static ret_t on_widget_end(ui_builder_t* b) {
+  if (s_level > 0 && --s_level == 0) {
+    b->widget = NULL;
+  }
+
+  return s_on_widget_end(b);
+}
+
+static ret_t on_end(ui_builder_t* b) {
+  while (s_level > 0) {
+    on_widget_end(b);
+  }
+
+  return s_on_end != NULL ? s_on_end(b) : RET_OK;
+}
+
+static void usage(const char* app) {
+  fprintf(stderr, "Usage: %s [-2] [-n name] input(.xml|.data) output\n", app);
+  exit(1);
+}
+
+int main(int argc, char* argv[]) {
+  int i = 1;
+  int v2 = 0;
+  int ret = 0;
+  uint32_t size = 0;
+  uint8_t* text = NULL;
+  uint8_t* data = NULL;
+  uint32_t data_size = 0;
+  const char* name = NULL;
+  const char* input = NULL;
+  ui_loader_t* loader = NULL;
+  ui_builder_t* builder = NULL;
+  char default_name[TK_NAME_LEN + 1];
+  ui_binary_writer_t writer;
+  wbuffer_t wbuffer;
+
+  for (; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp(argv[i], "-2") == 0) {
+      v2 = 1;
+    } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      name = argv[++i];
+    } else {
+      usage(argv[0]);
+    }
+  }
+
+  if (argc - i < 2) {
+    usage(argv[0]);
+  }
+
+  platform_prepare();
+  input = argv[i];
+  text = read_file(input, &size);
+  if (text == NULL) {
+    fprintf(stderr, "read %s failed\n", input);
+    return 1;
+  }
+
+  if (name == NULL) {
+    const char* p = strrchr(input, '/');
+    p = p != NULL ? p + 1 : input;
+    snprintf(default_name, sizeof(default_name), "%s", p);
+    if (strchr(default_name, '.') != NULL) {
+      *strchr(default_name, '.') = '\0';
+    }
+    name = default_name;
+  }
+
+  if (strstr(input, ".data") != NULL) {
+    /* 已经生成的资源：跳过头部，里面是 v1 或 v2 的 UI 数据 */
+    data = (uint8_t*)calloc(1, size / 5 + 1);
+    data_size = parse_asset_bytes((const char*)text, data);
+    if (data_size <= ASSET_HEADER_SIZE ||
+        ((const asset_info_t*)data)->size > data_size - ASSET_HEADER_SIZE) {
+      fprintf(stderr, "invalid asset %s\n", input);
+      return 1;
+    }
+    loader = default_ui_loader();
+    data_size = ((const asset_info_t*)data)->size;
+    memmove(data, data + ASSET_HEADER_SIZE, data_size);
+  } else {
+    loader = xml_ui_loader();
+    data = text;
+    data_size = size;
+    text = NULL;
+  }
+
+  wbuffer_init_extendable(&wbuffer);
+  if (v2) {
+    builder = ui_binary_writer_init_v2(&writer, &wbuffer);
+  } else {
+    builder = ui_binary_writer_init(&writer, &wbuffer);
+  }
+  s_on_widget_start = builder->on_widget_start;
+  s_on_widget_end = builder->on_widget_end;
+  builder->on_widget_start = on_widget_start;
+  builder->on_widget_end = on_widget_end;
+  s_on_end = builder->on_end;
+  builder->on_end = on_end;
+
+  if (ui_loader_load(loader, data, data_size, builder) != RET_OK || writer.failed ||
+      wbuffer.cursor <= sizeof(uint32_t)) {
+    fprintf(stderr, "convert %s failed\n", input);
+    ret = 1;
+  } else if (write_asset(argv[i + 1], name, &wbuffer) != 0) {
+    ret = 1;
+  } else {
+    printf("%s: v%d, %u bytes (input %u bytes)\n", name, v2 ? 2 : 1, wbuffer.cursor, data_size);
+  }
+
+  ui_binary_writer_deinit(&writer);
+  wbuffer_deinit(&wbuffer);
+  free(data);
+  free(text);
+
+  return ret;
+}